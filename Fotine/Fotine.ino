@@ -5,8 +5,13 @@
   - Pilotaggio pannello ST7701 480×480 via Arduino_GFX (type9).
   - Wi-Fi: STA da NVS, fallback AP con captive portal.
   - NTP per data/ora visualizzate nella barra in alto.
-  - SD su HSPI: salvataggio e lettura immagini.
-  - Download immagini via proxy (JPEG baseline), controllo SOF0.
+  - SD su HSPI: copia dell'ultima immagine buona, usata come ripiego.
+  - Download immagini via proxy (JPEG baseline) decodificato a blocchi mentre arriva:
+    SOI/SOF controllati al volo, stream copiato su SD nello stesso passaggio.
+  - Prefetch su core 0: il prossimo frame è già decodificato in PSRAM allo scadere del tempo,
+    il cambio è un solo blit (con dissolvenza); anello LRU degli ultimi frame per l'offline.
+  - Avvio non bloccante (BootSeq.h): prima foto da SD mentre il Wi-Fi si connette,
+    ora SNTP in background, tempi delle fasi su Serial e su /boot.
   - Cambio immagine ogni 60 s.
 */
 
@@ -18,6 +23,11 @@
 #include <HTTPClient.h>
 #include <WiFiClientSecure.h>
 #include <Arduino_GFX_Library.h>
+
+// Contatori di disegno su Serial (1 = attivi, 0 = nessun costo)
+#define DRAW_STATS 0
+#include <DrawStats.h>
+#include <BootSeq.h>
 #include <time.h>
 #include <TJpg_Decoder.h>
 #include <SPI.h>
@@ -34,13 +44,15 @@
 static const char* NTP_SERVER = "pool.ntp.org";
 static const long   GMT_OFFSET_SEC      = 3600;
 static const int    DAYLIGHT_OFFSET_SEC = 3600;
-static bool g_timeSynced = false;
+static const uint32_t STA_TIMEOUT_MS = 8000;       // poi portale AP
+static bool g_timeSynced = false;                   // primo sync SNTP arrivato (BootSeq.h)
 
 // ----------------------------- Sorgente immagini (proxy) -----------------------------
-// Il proxy forza JPEG baseline 480×480, qualità 85, con redirect gestiti da HTTPClient.
+// Il proxy forza JPEG baseline 480×424 (l'area sotto l'header), qualità 85,
+// con redirect gestiti da HTTPClient.
 static const char* IMAGE_PROXY_BASE =
   "https://images.weserv.nl/"
-  "?url=picsum.photos/480/480.jpg"
+  "?url=picsum.photos/480/424.jpg"
   "&output=jpg"
   "&quality=85"
   "&fit=cover"
@@ -61,7 +73,8 @@ static uint32_t lastImageChange = 0;
 
 SPIClass spiSD(HSPI);
 static bool sd_ok = false;
-static const char* SD_JPEG_PATH = "/picsum.jpg";
+static const char* SD_JPEG_PATH = "/picsum.jpg";   // ultima immagine completa (ripiego offline)
+static const char* SD_JPEG_TMP  = "/picsum.tmp";   // download in corso, rinominato a fine decode
 
 // Hot-plug SD: rilevazione inserimento/estrazione
 bool sdCardPresent = false;
@@ -87,7 +100,7 @@ Arduino_ESP32RGBPanel *rgbpanel = new Arduino_ESP32RGBPanel(
 );
 
 // Display 480×480 con sequenza init type9 (fornita dalla libreria)
-Arduino_RGB_Display *gfx = new Arduino_RGB_Display(
+DrawStatsDisplay *gfx = new DrawStatsDisplay(
   480, 480, rgbpanel, 0, true,
   bus, GFX_NOT_DEFINED,
   st7701_type9_init_operations, sizeof(st7701_type9_init_operations)
@@ -97,57 +110,140 @@ Arduino_RGB_Display *gfx = new Arduino_RGB_Display(
 DNSServer dnsServer;
 WebServer web(80);
 Preferences prefs;
-String sta_ssid, sta_pass;
 String ap_ssid, ap_pass;
 const byte DNS_PORT = 53;
 bool isAPMode = false;
 
+// ----------------------------- JPEG a flusso -----------------------------
+// Marker letti mentre i byte arrivano: SOI, segmenti fino al SOF, dimensioni.
+// Scarta subito (prima di disegnare) file non JPEG, progressivi o con SOF non baseline.
+struct JpegSniffer {
+  enum State : uint8_t { SOI0, SOI1, MARK, TYPE, LEN0, LEN1, SKIP, SOF, DONE, BAD };
+  State    st = SOI0;
+  uint8_t  type = 0;           // marker corrente
+  uint16_t left = 0;           // byte ancora da saltare nel segmento
+  uint8_t  sof[5]; uint8_t sofN = 0;
+  uint16_t width = 0, height = 0;
+  const char* why = nullptr;   // motivo dello scarto
+
+  static bool isSOF(uint8_t t) { return t >= 0xC0 && t <= 0xCF && t != 0xC4 && t != 0xC8 && t != 0xCC; }
+  void fail(const char* w) { st = BAD; why = w; }
+
+  // false = stream da scartare; dopo il SOF i byte passano senza controlli
+  bool feed(const uint8_t* p, size_t n) {
+    for (size_t i = 0; i < n && st < DONE; ++i) step(p[i]);
+    return st != BAD;
+  }
+
+  void step(uint8_t b) {
+    switch (st) {
+      case SOI0: if (b == 0xFF) st = SOI1; else fail("non e' un JPEG (no 0xFFD8)"); break;
+      case SOI1: if (b == 0xD8) st = MARK; else fail("non e' un JPEG (no 0xFFD8)"); break;
+      case MARK: if (b == 0xFF) st = TYPE; else fail("marker atteso"); break;
+      case TYPE:
+        if (b == 0xFF) break;                                          // riempimento
+        type = b;
+        if (b == 0x01 || (b >= 0xD0 && b <= 0xD8)) { st = MARK; break; } // marker senza lunghezza
+        if (b == 0xD9 || b == 0xDA) { fail("SOF non trovato"); break; }
+        st = LEN0; break;
+      case LEN0: left = (uint16_t)b << 8; st = LEN1; break;
+      case LEN1:
+        left |= b;
+        if (left < 2) { fail("segmento non valido"); break; }
+        left -= 2;
+        if (isSOF(type)) {
+          if (type == 0xC2)   { fail("PROGRESSIVE (SOF2)"); break; }
+          if (type != 0xC0)   { fail("SOF non baseline"); break; }
+          if (left < 5)       { fail("SOF troppo corto"); break; }
+          sofN = 0; st = SOF;
+        } else {
+          st = left ? SKIP : MARK;
+        }
+        break;
+      case SKIP: if (--left == 0) st = MARK; break;
+      case SOF:
+        sof[sofN++] = b;
+        if (sofN == 5) {
+          height = (uint16_t)(sof[1] << 8 | sof[2]);
+          width  = (uint16_t)(sof[3] << 8 | sof[4]);
+          if (!width || !height) fail("dimensioni nulle"); else st = DONE;
+        }
+        break;
+      default: break;
+    }
+  }
+};
+
+// Stato di una decodifica: stream HTTP o file -> (marker, copia SD) -> tjpgd -> frame in PSRAM
+struct JpegStreamCtx {
+  Stream*     in  = nullptr;   // sorgente dei byte
+  WiFiClient* net = nullptr;   // != nullptr se la sorgente è la rete (attesa dati, connected())
+  int32_t  remaining = -1;     // byte attesi (-1: fino a chiusura)
+  File     sd;                 // copia su SD (chiusa se la SD non c'è)
+  JpegSniffer sniff;
+  uint32_t total = 0, blocks = 0;
+  uint32_t tGet = 0;           // istante del GET
+  uint32_t sofMs = 0, firstBlockMs = 0, lastBlockMs = 0;   // dal GET
+  uint32_t waitMs = 0, sdMs = 0;                           // attesa rete, scrittura SD
+  uint32_t decodeMs = 0;       // jd_decomp senza l'attesa della rete
+  uint16_t* frame = nullptr;   // destinazione FRAME_W x FRAME_H
+  int16_t  offX = 0, offY = 0; // immagine centrata nel frame
+  uint8_t  scale = 0;          // 0..3 = 1/1..1/8
+};
+
+static const uint32_t JPEG_STALL_MS = 10000;  // stream fermo oltre questo tempo: download fallito
+
+#ifdef TJPGD_WORKSPACE_SIZE
+static uint8_t s_jpgPool[TJPGD_WORKSPACE_SIZE] __attribute__((aligned(4)));
+#else
+static uint8_t s_jpgPool[10240] __attribute__((aligned(4)));
+#endif
+
 // ----------------------------- Colori / Header UI -----------------------------
 #define RGB565_ORANGE 0xFD20
 #define RGB565_BLACK  0x0000
 #define RGB565_WHITE  0xFFFF
 static const int HEADER_H = 56;
 
-// ----------------------------- Utils LCD -----------------------------
-// PWM a 8 bit per accendere il backlight al 100%
-static void backlightOn() {
-  ledcSetup(PWM_CHANNEL, PWM_FREQ, PWM_BITS);
-  ledcAttachPin(GFX_BL, PWM_CHANNEL);
-  ledcWrite(PWM_CHANNEL, 255);
-}
-
-// Sequenza di avvio pannello + pulizia schermo
-static void panelKickstart() {
-  delay(50);
-  gfx->begin();
-  gfx->setRotation(0);
-  delay(120);
-  gfx->displayOn();
-  delay(20);
-  gfx->fillScreen(RGB565_BLACK);
-  gfx->fillRect(0, 0, 480, 20, RGB565_ORANGE);
-  delay(60);
-}
-
-// ----------------------------- NTP helpers -----------------------------
-static bool waitForValidTime(uint32_t timeoutMs = 8000) {
-  uint32_t t0 = millis();
-  time_t now = 0; struct tm info;
-  while ((millis() - t0) < timeoutMs) {
-    time(&now); localtime_r(&now, &info);
-    if (info.tm_year + 1900 > 2020) return true;
-    delay(200);
-  }
-  return false;
-}
-
-// Sincronizza una sola volta con NTP
-static void syncTimeOnce() {
-  configTime(GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER);
-  g_timeSynced = waitForValidTime();
-  Serial.println(g_timeSynced ? "NTP sync OK" : "NTP sync failed");
-}
-
+// ----------------------------- Frame in PSRAM -----------------------------
+// Il prossimo frame si scarica e decodifica durante la visualizzazione di quello corrente;
+// gli ultimi FRAME_CACHE decodificati restano in un anello LRU per quando la rete manca.
+#define FRAME_W 480
+#define FRAME_H (480 - HEADER_H)
+#define FRAME_CACHE     4      // frame RGB565 da ~400 KB ciascuno (PSRAM)
+#define CROSSFADE_STEPS 8      // passi di dissolvenza al cambio, 0 = cambio secco
+static const uint32_t PREFETCH_RETRY_MS = 30000;   // dopo un prefetch fallito
+
+struct FrameSlot {
+  uint16_t* px = nullptr;
+  bool     valid = false;
+  uint32_t shownTick = 0;      // ultima volta a schermo (0 = mai)
+  uint16_t srcW = 0, srcH = 0; // dimensioni del JPEG
+  uint8_t  scale = 0;
+};
+
+// Tempi dell'ultimo giro e somme per le medie (ms)
+struct FrameStats {
+  uint32_t fetched = 0, failed = 0, presented = 0, offline = 0;
+  uint32_t prefetchMs = 0, decodeMs = 0, presentMs = 0;
+  uint32_t prefetchSum = 0, decodeSum = 0, presentSum = 0;
+};
+
+static FrameSlot g_frames[FRAME_CACHE];
+static int       g_frameCount = 0;
+static uint16_t* g_fadeBuf = nullptr;          // scratch per la dissolvenza
+static int       g_shownFrame = -1;            // a schermo
+static int       g_nextFrame = -1;             // pronto per il prossimo cambio
+static int       g_presentingFrame = -1;       // in blit dal loop: il task non lo riscrive
+static int       g_decodingFrame = -1;         // in scrittura dal task
+static uint32_t  g_frameTick = 0;
+static volatile uint32_t g_prefetchFails = 0;  // prefetch falliti di fila
+static FrameStats g_fstats;
+static SemaphoreHandle_t g_frameMutex = nullptr;
+static SemaphoreHandle_t g_sdMutex = nullptr;  // SD condivisa tra task e hot-plug nel loop
+static TaskHandle_t g_prefetchTask = nullptr;
+
+// ----------------------------- Ora e header -----------------------------
 // Ritorna “gg/mm - hh:mm” se l’orologio è valido, altrimenti stringa vuota
 static String getFormattedDateTime() {
   if (!g_timeSynced) return "";
@@ -221,6 +317,13 @@ static void handleSave() {
 
 static void handleReboot() { web.send(200, "text/plain", "OK"); delay(100); ESP.restart(); }
 
+// Timeline di avvio (BootSeq.h) in testo semplice
+static void handleBoot() {
+  char buf[BOOT_MAX_PHASES * 56];
+  bootFormatTimeline(buf, sizeof(buf));
+  web.send(200, "text/plain; charset=utf-8", buf);
+}
+
 // Schermata locale con SSID/password dell’AP di configurazione
 static void drawAPScreen(const String& ssid, const String& pass) {
   gfx->fillScreen(RGB565_BLACK);
@@ -251,6 +354,7 @@ static void startAPWithPortal() {
   web.on("/", HTTP_GET, handleRoot);
   web.on("/save", HTTP_POST, handleSave);
   web.on("/reboot", HTTP_GET, handleReboot);
+  web.on("/boot", HTTP_GET, handleBoot);
   web.onNotFound(handleRoot);
   web.begin();
 
@@ -258,25 +362,10 @@ static void startAPWithPortal() {
   isAPMode = true;
 }
 
-// Tentativo di connessione STA usando credenziali persistite
-static bool tryConnectSTA(uint32_t timeoutMs = 8000) {
-  prefs.begin("wifi", true);
-  sta_ssid = prefs.getString("ssid", "");
-  sta_pass = prefs.getString("pass", "");
-  prefs.end();
-  if (sta_ssid.isEmpty()) return false;
-
-  WiFi.persistent(false);
-  WiFi.mode(WIFI_STA);
-  WiFi.setSleep(false);
-  WiFi.begin(sta_ssid.c_str(), sta_pass.c_str());
-
-  uint32_t t0 = millis();
-  while ((millis() - t0) < timeoutMs) {
-    if (WiFi.status() == WL_CONNECTED) return true;
-    delay(100);
-  }
-  return (WiFi.status() == WL_CONNECTED);
+// In STA il web server serve solo la timeline di avvio
+static void startSTAWeb() {
+  web.on("/boot", HTTP_GET, handleBoot);
+  web.begin();
 }
 
 // ----------------------------- SD: init e monitor -----------------------------
@@ -315,63 +404,104 @@ static bool isSDCurrentlyPresent() {
 }
 
 // ----------------------------- Decoder JPEG -----------------------------
-static bool tft_output(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t* bitmap) {
-  if (y < HEADER_H) {
-    int16_t skipRows = HEADER_H - y;
-    if (skipRows >= (int16_t)h) return true;
-    bitmap += skipRows * w; h -= skipRows; y = HEADER_H;
-  }
-  if (y >= 480 || x >= 480) return true;
-  if (x + w > 480) w = 480 - x;
-  if (y + h > 480) h = 480 - y;
-  gfx->draw16bitRGBBitmap(x, y, bitmap, w, h);
-  return true;
-}
-
-// ----------------------------- Download → SD -----------------------------
-static bool writeStreamToSD_sniffJPEG(const char* path, WiFiClient* stream, int content_len) {
-  File f = SD.open(path, FILE_WRITE);
-  if (!f) { Serial.println("[SD] open write FAILED"); return false; }
+// Legge fino a 'want' byte dalla sorgente (rete o file): li passa al parser dei marker
+// e, se è aperta, li copia su SD
+static int jpegStreamRead(JpegStreamCtx* c, uint8_t* dst, size_t want) {
+  if (c->remaining == 0 || c->sniff.st == JpegSniffer::BAD) return 0;
+  if (c->remaining > 0 && want > (size_t)c->remaining) want = c->remaining;
 
-  const size_t BUF = 2048;
-  uint8_t buf[BUF];
-  size_t total = 0;
   uint32_t t0 = millis();
+  int avail;
+  while ((avail = c->in->available()) <= 0) {
+    if (!c->net || !c->net->connected() || millis() - t0 > JPEG_STALL_MS) return 0;   // file: fine
+    delay(1);
+  }
+  c->waitMs += millis() - t0;
+
+  int n = c->in->readBytes(dst, want < (size_t)avail ? want : (size_t)avail);
+  if (n <= 0) return 0;
+  if (c->remaining > 0) c->remaining -= n;
+  c->total += n;
+
+  const bool headerDone = c->sniff.st == JpegSniffer::DONE;
+  if (!c->sniff.feed(dst, n)) return 0;
+  if (!headerDone && c->sniff.st == JpegSniffer::DONE) c->sofMs = millis() - c->tGet;
+
+  if (c->sd) {
+    uint32_t t1 = millis();
+    xSemaphoreTake(g_sdMutex, portMAX_DELAY);
+    bool ok = c->sd.write(dst, n) == (size_t)n;
+    if (!ok) c->sd.close();
+    xSemaphoreGive(g_sdMutex);
+    if (!ok) Serial.println("[SD] scrittura FALLITA, continuo senza copia");
+    c->sdMs += millis() - t1;
+  }
+  return n;
+}
 
-  bool checkedMagic = false;
-  bool jpegOK = false;
-
-  while ((content_len < 0) || (total < (size_t)content_len)) {
-    int avail = stream->available();
-    if (avail <= 0) {
-      if (!stream->connected()) break;
-      delay(1);
-      continue;
-    }
-
-    int toRead = avail > (int)BUF ? (int)BUF : avail;
-    int n = stream->readBytes(buf, toRead);
+// Ingresso di tjpgd: buf == nullptr vuol dire "salta len byte" (che vanno comunque su SD)
+static size_t jpegStreamInput(JDEC* jd, uint8_t* buf, size_t len) {
+  JpegStreamCtx* c = (JpegStreamCtx*)jd->device;
+  uint8_t skip[64];
+  size_t done = 0;
+  while (done < len) {
+    size_t want = len - done;
+    if (!buf && want > sizeof(skip)) want = sizeof(skip);
+    int n = jpegStreamRead(c, buf ? buf + done : skip, want);
     if (n <= 0) break;
+    done += n;
+  }
+  return done;
+}
 
-    if (!checkedMagic) {
-      checkedMagic = true;
-      if (n >= 2 && buf[0] == 0xFF && buf[1] == 0xD8) jpegOK = true;
-      if (!jpegOK) {
-        Serial.println("[SD] Non è un JPEG (no 0xFFD8)");
-        f.close(); SD.remove(path); return false;
-      }
-    }
+// Uscita di tjpgd: il blocco MCU (già scalato) va nel frame, centrato e ritagliato
+static int jpegBlockOut(JDEC* jd, void* bitmap, JRECT* r) {
+  JpegStreamCtx* c = (JpegStreamCtx*)jd->device;
+  uint32_t t = millis() - c->tGet;
+  if (!c->blocks++) c->firstBlockMs = t;
+  c->lastBlockMs = t;
+
+  const uint16_t* src = (const uint16_t*)bitmap;
+  const int w = r->right - r->left + 1, h = r->bottom - r->top + 1;
+  const int x = c->offX + r->left, y = c->offY + r->top;
+  if (x >= FRAME_W || y >= FRAME_H) return 1;
+  const int cw = (x + w > FRAME_W) ? FRAME_W - x : w;
+  const int ch = (y + h > FRAME_H) ? FRAME_H - y : h;
+  for (int j = 0; j < ch; ++j) memcpy(c->frame + (y + j) * FRAME_W + x, src + j * w, cw * sizeof(uint16_t));
+  return 1;
+}
 
-    f.write(buf, n);
-    total += n;
+// Decodifica la sorgente di c nel frame: scala 1/1..1/8 scelta dal SOF perché l'immagine
+// stia sotto l'header, poi centrata su fondo nero
+static JRESULT decodeToFrame(JpegStreamCtx& c, uint16_t* frame) {
+  JDEC jd;
+  JRESULT res = jd_prepare(&jd, jpegStreamInput, s_jpgPool, sizeof(s_jpgPool), &c);
+  if (res != JDR_OK) {
+    if (c.sniff.why) Serial.printf("[JPEG] %s, skip\n", c.sniff.why);
+    return res;
   }
-
-  f.flush(); f.close();
-  Serial.printf("[SD] scritto %u bytes in %u ms\n", (unsigned)total, (unsigned)(millis() - t0));
-  return total > 0;
+  uint8_t s = 0;
+  while (s < 3 && (((uint32_t)jd.width >> s) > FRAME_W || ((uint32_t)jd.height >> s) > FRAME_H)) s++;
+  const int sw = (jd.width + (1 << s) - 1) >> s, sh = (jd.height + (1 << s) - 1) >> s;
+  c.scale = s;
+  c.offX = sw < FRAME_W ? (FRAME_W - sw) / 2 : 0;
+  c.offY = sh < FRAME_H ? (FRAME_H - sh) / 2 : 0;
+  c.frame = frame;
+  memset(frame, 0, FRAME_W * FRAME_H * sizeof(uint16_t));   // RGB565_BLACK ai bordi
+  Serial.printf("[JPEG] baseline %ux%u, scala 1/%d, header in %lu ms\n",
+                jd.width, jd.height, 1 << s, (unsigned long)c.sofMs);
+
+  jd.swap = 0;                              // RGB565 nativo (niente swap)
+  const uint32_t t0 = millis(), w0 = c.waitMs;
+  res = jd_decomp(&jd, jpegBlockOut, s);
+  c.decodeMs = millis() - t0 - (c.waitMs - w0);
+  return res;
 }
 
-static bool downloadJPEGToSD() {
+// ----------------------------- Download → frame (+ SD) -----------------------------
+// Un solo passaggio: GET, marker controllati all'arrivo, decode nel frame mentre il resto
+// scarica, copia su SD rinominata solo se l'immagine è completa
+static bool fetchJPEGToFrame(JpegStreamCtx& c, uint16_t* frame) {
   String url = String(IMAGE_PROXY_BASE) + "&t=" + String(millis()); // cache-buster
 
   WiFiClientSecure client; client.setInsecure();
@@ -379,6 +509,7 @@ static bool downloadJPEGToSD() {
   HTTPClient http;
   http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
   http.setTimeout(15000);
+  http.useHTTP10(true);                     // corpo grezzo, niente chunked nello stream
   http.addHeader("User-Agent", "ESP32");
   http.addHeader("Accept", "image/jpeg,image/*;q=0.8");
 
@@ -390,6 +521,7 @@ static bool downloadJPEGToSD() {
     return false;
   }
 
+  c.tGet = millis();
   int httpCode = http.GET();
   if (httpCode != HTTP_CODE_OK) {
     Serial.printf("[HTTP] error: %d\n", httpCode);
@@ -398,8 +530,8 @@ static bool downloadJPEGToSD() {
   }
 
   String ctype = http.header("Content-Type"); ctype.toLowerCase();
-  int len = http.getSize(); // -1 se chunked
-  Serial.printf("[HTTP] CT='%s' LEN=%d\n", ctype.c_str(), len);
+  c.remaining = http.getSize();             // -1 se la lunghezza non è nota
+  Serial.printf("[HTTP] CT='%s' LEN=%d\n", ctype.c_str(), (int)c.remaining);
 
   if (ctype.indexOf("jpeg") < 0) {
     Serial.println("[HTTP] Non JPEG, stop");
@@ -407,140 +539,260 @@ static bool downloadJPEGToSD() {
     return false;
   }
 
-  WiFiClient* stream = http.getStreamPtr();
-  bool ok = writeStreamToSD_sniffJPEG(SD_JPEG_PATH, stream, len);
+  c.net = http.getStreamPtr();
+  c.in = c.net;
+  const bool tee = sd_ok && sdCardPresent;
+  if (tee) {
+    xSemaphoreTake(g_sdMutex, portMAX_DELAY);
+    c.sd = SD.open(SD_JPEG_TMP, FILE_WRITE);
+    xSemaphoreGive(g_sdMutex);
+    if (!c.sd) Serial.println("[SD] open write FAILED, nessuna copia");
+  }
+
+  JRESULT res = decodeToFrame(c, frame);
+  const bool ok = (res == JDR_OK);
+
+  // Il decoder si ferma a fine dati immagine: il resto (EOI, coda) finisce comunque su SD
+  if (ok && c.sd) {
+    uint8_t buf[512];
+    while (jpegStreamRead(&c, buf, sizeof(buf)) > 0) {}
+  }
   http.end();
-  return ok;
-}
 
-// ----------------------------- Validazione JPEG baseline -----------------------------
-static bool isJpegBaselineOnSD(const char* path) {
-  File f = SD.open(path, FILE_READ);
-  if (!f) { Serial.println("[SD] open read FAILED"); return false; }
-
-  bool baseline = false, progressive = false;
-  int prev = -1;
-  while (f.available()) {
-    int b = f.read();
-    if (prev == 0xFF) {
-      if (b == 0xC0) { baseline = true; break; }   // SOF0
-      if (b == 0xC2) { progressive = true; break; } // SOF2
+  if (tee) {
+    xSemaphoreTake(g_sdMutex, portMAX_DELAY);
+    if (c.sd) {
+      c.sd.close();
+      if (ok && c.remaining <= 0) { SD.remove(SD_JPEG_PATH); SD.rename(SD_JPEG_TMP, SD_JPEG_PATH); }
+      else SD.remove(SD_JPEG_TMP);
+    } else {
+      SD.remove(SD_JPEG_TMP);
     }
-    prev = b;
+    xSemaphoreGive(g_sdMutex);
   }
-  f.close();
 
-  if (progressive) { Serial.println("[JPEG] PROGRESSIVE (SOF2) — skip"); return false; }
-  if (!baseline)    { Serial.println("[JPEG] SOF0 non trovato — skip");   return false; }
+  if (!ok) {
+    Serial.printf("[JPEG] decode error: %d (%lu bytes, %lu blocchi)\n", (int)res,
+                  (unsigned long)c.total, (unsigned long)c.blocks);
+    return false;
+  }
   return true;
 }
 
-// ----------------------------- Rendering JPEG da SD -----------------------------
-static bool drawJPEGFromSD() {
+// Ultima immagine completa su SD -> frame (avvio senza rete, anello ancora vuoto)
+static bool decodeSDToFrame(JpegStreamCtx& c, uint16_t* frame) {
+  xSemaphoreTake(g_sdMutex, portMAX_DELAY);
+  File f = SD.open(SD_JPEG_PATH, FILE_READ);
+  bool ok = false;
+  if (f) {
+    c.tGet = millis();
+    c.in = &f;
+    JRESULT res = decodeToFrame(c, frame);
+    ok = (res == JDR_OK);
+    if (!ok) Serial.printf("[SD] JPEG decode error: %d\n", (int)res);
+    f.close();
+  }
+  xSemaphoreGive(g_sdMutex);
+  return ok;
+}
 
-  // Decoder configurato per RGB565 nativi e scala 1:1
-  TJpgDec.setSwapBytes(false);
-  TJpgDec.setJpgScale(1);
-  TJpgDec.setCallback(tft_output);
+// ----------------------------- Prefetch e anello dei frame -----------------------------
+// Frame in PSRAM: quanti ne entrano fino a FRAME_CACHE (almeno 1), più il buffer di dissolvenza
+static void initFrameCache() {
+  const size_t bytes = FRAME_W * FRAME_H * sizeof(uint16_t);
+  for (int i = 0; i < FRAME_CACHE; ++i) {
+    g_frames[i].px = (uint16_t*)ps_malloc(bytes);
+    if (!g_frames[i].px) break;
+    g_frameCount++;
+  }
+  if (CROSSFADE_STEPS > 0 && g_frameCount > 1) g_fadeBuf = (uint16_t*)ps_malloc(bytes);
+  Serial.printf("[FOTO] %d frame in PSRAM da %u KB, dissolvenza %s\n", g_frameCount,
+                (unsigned)(bytes / 1024), g_fadeBuf ? "si" : "no");
+}
 
-  if (!SD.exists(SD_JPEG_PATH)) {
-    Serial.println("JPEG non presente su SD");
-    return false;
+// Frame da riempire: il meno recente tra quelli non a schermo (con un solo frame, quello).
+// Mai quello in blit: con un solo frame si aspetta la fine del cambio.
+static int pickPrefetchSlot() {
+  int best = -1;
+  for (int i = 0; i < g_frameCount; ++i) {
+    if (i == g_presentingFrame) continue;
+    if (i == g_shownFrame && g_frameCount > 1) continue;
+    if (!g_frames[i].valid) return i;
+    if (best < 0 || g_frames[i].shownTick < g_frames[best].shownTick) best = i;
   }
-  int16_t res = TJpgDec.drawSdJpg(0, HEADER_H, SD_JPEG_PATH);
-  if (res != 1) {
-    Serial.printf("JPEG decode error: %d\n", (int)res);
-    return false;
+  return best;
+}
+
+// Prossimo frame dalla rete (o dalla SD se la rete manca e non c'è ancora nulla da mostrare)
+static void prefetchOnce() {
+  xSemaphoreTake(g_frameMutex, portMAX_DELAY);
+  int slot = pickPrefetchSlot();
+  bool anyValid = false;
+  for (int i = 0; i < g_frameCount; ++i) anyValid |= g_frames[i].valid;
+  const bool wasValid = slot >= 0 && g_frames[slot].valid;
+  if (slot >= 0) { g_frames[slot].valid = false; g_decodingFrame = slot; }
+  xSemaphoreGive(g_frameMutex);
+  if (slot < 0) return;
+
+  JpegStreamCtx c;
+  bool ok = false, fromSD = false;
+  if (WiFi.status() == WL_CONNECTED) ok = fetchJPEGToFrame(c, g_frames[slot].px);
+  if (!ok && !anyValid && sd_ok && sdCardPresent) {
+    c = JpegStreamCtx();
+    ok = fromSD = decodeSDToFrame(c, g_frames[slot].px);
   }
-  return true;
+
+  xSemaphoreTake(g_frameMutex, portMAX_DELAY);
+  g_decodingFrame = -1;
+  if (!ok && !c.frame) g_frames[slot].valid = wasValid;  // frame non toccato: resta nell'anello
+  if (ok) {
+    FrameSlot& f = g_frames[slot];
+    f.valid = true; f.shownTick = 0;
+    f.srcW = c.sniff.width; f.srcH = c.sniff.height; f.scale = c.scale;
+    g_nextFrame = slot;
+  }
+  xSemaphoreGive(g_frameMutex);
+
+  if (!ok) {
+    g_prefetchFails++; g_fstats.failed++;
+    Serial.printf("[FOTO] prefetch FALLITO (%lu di fila), riprovo fra %lu s\n",
+                  (unsigned long)g_prefetchFails, (unsigned long)(PREFETCH_RETRY_MS / 1000));
+    return;
+  }
+  if (!fromSD) g_prefetchFails = 0;
+  g_fstats.fetched++;
+  g_fstats.prefetchMs = c.lastBlockMs; g_fstats.prefetchSum += c.lastBlockMs;
+  g_fstats.decodeMs = c.decodeMs;      g_fstats.decodeSum += c.decodeMs;
+  Serial.printf("[FOTO] prefetch %s: %lu bytes, GET->ultimo blocco %lu ms, decode %lu ms "
+                "(attesa rete %lu ms, SD %lu ms, %lu blocchi)\n", fromSD ? "da SD" : "rete",
+                (unsigned long)c.total, (unsigned long)c.lastBlockMs, (unsigned long)c.decodeMs,
+                (unsigned long)c.waitMs, (unsigned long)c.sdMs, (unsigned long)c.blocks);
 }
 
-// ----------------------------- Pipeline: download → valida → disegna -----------------------------
-static bool downloadAndShowFromSD() {
-  if (!sd_ok || !sdCardPresent) {
-    Serial.println("[FLOW] SD non pronta");
-    return false;
+// Task sul core 0: tiene pronto il prossimo frame mentre il loop mostra quello corrente
+static void prefetchTask(void*) {
+  for (;;) {
+    xSemaphoreTake(g_frameMutex, portMAX_DELAY);
+    bool need = g_nextFrame < 0;
+    xSemaphoreGive(g_frameMutex);
+    if (need) {
+      prefetchOnce();
+      xSemaphoreTake(g_frameMutex, portMAX_DELAY);
+      need = g_nextFrame < 0;
+      xSemaphoreGive(g_frameMutex);
+    }
+    // frame pronto: si dorme fino al cambio immagine; fallito: nuovo tentativo più tardi
+    ulTaskNotifyTake(pdTRUE, need ? pdMS_TO_TICKS(PREFETCH_RETRY_MS) : portMAX_DELAY);
   }
+}
 
-  if (!downloadJPEGToSD()) {
-    Serial.println("[FLOW] download FAILED");
-    return false;
+static void startPrefetchTask() {
+  if (g_prefetchTask || !g_frameCount) return;
+  xTaskCreatePinnedToCore(prefetchTask, "prefetch", 8192, nullptr, 1, &g_prefetchTask, 0);
+}
+
+// Miscela RGB565 a/b con alpha 0..32 (b pesa alpha/32), due canali per moltiplicazione
+static void blend565(uint16_t* dst, const uint16_t* a, const uint16_t* b, uint32_t n, uint32_t alpha) {
+  for (uint32_t i = 0; i < n; ++i) {
+    uint32_t x = a[i], y = b[i];
+    x = (x | (x << 16)) & 0x07E0F81F;
+    y = (y | (y << 16)) & 0x07E0F81F;
+    uint32_t m = ((x * (32 - alpha) + y * alpha) >> 5) & 0x07E0F81F;
+    dst[i] = (uint16_t)(m | (m >> 16));
   }
-  if (!isJpegBaselineOnSD(SD_JPEG_PATH)) {
-    SD.remove(SD_JPEG_PATH);
-    delay(50);
-    Serial.println("[FLOW] non baseline, scarto");
-    return false;
+}
+
+// Cambio immagine: un blit a pieno frame (preceduto dalla dissolvenza, se attiva)
+static void presentFrame(int slot) {
+  const uint32_t t0 = millis();
+  const int from = g_shownFrame;
+  const uint16_t* to = g_frames[slot].px;
+  if (g_fadeBuf && from >= 0 && from != slot && g_frames[from].valid) {
+    DS_REFRESH_SCOPE("dissolvenza");
+    for (int k = 1; k < CROSSFADE_STEPS; ++k) {
+      blend565(g_fadeBuf, g_frames[from].px, to, FRAME_W * FRAME_H, k * 32 / CROSSFADE_STEPS);
+      gfx->draw16bitRGBBitmap(0, HEADER_H, g_fadeBuf, FRAME_W, FRAME_H);
+    }
   }
-  return drawJPEGFromSD();
+  {
+    DS_REFRESH_SCOPE("present");
+    gfx->draw16bitRGBBitmap(0, HEADER_H, (uint16_t*)to, FRAME_W, FRAME_H);
+  }
+  xSemaphoreTake(g_frameMutex, portMAX_DELAY);
+  g_shownFrame = slot;
+  g_presentingFrame = -1;
+  g_frames[slot].shownTick = ++g_frameTick;
+  xSemaphoreGive(g_frameMutex);
+
+  const uint32_t ms = millis() - t0;
+  g_fstats.presented++; g_fstats.presentMs = ms; g_fstats.presentSum += ms;
+  const uint32_t n = g_fstats.fetched ? g_fstats.fetched : 1;
+  Serial.printf("[FOTO] present %lu ms | medie: prefetch %lu ms, decode %lu ms, present %lu ms | "
+                "ok %lu, falliti %lu, dall'anello %lu\n",
+                (unsigned long)ms, (unsigned long)(g_fstats.prefetchSum / n), (unsigned long)(g_fstats.decodeSum / n),
+                (unsigned long)(g_fstats.presentSum / g_fstats.presented), (unsigned long)g_fstats.fetched,
+                (unsigned long)g_fstats.failed, (unsigned long)g_fstats.offline);
+}
+
+// Frame per il cambio: il prossimo già pronto; senza rete il meno recente dell'anello;
+// -1 = niente di nuovo (download in corso), si riprova al giro dopo.
+// Il frame scelto resta riservato fino alla fine di presentFrame.
+static int takeFrameToPresent() {
+  xSemaphoreTake(g_frameMutex, portMAX_DELAY);
+  int slot = g_nextFrame;
+  if (slot >= 0) {
+    g_nextFrame = -1;
+  } else if (WiFi.status() != WL_CONNECTED || g_prefetchFails > 0) {
+    for (int i = 0; i < g_frameCount; ++i) {
+      if (i == g_shownFrame || i == g_decodingFrame || !g_frames[i].valid) continue;
+      if (slot < 0 || g_frames[i].shownTick < g_frames[slot].shownTick) slot = i;
+    }
+    if (slot >= 0) g_fstats.offline++;
+  }
+  g_presentingFrame = slot;
+  xSemaphoreGive(g_frameMutex);
+  return slot;
 }
 
 static uint32_t lastHeaderUpdate = 0;
+static bool     g_presentDue = true;   // cambio immagine appena c'è un frame pronto
 
 // ----------------------------- Arduino: setup/loop -----------------------------
+// Header subito; Wi-Fi, portale e ora arrivano dal loop (bootPoll). Il task di prefetch parte
+// prima della rete: senza connessione il primo frame lo decodifica da /picsum.jpg su SD.
 void setup() {
   Serial.begin(115200);
-  delay(1000);
-
-  // Decoder impostato su endianess nativa (niente swap)
-  TJpgDec.setSwapBytes(false);
+  bootPanel(gfx, GFX_BL, PWM_CHANNEL, PWM_FREQ, PWM_BITS);
+  bootStart(STA_TIMEOUT_MS, GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER);
 
-  backlightOn();
-  panelKickstart();
-
-  // Splash di avvio
-  gfx->fillScreen(RGB565_BLACK);
+  drawHeader();
   gfx->setTextSize(2);
   gfx->setTextColor(RGB565_WHITE, RGB565_BLACK);
-  gfx->setCursor(10, 10);  gfx->println("FOTINE - AVVIO");
-  gfx->setCursor(10, 40);  gfx->print("WiFi connecting...");
-
-  // Wi-Fi: tenta STA, altrimenti AP con captive
-  if (!tryConnectSTA()) {
-    gfx->setCursor(10, 70);
-    gfx->setTextColor(RGB565_ORANGE, RGB565_BLACK);
-    gfx->println("WiFi FAILED - AP MODE");
-    delay(3000);
-    startAPWithPortal();
-  } else {
-    gfx->setCursor(10, 70);
-    gfx->setTextColor(0x07E0, RGB565_BLACK);
-    gfx->println("WiFi OK!");
-    gfx->setCursor(10, 100);
-    gfx->setTextColor(RGB565_WHITE, RGB565_BLACK);
-    gfx->print("IP: "); gfx->println(WiFi.localIP());
-    gfx->setCursor(10, 130);
-    gfx->print("NTP sync..."); syncTimeOnce();
-    gfx->setCursor(10, 160);
-    if (g_timeSynced) { gfx->setTextColor(0x07E0, RGB565_BLACK); gfx->println("NTP OK!"); }
-    else              { gfx->setTextColor(RGB565_ORANGE, RGB565_BLACK); gfx->println("NTP FAILED"); }
-  }
-
-  // SD init + stato
-  gfx->setCursor(10, 190);
-  gfx->setTextColor(RGB565_WHITE, RGB565_BLACK);
-  gfx->print("SD init...");
+  gfx->setCursor(10, HEADER_H + 10); gfx->print("FOTINE - AVVIO");
+  bootMark("primo frame");
+
+  int ph = bootPhaseBegin("psram");
+  g_frameMutex = xSemaphoreCreateMutex();
+  g_sdMutex    = xSemaphoreCreateMutex();
+  initFrameCache();
+  bootPhaseEnd(ph);
+
+  ph = bootPhaseBegin("sd");
   sd_ok = initSD();
-  gfx->setCursor(10, 210);
-  if (sd_ok) { gfx->setTextColor(0x07E0, RGB565_BLACK); gfx->println("SD OK!"); }
-  else       { gfx->setTextColor(RGB565_ORANGE, RGB565_BLACK); gfx->println("SD FAILED"); }
   sdCardPresent = sd_ok;
+  bootPhaseEnd(ph);
 
   lastHeaderUpdate = millis();
   lastImageChange  = millis();
-
-  if (!isAPMode && WiFi.status() == WL_CONNECTED && sd_ok && sdCardPresent) {
-    (void)downloadAndShowFromSD(); 
-  }
-
-  drawHeader();
+  startPrefetchTask();                 // il loop mostra il primo frame appena è pronto
 }
 
 void loop() {
   uint32_t now = millis();
 
   // Hot-plug SD: rileva cambi e re-inizializza con ritardo per stabilizzare i contatti
-  if (now - lastSDCheckTime >= SD_CHECK_INTERVAL) {
+  // (saltato se il task di prefetch sta usando la SD)
+  if (now - lastSDCheckTime >= SD_CHECK_INTERVAL && xSemaphoreTake(g_sdMutex, 0) == pdTRUE) {
     lastSDCheckTime = now;
     bool presentNow = isSDCurrentlyPresent();
     if (sdCardPresent && !presentNow) {
@@ -553,22 +805,40 @@ void loop() {
       if (initSD()) Serial.println("[SD] Re-init OK");
       else          { Serial.println("[SD] Re-init FALLITA"); sdReinitTime = now + SD_REINIT_DELAY; }
     }
+    xSemaphoreGive(g_sdMutex);
+  }
+
+  switch (bootPoll()) {
+    case BOOT_ONLINE:                  // il prefetch fallito senza rete non aspetta i 30 s
+      startSTAWeb();
+      if (g_prefetchTask) xTaskNotifyGive(g_prefetchTask);
+      break;
+    case BOOT_PORTAL: startAPWithPortal(); break;
+    case BOOT_TIME:   g_timeSynced = true; drawHeader(); lastHeaderUpdate = millis(); break;
+    default: break;
   }
 
   // In AP mode gestisce DNS e HTTP, poi esce per ridurre il carico
   if (isAPMode) { dnsServer.processNextRequest(); web.handleClient(); delay(5); return; }
-
-  // Aggiornamento header ogni 30 s (o immediato se l’NTP non è ancora valido)
-  if (!g_timeSynced) { syncTimeOnce(); drawHeader(); lastHeaderUpdate = millis(); }
-  else if (millis() - lastHeaderUpdate >= 30000) { drawHeader(); lastHeaderUpdate = millis(); }
-
-  // Cambio immagine ogni IMAGE_DISPLAY_TIME se Wi-Fi e SD sono pronti
-  if (WiFi.status() == WL_CONNECTED && sd_ok && sdCardPresent &&
-      (millis() - lastImageChange >= IMAGE_DISPLAY_TIME)) {
-    (void)downloadAndShowFromSD(); // ignora l’esito: errore visibile via Serial/log
-
-    drawHeader();                  // ridisegna l’orario
-    lastImageChange = millis();
+  web.handleClient();
+
+  // Aggiornamento header ogni 30 s
+  if (millis() - lastHeaderUpdate >= 30000) { drawHeader(); lastHeaderUpdate = millis(); }
+
+  // Cambio immagine ogni IMAGE_DISPLAY_TIME: il frame è già decodificato dal task, qui solo il blit.
+  // Senza rete si gira sull'anello dei frame già visti.
+  if (g_presentDue || millis() - lastImageChange >= IMAGE_DISPLAY_TIME) {
+    int slot = takeFrameToPresent();
+    if (slot >= 0) {
+      presentFrame(slot);
+      drawHeader();                // ridisegna l’orario
+      bootMark("prima foto");
+      lastImageChange = millis();
+      g_presentDue = false;
+      if (g_prefetchTask) xTaskNotifyGive(g_prefetchTask);   // via al prossimo
+    } else {
+      g_presentDue = true;         // nessun frame pronto: cambio appena arriva
+    }
   }
 
   delay(5);
@@ -6,10 +6,14 @@
   - Wi-Fi: se mancano credenziali → AP con captive portal (solo setup Wi-Fi).
            se connesso in STA → WebUI unica /rss (GET/POST) per gestire feed.
   - Config RSS in NVS (namespace "rss"): url0..url7, limit0..limit7, n.
-  - Parser RSS light (string-based) con de-duplicazione e shuffle.
+  - Parser RSS/Atom a flusso (finestra fissa, passata singola) con de-duplicazione e shuffle.
   - Rendering display: top bar blu con testo giallo, separatori verdi, news bianche.
-  - Aggiornamento: periodico e immediato dopo salvataggio WebUI (flag).
+    Testo bold da atlante di glifi (TextAtlas.h), pagine ridisegnate senza fillScreen.
+  - Aggiornamento: task dedicato sul core 0 (periodico e subito dopo salvataggio WebUI),
+    GET condizionale ETag/Last-Modified, doppio buffer scambiato a refresh finito.
   - Charsets web: UTF-8 per mostrare correttamente accenti/caratteri speciali.
+  - Avvio non bloccante (BootSeq.h): primo schermo subito, Wi-Fi/portale/SNTP dal loop,
+    tempi delle fasi su Serial e su /boot.
 */
 
 #include <Arduino.h>
@@ -20,6 +24,13 @@
 #include <DNSServer.h>
 #include <HTTPClient.h>
 #include <Arduino_GFX_Library.h>
+
+// Contatori di disegno su Serial (1 = attivi, 0 = nessun costo)
+#define DRAW_STATS 0
+#include <DrawStats.h>
+#include <TextAtlas.h>
+#include <WebChunk.h>
+#include <BootSeq.h>
 #include <time.h>
 
 // =========================== Costanti hardware/display ===========================
@@ -34,10 +45,11 @@
 static const char* NTP_SERVER = "pool.ntp.org";
 static const long GMT_OFFSET_SEC = 3600;
 static const int  DAYLIGHT_OFFSET_SEC = 3600;
-static bool g_timeSynced = false;
+static const uint32_t STA_TIMEOUT_MS = 8000;       // poi portale AP
+static bool g_timeSynced = false;                   // primo sync SNTP arrivato (BootSeq.h)
 
-// Flag per richiedere un refresh immediato dei feed dopo salvataggio via WebUI
-volatile bool g_rssRefreshPending = false;
+// Task dei feed (core 0): si sveglia allo scadere del periodo o su richiesta dalla WebUI
+static TaskHandle_t g_feedTask = nullptr;
 
 // =========================== Bus grafico e display ===========================
 // SWSPI per inviare i comandi di init allo ST7701
@@ -59,7 +71,7 @@ Arduino_ESP32RGBPanel* rgbpanel = new Arduino_ESP32RGBPanel(
 );
 
 // Istanza display 480×480 con sequenza d’inizializzazione ST7701 type9
-Arduino_RGB_Display* gfx = new Arduino_RGB_Display(
+DrawStatsDisplay *gfx = new DrawStatsDisplay(
   480, 480, rgbpanel, 0, true, bus, GFX_NOT_DEFINED,
   st7701_type9_init_operations, sizeof(st7701_type9_init_operations)
 );
@@ -69,7 +81,6 @@ Preferences prefs;
 DNSServer dnsServer;
 WebServer  web(80);
 
-String sta_ssid, sta_pass;
 String ap_ssid, ap_pass;
 const byte DNS_PORT = 53;
 
@@ -81,22 +92,152 @@ static const char* FEEDS_DEFAULT[4] = {
   "https://www.fanpage.it/feed/"
 };
 
-static const int MAX_ITEMS   = 120;  // buffer globale notizie
+static const int MAX_ITEMS   = 480;  // buffer globale notizie
 static const int MAX_FEEDS   = 8;    // righe configurabili in UI
 static const int DEFAULT_LIMIT = 30; // fallback per-feed
 
 struct FeedConfig { String url; int limit; };
 
 // =========================== Buffer contenuti news ===========================
-String titles[MAX_ITEMS];
-String links [MAX_ITEMS];
-int itemCount = 0;
+// Arena unica per il testo: record offset/lunghezza su un solo buffer di byte, allocato una
+// volta all'avvio (PSRAM se presente). Ogni refresh la riscrive da zero, quindi resta compatta.
+// Duplicati scartati con un set di hash FNV-1a a 64 bit su titolo e URL normalizzati.
+static const uint32_t ARENA_BYTES   = 96 * 1024;   // titoli + link, terminati da '\0'
+static const uint32_t ARENA_FALLBACK = 32 * 1024;  // senza PSRAM
+static const int      DEDUP_SLOTS   = 2048;        // potenza di 2, >= 4 × MAX_ITEMS (2 hash per item)
+
+struct NewsItem { uint32_t off; uint16_t titleLen, linkLen; uint8_t feed; };   // link subito dopo il titolo
+
+struct NewsStore {
+  char     *arena = nullptr;
+  uint32_t  cap = 0, used = 0;
+  uint64_t *seen = nullptr;          // open addressing, 0 = slot libero
+  NewsItem  item[MAX_ITEMS];
+  uint16_t  order[MAX_ITEMS];        // permutazione per la rotazione (lo shuffle tocca solo questa)
+  int       count = 0;
+
+  bool begin() {
+    cap = ARENA_BYTES;
+    arena = (char*)ps_malloc(cap);
+    if (!arena) { cap = ARENA_FALLBACK; arena = (char*)malloc(cap); }
+    seen = (uint64_t*)ps_malloc(DEDUP_SLOTS * sizeof(uint64_t));
+    if (!seen) seen = (uint64_t*)malloc(DEDUP_SLOTS * sizeof(uint64_t));
+    if (!arena || !seen) { cap = 0; return false; }
+    clear();
+    return true;
+  }
+
+  void clear() {
+    used = 0; count = 0;
+    if (seen) memset(seen, 0, DEDUP_SLOTS * sizeof(uint64_t));
+  }
+
+  bool full() const { return count >= MAX_ITEMS || used >= cap; }
+
+  const char* title(int i) const { return arena + item[order[i]].off; }
+  const char* link(int i)  const { const NewsItem &it = item[order[i]]; return arena + it.off + it.titleLen + 1; }
+
+  // Titolo: solo lettere/cifre ASCII in minuscolo (spazi e punteggiatura non contano)
+  static uint64_t hashTitle(const char *t) {
+    uint64_t h = 1469598103934665603ULL;
+    for (; *t; ++t) {
+      char c = *t;
+      if (c >= 'A' && c <= 'Z') c += 32;
+      else if (!((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || (uint8_t)c >= 0x80)) continue;
+      h = (h ^ (uint8_t)c) * 1099511628211ULL;
+    }
+    return h | 1;                                  // mai 0 (slot libero)
+  }
+
+  // URL: senza schema, "www.", frammento e '/' finale; host in minuscolo
+  static uint64_t hashLink(const char *u) {
+    if (!strncasecmp(u, "https://", 8)) u += 8; else if (!strncasecmp(u, "http://", 7)) u += 7;
+    if (!strncasecmp(u, "www.", 4)) u += 4;
+    size_t n = strcspn(u, "#");
+    while (n && u[n-1] == '/') n--;
+    uint64_t h = 1099511628211ULL ^ 0x5bd1e995ULL; // seme diverso dai titoli
+    bool host = true;
+    for (size_t i = 0; i < n; ++i) {
+      char c = u[i];
+      if (c == '/') host = false;
+      if (host && c >= 'A' && c <= 'Z') c += 32;
+      h = (h ^ (uint8_t)c) * 1099511628211ULL;
+    }
+    return h | 1;
+  }
+
+  // Slot di h nel set: quello che lo contiene oppure il primo libero
+  uint32_t slotOf(uint64_t h) const {
+    uint32_t i = (uint32_t)(h ^ (h >> 32)) & (DEDUP_SLOTS - 1);
+    while (seen[i] && seen[i] != h) i = (i + 1) & (DEDUP_SLOTS - 1);
+    return i;
+  }
+
+  // Aggiunge titolo (già normalizzato) e link del feed 'feed'; false se duplicato o spazio esaurito
+  bool add(const char *t, const char *l, uint8_t feed) {
+    if (full()) return false;
+    size_t tl = strlen(t), ll = strlen(l);
+    if (!tl || !ll || tl > 0xFFFF || ll > 0xFFFF || used + tl + ll + 2 > cap) return false;
+    uint64_t ht = hashTitle(t), hl = hashLink(l);
+    if (seen[slotOf(ht)] || seen[slotOf(hl)]) return false;
+    seen[slotOf(ht)] = ht;
+    seen[slotOf(hl)] = hl;
+    NewsItem &it = item[count];
+    it.off = used; it.titleLen = tl; it.linkLen = ll; it.feed = feed;
+    memcpy(arena + used, t, tl + 1); used += tl + 1;
+    memcpy(arena + used, l, ll + 1); used += ll + 1;
+    order[count] = count;
+    count++;
+    return true;
+  }
+
+  // Ricopia (in ordine di arrivo) al massimo limit item di un feed da un altro store: 304 o
+  // errore di rete. cut = true se lo store si è riempito prima dell'ultimo item del feed
+  int copyFeed(const NewsStore &src, uint8_t feed, int limit, bool &cut) {
+    int n = 0;
+    cut = false;
+    for (int i = 0; i < src.count && n < limit; ++i) {
+      const NewsItem &it = src.item[i];
+      if (it.feed != feed) continue;
+      if (full()) { cut = true; break; }
+      const char *t = src.arena + it.off;
+      if (add(t, t + it.titleLen + 1, feed)) n++;
+    }
+    return n;
+  }
+
+  // Fisher–Yates sugli indici: i record e il testo restano dove sono
+  void shuffle() {
+    for (int i = count - 1; i > 0; --i) {
+      int j = random(i + 1);
+      uint16_t t = order[i]; order[i] = order[j]; order[j] = t;
+    }
+  }
+};
+
+// Doppio buffer: il task dei feed riempie g_back mentre lo schermo legge g_front,
+// poi scambia i puntatori sotto mutex. Nessuna copia degli item allo scambio.
+static NewsStore g_storeA, g_storeB;
+static NewsStore *g_front = &g_storeA;
+static NewsStore *g_back  = &g_storeB;
+static SemaphoreHandle_t g_newsMutex = nullptr;
+static volatile bool g_newsSwapped = false;          // nuovo set pronto: il loop torna a pagina 1
+
+// Per feed: validatori del GET condizionale (usati solo dal task) e statistiche per la WebUI
+struct FeedStats {
+  String   url, etag, lastModified;
+  uint32_t requests = 0, notModified = 0, errors = 0;
+  uint32_t lastMs = 0, lastBytes = 0, totalBytes = 0;
+  int      limit = 0;                          // limite con cui sono stati presi i validatori
+  int      lastCode = 0, lastItems = 0;
+};
+static FeedStats g_feedStats[MAX_FEEDS];
+static uint32_t g_lastRefreshMs = 0, g_lastRefreshAt = 0;
 
 static const uint32_t PAGE_DURATION_MS    = 30000;   // scorrimento pagina
 static const uint32_t REFRESH_INTERVAL_MS = 600000;  // refresh feed
 
 uint32_t lastPageSwitch = 0;
-uint32_t lastRefresh    = 0;
 int currentPage = 0;
 static const int ITEMS_PER_PAGE = 4;
 
@@ -125,45 +266,7 @@ static const int TEXT_SCALE  = 2;
 static const int CHAR_W = BASE_CHAR_W * TEXT_SCALE;
 static const int CHAR_H = BASE_CHAR_H * TEXT_SCALE;
 
-// =========================== Pannello: retroilluminazione e avvio ===========================
-// Abilita PWM e porta la retroilluminazione a piena intensità
-static void backlightOn() {
-  ledcSetup(PWM_CHANNEL, PWM_FREQ, PWM_BITS);
-  ledcAttachPin(GFX_BL, PWM_CHANNEL);
-  ledcWrite(PWM_CHANNEL, 255);
-}
-
-// Sequenza base: init controller, accensione display, schermo nero
-static void panelKickstart() {
-  delay(50);
-  gfx->begin();
-  gfx->setRotation(0);
-  delay(120);
-  gfx->displayOn();
-  delay(20);
-  gfx->fillScreen(RGB565_BLACK);
-  delay(60);
-}
-
-// =========================== Tempo: sync NTP e formattazione ===========================
-// Attende un timestamp valido (anno > 2020) entro timeout
-static bool waitForValidTime(uint32_t timeoutMs = 8000) {
-  uint32_t t0 = millis(); time_t now = 0; struct tm info;
-  while ((millis() - t0) < timeoutMs) {
-    time(&now); localtime_r(&now, &info);
-    if (info.tm_year + 1900 > 2020) return true;
-    delay(100);
-  }
-  return false;
-}
-
-// Configura fusi e marca sync; evita doppie richieste NTP
-static void syncTimeFromNTP() {
-  if (g_timeSynced) return;
-  configTime(GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER);
-  g_timeSynced = waitForValidTime(8000);
-}
-
+// =========================== Tempo: formattazione ===========================
 // Converte data/ora in stringa corta “gg/mm - hh:mm”
 static String getFormattedDateTime() {
   if (!g_timeSynced) return "";
@@ -197,85 +300,55 @@ static String normalizeAndTransliterate(const String& in) {
   return s;
 }
 
-// Disegna titolo con finto “bold” (quattro passate) — testo bianco su fondo nero
-static void drawBoldText(int16_t x, int16_t y, const String& raw) {
+// Titolo bold dall'atlante (un blit per glifo) — testo bianco su fondo nero.
+// padW > 0: sfondo nero fino a padW px, copre il testo che c'era prima senza cancellarlo
+static void drawBoldText(int16_t x, int16_t y, const String& raw, int16_t padW = 0) {
   String s = normalizeAndTransliterate(raw);
-  gfx->setTextSize(TEXT_SCALE);
-  gfx->setTextColor(RGB565_WHITE, RGB565_BLACK);
-  gfx->setCursor(x+1, y);   gfx->print(s);
-  gfx->setCursor(x,   y+1); gfx->print(s);
-  gfx->setCursor(x+1, y+1); gfx->print(s);
-  gfx->setCursor(x,   y);   gfx->print(s);
+  drawAtlasText(gfx, x, y, s.c_str(), RGB565_WHITE, RGB565_BLACK, true, padW);
 }
 
 // Variante con colori personalizzati (usata in header)
 static void drawBoldTextColored(int16_t x, int16_t y, const String& raw, uint16_t fg, uint16_t bg) {
   String s = normalizeAndTransliterate(raw);
-  gfx->setTextSize(TEXT_SCALE);
-  gfx->setTextColor(fg, bg);
-  gfx->setCursor(x+1, y);   gfx->print(s);
-  gfx->setCursor(x,   y+1); gfx->print(s);
-  gfx->setCursor(x+1, y+1); gfx->print(s);
-  gfx->setCursor(x,   y);   gfx->print(s);
+  drawAtlasText(gfx, x, y, s.c_str(), fg, bg, true);
 }
 
-// Stima rapida larghezza in pixel (carattere monospazio)
-static int approxTextWidthPx(const String& s) { return s.length() * CHAR_W; }
-
 // =========================== XML helper e wrapping ===========================
-// Rimuove tag XML/HTML, decodifica entità e gestisce blocchi CDATA
-static String stripTagsAndDecode(String s) {
-  int c0 = s.indexOf("<![CDATA[");
-  if (c0 >= 0) { int c1 = s.indexOf("]]>", c0); if (c1 > c0) s = s.substring(c0 + 9, c1); }
-  String out; out.reserve(s.length()); bool inTag = false;
-  for (size_t i=0;i<s.length();++i) {
-    char ch = s[i];
-    if (ch == '<') { inTag = true; continue; }
-    if (ch == '>') { inTag = false; continue; }
-    if (!inTag) out += ch;
-  }
-  out.replace("&amp;","&"); out.replace("&lt;","<"); out.replace("&gt;",">");
-  out.replace("&quot;","'"); out.replace("&apos;","'"); out.replace("&nbsp;"," ");
-  out.trim(); while (out.indexOf("  ") >= 0) out.replace("  ", " ");
-  return normalizeAndTransliterate(out);
-}
-
-// Wrap manuale in un box rettangolare (line breaking per parole/spazi)
+// Wrap manuale in un box rettangolare (line breaking per parole/spazi).
+// Ogni riga copre la precedente fino a maxWidth; le righe rimaste vuote si puliscono.
 static void drawWrappedInBox(int bx, int by, int bw, int bh, const String& text) {
   const int lineHeight = CHAR_H + ITEM_LINE_SP;
   const int maxLines   = (bh - ITEM_MARGIN_TOP*2) / lineHeight;
   const int maxWidth   = bw - ITEM_MARGIN_X*2;
+  const int y0         = by + ITEM_MARGIN_TOP + CHAR_H;
 
-  int y = by + ITEM_MARGIN_TOP + CHAR_H;
-  String s = text; int start = 0;
-
-  for (int line=0; line<maxLines && start < s.length(); ++line) {
+  const String& s = text; const int len = s.length();
+  int start = 0, line = 0;
+  while (line < maxLines && start < len) {
     int end = start, lastSpace = -1;
-    while (end < (int)s.length()) {
-      String candidate = s.substring(start, end+1);
-      if (candidate.endsWith(" ")) lastSpace = end;
-      if (approxTextWidthPx(candidate) > maxWidth) break;
+    while (end < len) {
+      if (s[end] == ' ') lastSpace = end;
+      if ((end - start + 1) * CHAR_W > maxWidth) break;
       end++;
     }
-    if (end == (int)s.length()) {
-      String chunk = s.substring(start, end); chunk.trim();
-      drawBoldText(bx + ITEM_MARGIN_X, y, chunk);
-      start = end; break;
-    } else {
-      int cut = (lastSpace >= start) ? lastSpace : (end - 1);
-      String chunk = s.substring(start, cut + 1); chunk.trim();
-      drawBoldText(bx + ITEM_MARGIN_X, y, chunk);
-      start = cut + 1;
-      while (start < (int)s.length() && s[start] == ' ') start++;
-    }
-    y += lineHeight;
+    int cut = (end == len) ? end - 1 : ((lastSpace >= start) ? lastSpace : (end - 1));
+    String chunk = s.substring(start, cut + 1); chunk.trim();
+    drawBoldText(bx + ITEM_MARGIN_X, y0 + line * lineHeight, chunk, maxWidth);
+    line++;
+    start = cut + 1;
+    while (start < len && s[start] == ' ') start++;
   }
+  if (line < maxLines)
+    gfx->fillRect(bx + ITEM_MARGIN_X, y0 + line * lineHeight, maxWidth,
+                  (maxLines - line - 1) * lineHeight + TA_BOLD_H, RGB565_BLACK);
 }
 
 // =========================== NVS: lettura/scrittura config feed ===========================
 // Carica al più MAX_FEEDS voci: se NVS vuoto, popola con default
+// Usa un'istanza Preferences propria: la chiamano sia la WebUI (core 1) sia il task dei feed (core 0)
 static void loadFeedConfig(FeedConfig outFeeds[MAX_FEEDS], int &count) {
   count = 0;
+  Preferences prefs;
   prefs.begin("rss", true);
   uint8_t n = prefs.getUChar("n", 0);
   if (n == 0) {
@@ -316,6 +389,7 @@ static void saveFeedConfigFromForm() {
     else { prefs.remove(kurl.c_str()); prefs.remove(klim.c_str()); }
   }
   prefs.end();
+  invalidateWebFeeds();            // la pagina /rss rilegge la config al prossimo GET
 }
 
 // =========================== HTML: pagine captive e WebUI (UTF-8) ===========================
@@ -341,130 +415,183 @@ static String htmlIndexAP() {
 }
 
 // STA: home minima con link a /rss; utile come default di onNotFound
-static String htmlIndexSTA() {
-  String page =
-    "<!doctype html><html><head>"
-    "<meta charset='utf-8'/>"
-    "<meta name='viewport' content='width=device-width,initial-scale=1'/>"
-    "<title>News Ticker</title>"
-    "<style>body{font-family:system-ui,Segoe UI,Roboto,Ubuntu,Arial,sans-serif}</style>"
-    "</head><body>"
-    "<h2>Gat News Ticker</h2>"
-    "<p><a href='/rss'>Impostazioni RSS</a></p>"
-    "</body></html>";
-  return page;
-}
-
-// STA: singola pagina /rss. In POST mostra un banner di conferma (senza redirect).
-static String htmlRSS(bool saved = false) {
-  FeedConfig cfg[MAX_FEEDS]; int n=0; loadFeedConfig(cfg, n);
-
-  String rows;
+static const char INDEX_STA[] PROGMEM =
+  "<!doctype html><html><head>"
+  "<meta charset='utf-8'/>"
+  "<meta name='viewport' content='width=device-width,initial-scale=1'/>"
+  "<title>News Ticker</title>"
+  "<style>body{font-family:system-ui,Segoe UI,Roboto,Ubuntu,Arial,sans-serif}</style>"
+  "</head><body>"
+  "<h2>Gat News Ticker</h2>"
+  "<p><a href='/rss'>Impostazioni RSS</a></p>"
+  "<p><a href='/boot'>Tempi di avvio</a></p>"
+  "</body></html>";
+
+// STA: pagina /rss a pezzi (WebChunk.h). Le parti fisse restano in flash
+static const char RSS_HEAD[] PROGMEM =
+  "<!doctype html><html><head>"
+  "<meta charset='utf-8'/>"
+  "<meta name='viewport' content='width=device-width, initial-scale=1'/>"
+  "<title>RSS – Gat News Ticker</title>"
+  "<style>"
+  "body{font-family:system-ui,-apple-system,Segoe UI,Roboto,Ubuntu,Helvetica,Arial,sans-serif;margin:0;background:#0b0b0b;color:#eee}"
+  "header{position:sticky;top:0;background:#0b5bd3;padding:14px 16px;color:#ffea00;box-shadow:0 1px 8px rgba(0,0,0,.3)}"
+  "header h1{margin:0;font-size:18px}"
+  ".notice{margin:12px 0;padding:12px 14px;border-left:4px solid #0dad4a;background:#0f2218;color:#c7ffd9;border-radius:8px}"
+  "main{padding:16px;max-width:900px;margin:0 auto}"
+  ".card{background:#141414;border:1px solid #262626;border-radius:12px;box-shadow:0 4px 14px rgba(0,0,0,.25)}"
+  ".card h2{margin:0;padding:14px 16px;border-bottom:2px solid #0dad4a;font-size:16px;color:#f1f1f1}"
+  "table{width:100%;border-collapse:collapse}"
+  "th,td{padding:10px 12px;border-bottom:1px solid #222;vertical-align:middle}"
+  "th{color:#cfcfcf;font-weight:600;text-align:left}"
+  "tr:last-child td{border-bottom:none}"
+  "input[type=text]{width:100%;padding:10px 12px;border:1px solid #2b2b2b;background:#0f0f0f;color:#eee;border-radius:8px;outline:none}"
+  "input[type=number]{width:110px;padding:10px 12px;border:1px solid #2b2b2b;background:#0f0f0f;color:#eee;border-radius:8px;outline:none}"
+  "input:focus{border-color:#0dad4a;box-shadow:0 0 0 3px rgba(13,173,74,.2)}"
+  ".toolbar{display:flex;gap:8px;flex-wrap:wrap;padding:12px 16px;border-top:2px solid #0dad4a;background:#101010;border-bottom-left-radius:12px;border-bottom-right-radius:12px}"
+  ".btn{appearance:none;border:none;border-radius:10px;padding:10px 14px;font-weight:600;cursor:pointer}"
+  ".primary{background:#0dad4a;color:#111}"
+  ".ghost{background:transparent;color:#ddd;border:1px solid #2b2b2b}"
+  ".danger{background:#2b0b0b;color:#ffb3b3;border:1px solid #4a1111}"
+  ".btn:disabled{opacity:.6;cursor:not-allowed}"
+  ".row .actions{white-space:nowrap}"
+  ".icon{width:36px;height:36px;border-radius:8px;border:1px solid #2b2b2b;background:#121212;color:#ddd;margin-left:6px}"
+  ".icon:hover{border-color:#0dad4a}"
+  ".drag{width:30px;text-align:center;color:#777;cursor:grab}"
+  ".limit{width:130px}"
+  "@media(max-width:720px){.drag{display:none}.limit{width:auto}}"
+  ".help{color:#aaa;font-size:13px;margin:10px 0 0 0}"
+  ".footer{padding:14px 16px;color:#aaa;font-size:12px;text-align:center}"
+  ".u{max-width:260px;overflow:hidden;text-overflow:ellipsis;white-space:nowrap;font-size:13px}"
+  "</style>"
+  "</head><body>"
+  "<header><h1>Impostazioni RSS</h1></header>"
+  "<main>";
+
+static const char RSS_TABLE_HEAD[] PROGMEM =
+  ")</h2>"
+  "<form id='f' method='POST' action='/rss' onsubmit='return prepareSubmit()'>"
+  "<table id='tbl'>"
+  "<thead><tr><th></th><th>URL</th><th>Max elementi</th><th></th></tr></thead>"
+  "<tbody id='tbody'>";
+
+static const char RSS_TABLE_TAIL[] PROGMEM =
+  "</tbody>"
+  "</table>"
+  "<div class='toolbar'>"
+  "<button type='button' class='btn ghost' onclick='addRow()'>+ Aggiungi feed</button>"
+  "<button type='button' class='btn ghost' onclick='fillDefaults()'>Carica default</button>"
+  "<button type='button' class='btn danger' onclick='clearAll()'>Svuota tutto</button>"
+  "<span class='help'>Suggerimento: riordina con le frecce; i campi vuoti non verranno salvati.</span>"
+  "<div style='flex:1'></div>"
+  "<button type='submit' class='btn primary'>Salva</button>"
+  "<a class='btn ghost' href='/' role='button'>Home</a>"
+  "</div>"
+  "</form>"
+  "</div>";
+
+static const char RSS_ROW_ACTIONS[] PROGMEM =
+  "'/></td>"
+  "<td class='actions'>"
+  "<button class='icon up' type='button' onclick='moveUp(this)' title='Su'>&#8593;</button>"
+  "<button class='icon down' type='button' onclick='moveDown(this)' title='Giù'>&#8595;</button>"
+  "<button class='icon del' type='button' onclick='delRow(this)' title='Rimuovi'>&#10006;</button>"
+  "</td></tr>";
+
+// MAX, DEF e LIM arrivano prima, dal firmware
+static const char RSS_SCRIPT[] PROGMEM =
+  "function qs(s,el=document){return el.querySelector(s)}"
+  "function qsa(s,el=document){return Array.from(el.querySelectorAll(s))}"
+  "function rowTemplate(i,url='',lim=LIM){"
+    "return `<tr class='row'>"
+    "<td class='drag' title='Trascina per riordinare'>&#8942;&#8942;</td>"
+    "<td><input type='text' name='url${i}' value='${url}' placeholder='https://...'/></td>"
+    "<td class='limit'><input type='number' name='limit${i}' min='1' max='120' value='${lim}'/></td>"
+    "<td class='actions'>"
+    "<button class='icon up' type='button' onclick='moveUp(this)' title='Su'>&#8593;</button>"
+    "<button class='icon down' type='button' onclick='moveDown(this)' title='Giù'>&#8595;</button>"
+    "<button class='icon del' type='button' onclick='delRow(this)' title='Rimuovi'>&#10006;</button>"
+    "</td></tr>`}"
+  "function renumber(){qsa('#tbody tr').forEach((tr,idx)=>{qs(\"input[type=text]\",tr).setAttribute('name','url'+idx);qs(\"input[type=number]\",tr).setAttribute('name','limit'+idx);});}"
+  "function addRow(){let body=qs('#tbody');let rows=qsa('tr',body).length;if(rows>=MAX)return;body.insertAdjacentHTML('beforeend',rowTemplate(rows,'',LIM));}"
+  "function delRow(btn){let tr=btn.closest('tr'); tr.remove(); renumber();}"
+  "function moveUp(btn){let tr=btn.closest('tr'); let prev=tr.previousElementSibling; if(prev){tr.parentNode.insertBefore(tr,prev); renumber();}}"
+  "function moveDown(btn){let tr=btn.closest('tr'); let next=tr.nextElementSibling; if(next){tr.parentNode.insertBefore(next,tr); renumber();}}"
+  "function clearAll(){qs('#tbody').innerHTML=''; addRow();}"
+  "function fillDefaults(){qs('#tbody').innerHTML=''; let lim=LIM; for(let i=0;i<Math.min(DEF.length,MAX);i++){qs('#tbody').insertAdjacentHTML('beforeend',rowTemplate(i,DEF[i],lim));} renumber();}"
+  "function prepareSubmit(){let rows=qsa('#tbody tr'); rows.forEach(tr=>{let url=qs(\"input[type=text]\",tr).value.trim(); let lim=qs(\"input[type=number]\",tr); let v=parseInt(lim.value||LIM); if(isNaN(v)||v<1)v=1; if(v>120)v=120; lim.value=v; if(url===''){ tr.querySelectorAll('input').forEach(i=>i.value=''); }}); renumber(); return true;}"
+  "</script>"
+  "</body></html>";
+
+// Config dei feed come la mostra /rss: si rilegge dall'NVS e si rifà in HTML solo dopo un salvataggio
+static FeedConfig g_webCfg[MAX_FEEDS];
+static int        g_webCfgN = -1;           // -1: da rileggere
+static WebFrag    g_feedRowsFrag;           // righe del form, già escapate
+
+static void invalidateWebFeeds() { g_webCfgN = -1; g_feedRowsFrag.invalidate(); }
+
+static void renderFeedRows(WebChunk &w) {
   for (int i=0; i<MAX_FEEDS; ++i) {
-    String u = (i<n) ? cfg[i].url : String("");
-    int lim   = (i<n) ? cfg[i].limit : DEFAULT_LIMIT;
-    rows +=
-      "<tr class='row'>"
-      "<td class='drag' title='Trascina per riordinare'>&#8942;&#8942;</td>"
-      "<td><input type='text' name='url" + String(i) + "' value='" + u + "' placeholder='https://...'/></td>"
-      "<td class='limit'><input type='number' name='limit" + String(i) + "' min='1' max='120' value='" + String(lim) + "'/></td>"
-      "<td class='actions'>"
-      "<button class='icon up' type='button' onclick='moveUp(this)' title='Su'>&#8593;</button>"
-      "<button class='icon down' type='button' onclick='moveDown(this)' title='Giù'>&#8595;</button>"
-      "<button class='icon del' type='button' onclick='delRow(this)' title='Rimuovi'>&#10006;</button>"
-      "</td></tr>";
-  }
-
-  String notice = saved
-    ? "<div class='notice'>Impostazioni salvate. La lista news si aggiorna subito.</div>"
-    : "";
+    w.put("<tr class='row'>"
+          "<td class='drag' title='Trascina per riordinare'>&#8942;&#8942;</td>"
+          "<td><input type='text' name='url"); w.num(i);
+    w.put("' value='"); if (i<g_webCfgN) w.esc(g_webCfg[i].url);
+    w.put("' placeholder='https://...'/></td>"
+          "<td class='limit'><input type='number' name='limit"); w.num(i);
+    w.put("' min='1' max='120' value='"); w.num(i<g_webCfgN ? g_webCfg[i].limit : DEFAULT_LIMIT);
+    w.put(RSS_ROW_ACTIONS);
+  }
+}
 
-  String page =
-    "<!doctype html><html><head>"
-    "<meta charset='utf-8'/>"
-    "<meta name='viewport' content='width=device-width, initial-scale=1'/>"
-    "<title>RSS – Gat News Ticker</title>"
-    "<style>"
-    "body{font-family:system-ui,-apple-system,Segoe UI,Roboto,Ubuntu,Helvetica,Arial,sans-serif;margin:0;background:#0b0b0b;color:#eee}"
-    "header{position:sticky;top:0;background:#0b5bd3;padding:14px 16px;color:#ffea00;box-shadow:0 1px 8px rgba(0,0,0,.3)}"
-    "header h1{margin:0;font-size:18px}"
-    ".notice{margin:12px 0;padding:12px 14px;border-left:4px solid #0dad4a;background:#0f2218;color:#c7ffd9;border-radius:8px}"
-    "main{padding:16px;max-width:900px;margin:0 auto}"
-    ".card{background:#141414;border:1px solid #262626;border-radius:12px;box-shadow:0 4px 14px rgba(0,0,0,.25)}"
-    ".card h2{margin:0;padding:14px 16px;border-bottom:2px solid #0dad4a;font-size:16px;color:#f1f1f1}"
-    "table{width:100%;border-collapse:collapse}"
-    "th,td{padding:10px 12px;border-bottom:1px solid #222;vertical-align:middle}"
-    "th{color:#cfcfcf;font-weight:600;text-align:left}"
-    "tr:last-child td{border-bottom:none}"
-    "input[type=text]{width:100%;padding:10px 12px;border:1px solid #2b2b2b;background:#0f0f0f;color:#eee;border-radius:8px;outline:none}"
-    "input[type=number]{width:110px;padding:10px 12px;border:1px solid #2b2b2b;background:#0f0f0f;color:#eee;border-radius:8px;outline:none}"
-    "input:focus{border-color:#0dad4a;box-shadow:0 0 0 3px rgba(13,173,74,.2)}"
-    ".toolbar{display:flex;gap:8px;flex-wrap:wrap;padding:12px 16px;border-top:2px solid #0dad4a;background:#101010;border-bottom-left-radius:12px;border-bottom-right-radius:12px}"
-    ".btn{appearance:none;border:none;border-radius:10px;padding:10px 14px;font-weight:600;cursor:pointer}"
-    ".primary{background:#0dad4a;color:#111}"
-    ".ghost{background:transparent;color:#ddd;border:1px solid #2b2b2b}"
-    ".danger{background:#2b0b0b;color:#ffb3b3;border:1px solid #4a1111}"
-    ".btn:disabled{opacity:.6;cursor:not-allowed}"
-    ".row .actions{white-space:nowrap}"
-    ".icon{width:36px;height:36px;border-radius:8px;border:1px solid #2b2b2b;background:#121212;color:#ddd;margin-left:6px}"
-    ".icon:hover{border-color:#0dad4a}"
-    ".drag{width:30px;text-align:center;color:#777;cursor:grab}"
-    ".limit{width:130px}"
-    "@media(max-width:720px){.drag{display:none}.limit{width:auto}}"
-    ".help{color:#aaa;font-size:13px;margin:10px 0 0 0}"
-    ".footer{padding:14px 16px;color:#aaa;font-size:12px;text-align:center}"
-    "</style>"
-    "</head><body>"
-    "<header><h1>Impostazioni RSS</h1></header>"
-    "<main>"
-    + notice +
-    "<div class='card'>"
-    "<h2>Feed e limiti (max " + String(MAX_FEEDS) + ")</h2>"
-    "<form id='f' method='POST' action='/rss' onsubmit='return prepareSubmit()'>"
-    "<table id='tbl'>"
-    "<thead><tr><th></th><th>URL</th><th>Max elementi</th><th></th></tr></thead>"
-    "<tbody id='tbody'>" + rows + "</tbody>"
-    "</table>"
-    "<div class='toolbar'>"
-    "<button type='button' class='btn ghost' onclick='addRow()'>+ Aggiungi feed</button>"
-    "<button type='button' class='btn ghost' onclick='fillDefaults()'>Carica default</button>"
-    "<button type='button' class='btn danger' onclick='clearAll()'>Svuota tutto</button>"
-    "<span class='help'>Suggerimento: riordina con le frecce; i campi vuoti non verranno salvati.</span>"
-    "<div style='flex:1'></div>"
-    "<button type='submit' class='btn primary'>Salva</button>"
-    "<a class='btn ghost' href='/' role='button'>Home</a>"
-    "</div>"
-    "</form>"
-    "</div>"
-    "<div class='footer'>Gat News Ticker · WebUI RSS</div>"
-    "</main>"
-    "<script>"
-    "const MAX=" + String(MAX_FEEDS) + ";"
-    "const DEF=['" + String(FEEDS_DEFAULT[0]) + "','" + String(FEEDS_DEFAULT[1]) + "','" + String(FEEDS_DEFAULT[2]) + "','" + String(FEEDS_DEFAULT[3]) + "'];"
-    "function qs(s,el=document){return el.querySelector(s)}"
-    "function qsa(s,el=document){return Array.from(el.querySelectorAll(s))}"
-    "function rowTemplate(i,url='',lim=" + String(DEFAULT_LIMIT) + "){"
-      "return `<tr class='row'>"
-      "<td class='drag' title='Trascina per riordinare'>&#8942;&#8942;</td>"
-      "<td><input type='text' name='url${i}' value='${url}' placeholder='https://...'/></td>"
-      "<td class='limit'><input type='number' name='limit${i}' min='1' max='120' value='${lim}'/></td>"
-      "<td class='actions'>"
-      "<button class='icon up' type='button' onclick='moveUp(this)' title='Su'>&#8593;</button>"
-      "<button class='icon down' type='button' onclick='moveDown(this)' title='Giù'>&#8595;</button>"
-      "<button class='icon del' type='button' onclick='delRow(this)' title='Rimuovi'>&#10006;</button>"
-      "</td></tr>`}"
-    "function renumber(){qsa('#tbody tr').forEach((tr,idx)=>{qs(\"input[type=text]\",tr).setAttribute('name','url'+idx);qs(\"input[type=number]\",tr).setAttribute('name','limit'+idx);});}"
-    "function addRow(){let body=qs('#tbody');let rows=qsa('tr',body).length;if(rows>=MAX)return;body.insertAdjacentHTML('beforeend',rowTemplate(rows,''," + String(DEFAULT_LIMIT) + "));}"
-    "function delRow(btn){let tr=btn.closest('tr'); tr.remove(); renumber();}"
-    "function moveUp(btn){let tr=btn.closest('tr'); let prev=tr.previousElementSibling; if(prev){tr.parentNode.insertBefore(tr,prev); renumber();}}"
-    "function moveDown(btn){let tr=btn.closest('tr'); let next=tr.nextElementSibling; if(next){tr.parentNode.insertBefore(next,tr); renumber();}}"
-    "function clearAll(){qs('#tbody').innerHTML=''; addRow();}"
-    "function fillDefaults(){qs('#tbody').innerHTML=''; let lim=" + String(DEFAULT_LIMIT) + "; for(let i=0;i<Math.min(DEF.length,MAX);i++){qs('#tbody').insertAdjacentHTML('beforeend',rowTemplate(i,DEF[i],lim));} renumber();}"
-    "function prepareSubmit(){let rows=qsa('#tbody tr'); rows.forEach(tr=>{let url=qs(\"input[type=text]\",tr).value.trim(); let lim=qs(\"input[type=number]\",tr); let v=parseInt(lim.value||" + String(DEFAULT_LIMIT) + "); if(isNaN(v)||v<1)v=1; if(v>120)v=120; lim.value=v; if(url===''){ tr.querySelectorAll('input').forEach(i=>i.value=''); }}); renumber(); return true;}"
-    "</script>"
-    "</body></html>";
+// STA: tabella statistiche del task dei feed (latenza, byte, hit 304), sempre dal vivo
+static void sendFeedStats(WebChunk &w) {
+  w.put("<div class='card' style='margin-top:16px'>"
+        "<h2>Aggiornamento feed</h2>"
+        "<table><thead><tr><th>Feed</th><th>Esito</th><th>Latenza</th><th>Byte ultimo / totale</th><th>Item</th><th>Hit 304</th><th>Errori</th></tr></thead>"
+        "<tbody>");
+  for (int i=0; i<g_webCfgN; ++i) {
+    const FeedStats &st = g_feedStats[i];
+    w.put("<tr><td class='u'>"); w.esc(g_webCfg[i].url); w.put("</td><td>");
+    if (st.requests == 0)        w.put("-");
+    else if (st.lastCode == 304) w.put("304 invariato");
+    else                         w.num(st.lastCode);
+    w.put("</td><td>"); w.num(st.lastMs);
+    w.put(" ms</td><td>"); w.num(st.lastBytes / 1024); w.put(" / "); w.num(st.totalBytes / 1024);
+    w.put(" KB</td><td>"); w.num(st.lastItems);
+    w.put("</td><td>"); w.num(st.requests ? (int)(st.notModified * 100 / st.requests) : 0);
+    w.put("% ("); w.num(st.notModified); w.put("/"); w.num(st.requests);
+    w.put(")</td><td>"); w.num(st.errors); w.put("</td></tr>");
+  }
+  w.put("</tbody></table><p class='help' style='padding:0 16px 14px'>");
+  if (g_lastRefreshAt) {
+    w.put("Ultimo refresh "); w.num((millis() - g_lastRefreshAt) / 1000);
+    w.put(" s fa, durata "); w.num(g_lastRefreshMs); w.put(" ms.");
+  } else {
+    w.put("Primo refresh in corso...");
+  }
+  w.put("</p></div>");
+}
 
-  return page;
+// STA: singola pagina /rss. In POST mostra un banner di conferma (senza redirect).
+static void sendRSSPage(bool saved) {
+  WebChunk w(web, "/rss");
+  w.begin("text/html; charset=utf-8");
+  w.put(RSS_HEAD);
+  if (g_webCfgN < 0) { loadFeedConfig(g_webCfg, g_webCfgN); g_feedRowsFrag.invalidate(); }
+  if (saved) w.put("<div class='notice'>Impostazioni salvate. La lista news si aggiorna subito.</div>");
+  w.put("<div class='card'><h2>Feed e limiti (max "); w.num(MAX_FEEDS);
+  w.put(RSS_TABLE_HEAD);
+  if (!g_feedRowsFrag.valid) { WebChunk f(g_feedRowsFrag); renderFeedRows(f); f.end(); }
+  if (g_feedRowsFrag.valid) w.frag(g_feedRowsFrag);
+  else renderFeedRows(w);                    // niente memoria per il frammento: render diretto
+  w.put(RSS_TABLE_TAIL);
+  sendFeedStats(w);
+  w.put("<div class='footer'>Gat News Ticker · WebUI RSS</div></main><script>const MAX="); w.num(MAX_FEEDS);
+  w.put(";const DEF=[");
+  for (int i=0; i<4; ++i) { w.put(i ? ",'" : "'"); w.js(FEEDS_DEFAULT[i]); w.put('\''); }
+  w.put("];const LIM="); w.num(DEFAULT_LIMIT); w.put(';');
+  w.put(RSS_SCRIPT);
+  w.end();
 }
 
 // =========================== Handler HTTP (AP/STA) ===========================
@@ -487,17 +614,29 @@ static void handleSave() {
 
 static void handleReboot() { web.send(200, "text/plain; charset=utf-8", "OK"); delay(100); ESP.restart(); }
 
+// Timeline di avvio (BootSeq.h) in testo semplice
+static void handleBoot() {
+  char buf[BOOT_MAX_PHASES * 56];
+  bootFormatTimeline(buf, sizeof(buf));
+  web.send(200, "text/plain; charset=utf-8", buf);
+}
+
 // STA: una sola pagina /rss. GET mostra form, POST salva e conferma inline
-static void handleRootSTA() { web.send(200, "text/html; charset=utf-8", htmlIndexSTA()); }
+static void handleRootSTA() {
+  WebChunk w(web, "/");
+  w.begin("text/html; charset=utf-8");
+  w.put(INDEX_STA);
+  w.end();
+}
 
 static void handleRSS() {
   bool saved = false;
   if (web.method() == HTTP_POST) {
     saveFeedConfigFromForm();
-    g_rssRefreshPending = true;    // segnala al loop di ricaricare e ridisegnare
+    requestFeedRefresh();          // il task dei feed ricarica subito, il loop ridisegna allo scambio
     saved = true;
   }
-  web.send(200, "text/html; charset=utf-8", htmlRSS(saved));
+  sendRSSPage(saved);
 }
 
 // =========================== Avvio server web e captive ===========================
@@ -509,6 +648,7 @@ static void startAPPortal() {
   web.on("/",       HTTP_GET,  handleRootAP);
   web.on("/save",   HTTP_POST, handleSave);
   web.on("/reboot", HTTP_GET,  handleReboot);
+  web.on("/boot",   HTTP_GET,  handleBoot);
   web.onNotFound(handleRootAP);
   web.begin();
 }
@@ -517,21 +657,33 @@ static void startAPPortal() {
 static void startSTAWebUI() {
   web.on("/",   HTTP_GET,  handleRootSTA);
   web.on("/rss",HTTP_ANY,  handleRSS);
+  web.on("/boot",HTTP_GET, handleBoot);
   web.onNotFound(handleRootSTA);
   web.begin();
 }
 
 // =========================== UI grafica su display ===========================
+// Cosa c'è a schermo: la pagina si ridisegna sopra la precedente, header e orologio solo se cambiano
+static bool   g_scrPage   = false;          // false: schermo da ripulire (avvio, schermata AP)
+static bool   g_scrHeader = false;
+static String g_scrClock;
+
 // Barra superiore (blu) con titolo e orologio (gialli)
 static void drawHeader() {
-  gfx->fillRect(0, 0, 480, HEADER_H, RGB565_BLUE);
-  drawBoldTextColored(16, 28, "Gat News Ticker", RGB565_YELLOW, RGB565_BLUE);
-  String datetime = getFormattedDateTime();
-  if (datetime.length() > 0) {
-    int textWidth = datetime.length() * CHAR_W;
-    int xPos = 480 - textWidth - 16;
-    drawBoldTextColored(xPos, 28, datetime, RGB565_YELLOW, RGB565_BLUE);
+  if (!g_scrHeader) {
+    gfx->fillRect(0, 0, 480, HEADER_H, RGB565_BLUE);
+    drawBoldTextColored(16, 28, "Gat News Ticker", RGB565_YELLOW, RGB565_BLUE);
+    g_scrHeader = true;
+    g_scrClock = "";
   }
+  String datetime = getFormattedDateTime();
+  if (datetime == g_scrClock) return;
+  // Allineato a destra: se il nuovo testo è più corto si ripulisce solo l'avanzo a sinistra
+  int oldW = g_scrClock.length() * CHAR_W;
+  int textWidth = datetime.length() * CHAR_W;
+  if (oldW > textWidth) gfx->fillRect(480 - oldW - 16, 28, oldW - textWidth, TA_BOLD_H, RGB565_BLUE);
+  if (textWidth) drawBoldTextColored(480 - textWidth - 16, 28, datetime, RGB565_YELLOW, RGB565_BLUE);
+  g_scrClock = datetime;
 }
 
 // Schermata di istruzioni quando il dispositivo è in AP (captive attivo)
@@ -558,141 +710,407 @@ static void startAPWithPortal() {
   startDNSCaptive(); startAPPortal(); drawAPScreenOnce(ap_ssid, ap_pass);
 }
 
-// Connette in STA usando credenziali da NVS; timeout configurabile
-static bool tryConnectSTA(uint32_t timeoutMs = 8000) {
-  prefs.begin("wifi", true);
-  sta_ssid = prefs.getString("ssid", "");
-  sta_pass = prefs.getString("pass", "");
-  prefs.end();
-  if (sta_ssid.isEmpty()) return false;
-  WiFi.persistent(false); WiFi.mode(WIFI_STA); WiFi.setSleep(false);
-  WiFi.begin(sta_ssid.c_str(), sta_pass.c_str());
-  uint32_t t0 = millis();
-  while (WiFi.status() != WL_CONNECTED && (millis() - t0) < timeoutMs) { delay(100); yield(); }
-  return WiFi.status() == WL_CONNECTED;
-}
-
 // =========================== HTTP/RSS util e parsing ===========================
 // Helper status 2xx
 static inline bool isHttpOk(int code) { return (code >= 200 && code < 300); }
 
-// Ricerca case-insensitive
-static int indexOfCI(const String& s, const String& pat, int from=0) {
-  String S = s; S.toLowerCase();
-  String P = pat; P.toLowerCase();
-  return S.indexOf(P, from);
+// Aggiunge un item se non duplicato (titolo o link già visti in questo refresh); true se inserito
+static bool addFeedItem(NewsStore &dst, uint8_t feed, const char* rawTitle, const char* link) {
+  if (dst.full()) return false;
+  String t = normalizeAndTransliterate(String(rawTitle));
+  return dst.add(t.c_str(), link, feed);
 }
 
-// Estrae <tag>…</tag> a partire da un offset e aggiorna l’indice di scansione
-static String extractTag(const String& xml, const String& tag, int& fromIdx) {
-  String open = "<" + tag + ">";
-  String close = "</" + tag + ">";
-  int s = indexOfCI(xml, open, fromIdx); if (s < 0) return "";
-  s += open.length();
-  int e = indexOfCI(xml, close, s); if (e < 0) return "";
-  fromIdx = e + close.length();
-  String raw = xml.substring(s, e); raw.trim();
-  return raw;
-}
+// Tokenizer XML a passata singola per RSS 2.0/1.0 (<item>) e Atom (<entry>).
+// Riceve lo stream a blocchi (finestra fissa): nessuna copia del body, tag confrontati
+// in minuscolo man mano che arrivano, titolo e link estratti già puliti
+// (tag HTML nei CDATA rimossi, entità decodificate, spazi compattati).
+static const int RSS_CHUNK     = 512;   // finestra di lettura dallo stream HTTP
+static const int RSS_TITLE_MAX = 320;
+static const int RSS_LINK_MAX  = 384;
+
+struct RssStreamParser {
+  enum State : uint8_t { TEXT, TAG_START, TAG_NAME, ATTRS, ATTR_VALUE, BANG, COMMENT, CDATA, SKIP_PI, SKIP_DECL };
+  enum Field : uint8_t { NONE, TITLE, LINK };
+
+  NewsStore &dst; uint8_t feedIdx;
+  int limit = 0, added = 0;
+  uint32_t bytes = 0;
+  bool done = false;
+
+  State st = TEXT;
+  char name[16]; uint8_t nameLen = 0; bool closing = false, selfClose = false;
+  char attr[8];  uint8_t attrLen = 0; bool inAttrName = false;
+  char quote = 0; char *aval = nullptr; uint16_t avalLen = 0, avalCap = 0;
+  char bang[8];  uint8_t bangLen = 0;
+  uint8_t tail = 0;                       // '-' per i commenti, ']' per i CDATA, '?' per i PI
+
+  bool inItem = false;
+  Field field = NONE; bool htmlTag = false;
+  char ent[12]; uint8_t entLen = 0;
+  char title[RSS_TITLE_MAX]; uint16_t titleLen = 0;
+  char link[RSS_LINK_MAX];   uint16_t linkLen = 0;
+  char href[RSS_LINK_MAX];   char rel[12];
+
+  RssStreamParser(NewsStore &store, uint8_t feed, int maxItems) : dst(store), feedIdx(feed), limit(maxItems) {}
+
+  // Elabora un blocco; false quando il limite del feed è raggiunto (si può chiudere la connessione)
+  bool feed(const uint8_t* p, size_t n) {
+    bytes += n;
+    for (size_t i = 0; i < n && !done; ++i) step((char)p[i]);
+    return !done;
+  }
+
+  static inline char lower(char c) { return (c >= 'A' && c <= 'Z') ? c + 32 : c; }
+  static inline bool isNameChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == ':' || c == '-' || c == '_' || c == '.';
+  }
+
+  // ---- testo dei campi: spazi compattati, entità, tag HTML dentro CDATA ----
+  void put(char c) {
+    char *buf = (field == TITLE) ? title : link;
+    uint16_t &len = (field == TITLE) ? titleLen : linkLen;
+    const uint16_t cap = (field == TITLE) ? RSS_TITLE_MAX : RSS_LINK_MAX;
+    if (c == '\n' || c == '\r' || c == '\t') c = ' ';
+    if (c == ' ' && (len == 0 || buf[len-1] == ' ')) return;
+    if (len < cap - 1) buf[len++] = c;
+  }
+
+  void putUtf8(uint32_t cp) {
+    if (cp < 0x80) put((char)cp);
+    else if (cp < 0x800) { put(0xC0 | (cp >> 6)); put(0x80 | (cp & 0x3F)); }
+    else if (cp < 0x10000) { put(0xE0 | (cp >> 12)); put(0x80 | ((cp >> 6) & 0x3F)); put(0x80 | (cp & 0x3F)); }
+    else { put(0xF0 | (cp >> 18)); put(0x80 | ((cp >> 12) & 0x3F)); put(0x80 | ((cp >> 6) & 0x3F)); put(0x80 | (cp & 0x3F)); }
+  }
+
+  void flushEntity() {
+    ent[entLen] = 0;
+    const char *e = ent + 1;
+    if      (!strcmp(e, "amp"))  put('&');
+    else if (!strcmp(e, "lt"))   put('<');
+    else if (!strcmp(e, "gt"))   put('>');
+    else if (!strcmp(e, "quot") || !strcmp(e, "apos")) put('\'');
+    else if (!strcmp(e, "nbsp")) put(' ');
+    else if (e[0] == '#') {
+      uint32_t cp = (e[1] == 'x' || e[1] == 'X') ? strtoul(e + 2, nullptr, 16) : strtoul(e + 1, nullptr, 10);
+      if (cp) putUtf8(cp);
+    } else {
+      for (uint8_t k = 0; k < entLen; ++k) put(ent[k]);   // entità sconosciuta: testo invariato
+      put(';');
+    }
+    entLen = 0;
+  }
+
+  void fieldChar(char c, bool cdata) {
+    if (cdata) {                                           // HTML annidato nei CDATA
+      if (htmlTag) { if (c == '>') htmlTag = false; return; }
+      if (c == '<') { htmlTag = true; return; }
+    }
+    if (entLen) {
+      if (c == ';') { flushEntity(); return; }
+      if (entLen < sizeof(ent) - 1 && (isNameChar(c) || c == '#')) { ent[entLen++] = c; return; }
+      for (uint8_t k = 0; k < entLen; ++k) put(ent[k]);   // '&' isolato: testo invariato
+      entLen = 0;
+    }
+    if (c == '&') { ent[0] = '&'; entLen = 1; return; }
+    put(c);
+  }
+
+  void closeField() {
+    if (entLen) { for (uint8_t k = 0; k < entLen; ++k) put(ent[k]); entLen = 0; }
+    char *buf = (field == TITLE) ? title : link;
+    uint16_t &len = (field == TITLE) ? titleLen : linkLen;
+    while (len && buf[len-1] == ' ') len--;
+    buf[len] = 0;
+    field = NONE; htmlTag = false;
+  }
+
+  // ---- tag completi ----
+  void openItem() { inItem = true; titleLen = linkLen = 0; title[0] = link[0] = 0; field = NONE; }
+
+  void closeItem() {
+    if (field != NONE) closeField();
+    inItem = false;
+    if (titleLen && linkLen && addFeedItem(dst, feedIdx, title, link)) {
+      if (++added >= limit) done = true;
+    }
+  }
 
-// Aggiunge fino a maxAdd item (title+link), elimina duplicati, tenta fallback per feed “atipici”
-static int parseFeedItemsLimited(const String& body, int maxAdd) {
-  if (maxAdd <= 0) return 0;
-  int added = 0; int pos = 0; extractTag(body, "title", pos); // salta titolo canale
-  int start;
-  while (added < maxAdd && (start = indexOfCI(body, "<item", pos)) >= 0) {
-    int openEnd = body.indexOf('>', start); if (openEnd < 0) break;
-    int end = indexOfCI(body, "</item>", openEnd); if (end < 0) break;
-    String item = body.substring(openEnd + 1, end);
-    int ipos = 0; String t = extractTag(item, "title", ipos); ipos = 0; String l = extractTag(item, "link", ipos);
-    t = stripTagsAndDecode(t); l.trim();
-    if (t.length() && l.length()) {
-      bool dup = false; for (int i=0;i<itemCount;i++) { if (titles[i]==t || links[i]==l) { dup=true; break; } }
-      if (!dup && itemCount < MAX_ITEMS) { titles[itemCount]=t; links[itemCount]=l; itemCount++; added++; }
+  void tagDone() {
+    name[nameLen] = 0;
+    if (strchr(name, ':')) return;                         // media:title, atom:link, dc:*…: ignorati
+    bool isItem = !strcmp(name, "item") || !strcmp(name, "entry");
+    if (closing) {
+      if (isItem) { if (inItem) closeItem(); }
+      else if (field == TITLE && !strcmp(name, "title")) closeField();
+      else if (field == LINK  && !strcmp(name, "link"))  closeField();
+      return;
     }
-    pos = end + 7;
-  }
-  if (added == 0 && itemCount < MAX_ITEMS) {
-    int p = 0; extractTag(body, "title", p);
-    for (int i=0; i<maxAdd && itemCount<MAX_ITEMS; ++i) {
-      String t = extractTag(body, "title", p);
-      String l = extractTag(body, "link",  p);
-      if (t.isEmpty() || l.isEmpty()) break;
-      t = stripTagsAndDecode(t); l.trim();
-      bool dup=false; for (int k=0;k<itemCount;k++) if (titles[k]==t || links[k]==l) { dup=true; break; }
-      if (!dup) { titles[itemCount]=t; links[itemCount]=l; itemCount++; added++; if (added>=maxAdd) break; }
+    if (isItem) { if (!selfClose) openItem(); return; }
+    if (!inItem || field != NONE) return;
+    if (!strcmp(name, "title") && !titleLen && !selfClose) { field = TITLE; titleLen = 0; }
+    else if (!strcmp(name, "link") && !linkLen) {
+      // Atom: <link rel="alternate" href="…"/>; RSS: <link>…</link>
+      if (href[0] && (!rel[0] || !strcmp(rel, "alternate"))) {
+        strlcpy(link, href, sizeof(link)); linkLen = strlen(link);
+      } else if (!selfClose) { field = LINK; linkLen = 0; }
     }
   }
-  return added;
+
+  void step(char c) {
+    switch (st) {
+      case TEXT:
+        if (c == '<') { st = TAG_START; return; }
+        if (field != NONE) fieldChar(c, false);
+        return;
+
+      case TAG_START:
+        nameLen = 0; attrLen = 0; closing = selfClose = false; href[0] = rel[0] = 0; inAttrName = false;
+        if (c == '/') { closing = true; st = TAG_NAME; return; }
+        if (c == '!') { bangLen = 0; st = BANG; return; }
+        if (c == '?') { tail = 0; st = SKIP_PI; return; }
+        st = TAG_NAME;
+        // fallthrough
+      case TAG_NAME:
+        if (isNameChar(c)) { if (nameLen < sizeof(name) - 1) name[nameLen++] = lower(c); return; }
+        st = ATTRS;
+        // fallthrough
+      case ATTRS:
+        if (c == '>') { tagDone(); st = TEXT; return; }
+        if (c == '/') { selfClose = true; return; }
+        if (c == '"' || c == '\'') {
+          attr[attrLen] = 0; inAttrName = false; quote = c; avalLen = 0;
+          if (!closing && !strcmp(attr, "href")) { aval = href; avalCap = sizeof(href); }
+          else if (!closing && !strcmp(attr, "rel")) { aval = rel; avalCap = sizeof(rel); }
+          else aval = nullptr;
+          st = ATTR_VALUE; return;
+        }
+        if (isNameChar(c)) {
+          if (!inAttrName) { attrLen = 0; inAttrName = true; }
+          if (attrLen < sizeof(attr) - 1) attr[attrLen++] = lower(c);
+        } else inAttrName = false;
+        if (c != ' ' && c != '\t' && c != '\r' && c != '\n') selfClose = false;
+        return;
+
+      case ATTR_VALUE:
+        if (c == quote) {
+          if (aval) {
+            aval[avalLen] = 0;
+            if (aval == rel) for (char *q = rel; *q; ++q) *q = lower(*q);
+            aval = nullptr;
+          }
+          st = ATTRS; return;
+        }
+        if (aval && avalLen < avalCap - 1) aval[avalLen++] = c;
+        return;
+
+      case BANG:                                           // <!-- … -->, <![CDATA[ … ]]>, <!DOCTYPE …>
+        bang[bangLen++] = c;
+        if (bangLen == 2 && bang[0] == '-' && bang[1] == '-') { tail = 0; st = COMMENT; return; }
+        if (memcmp(bang, "[CDATA[", bangLen) != 0 && !(bangLen == 1 && c == '-')) { st = (c == '>') ? TEXT : SKIP_DECL; return; }
+        if (bangLen == 7) { tail = 0; st = CDATA; }
+        return;
+
+      case COMMENT:
+        if (c == '>' && tail >= 2) { st = TEXT; return; }
+        tail = (c == '-') ? tail + 1 : 0;
+        return;
+
+      case CDATA:
+        if (c == ']') { if (tail < 2) { tail++; return; } if (field != NONE) fieldChar(']', true); return; }
+        if (c == '>' && tail == 2) { st = TEXT; return; }
+        if (field != NONE) { for (uint8_t k = 0; k < tail; ++k) fieldChar(']', true); fieldChar(c, true); }
+        tail = 0;
+        return;
+
+      case SKIP_PI:
+        if (c == '>' && tail) { st = TEXT; return; }
+        tail = (c == '?');
+        return;
+
+      case SKIP_DECL:
+        if (c == '>') st = TEXT;
+        return;
+    }
+  }
+};
+
+// Su 304 o errore: gli item del feed dal set precedente, non oltre il limite. Se la riga
+// punta a un URL nuovo quelli di prev sono dell'URL vecchio e non si tengono. Se non entrano
+// tutti, via i validatori come per un body troncato: il giro dopo il feed si riscarica intero.
+static int keepPrevFeed(FeedStats &st, uint8_t f, bool sameUrl, NewsStore &dst, const NewsStore &prev) {
+  if (!sameUrl) return 0;
+  bool cut;
+  const int n = dst.copyFeed(prev, f, st.limit, cut);
+  if (cut) { st.etag = ""; st.lastModified = ""; }
+  return n;
 }
 
-// Mescola gli item (Fisher–Yates) per dare varietà alla rotazione
-static void shuffleItems() {
-  if (itemCount <= 1) return;
-  for (int i = itemCount - 1; i > 0; --i) {
-    int j = random(i + 1);
-    if (i != j) { String t=titles[i]; titles[i]=titles[j]; titles[j]=t; String l=links[i]; links[i]=links[j]; links[j]=l; }
+// Legge il feed f in dst: GET condizionale (ETag/Last-Modified), stream a blocchi da RSS_CHUNK
+// byte, stop al limite del feed. Su 304 o errore ricopia gli item del feed dal set precedente.
+static int fetchFeed(uint8_t f, const FeedConfig &cfg, NewsStore &dst, const NewsStore &prev) {
+  FeedStats &st = g_feedStats[f];
+  const bool sameUrl = st.url == cfg.url;
+  if (!sameUrl) { st = FeedStats(); st.url = cfg.url; }              // riga cambiata in WebUI
+  else if (st.limit != cfg.limit) { st.etag = ""; st.lastModified = ""; }   // il 304 non basta più
+  st.limit = cfg.limit;
+  const uint32_t t0 = millis();
+  const uint32_t heap0 = ESP.getFreeHeap();
+  uint32_t heapLow = heap0;
+  st.requests++;
+
+  HTTPClient http; http.setTimeout(8000);
+  http.useHTTP10(true);                      // niente chunked encoding: lo stream è il body XML
+  static const char *VALIDATORS[] = { "ETag", "Last-Modified" };
+  if (!http.begin(cfg.url)) { st.errors++; st.lastCode = -1; return keepPrevFeed(st, f, sameUrl, dst, prev); }
+  http.collectHeaders(VALIDATORS, 2);
+  if (st.etag.length())         http.addHeader("If-None-Match", st.etag);
+  if (st.lastModified.length()) http.addHeader("If-Modified-Since", st.lastModified);
+  int code = http.GET();
+  st.lastCode = code;
+
+  if (code == HTTP_CODE_NOT_MODIFIED) {
+    http.end();
+    st.notModified++; st.lastBytes = 0; st.lastMs = millis() - t0;
+    st.lastItems = keepPrevFeed(st, f, sameUrl, dst, prev);
+    Serial.printf("[RSS] %s: 304 item=%d ms=%lu\n", cfg.url.c_str(), st.lastItems, (unsigned long)st.lastMs);
+    return st.lastItems;
+  }
+  if (!isHttpOk(code)) {
+    http.end();
+    st.errors++; st.lastBytes = 0; st.lastMs = millis() - t0;
+    st.lastItems = keepPrevFeed(st, f, sameUrl, dst, prev);   // meglio le notizie di prima che un feed vuoto
+    Serial.printf("[RSS] %s: HTTP %d, tenuti %d item\n", cfg.url.c_str(), code, st.lastItems);
+    return st.lastItems;
+  }
+  String etag = http.header("ETag"), lastMod = http.header("Last-Modified");
+
+  RssStreamParser parser(dst, f, cfg.limit);
+  WiFiClient *stream = http.getStreamPtr();
+  int remaining = http.getSize();            // -1 se il server non manda Content-Length
+  uint8_t buf[RSS_CHUNK];
+  uint32_t lastData = millis();
+  bool cut = false;                          // body interrotto (timeout) o store pieno
+  while (remaining != 0) {
+    if (dst.full()) { cut = true; break; }
+    size_t avail = stream->available();
+    if (!avail) {
+      if (!http.connected()) break;
+      if (millis() - lastData > 8000) { cut = true; break; }
+      delay(1); continue;
+    }
+    int n = stream->readBytes(buf, min(avail, sizeof(buf)));
+    if (n <= 0) { cut = true; break; }
+    lastData = millis();
+    if (remaining > 0) remaining -= min(remaining, n);
+    uint32_t h = ESP.getFreeHeap(); if (h < heapLow) heapLow = h;
+    if (!parser.feed(buf, n)) break;         // limite raggiunto: il resto del feed non si scarica
   }
+  http.end();
+
+  // Validatori solo se il feed è entrato tutto: un 304 successivo ricopia da qui
+  if (cut) { st.etag = ""; st.lastModified = ""; }
+  else     { st.etag = etag; st.lastModified = lastMod; }
+  st.lastBytes = parser.bytes; st.totalBytes += parser.bytes;
+  st.lastMs = millis() - t0; st.lastItems = parser.added;
+  Serial.printf("[RSS] %s: item=%d byte=%lu ms=%lu heap picco=%lu\n",
+                cfg.url.c_str(), parser.added, (unsigned long)parser.bytes,
+                (unsigned long)st.lastMs, (unsigned long)(heap0 - heapLow));
+  return parser.added;
 }
 
-// Scarica e consolida tutti i feed secondo config, quindi azzera la pagina corrente
-static void refreshAllFeeds() {
-  itemCount = 0;
+// Costruisce in dst il nuovo set di notizie (tutti i feed configurati); prev è il set a schermo
+static void refreshAllFeeds(NewsStore &dst, const NewsStore &prev) {
+  const uint32_t t0 = millis();
+  dst.clear();
   FeedConfig cfg[MAX_FEEDS]; int n=0; loadFeedConfig(cfg, n);
   for (int f=0; f<n; ++f) {
-    const String &url = cfg[f].url; int lim = max(1, cfg[f].limit);
-    if (!url.length()) continue;
-    HTTPClient http; http.setTimeout(8000);
-    if (!http.begin(url)) continue;
-    int code = http.GET();
-    if (!isHttpOk(code)) { http.end(); continue; }
-    String body = http.getString(); http.end();
-    parseFeedItemsLimited(body, lim);
-    if (itemCount >= MAX_ITEMS) break;
-  }
-  shuffleItems();
-  currentPage = 0; lastPageSwitch = millis();
+    if (!cfg[f].url.length()) continue;
+    fetchFeed(f, cfg[f], dst, prev);
+    if (dst.full()) break;
+  }
+  dst.shuffle();
+  g_lastRefreshMs = millis() - t0; g_lastRefreshAt = millis();
+  Serial.printf("[RSS] refresh: item=%d/%d arena=%lu/%lu byte ms=%lu\n", dst.count, MAX_ITEMS,
+                (unsigned long)dst.used, (unsigned long)dst.cap, (unsigned long)g_lastRefreshMs);
+}
+
+// Task dei feed: refresh fuori dal loop, poi scambio dei buffer sotto mutex
+static void feedTask(void*) {
+  for (;;) {
+    if (WiFi.status() != WL_CONNECTED) { ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(5000)); continue; }
+    refreshAllFeeds(*g_back, *g_front);
+    xSemaphoreTake(g_newsMutex, portMAX_DELAY);
+    NewsStore *t = g_front; g_front = g_back; g_back = t;
+    xSemaphoreGive(g_newsMutex);
+    g_newsSwapped = true;
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(REFRESH_INTERVAL_MS));   // periodo o richiesta WebUI
+  }
+}
+
+static void requestFeedRefresh() { if (g_feedTask) xTaskNotifyGive(g_feedTask); }
+
+// Core 0 (il loop Arduino gira sul core 1): stack ampio per TLS
+static void startFeedTask() {
+  if (g_feedTask) return;
+  xTaskCreatePinnedToCore(feedTask, "feeds", 12288, nullptr, 1, &g_feedTask, 0);
 }
 
 // =========================== Render della pagina di news ===========================
-// Ridisegna intero frame: header + 4 titoli impaginati con separatori verdi
+// Header + 4 titoli impaginati con separatori verdi, disegnati sopra la pagina precedente:
+// niente fillScreen (lo schermo non passa dal nero), i box senza titolo si ripuliscono
 static void drawNewsPage(int pageIdx) {
-  gfx->fillScreen(RGB565_BLACK);
+  DS_REFRESH_SCOPE("pagina");
+  xSemaphoreTake(g_newsMutex, portMAX_DELAY);        // il task dei feed non scambia durante il disegno
+  const NewsStore &news = *g_front;
+  if (!g_scrPage) { gfx->fillScreen(RGB565_BLACK); g_scrPage = true; g_scrHeader = false; }
   drawHeader();
   for (int i=0; i<ITEMS_PER_PAGE; ++i) {
     int itemIdx = pageIdx * ITEMS_PER_PAGE + i;
-    if (itemCount == 0 || itemIdx >= itemCount) break;
+    bool has = itemIdx < news.count;
     int by = PAGE_Y + i * ITEM_BOX_H;
-    if (i > 0) gfx->drawLine(PAGE_X, by, PAGE_X + PAGE_W, by, RGB565_GREEN);
-    drawWrappedInBox(PAGE_X, by, PAGE_W, ITEM_BOX_H, titles[itemIdx]);
+    if (i > 0) gfx->drawLine(PAGE_X, by, PAGE_X + PAGE_W, by, has ? RGB565_GREEN : RGB565_BLACK);
+    String title = has ? String(news.title(itemIdx))
+                 : (news.count == 0 && i == 0) ? String("Aggiornamento notizie...") : String();
+    drawWrappedInBox(PAGE_X, by, PAGE_W, ITEM_BOX_H, title);
   }
-  int totalPages = (itemCount + ITEMS_PER_PAGE - 1) / ITEMS_PER_PAGE; if (totalPages == 0) totalPages = 1;
+  int totalPages = (news.count + ITEMS_PER_PAGE - 1) / ITEMS_PER_PAGE; if (totalPages == 0) totalPages = 1;
+  xSemaphoreGive(g_newsMutex);
   char buf[32]; snprintf(buf, sizeof(buf), "%d/%d", (pageIdx % totalPages) + 1, totalPages);
   gfx->setTextSize(1); gfx->setTextColor(RGB565_WHITE, RGB565_BLACK); gfx->setCursor(440, 470); gfx->print(buf);
+  int w = strlen(buf) * BASE_CHAR_W;
+  if (w < 40) gfx->fillRect(440 + w, 470, 40 - w, BASE_CHAR_H, RGB565_BLACK);   // "10/12" -> "1/12"
   gfx->setTextSize(TEXT_SCALE);
 }
 
 // =========================== Ciclo di vita: setup/loop ===========================
-// Setup: avvia pannello, tenta STA, altrimenti AP. In STA: tempo NTP, WebUI, primo fetch.
+// Setup: pannello e pagina vuota subito; Wi-Fi, portale e ora arrivano dal loop (bootPoll)
 void setup() {
   Serial.begin(115200);
-  backlightOn(); panelKickstart();
+  bootPanel(gfx, GFX_BL, PWM_CHANNEL, PWM_FREQ, PWM_BITS);
+  bootStart(STA_TIMEOUT_MS, GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER);
   randomSeed(esp_timer_get_time());
-  gfx->fillScreen(RGB565_BLACK);
-  drawBoldTextColored(16, 36, "Connessione alla rete...", RGB565_WHITE, RGB565_BLACK);
 
-  if (!tryConnectSTA(8000)) {
-    startAPWithPortal();
-  } else {
-    startSTAWebUI();
-    syncTimeFromNTP();
-    refreshAllFeeds(); lastRefresh = millis();
-    drawNewsPage(currentPage);
-  }
+  int ph = bootPhaseBegin("arena");
+  g_newsMutex = xSemaphoreCreateMutex();
+  if (!g_storeA.begin() || !g_storeB.begin()) Serial.println("[RSS] memoria insufficiente per l'arena delle notizie");
+  bootPhaseEnd(ph);
+
+  drawNewsPage(currentPage);          // "Aggiornamento notizie..." finché il task non ha un set
+  bootMark("primo frame");
 }
 
-// Loop: gestisce captive o WebUI, riconnessioni, refresh immediati e periodici, paging
+// Loop: eventi di avvio, captive o WebUI, nuovi set dal task dei feed, paging.
+// Senza rete il paging continua sull'ultimo set; la riconnessione la tenta BootSeq.h.
 void loop() {
+  switch (bootPoll()) {
+    case BOOT_ONLINE: startSTAWebUI(); startFeedTask(); break;   // primo refresh in background
+    case BOOT_PORTAL: startAPWithPortal(); break;
+    case BOOT_TIME:   g_timeSynced = true; break;                // orologio al prossimo controllo
+    case BOOT_BACK:   requestFeedRefresh(); break;               // il task non aspetta i 5 s
+    default: break;
+  }
+
   if (WiFi.getMode() == WIFI_AP) {
     dnsServer.processNextRequest();
     web.handleClient();
@@ -702,33 +1120,25 @@ void loop() {
 
   web.handleClient();
 
-  if (WiFi.status() != WL_CONNECTED) {
-    static uint32_t nextTry = 0;
-    if (millis() > nextTry) {
-      nextTry = millis() + 5000;
-      if (tryConnectSTA(5000)) { if (!g_timeSynced) syncTimeFromNTP(); }
-    }
-    delay(40);
-    return;
-  }
-
-  if (g_rssRefreshPending) {
-    g_rssRefreshPending = false;
-    refreshAllFeeds();
-    drawNewsPage(currentPage);
-  }
-
-  if (millis() - lastRefresh >= REFRESH_INTERVAL_MS) {
-    lastRefresh = millis();
-    refreshAllFeeds();
+  if (g_newsSwapped) {                // nuovo set dal task dei feed: si riparte da pagina 1
+    g_newsSwapped = false;
+    bootMark("primi feed");
+    currentPage = 0; lastPageSwitch = millis();
     drawNewsPage(currentPage);
   }
 
   if (millis() - lastPageSwitch >= PAGE_DURATION_MS) {
     lastPageSwitch = millis();
-    int totalPages = (itemCount + ITEMS_PER_PAGE - 1) / ITEMS_PER_PAGE; if (totalPages == 0) totalPages = 1;
+    int totalPages = (g_front->count + ITEMS_PER_PAGE - 1) / ITEMS_PER_PAGE; if (totalPages == 0) totalPages = 1;
     currentPage = (currentPage + 1) % totalPages;
     drawNewsPage(currentPage);
   }
+
+  // Orologio: controllo ogni secondo, disegno solo quando cambia il minuto
+  static uint32_t lastClockCheck = 0;
+  if (g_scrPage && millis() - lastClockCheck >= 1000) {
+    lastClockCheck = millis();
+    drawHeader();
+  }
   delay(5);
 }
@@ -11,6 +11,11 @@
   - Web UI /route: from/to, refresh (60–3600), preset (NVS JSON)
   - Captive portal Wi‑Fi se mancano credenziali
   - Touch GT911: tap singolo cicla preset temporanei (senza scrivere in NVS)
+  - Cache tabelle: un task sul core 0 tiene aggiornata una tabella per rotta base e
+    per ogni preset (connessione TLS riusata), il tap disegna subito dalla cache
+  - Disegno a celle: testo da atlante di glifi (TextAtlas.h), si ridisegna solo ciò che cambia
+  - Avvio non bloccante (BootSeq.h): primo schermo subito, Wi‑Fi/portale/SNTP dal loop,
+    tempi delle fasi su Serial e su /boot
 */
 
 #include <Arduino.h>
@@ -22,6 +27,13 @@
 #include <HTTPClient.h>
 #include <WiFiClientSecure.h>
 #include <Arduino_GFX_Library.h>
+
+// Contatori di disegno su Serial (1 = attivi, 0 = nessun costo)
+#define DRAW_STATS 0
+#include <DrawStats.h>
+#include <TextAtlas.h>
+#include <WebChunk.h>
+#include <BootSeq.h>
 #include <time.h>
 #include <ArduinoJson.h>
 #include <TAMC_GT911.h>
@@ -36,7 +48,8 @@
 static const char* NTP_SERVER = "pool.ntp.org";
 static const long   GMT_OFFSET_SEC      = 3600;   // UTC+1
 static const int    DAYLIGHT_OFFSET_SEC = 3600;   // DST
-static bool g_timeSynced = false;
+static const uint32_t STA_TIMEOUT_MS = 8000;       // poi portale AP
+static bool g_timeSynced = false;                   // primo sync SNTP arrivato (BootSeq.h)
 
 // =========================== Palette / metrica testo ==========================
 #define RGB565_BLACK   0x0000
@@ -73,12 +86,13 @@ static const int COL4_X      = 400;   // CAMBI
 #define TOUCH_MAP_Y2  0
 
 // =========================== Dati riga tabella ================================
+// Campi a larghezza fissa: niente String sull'heap per ogni riga
 struct Row {
-  String timeHHMM;     // orario HH:MM
-  String line;         // etichetta linea (es. IC 21 / RE 8 / numero)
-  String duration;     // stringa durata formattata
-  String transfers;    // numero cambi -> stringa
-  int    delayMin = 0; // ritardo stimato in minuti
+  char timeHHMM[6];    // orario HH:MM
+  char line[16];       // etichetta linea (es. IC 21 / RE 8 / numero), troncata
+  char duration[8];    // durata formattata (XhYm / Xm)
+  char transfers[4];   // numero cambi
+  int  delayMin = 0;   // ritardo stimato in minuti
 };
 
 // =========================== Bus / pannello RGB ===============================
@@ -99,7 +113,7 @@ Arduino_ESP32RGBPanel *rgbpanel = new Arduino_ESP32RGBPanel(
   /* useBigEndian */ false, 0, 0, 0
 );
 
-Arduino_RGB_Display *gfx = new Arduino_RGB_Display(
+DrawStatsDisplay *gfx = new DrawStatsDisplay(
   480, 480, rgbpanel, 0, true, bus, GFX_NOT_DEFINED,
   st7701_type9_init_operations, sizeof(st7701_type9_init_operations)
 );
@@ -132,65 +146,64 @@ static int      g_touchPresetIdx = -1; // -1 = route base
 DNSServer dnsServer;
 WebServer  web(80);
 Preferences prefs;         // credenziali Wi‑Fi
-String sta_ssid, sta_pass, ap_ssid, ap_pass;
+String ap_ssid, ap_pass;
 const byte DNS_PORT = 53;
 
 // =========================== Route / API config ===============================
 Preferences routePrefs;     // namespace "route"
 String g_from = "Bellinzona";
 String g_to   = "Lugano";
-String g_apiUrl;            // URL costruita da buildApiUrl()
-static const int ROWS_MAX = 11;
+static const int ROWS_MAX = 11;           // righe in tabella (11 riempiono l'area dati)
+static const int API_LIMIT = (ROWS_MAX + 5 < 16) ? ROWS_MAX + 5 : 16;  // connessioni per pagina (API: max 16)
+static const int API_PAGES = 4;           // pagine 0..3: finestra fino a 64 connessioni
+static const size_t CONN_DOC_SIZE = 2048; // documento JSON di una sola connessione filtrata
 static volatile bool g_routeChanged = false;
 static uint32_t g_refreshSec = 300; // [60..3600]
-static uint32_t g_lastFetchMs = 0;
 
 // =========================== Preset (NVS) =====================
 struct Preset { String label, from, to; };
 static const int MAX_PRESETS = 12;
 Preset g_presets[MAX_PRESETS];
 int g_presetCount = 0;
+static WebFrag g_presetsFrag;    // lista preset già in HTML per /route: si rifà quando cambia l'NVS "presets"
+
+// =========================== Cache tabelle ====================
+// Slot [0] = rotta base (NVS), [1+i] = preset i. Scarica boardTask (core 0), il loop disegna.
+struct Board {
+  char     from[64], to[64];
+  Row      rows[ROWS_MAX];
+  int      count = 0;
+  uint32_t fetchedMs = 0;    // ultimo fetch riuscito, 0 = mai
+  uint32_t dueMs = 0;        // prossimo refresh programmato
+  uint32_t version = 0;      // +1 a ogni esito: il loop ridisegna se è la tabella mostrata
+  uint16_t gen = 0;          // +1 quando cambia la rotta: un fetch in volo viene scartato
+  int8_t   err = 0;          // ultimo esito: 0 ok, 1 Wi-Fi, 2 HTTP/JSON
+  bool     used = false;
+  bool     urgent = false;   // in coda prima delle scadenze (tap, salvataggio da Web)
+};
+static const int BOARD_BASE = 0;
+static const int BOARDS = MAX_PRESETS + 1;
+static const uint32_t API_DAILY_BUDGET = 900;   // richieste/giorno per tutte le tabelle (API: 1000)
+static const uint32_t TAP_REFRESH_AGE_MS = 60000; // al tap si riscarica solo se più vecchia
+static Board g_boards[BOARDS];
+static SemaphoreHandle_t g_boardMutex = nullptr;
+static TaskHandle_t g_boardTask = nullptr;
+static volatile int g_shownSlot = BOARD_BASE;
+static uint32_t g_shownVersion = 0;
+
+// Contatori: tap serviti dalla cache e latenza tap -> tabella a schermo
+static uint32_t g_tapCount = 0, g_tapHits = 0;
+static uint32_t g_tapPaintN = 0, g_tapPaintSumMs = 0, g_tapPaintMaxMs = 0;
+static uint32_t g_tapPendingMs = 0;             // tap non in cache in attesa del fetch (0 = nessuno)
+static volatile uint32_t g_apiRequests = 0, g_apiReused = 0;
 
 // =========================== Prototipi ========================
-static bool   fetchDepartures(Row* outRows, int &count);
+static bool   fetchDepartures(const String& url, Row* outRows, int &count);
 static void   initTouch(bool showOverlay=true);
 static bool   touchTapDetected();
 static void   applyPresetByIndex(int idx);
 
 // =========================== Helpers disegno ==================
-static void backlightOn() {
-  ledcSetup(PWM_CHANNEL, PWM_FREQ, PWM_BITS);
-  ledcAttachPin(GFX_BL, PWM_CHANNEL);
-  ledcWrite(PWM_CHANNEL, 255);
-}
-
-static void panelKickstart() {
-  delay(50);
-  gfx->begin();
-  gfx->setRotation(0);
-  delay(120);
-  gfx->displayOn();
-  delay(20);
-  gfx->fillScreen(RGB565_BLACK);
-  delay(60);
-}
-
-static bool waitForValidTime(uint32_t timeoutMs = 8000) {
-  uint32_t t0 = millis();
-  time_t now = 0; struct tm info;
-  while ((millis() - t0) < timeoutMs) {
-    time(&now); localtime_r(&now, &info);
-    if (info.tm_year + 1900 > 2020) return true;
-    delay(200);
-  }
-  return false;
-}
-
-static void syncTimeOnce() {
-  configTime(GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER);
-  g_timeSynced = waitForValidTime();
-}
-
 static String fmtDateTime() {
   if (!g_timeSynced) return "";
   time_t now; struct tm ti; time(&now); localtime_r(&now, &ti);
@@ -209,98 +222,120 @@ static String normalize(const String& in) {
   return s;
 }
 
+// Testo bold dall'atlante: un blit per glifo invece di quattro print sovrapposte
 static void drawBoldTextColored(int16_t x, int16_t y, const String& raw, uint16_t fg, uint16_t bg) {
   String s = normalize(raw);
-  gfx->setTextSize(TEXT_SCALE);
-  gfx->setTextColor(fg, bg);
-  gfx->setCursor(x+1, y);   gfx->print(s);
-  gfx->setCursor(x,   y+1); gfx->print(s);
-  gfx->setCursor(x+1, y+1); gfx->print(s);
-  gfx->setCursor(x,   y);   gfx->print(s);
+  drawAtlasText(gfx, x, y, s.c_str(), fg, bg, true);
 }
 
+// Cosa c'è a schermo: header, barra rotta, intestazioni e righe si ridisegnano solo dove cambiano
+static bool   g_scrHeader    = false;        // fondo + titolo
+static String g_scrClock;                    // data/ora mostrata
+static bool   g_scrRouteOk   = false;
+static String g_scrRoute, g_scrAge;          // barra rotta: testo e età della tabella
+static bool   g_scrSubHeader = false;
+static Row    g_scrRows[ROWS_MAX];
+static int    g_scrRowCount  = -1;           // -1: nell'area dati non c'è una tabella
+
 static void drawHeader() {
-  gfx->fillRect(0, 0, 480, HEADER_H, RGB565_RED);
-  drawBoldTextColored(16, 16, "Partenze di oggi", RGB565_WHITE, RGB565_RED);
-  String dt = fmtDateTime();
-  if (dt.length()) {
-    int w = dt.length() * CHAR_W;
-    int x = 480 - w - 16;
-    drawBoldTextColored(x, 16, dt, RGB565_WHITE, RGB565_RED);
+  if (!g_scrHeader) {
+    gfx->fillRect(0, 0, 480, HEADER_H, RGB565_RED);
+    drawBoldTextColored(16, 16, "Partenze di oggi", RGB565_WHITE, RGB565_RED);
+    g_scrHeader = true;
+    g_scrClock = "";
   }
+  String dt = fmtDateTime();
+  if (dt == g_scrClock) return;
+  // Allineato a destra: se il nuovo testo è più corto si ripulisce solo l'avanzo a sinistra
+  int oldW = g_scrClock.length() * CHAR_W;
+  int w    = dt.length() * CHAR_W;
+  if (oldW > w) gfx->fillRect(480 - oldW - 16, 16, oldW - w, TA_BOLD_H, RGB565_RED);
+  if (w) drawBoldTextColored(480 - w - 16, 16, dt, RGB565_WHITE, RGB565_RED);
+  g_scrClock = dt;
 }
 
 static void drawRouteBar() {
-  gfx->fillRect(0, HEADER_H, 480, ROUTE_H, RGB565_RED);
-  gfx->setTextSize(2);
-  gfx->setTextColor(RGB565_WHITE, RGB565_RED);
-  int y = HEADER_H + (ROUTE_H - 25) / 2;
-  gfx->setCursor(16, y);
-  gfx->print(normalize(g_from) + " -> " + normalize(g_to));
+  String route = normalize(g_from) + " -> " + normalize(g_to);
+  const int y = HEADER_H + (ROUTE_H - 25) / 2;
+
+  // Età della tabella mostrata, allineata a destra
+  char age[16] = "";
+  uint32_t fetched = g_boards[g_shownSlot].fetchedMs;
+  if (fetched) {
+    uint32_t min = (millis() - fetched) / 60000UL;
+    if (min == 0)      strlcpy(age, "<1 min fa", sizeof(age));
+    else if (min < 60) snprintf(age, sizeof(age), "%lu min fa", (unsigned long)min);
+    else               snprintf(age, sizeof(age), "%luh fa", (unsigned long)(min / 60));
+  }
+  const size_t ageLen = strlen(age);
+
+  // Età più corta di prima: il riquadro vecchio copriva parte della rotta, si rifà tutto
+  if (!g_scrRouteOk || route != g_scrRoute || ageLen < g_scrAge.length()) {
+    gfx->fillRect(0, HEADER_H, 480, ROUTE_H, RGB565_RED);
+    drawAtlasText(gfx, 16, y, route.c_str(), RGB565_WHITE, RGB565_RED, false);
+    g_scrRoute = route; g_scrRouteOk = true;
+    g_scrAge = "";
+  }
+  if (!ageLen || g_scrAge == age) return;
+  int w = ageLen * CHAR_W;
+  gfx->fillRect(480 - w - 24, HEADER_H, w + 24, ROUTE_H, RGB565_RED);
+  drawAtlasText(gfx, 480 - w - 16, y, age, RGB565_WHITE, RGB565_RED, false);
+  g_scrAge = age;
 }
 
 static void drawSubHeader() {
+  if (g_scrSubHeader) return;                // etichette fisse
   gfx->fillRect(0, HEADER_H + ROUTE_H, 480, SUBHDR_H, RGB565_BLACK);
-  gfx->setTextSize(TEXT_SCALE);
-  gfx->setTextColor(RGB565_WHITE, RGB565_BLACK);
   int y = HEADER_H + ROUTE_H + (SUBHDR_H - CHAR_H) / 2;
-  gfx->setCursor(COL1_X, y); gfx->print("ORA");
-  gfx->setCursor(COL2_X, y); gfx->print("LINEA");
-  gfx->setCursor(COL3_X, y); gfx->print("DURATA");
-  gfx->setCursor(COL4_X, y); gfx->print("CAMBI");
+  drawAtlasText(gfx, COL1_X, y, "ORA",    RGB565_WHITE, RGB565_BLACK, false);
+  drawAtlasText(gfx, COL2_X, y, "LINEA",  RGB565_WHITE, RGB565_BLACK, false);
+  drawAtlasText(gfx, COL3_X, y, "DURATA", RGB565_WHITE, RGB565_BLACK, false);
+  drawAtlasText(gfx, COL4_X, y, "CAMBI",  RGB565_WHITE, RGB565_BLACK, false);
   gfx->drawLine(10, HEADER_H + ROUTE_H + SUBHDR_H - 2, 470, HEADER_H + ROUTE_H + SUBHDR_H - 2, RGB565_DKGREY);
+  g_scrSubHeader = true;
 }
 
 static void clearContentArea() { gfx->fillRect(0, CONTENT_Y, 480, 480 - CONTENT_Y, RGB565_BLUE); }
 
-static void drawRow(int row, const String& t, const String& line, const String& dur, const String& tr) {
-  int y = CONTENT_Y + 8 + row * ROW_H;
-  if (row > 0) gfx->drawLine(10, y - 6, 470, y - 6, RGB565_WHITE);
-  gfx->setTextSize(TEXT_SCALE);
-  gfx->setCursor(COL1_X, y); gfx->print(t);
-  gfx->setCursor(COL2_X, y); gfx->print(line);
-  gfx->setCursor(COL3_X, y); gfx->print(dur);
-  gfx->setCursor(COL4_X, y); gfx->print(tr);
+// Celle della tabella: larghezza = fino alla colonna dopo (il testo più lungo si tronca)
+static const int CELL_X[4] = { COL1_X, COL2_X, COL3_X, COL4_X };
+static const int CELL_W[4] = { COL2_X - COL1_X - 2, COL3_X - COL2_X - 2, COL4_X - COL3_X - 2, 480 - COL4_X - 10 };
+
+static const char* rowCell(const Row& r, int c) {
+  switch (c) {
+    case 0:  return r.timeHHMM;
+    case 1:  return r.line;
+    case 2:  return r.duration;
+    default: return r.transfers;
+  }
 }
 
 static void drawStatus(const char* msg) {
   clearContentArea();
-  gfx->setTextSize(TEXT_SCALE);
-  gfx->setTextColor(RGB565_WHITE, RGB565_BLACK);
-  gfx->setCursor(16, CONTENT_Y + 10);
-  gfx->print(msg);
+  drawAtlasText(gfx, 16, CONTENT_Y + 10, msg, RGB565_WHITE, RGB565_BLACK, false);
+  g_scrRowCount = -1;
 }
 
-static void forceRedrawNow() {
-  drawHeader();
-  drawRouteBar();
-  drawSubHeader();
-  // Fetch immediato dopo header/route
-  // (mantiene identica la sequenza visiva originale)
-  //
-  // Nota: la logica di fetch rimane invariata.
-  extern void doFetchAndRedraw();
-  doFetchAndRedraw();
-}
-
-// =========================== Wi‑Fi base (STA) ==================
-static bool tryConnectSTA(uint32_t timeoutMs = 8000) {
-  prefs.begin("wifi", true);
-  sta_ssid = prefs.getString("ssid", "");
-  sta_pass = prefs.getString("pass", "");
-  prefs.end();
-  if (sta_ssid.isEmpty()) return false;
-
-  WiFi.persistent(false);
-  WiFi.mode(WIFI_STA);
-  WiFi.setSleep(false);
-  WiFi.begin(sta_ssid.c_str(), sta_pass.c_str());
-  uint32_t t0 = millis();
-  while ((millis() - t0) < timeoutMs) {
-    if (WiFi.status() == WL_CONNECTED) return true;
-    delay(100);
+// Porta a schermo le righe confrontandole con quelle già mostrate: si ridisegnano solo le
+// celle cambiate (testo o colore ritardo), opache su blu, senza ripulire prima l'area
+static void drawRows(const Row* rows, int n) {
+  if (g_scrRowCount < 0) { clearContentArea(); g_scrRowCount = 0; }
+  const int old = g_scrRowCount;
+  const int last = n > old ? n : old;
+  for (int i = 0; i < last; ++i) {
+    const int y = CONTENT_Y + 8 + i * ROW_H;
+    if (i >= n) { gfx->fillRect(0, y - 6, 480, ROW_H, RGB565_BLUE); continue; }   // riga sparita
+    if (i >= old && i > 0) gfx->drawLine(10, y - 6, 470, y - 6, RGB565_WHITE);
+    const bool late = rows[i].delayMin > 0;
+    for (int c = 0; c < 4; ++c) {
+      if (i < old && (g_scrRows[i].delayMin > 0) == late &&
+          strcmp(rowCell(g_scrRows[i], c), rowCell(rows[i], c)) == 0) continue;
+      drawAtlasText(gfx, CELL_X[c], y, rowCell(rows[i], c), late ? RGB565_RED : RGB565_WHITE,
+                    RGB565_BLUE, false, CELL_W[c]);
+    }
   }
-  return false;
+  memcpy(g_scrRows, rows, n * sizeof(Row));
+  g_scrRowCount = n;
 }
 
 // =========================== Captive portal ====================
@@ -370,8 +405,8 @@ static void registerWebHandlers(bool portalMode) {
   web.on("/route", HTTP_GET, [](){
     IPAddress ip = (WiFi.getMode()==WIFI_AP) ? WiFi.softAPIP() : WiFi.localIP();
     String ipStr = String(ip[0])+"."+ip[1]+"."+ip[2]+"."+ip[3];
-    extern String buildRoutePage(const String&, const String&);
-    web.send(200, "text/html", buildRoutePage(ipStr, ""));
+    extern void sendRoutePage(const String&, const String&);
+    sendRoutePage(ipStr, "");
   });
 
   web.on("/route", HTTP_POST, [](){
@@ -396,12 +431,10 @@ static void registerWebHandlers(bool portalMode) {
       extern void saveRouteToNVS(const String&, const String&);
       saveRouteToNVS(nf, nt);
       g_from = nf; g_to = nt;
-      extern void buildApiUrl();
-      buildApiUrl();
       g_routeChanged = true;
       g_touchPresetIdx = -1; // torna alla route base
 
-      notice = "Impostazioni salvate – aggiornamento schermo in corso. Percorso: <b>" + nf + " → " + nt + "</b> | Refresh: <b>" + String(g_refreshSec) + " s</b>";
+      notice = "Impostazioni salvate – aggiornamento schermo in corso. Percorso: <b>" + htmlEscape(nf) + " → " + htmlEscape(nt) + "</b> | Refresh: <b>" + String(g_refreshSec) + " s</b>";
     }
     else if (action == "save_preset") {
       int idx = web.hasArg("id") ? web.arg("id").toInt() : -1;
@@ -411,14 +444,16 @@ static void registerWebHandlers(bool portalMode) {
       label.trim(); pf.trim(); pt.trim();
       extern bool addOrUpdatePreset(int, const String&, const String&, const String&);
       extern void savePresetsToNVS();
-      if (addOrUpdatePreset(idx, label, pf, pt)) { savePresetsToNVS(); notice = "Preset salvato: <b>"+label+"</b>"; }
+      extern void syncPresetBoards();
+      if (addOrUpdatePreset(idx, label, pf, pt)) { savePresetsToNVS(); syncPresetBoards(); notice = "Preset salvato: <b>"+htmlEscape(label)+"</b>"; }
       else { notice = "Errore: preset non salvato (campi vuoti o limite raggiunto)."; }
     }
     else if (action == "delete_preset") {
       int idx = web.hasArg("id") ? web.arg("id").toInt() : -1;
       extern bool deletePreset(int);
       extern void savePresetsToNVS();
-      if (deletePreset(idx)) { savePresetsToNVS(); notice = "Preset eliminato."; }
+      extern void syncPresetBoards();
+      if (deletePreset(idx)) { savePresetsToNVS(); syncPresetBoards(); notice = "Preset eliminato."; }
       else { notice = "Errore: impossibile eliminare il preset."; }
     }
     else if (action == "apply_preset") {
@@ -427,12 +462,10 @@ static void registerWebHandlers(bool portalMode) {
         g_from = g_presets[idx].from;
         g_to   = g_presets[idx].to;
         extern void saveRouteToNVS(const String&, const String&);
-        extern void buildApiUrl();
         saveRouteToNVS(g_from, g_to);
-        buildApiUrl();
         g_routeChanged = true;
         g_touchPresetIdx = -1; // applicazione via Web = base
-        notice = "Preset applicato: <b>"+g_presets[idx].label+"</b>. Aggiornamento schermo in corso.";
+        notice = "Preset applicato: <b>"+htmlEscape(g_presets[idx].label)+"</b>. Aggiornamento schermo in corso.";
       } else {
         notice = "Errore: preset non valido.";
       }
@@ -440,8 +473,14 @@ static void registerWebHandlers(bool portalMode) {
 
     IPAddress ip = (WiFi.getMode()==WIFI_AP) ? WiFi.softAPIP() : WiFi.localIP();
     String ipStr = String(ip[0])+"."+ip[1]+"."+ip[2]+"."+ip[3];
-    extern String buildRoutePage(const String&, const String&);
-    web.send(200, "text/html", buildRoutePage(ipStr, notice));
+    extern void sendRoutePage(const String&, const String&);
+    sendRoutePage(ipStr, notice);
+  });
+
+  web.on("/boot", HTTP_GET, [](){
+    char buf[BOOT_MAX_PHASES * 56];
+    bootFormatTimeline(buf, sizeof(buf));
+    web.send(200, "text/plain; charset=utf-8", buf);
   });
 
   if (portalMode) {
@@ -468,6 +507,7 @@ static void loadPresetsFromNVS() {
   Preferences pv; pv.begin("presets", true);
   String raw = pv.getString("list", "");
   pv.end();
+  g_presetsFrag.invalidate();
 
   g_presetCount = 0;
   if (!raw.length()) return;
@@ -508,6 +548,7 @@ static void savePresetsToNVS() {
   String out; serializeJson(doc, out);
   Preferences pv; pv.begin("presets", false);
   pv.putString("list", out); pv.end();
+  g_presetsFrag.invalidate();      // la lista nella pagina /route va rifatta
 }
 
 static bool addOrUpdatePreset(int idx, const String& label, const String& from, const String& to) {
@@ -535,21 +576,20 @@ static String urlEncodeSpaces(const String &s) {
   return out;
 }
 
-static void buildApiUrl() {
-  String fromEnc = urlEncodeSpaces(g_from);
-  String toEnc   = urlEncodeSpaces(g_to);
-  g_apiUrl  = "https://transport.opendata.ch/v1/connections";
-  g_apiUrl += "?from=" + fromEnc + "&to=" + toEnc + "&limit=" + String(ROWS_MAX + 5);
-  g_apiUrl += "&fields[]=connections/from/departure";
-  g_apiUrl += "&fields[]=connections/from/departureTimestamp";
-  g_apiUrl += "&fields[]=connections/from/prognosis/departure";
-  g_apiUrl += "&fields[]=connections/from/prognosis/departureTimestamp";
-  g_apiUrl += "&fields[]=connections/duration";
-  g_apiUrl += "&fields[]=connections/transfers";
-  g_apiUrl += "&fields[]=connections/products";
-  g_apiUrl += "&fields[]=connections/sections/journey/name";
-  g_apiUrl += "&fields[]=connections/sections/journey/category";
-  g_apiUrl += "&fields[]=connections/sections/journey/number";
+static String apiUrlFor(const String& from, const String& to) {
+  String url = "https://transport.opendata.ch/v1/connections";
+  url += "?from=" + urlEncodeSpaces(from) + "&to=" + urlEncodeSpaces(to) + "&limit=" + String(API_LIMIT);
+  url += "&fields[]=connections/from/departure";
+  url += "&fields[]=connections/from/departureTimestamp";
+  url += "&fields[]=connections/from/prognosis/departure";
+  url += "&fields[]=connections/from/prognosis/departureTimestamp";
+  url += "&fields[]=connections/duration";
+  url += "&fields[]=connections/transfers";
+  url += "&fields[]=connections/products";
+  url += "&fields[]=connections/sections/journey/name";
+  url += "&fields[]=connections/sections/journey/category";
+  url += "&fields[]=connections/sections/journey/number";
+  return url;
 }
 
 static void loadRouteFromNVS() {
@@ -562,7 +602,6 @@ static void loadRouteFromNVS() {
   if (t.length()) g_to   = t;
   if (rs < 60 || rs > 3600) rs = 300;
   g_refreshSec = rs;
-  buildApiUrl();
 }
 
 static void saveRouteToNVS(const String &from, const String &to) {
@@ -573,45 +612,45 @@ static void saveRouteToNVS(const String &from, const String &to) {
 }
 
 // =========================== Helpers orario/linea =============
-static String trimSpaces(String s) {
-  while (s.length() && s[0]==' ') s.remove(0,1);
-  while (s.length() && s[s.length()-1]==' ') s.remove(s.length()-1);
-  return s;
+// Copia src in out (n byte) senza spazi iniziali/finali
+static void copyTrimmed(char* out, size_t n, const char* src) {
+  if (!src) src = "";
+  while (*src == ' ') src++;
+  size_t len = strlen(src);
+  while (len && src[len-1] == ' ') len--;
+  if (len >= n) len = n - 1;
+  memcpy(out, src, len); out[len] = 0;
 }
 
-static String hhmmFromISO(const char* iso) {
-  if (!iso) return "";
+static bool hhmmFromISO(const char* iso, char* out, size_t n) {
+  if (!iso) return false;
   const char* t = strchr(iso, 'T');
-  if (!t || strlen(t) < 6) return "";
-  char hhmm[6] = { t[1], t[2], ':', t[4], t[5], 0 };
-  return String(hhmm);
+  if (!t || strlen(t) < 6) return false;
+  snprintf(out, n, "%c%c:%c%c", t[1], t[2], t[4], t[5]);
+  return true;
 }
 
-static String hhmmFromTimestamp(long ts) {
-  if (ts <= 0) return "";
+static bool hhmmFromTimestamp(long ts, char* out, size_t n) {
+  if (ts <= 0) return false;
   time_t tt = (time_t)ts; struct tm ti; localtime_r(&tt, &ti);
-  char buf[6]; snprintf(buf, sizeof(buf), "%02d:%02d", ti.tm_hour, ti.tm_min);
-  return String(buf);
+  snprintf(out, n, "%02d:%02d", ti.tm_hour, ti.tm_min);
+  return true;
 }
 
-static String extractHHMM(JsonObject conn) {
+static void extractHHMM(JsonObject conn, char* out, size_t n) {
   long ts = (long)(conn["from"]["departureTimestamp"] | 0L);
-  String hhmm = hhmmFromTimestamp(ts);
-  if (!hhmm.length()) {
-    const char* iso = conn["from"]["departure"] | nullptr;
-    hhmm = hhmmFromISO(iso);
-  }
-  if (!hhmm.length()) hhmm = "--:--";
-  return hhmm;
+  if (hhmmFromTimestamp(ts, out, n)) return;
+  const char* iso = conn["from"]["departure"] | nullptr;
+  if (hhmmFromISO(iso, out, n)) return;
+  strlcpy(out, "--:--", n);
 }
 
-static String extractLineLabel(JsonObject conn) {
+static void extractLineLabel(JsonObject conn, char* out, size_t n) {
   if (conn.containsKey("products")) {
     JsonArray prods = conn["products"].as<JsonArray>();
     if (!prods.isNull() && prods.size() > 0) {
-      String p0 = (const char*)(prods[0] | "");
-      p0 = trimSpaces(p0);
-      if (p0.length()) return p0;
+      copyTrimmed(out, n, prods[0] | "");
+      if (out[0]) return;
     }
   }
   JsonArray sections = conn["sections"].as<JsonArray>();
@@ -619,19 +658,19 @@ static String extractLineLabel(JsonObject conn) {
     for (JsonObject sec : sections) {
       JsonObject j = sec["journey"].as<JsonObject>();
       if (!j.isNull()) {
-        String cat = (const char*)(j["category"] | "");
-        String num = (const char*)(j["number"]   | "");
-        String nam = (const char*)(j["name"]     | "");
-        String lab;
-        if (cat.length()) lab += cat;
-        if (num.length()) { if (lab.length()) lab += " "; lab += num; }
-        if (!lab.length() && nam.length()) lab = nam;
-        lab = trimSpaces(lab);
-        if (lab.length()) return lab;
+        const char* cat = j["category"] | "";
+        const char* num = j["number"]   | "";
+        const char* nam = j["name"]     | "";
+        char lab[40];
+        if (*cat && *num) snprintf(lab, sizeof(lab), "%s %s", cat, num);
+        else if (*cat || *num) strlcpy(lab, *cat ? cat : num, sizeof(lab));
+        else strlcpy(lab, nam, sizeof(lab));
+        copyTrimmed(out, n, lab);
+        if (out[0]) return;
       }
     }
   }
-  return "—";
+  strlcpy(out, "—", n);
 }
 
 // =========================== Filtro "entro 60s" ===============
@@ -671,63 +710,328 @@ static int parseDelayMinutes(JsonObject fromObj) {
 }
 
 // =========================== Transport API (fetch) ============
-static bool fetchDepartures(Row* outRows, int &count) {
-  count = 0;
-  if (WiFi.status() != WL_CONNECTED) return false;
+// Corpo della risposta API letto a blocchi da 512 byte: ArduinoJson legge un byte alla volta,
+// qui ogni read() pesca dal blocco. Toglie da sé la codifica chunked di HTTP/1.1 e con finish()
+// consuma il resto del corpo, così la connessione TLS resta buona per la richiesta successiva.
+class ApiBodyStream : public Stream {
+public:
+  ApiBodyStream(WiFiClient& c, bool chunked, int length)
+    : client(c), chunked(chunked), closeDelimited(!chunked && length < 0), left(chunked ? 0 : length) {}
+  int available() override { return (int)(len - pos) + (done ? 0 : client.available()); }
+  int read() override { if (!fill()) return -1; bytes++; return buf[pos++]; }
+  int peek() override { return fill() ? buf[pos] : -1; }
+  size_t write(uint8_t) override { return 0; }
+
+  // Scarta il resto del corpo (al massimo limit byte); true se la connessione è riusabile
+  bool finish(size_t limit) {
+    pos = len;
+    uint32_t t0 = millis();
+    while (!done) {
+      if (fill()) {
+        if (len - pos > limit) return false;
+        limit -= len - pos; pos = len; t0 = millis();
+      } else if (!done) {
+        if (millis() - t0 > 12000) return false;
+        delay(1);
+      }
+    }
+    return !broken && !closeDelimited;
+  }
+  size_t bytes = 0;                        // byte consumati dal parser
+
+private:
+  bool fill() {                            // non bloccante: l'attesa la fa Stream::timedRead()
+    if (pos < len) return true;
+    if (done) return false;
+    if (chunked && left == 0 && !nextChunk()) return false;
+    if (left == 0) { done = true; return false; }
+    int avail = client.available();
+    if (avail <= 0) { if (!client.connected()) { done = true; broken = !closeDelimited; } return false; }
+    size_t want = min((size_t)avail, sizeof(buf));
+    if (left > 0 && (size_t)left < want) want = (size_t)left;
+    int n = client.read(buf, want);
+    if (n <= 0) return false;
+    pos = 0; len = (size_t)n;
+    if (left > 0) left -= n;
+    return true;
+  }
+  int timedByte() {
+    uint32_t t0 = millis();
+    while (millis() - t0 < 12000) {
+      if (client.available()) return client.read();
+      if (!client.connected()) return -1;
+      delay(1);
+    }
+    return -1;
+  }
+  // Intestazione "<hex>[;ext]\r\n" del blocco successivo; il blocco 0 chiude il corpo
+  bool nextChunk() {
+    int c;
+    if (inChunks && (timedByte() != '\r' || timedByte() != '\n')) return fail();
+    inChunks = true;
+    long size = 0; bool any = false;
+    while ((c = timedByte()) >= 0 && isxdigit(c)) { size = size * 16 + (isdigit(c) ? c - '0' : (tolower(c) - 'a' + 10)); any = true; }
+    while (c >= 0 && c != '\n') c = timedByte();
+    if (!any || c < 0) return fail();
+    if (size == 0) {                       // eventuali trailer fino alla riga vuota
+      int lineLen = 0;
+      while ((c = timedByte()) >= 0) {
+        if (c == '\n') { if (lineLen == 0) break; lineLen = 0; }
+        else if (c != '\r') lineLen++;
+      }
+      if (c < 0) return fail();
+      done = true;
+      return false;
+    }
+    left = size;
+    return true;
+  }
+  bool fail() { done = true; broken = true; return false; }
+
+  WiFiClient& client;
+  const bool chunked, closeDelimited;
+  long left;                               // byte restanti (del blocco se chunked), -1 = fino a chiusura
+  bool inChunks = false, done = false, broken = false;
+  uint8_t buf[512];
+  size_t pos = 0, len = 0;
+};
 
-  WiFiClientSecure client; client.setInsecure(); client.setTimeout(12000);
-  HTTPClient http;
-  if (!http.begin(client, g_apiUrl)) return false;
+// Filtro per una connessione: solo i campi letti da extractHHMM, extractLineLabel,
+// parseDelayMinutes, durata e cambi. sections/passList/coordinate restano nello stream.
+static void buildConnFilter(JsonDocument& f) {
+  f["from"]["departure"] = true;
+  f["from"]["departureTimestamp"] = true;
+  f["from"]["prognosis"]["departure"] = true;
+  f["from"]["prognosis"]["departureTimestamp"] = true;
+  f["duration"]  = true;
+  f["transfers"] = true;
+  f["products"]  = true;
+  f["sections"][0]["journey"]["category"] = true;   // [0] vale per tutti gli elementi
+  f["sections"][0]["journey"]["number"]   = true;
+  f["sections"][0]["journey"]["name"]     = true;
+}
 
-  int code = http.GET();
-  if (code != HTTP_CODE_OK) { http.end(); return false; }
+// Riempie una Row da una connessione filtrata; false se la partenza va scartata
+static bool rowFromConnection(JsonObject c, Row& r) {
+  long tsdep = (long)(c["from"]["departureTimestamp"] | 0L);
+  const char* iso = c["from"]["departure"] | nullptr;
+  if (shouldSkipSoon(tsdep, iso)) return false;
+
+  extractHHMM(c, r.timeHHMM, sizeof(r.timeHHMM));
+  extractLineLabel(c, r.line, sizeof(r.line));
+
+  // Durata ("00d01:07:00"): XhYm (>60m) altrimenti Xm
+  const char* durField = c["duration"] | "";
+  size_t dl = strlen(durField);
+  int h = 0, m = 0, totalMin = 0;
+  if (dl >= 8) {
+    const char* tail = durField + dl - 8;
+    h = atoi(tail);
+    m = atoi(tail + 3);
+    totalMin = h * 60 + m;
+  }
+  if (totalMin > 60)     snprintf(r.duration, sizeof(r.duration), "%dh%dm", h, m);
+  else if (totalMin > 0) snprintf(r.duration, sizeof(r.duration), "%dm", totalMin);
+  else                   strlcpy(r.duration, "--", sizeof(r.duration));
 
-  String payload = http.getString();
+  snprintf(r.transfers, sizeof(r.transfers), "%d", (int)(c["transfers"] | 0));
+  r.delayMin = parseDelayMinutes(c["from"].as<JsonObject>());
+  return true;
+}
+
+// Un solo client TLS per tutte le richieste, usato solo da boardTask: con keep-alive
+// le tabelle scaricate di seguito evitano un handshake per richiesta
+static WiFiClientSecure g_apiClient;
+static HTTPClient g_apiHttp;
+static const size_t API_DRAIN_MAX = 16384;  // oltre, chiudere costa meno che scaricare il resto
+
+// Una pagina dell'API letta in streaming: ogni elemento di "connections" si deserializza
+// da solo nel documento doc (riusato), quindi la memoria non cresce con la risposta.
+// Ritorna le connessioni lette (anche scartate), -1 su errore HTTP/JSON.
+static int fetchPage(const String& baseUrl, int page, JsonDocument& doc, const JsonDocument& filter, Row* outRows, int& count) {
+  static const char* HDRS[] = { "Transfer-Encoding" };
+  HTTPClient& http = g_apiHttp;
+  String url = baseUrl;
+  if (page > 0) url += "&page=" + String(page);
+  const bool reused = g_apiClient.connected();
+  if (!http.begin(g_apiClient, url)) return -1;
+  http.setReuse(true);
+  http.collectHeaders(HDRS, 1);
+  g_apiRequests++; if (reused) g_apiReused++;
+
+  const uint32_t t0 = millis();
+  int code = http.GET();
+  if (code != HTTP_CODE_OK) { g_apiClient.stop(); http.end(); return -1; }
+
+  ApiBodyStream in(http.getStream(), http.header("Transfer-Encoding").equalsIgnoreCase("chunked"), http.getSize());
+  in.setTimeout(12000);
+  int conns = 0;
+  uint32_t heapLow = ESP.getFreeHeap();
+  bool ok = in.find("\"connections\":[");
+  if (ok && in.peek() != ']') {
+    do {
+      DeserializationError err = deserializeJson(doc, in, DeserializationOption::Filter(filter));
+      if (err) { Serial.printf("[API] JSON: %s\n", err.c_str()); ok = false; break; }
+      conns++;
+      uint32_t hf = ESP.getFreeHeap(); if (hf < heapLow) heapLow = hf;
+      if (count < ROWS_MAX && rowFromConnection(doc.as<JsonObject>(), outRows[count])) count++;
+    } while (count < ROWS_MAX && in.findUntil(",", "]"));
+  }
+  // Il resto del corpo si consuma solo se è poco: la connessione resta aperta per la prossima
+  bool keep = ok && in.finish(API_DRAIN_MAX);
+  if (!keep) g_apiClient.stop();
   http.end();
 
-  DynamicJsonDocument doc(32768);
-  if (deserializeJson(doc, payload)) return false;
+  Serial.printf("[API] pagina %d: conn=%d righe=%d byte=%u ms=%lu heap min=%lu tls=%s\n",
+                page, conns, count, (unsigned)in.bytes, (unsigned long)(millis() - t0),
+                (unsigned long)heapLow, reused ? "riusata" : "nuova");
+  return ok ? conns : -1;
+}
 
-  JsonArray conns = doc["connections"].as<JsonArray>();
-  if (conns.isNull()) return false;
+static bool fetchDepartures(const String& url, Row* outRows, int &count) {
+  count = 0;
+  if (WiFi.status() != WL_CONNECTED) return false;
 
-  for (JsonObject c : conns) {
-    if (count >= ROWS_MAX) break;
+  DynamicJsonDocument filter(384);
+  buildConnFilter(filter);
+  DynamicJsonDocument doc(CONN_DOC_SIZE);
 
-    long tsdep = (long)(c["from"]["departureTimestamp"] | 0L);
-    const char* iso = c["from"]["departure"] | nullptr;
-    if (shouldSkipSoon(tsdep, iso)) continue;
+  // Pagine successive solo se il filtro "entro 60 s" ha lasciato righe vuote
+  for (int page = 0; page < API_PAGES && count < ROWS_MAX; ++page) {
+    int conns = fetchPage(url, page, doc, filter, outRows, count);
+    if (conns < 0) return count > 0;
+    if (conns < API_LIMIT) break;          // ultima pagina disponibile
+  }
+  return count > 0;
+}
 
-    String hhmm = hhmmFromTimestamp(tsdep);
-    if (!hhmm.length()) hhmm = hhmmFromISO(iso);
-    if (!hhmm.length()) hhmm = "--:--";
+// =========================== Cache tabelle (task) =============
+// Intervallo di refresh: g_refreshSec per la tabella mostrata; le altre si allungano quanto
+// basta a restare in API_DAILY_BUDGET richieste al giorno (con 12 preset e 300 s: ~28 min)
+static uint32_t boardIntervalMs(int slot) {
+  const int shown = g_shownSlot;             // una sola lettura: il conteggio sotto usa lo stesso slot
+  const uint32_t base = g_refreshSec * 1000UL;
+  if (slot == shown) return base;
+  uint32_t bg = 0;
+  for (int i = 0; i < BOARDS; ++i) if (g_boards[i].used && i != shown) bg++;
+  const uint32_t fgPerDay = 86400UL / g_refreshSec;
+  const uint32_t left = (API_DAILY_BUDGET > fgPerDay + bg) ? API_DAILY_BUDGET - fgPerDay : bg;
+  if (left == 0) return base;                // budget esaurito dalla tabella mostrata, nessuna in fondo
+  const uint32_t spread = 86400UL * bg / left * 1000UL;
+  return spread > base ? spread : base;
+}
 
-    String line = extractLineLabel(c);
+// Prossima tabella da scaricare: prima le urgenti (quella mostrata per prima), poi la più
+// in ritardo sulla scadenza; -1 se nessuna è dovuta. Chiamare col mutex preso.
+static int pickDueBoard(uint32_t now) {
+  const int shown = g_shownSlot;
+  if (g_boards[shown].used && g_boards[shown].urgent) return shown;
+  int best = -1; int32_t bestLate = -1;
+  for (int i = 0; i < BOARDS; ++i) {
+    const Board& b = g_boards[i];
+    if (!b.used) continue;
+    if (b.urgent) return i;
+    int32_t late = (int32_t)(now - b.dueMs);
+    if (late >= 0 && late > bestLate) { best = i; bestLate = late; }
+  }
+  return best;
+}
 
-    // Durata: XhYm (>60m) altrimenti Xm
-    String durField = (const char*)(c["duration"] | "");
-    int totalMin = 0; int h = 0, m = 0;
-    if (durField.length() >= 8) {
-      String tail = durField.substring(durField.length() - 8);
-      h = tail.substring(0, 2).toInt();
-      m = tail.substring(3, 5).toInt();
-      totalMin = h * 60 + m;
+// Scarica una tabella alla volta; le tabelle dovute insieme (avvio, burst di tap) passano
+// sulla stessa connessione TLS. Fuori dal mutex durante la rete: il loop non aspetta mai.
+static void boardTask(void*) {
+  for (;;) {
+    char from[64], to[64];
+    uint16_t gen = 0;
+    xSemaphoreTake(g_boardMutex, portMAX_DELAY);
+    int slot = pickDueBoard(millis());
+    if (slot >= 0) {
+      Board& b = g_boards[slot];
+      strlcpy(from, b.from, sizeof(from)); strlcpy(to, b.to, sizeof(to));
+      gen = b.gen; b.urgent = false;
+    }
+    xSemaphoreGive(g_boardMutex);
+    if (slot < 0) { ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000)); continue; }
+
+    Row rows[ROWS_MAX]; int n = 0;
+    bool ok = fetchDepartures(apiUrlFor(from, to), rows, n);
+    const uint32_t now = millis();
+
+    xSemaphoreTake(g_boardMutex, portMAX_DELAY);
+    Board& b = g_boards[slot];
+    if (b.used && b.gen == gen) {          // rotta cambiata nel frattempo: risultato da buttare
+      const uint32_t every = boardIntervalMs(slot);
+      if (ok) {
+        // Al primo fetch le tabelle in background si sfalsano su un intervallo
+        uint32_t stagger = (!b.fetchedMs && slot != g_shownSlot) ? every * slot / BOARDS : 0;
+        memcpy(b.rows, rows, n * sizeof(Row));
+        b.count = n; b.err = 0;
+        b.fetchedMs = now ? now : 1;
+        b.dueMs = now + every - stagger;
+      } else {
+        b.err = (WiFi.status() != WL_CONNECTED) ? 1 : 2;   // le righe vecchie restano
+        b.dueMs = now + (every < 60000UL ? every : 60000UL);
+      }
+      b.version++;
     }
-    String durStr;
-    if (totalMin > 60) { char buf[16]; snprintf(buf, sizeof(buf), "%dh%dm", h, m); durStr = buf; }
-    else if (totalMin > 0) { durStr = String(totalMin) + "m"; }
-    else { durStr = "--"; }
+    xSemaphoreGive(g_boardMutex);
+  }
+}
+
+static void startBoardTask() {
+  if (g_boardTask) return;
+  g_apiClient.setInsecure();
+  g_apiClient.setTimeout(12000);
+  // stack: handshake TLS (mbedTLS) + ArduinoJson + due tabelle di righe
+  xTaskCreatePinnedToCore(boardTask, "boards", 16384, nullptr, 1, &g_boardTask, 0);
+}
 
-    int transfers = (int)(c["transfers"] | 0);
-    int delayMin  = parseDelayMinutes(c["from"].as<JsonObject>());
+static void wakeBoardTask() { if (g_boardTask) xTaskNotifyGive(g_boardTask); }
 
-    Row r; r.timeHHMM = hhmm; r.line = line; r.duration = durStr; r.transfers = String(transfers); r.delayMin = delayMin;
-    outRows[count++] = r;
+// Mette in coda una tabella se non c'è o se è più vecchia di minAgeMs
+static void requestBoardRefresh(int slot, uint32_t minAgeMs) {
+  xSemaphoreTake(g_boardMutex, portMAX_DELAY);
+  Board& b = g_boards[slot];
+  bool queue = b.used && (!b.fetchedMs || millis() - b.fetchedMs >= minAgeMs);
+  if (queue) b.urgent = true;
+  xSemaphoreGive(g_boardMutex);
+  if (queue) wakeBoardTask();
+}
+
+// Assegna una rotta a uno slot. Se cambia, la tabella riparte da una copia di un altro slot
+// con la stessa rotta (preset spostato o applicato come base) oppure vuota, e va in coda.
+static void setBoardRoute(int slot, const String& from, const String& to) {
+  xSemaphoreTake(g_boardMutex, portMAX_DELAY);
+  Board& b = g_boards[slot];
+  if (b.used && from == b.from && to == b.to) { xSemaphoreGive(g_boardMutex); return; }
+  strlcpy(b.from, from.c_str(), sizeof(b.from));
+  strlcpy(b.to, to.c_str(), sizeof(b.to));
+  b.used = true; b.gen++; b.version++;
+  b.count = 0; b.fetchedMs = 0; b.err = 0; b.urgent = false; b.dueMs = millis();
+  for (int i = 0; i < BOARDS; ++i) {
+    const Board& o = g_boards[i];
+    if (i == slot || !o.used || !o.fetchedMs || strcmp(o.from, b.from) || strcmp(o.to, b.to)) continue;
+    memcpy(b.rows, o.rows, o.count * sizeof(Row));
+    b.count = o.count; b.fetchedMs = o.fetchedMs; b.dueMs = o.dueMs;
+    break;
+  }
+  xSemaphoreGive(g_boardMutex);
+  wakeBoardTask();
+}
+
+// Riallinea gli slot dei preset a g_presets (dopo caricamento, salvataggio o eliminazione)
+static void syncPresetBoards() {
+  for (int i = 0; i < MAX_PRESETS; ++i) {
+    if (i < g_presetCount) { setBoardRoute(1 + i, g_presets[i].from, g_presets[i].to); continue; }
+    xSemaphoreTake(g_boardMutex, portMAX_DELAY);
+    Board& b = g_boards[1 + i];
+    if (b.used) { b.used = false; b.count = 0; b.fetchedMs = 0; b.gen++; b.version++; }
+    xSemaphoreGive(g_boardMutex);
   }
-  return count > 0;
 }
 
 // =========================== Web UI (HTML helpers) ============
+// Le pagine partono a pezzi (WebChunk.h): parti fisse dalla flash, campi dinamici escapati al volo
 static String htmlEscape(const String& s) {
   String o; o.reserve(s.length()*2);
   for (size_t i=0;i<s.length();++i) {
@@ -736,129 +1040,168 @@ static String htmlEscape(const String& s) {
     else if (c=='<') o += "&lt;";
     else if (c=='>') o += "&gt;";
     else if (c=='\"') o += "&quot;";
+    else if (c=='\'') o += "&#39;";
     else o += c;
   }
   return o;
 }
 
-static String buildPresetsHTML() {
-  String html;
-  html += "<h3>Preset</h3>";
-  html += "<div class='box'><p class='hint'>Salva i percorsi come preset personali (max ";
-  html += String(MAX_PRESETS);
-  html += "). Tap sul display per ciclarli, senza modificare l’NVS.</p>";
-
-  html +=
-    "<form id='pform' method='POST' action='/route'>"
-    "<input type='hidden' name='action' value='save_preset'>"
-    "<input type='hidden' id='pid' name='id' value='-1'>"
-    "<label>Nome preset</label>"
-    "<input id='plabel' name='label' placeholder='Es. Casa → Lavoro'>"
-    "<div class='grid2'>"
-      "<div><label>Partenza</label><input id='pfrom' name='pfrom' placeholder='Es. Bellinzona'></div>"
-      "<div><label>Arrivo</label><input id='pto'   name='pto'   placeholder='Es. Lugano'></div>"
-    "</div>"
-    "<div class='grid2'>"
-      "<button type='submit'>Salva preset</button>"
-      "<button type='button' onclick='fillFromCurrent()'>Compila dai campi sopra</button>"
-    "</div>"
-    "</form>";
-
-  html += "<div class='list'>";
-  if (g_presetCount==0) {
-    html += "<p class='hint'>Nessun preset salvato.</p>";
-  } else {
-    for (int i=0;i<g_presetCount;i++) {
-      String lbl = htmlEscape(g_presets[i].label);
-      String fr  = htmlEscape(g_presets[i].from);
-      String to  = htmlEscape(g_presets[i].to);
-      html +=
-        "<div class='item'>"
-          "<div class='itxt'><b>" + lbl + "</b><br><span>" + fr + " → " + to + "</span></div>"
-          "<div class='iact'>"
-            "<form method='POST' action='/route' style='display:inline'>"
-              "<input type='hidden' name='action' value='apply_preset'>"
-              "<input type='hidden' name='id' value='"+String(i)+"'>"
-              "<button>Usa</button></form>"
-            "<button type='button' onclick='editPreset("+String(i)+")'>Modifica</button>"
-            "<form method='POST' action='/route' style='display:inline' onsubmit='return confirm(\"Eliminare preset?\")'>"
-              "<input type='hidden' name='action' value='delete_preset'>"
-              "<input type='hidden' name='id' value='"+String(i)+"'>"
-              "<button class='danger'>Elimina</button></form>"
-          "</div>"
-        "</div>";
-    }
+static const char ROUTE_HEAD[] PROGMEM =
+  "<!DOCTYPE html><html><head><meta charset='utf-8'>"
+  "<meta name='viewport' content='width=device-width,initial-scale=1'>"
+  "<title>Route Setup</title>"
+  "<style>"
+  "body{font-family:sans-serif;background:#111;color:#eee;padding:24px}"
+  "input,button{font-size:18px;padding:10px;margin:6px;width:100%;box-sizing:border-box}"
+  "form{max-width:820px;margin:0 auto}"
+  "label{display:block;margin-top:10px}"
+  ".box{background:#1c1c1c;padding:16px;border-radius:8px;margin-bottom:20px}"
+  ".grid2{display:grid;grid-template-columns:1fr;gap:10px}"
+  "@media(min-width:720px){.grid2{grid-template-columns:1fr 1fr}}"
+  ".hint{color:#aaa;font-size:14px}"
+  ".notice{background:#0b5;color:#031;padding:10px 12px;border-radius:8px;margin:12px 0}"
+  ".list .item{display:flex;justify-content:space-between;align-items:center;background:#222;padding:8px;border-radius:8px;margin:8px 0}"
+  ".list .itxt span{color:#aaa;font-size:14px}"
+  ".list .iact form,.list .iact button{display:inline-block;width:auto;margin:4px}"
+  ".danger{background:#6b1b1b;color:#fff;border:0;border-radius:8px}"
+  "button{background:#2b2b2b;border:0;border-radius:8px;color:#eee;cursor:pointer}"
+  "button:active{transform:scale(0.99)}"
+  "</style></head><body>"
+  "<h2>Configura percorso</h2>"
+  "<div class='box'>";
+
+static const char ROUTE_FORM[] PROGMEM =
+  "<form id='rform' method='POST' action='/route'>"
+  "<input type='hidden' name='action' value='save_route'>"
+  "<div class='grid2'>"
+    "<div><label>Partenza</label><input id='from' name='from' placeholder='Es. Bellinzona' value='";
+
+static const char PRESETS_FORM[] PROGMEM =
+  "). Tap sul display per ciclarli, senza modificare l’NVS.</p>"
+  "<form id='pform' method='POST' action='/route'>"
+  "<input type='hidden' name='action' value='save_preset'>"
+  "<input type='hidden' id='pid' name='id' value='-1'>"
+  "<label>Nome preset</label>"
+  "<input id='plabel' name='label' placeholder='Es. Casa → Lavoro'>"
+  "<div class='grid2'>"
+    "<div><label>Partenza</label><input id='pfrom' name='pfrom' placeholder='Es. Bellinzona'></div>"
+    "<div><label>Arrivo</label><input id='pto'   name='pto'   placeholder='Es. Lugano'></div>"
+  "</div>"
+  "<div class='grid2'>"
+    "<button type='submit'>Salva preset</button>"
+    "<button type='button' onclick='fillFromCurrent()'>Compila dai campi sopra</button>"
+  "</div>"
+  "</form>";
+
+static const char PRESETS_SCRIPT[] PROGMEM =
+  "function fillFromCurrent(){"
+    "document.getElementById('pfrom').value=document.getElementById('from').value;"
+    "document.getElementById('pto').value=document.getElementById('to').value;"
+  "}"
+  "function editPreset(i){"
+    "if(i>=0 && i<P.length){"
+      "document.getElementById('pid').value=i;"
+      "document.getElementById('plabel').value=P[i][0];"
+      "document.getElementById('pfrom').value=P[i][1];"
+      "document.getElementById('pto').value=P[i][2];"
+      "window.scrollTo({top:0,behavior:'smooth'});"
+    "}"
+  "}"
+  "</script>";
+
+static const char ROUTE_TAIL[] PROGMEM =
+  "<script>setTimeout(function(){var n=document.getElementById('notice'); if(n){n.style.display='none';}},2200);</script></body></html>";
+
+static void renderPresetList(WebChunk& w) {
+  w.put("<div class='list'>");
+  if (g_presetCount==0) w.put("<p class='hint'>Nessun preset salvato.</p>");
+  for (int i=0;i<g_presetCount;i++) {
+    w.put("<div class='item'><div class='itxt'><b>"); w.esc(g_presets[i].label);
+    w.put("</b><br><span>"); w.esc(g_presets[i].from); w.put(" → "); w.esc(g_presets[i].to);
+    w.put("</span></div><div class='iact'>"
+          "<form method='POST' action='/route' style='display:inline'>"
+          "<input type='hidden' name='action' value='apply_preset'>"
+          "<input type='hidden' name='id' value='"); w.num(i);
+    w.put("'><button>Usa</button></form>"
+          "<button type='button' onclick='editPreset("); w.num(i);
+    w.put(")'>Modifica</button>"
+          "<form method='POST' action='/route' style='display:inline' onsubmit='return confirm(\"Eliminare preset?\")'>"
+          "<input type='hidden' name='action' value='delete_preset'>"
+          "<input type='hidden' name='id' value='"); w.num(i);
+    w.put("'><button class='danger'>Elimina</button></form></div></div>");
   }
-  html += "</div></div>";
+  w.put("</div></div><script>var P=[");
+  for (int i=0;i<g_presetCount;i++) {
+    w.put(i ? ",['" : "['"); w.js(g_presets[i].label);
+    w.put("','"); w.js(g_presets[i].from);
+    w.put("','"); w.js(g_presets[i].to); w.put("']");
+  }
+  w.put("];");
+}
 
-  html +=
-    "<script>"
-    "function fillFromCurrent(){"
-      "document.getElementById('pfrom').value=document.getElementById('from').value;"
-      "document.getElementById('pto').value=document.getElementById('to').value;"
-    "}"
-    "function editPreset(i){"
-      "var L="+String(g_presetCount)+";"
-      "var labels=[";
-  for (int i=0;i<g_presetCount;i++) { if (i) html += ","; html += "'"+htmlEscape(g_presets[i].label)+"'"; }
-  html += "];var froms=[";
-  for (int i=0;i<g_presetCount;i++) { if (i) html += ","; html += "'"+htmlEscape(g_presets[i].from)+"'"; }
-  html += "];var tos=[";
-  for (int i=0;i<g_presetCount;i++) { if (i) html += ","; html += "'"+htmlEscape(g_presets[i].to)+"'"; }
-  html += "];"
-         "if(i>=0 && i<L){"
-           "document.getElementById('pid').value=i;"
-           "document.getElementById('plabel').value=labels[i];"
-           "document.getElementById('pfrom').value=froms[i];"
-           "document.getElementById('pto').value=tos[i];"
-           "window.scrollTo({top:0,behavior:'smooth'});"
-         "}"
-       "}"
-    "</script>";
-  return html;
-}
-
-static String buildRoutePage(const String& ipStr, const String& notice) {
-  String page =
-    "<!DOCTYPE html><html><head><meta charset='utf-8'>"
-    "<meta name='viewport' content='width=device-width,initial-scale=1'>"
-    "<title>Route Setup</title>"
-    "<style>"
-    "body{font-family:sans-serif;background:#111;color:#eee;padding:24px}"
-    "input,button{font-size:18px;padding:10px;margin:6px;width:100%;box-sizing:border-box}"
-    "form{max-width:820px;margin:0 auto}"
-    "label{display:block;margin-top:10px}"
-    ".box{background:#1c1c1c;padding:16px;border-radius:8px;margin-bottom:20px}"
-    ".grid2{display:grid;grid-template-columns:1fr;gap:10px}"
-    "@media(min-width:720px){.grid2{grid-template-columns:1fr 1fr}}"
-    ".hint{color:#aaa;font-size:14px}"
-    ".notice{background:#0b5;color:#031;padding:10px 12px;border-radius:8px;margin:12px 0;display:" + String(notice.length()? "block":"none") + "}"
-    ".list .item{display:flex;justify-content:space-between;align-items:center;background:#222;padding:8px;border-radius:8px;margin:8px 0}"
-    ".list .itxt span{color:#aaa;font-size:14px}"
-    ".list .iact form,.list .iact button{display:inline-block;width:auto;margin:4px}"
-    ".danger{background:#6b1b1b;color:#fff;border:0;border-radius:8px}"
-    "button{background:#2b2b2b;border:0;border-radius:8px;color:#eee;cursor:pointer}"
-    "button:active{transform:scale(0.99)}"
-    "</style></head><body>"
-    "<h2>Configura percorso</h2>"
-    "<div class='box'>"
-    "<div id='notice' class='notice'>" + notice + "</div>"
-    "<form id='rform' method='POST' action='/route'>"
-    "<input type='hidden' name='action' value='save_route'>"
-    "<div class='grid2'>"
-      "<div><label>Partenza</label><input id='from' name='from' value='" + htmlEscape(g_from) + "' placeholder='Es. Bellinzona'></div>"
-      "<div><label>Arrivo</label><input id='to' name='to' value='" + htmlEscape(g_to) + "' placeholder='Es. Lugano'></div>"
-    "</div>"
-    "<label>Refresh (secondi, 60–3600)</label>"
-    "<input id='refresh' type='number' min='60' max='3600' step='10' name='refresh' value='" + String(g_refreshSec) + "'>"
-    "<button type='submit'>Salva percorso</button>"
-    "</form>"
-    "<p class='hint'>Tip: tap singolo sul display cicla i preset salvati, senza modificare l’NVS.</p>"
-    "<p class='hint'>IP pannello: <b>" + ipStr + "</b></p>"
-    "</div>";
-  page += buildPresetsHTML();
-  page += "<script>setTimeout(function(){var n=document.getElementById('notice'); if(n){n.style.display='none';}},2200);</script></body></html>";
-  return page;
+static void sendPresetsHTML(WebChunk& w) {
+  w.put("<h3>Preset</h3><div class='box'><p class='hint'>Salva i percorsi come preset personali (max ");
+  w.num(MAX_PRESETS);
+  w.put(PRESETS_FORM);
+  if (!g_presetsFrag.valid) { WebChunk f(g_presetsFrag); renderPresetList(f); f.end(); }
+  if (g_presetsFrag.valid) w.frag(g_presetsFrag);
+  else renderPresetList(w);                    // niente memoria per il frammento: render diretto
+  w.put(PRESETS_SCRIPT);
+}
+
+// Stato della cache tabelle: hit rate dei tap, latenza tap -> schermo, riuso TLS, età per rotta.
+// Sempre dal vivo; ogni tabella si copia sotto mutex e si scrive fuori, così un client lento
+// non blocca il task di fetch
+static void sendCacheHTML(WebChunk& w) {
+  w.put("<h3>Cache tabelle</h3><div class='box'><p class='hint'>Tap: <b>"); w.num(g_tapCount);
+  w.put("</b>, serviti dalla cache <b>"); w.num(g_tapHits);
+  w.put("</b> ("); w.num(g_tapCount ? g_tapHits * 100 / g_tapCount : 0);
+  w.put("%). Tap &rarr; schermo: medio <b>"); w.num(g_tapPaintN ? g_tapPaintSumMs / g_tapPaintN : 0);
+  w.put(" ms</b>, max "); w.num(g_tapPaintMaxMs);
+  w.put(" ms. Richieste API: "); w.num(g_apiRequests);
+  w.put(", su connessione TLS riusata "); w.num(g_apiReused);
+  w.put(".</p><div class='list'>");
+  const uint32_t now = millis();
+  for (int i = 0; i < BOARDS; ++i) {
+    char from[sizeof(Board::from)], to[sizeof(Board::to)];
+    xSemaphoreTake(g_boardMutex, portMAX_DELAY);
+    const Board& b = g_boards[i];
+    const bool used = b.used;
+    const int count = b.count; const uint32_t fetchedMs = b.fetchedMs; const int8_t err = b.err;
+    memcpy(from, b.from, sizeof(from)); memcpy(to, b.to, sizeof(to));
+    xSemaphoreGive(g_boardMutex);
+    if (!used) continue;
+    w.put("<div class='item'><div class='itxt'><b>");
+    if (i == BOARD_BASE) w.put("Rotta base"); else w.esc(g_presets[i - 1].label);
+    w.put("</b><br><span>"); w.esc(from); w.put(" → "); w.esc(to); w.put(" &middot; ");
+    if (fetchedMs) { w.num(count); w.put(" righe, "); w.num((now - fetchedMs) / 1000); w.put(" s fa"); }
+    else           w.put("non ancora scaricata");
+    if (err) w.put((err == 1) ? ", ultimo errore Wi-Fi" : ", ultimo errore HTTP/JSON");
+    if (i == g_shownSlot) w.put(" &middot; a schermo");
+    w.put("</span></div></div>");
+  }
+  w.put("</div></div>");
+}
+
+// notice è HTML già pronto (i valori inseriti dall'utente arrivano già escapati)
+static void sendRoutePage(const String& ipStr, const String& notice) {
+  WebChunk w(web, "/route");
+  w.begin("text/html");
+  w.put(ROUTE_HEAD);
+  if (notice.length()) { w.put("<div id='notice' class='notice'>"); w.put(notice); w.put("</div>"); }
+  w.put(ROUTE_FORM); w.esc(g_from);
+  w.put("'></div><div><label>Arrivo</label><input id='to' name='to' placeholder='Es. Lugano' value='"); w.esc(g_to);
+  w.put("'></div></div>"
+        "<label>Refresh (secondi, 60–3600)</label>"
+        "<input id='refresh' type='number' min='60' max='3600' step='10' name='refresh' value='"); w.num(g_refreshSec);
+  w.put("'><button type='submit'>Salva percorso</button></form>"
+        "<p class='hint'>Tip: tap singolo sul display cicla i preset salvati, senza modificare l’NVS.</p>"
+        "<p class='hint'>IP pannello: <b>"); w.put(ipStr);
+  w.put("</b> &middot; <a href='/boot' style='color:#aaa'>tempi di avvio</a></p></div>");
+  sendPresetsHTML(w);
+  sendCacheHTML(w);
+  w.put(ROUTE_TAIL);
+  w.end();
 }
 
 // =========================== Touch helpers ====================
@@ -917,99 +1260,142 @@ static bool touchTapDetected() {
   return false;
 }
 
+// =========================== Tabelle a schermo ================
+static void noteTapPaint(uint32_t ms) {
+  g_tapPaintN++; g_tapPaintSumMs += ms;
+  if (ms > g_tapPaintMaxMs) g_tapPaintMaxMs = ms;
+}
+
+// Disegna la tabella in cache dello slot: copia sotto mutex, disegno fuori
+static void paintBoard(int slot) {
+  Row rows[ROWS_MAX]; int n; int8_t err; bool pending;
+  xSemaphoreTake(g_boardMutex, portMAX_DELAY);
+  const Board& b = g_boards[slot];
+  n = b.count;
+  memcpy(rows, b.rows, n * sizeof(Row));
+  err = b.err;
+  pending = b.urgent || (!b.fetchedMs && !err);
+  g_shownVersion = b.version;
+  xSemaphoreGive(g_boardMutex);
+
+  if (n == 0) {
+    if (pending)       drawStatus("Aggiornamento...");
+    else if (err == 1) drawStatus("NET ERR: Wi-Fi");
+    else               drawStatus("HTTP/JSON ERR");
+    return;
+  }
+  DS_REFRESH_SCOPE("righe");
+  drawRows(rows, n);
+}
+
+// Porta a schermo lo slot (g_from/g_to già impostati): subito dalla cache, refresh in coda
+static void showBoard(int slot, uint32_t refreshAgeMs) {
+  xSemaphoreTake(g_boardMutex, portMAX_DELAY);
+  g_shownSlot = slot;
+  Board& b = g_boards[slot];                 // ora è in primo piano: torna alla cadenza g_refreshSec
+  uint32_t due = b.fetchedMs + g_refreshSec * 1000UL;
+  if (b.fetchedMs && (int32_t)(b.dueMs - due) > 0) b.dueMs = due;
+  xSemaphoreGive(g_boardMutex);
+  requestBoardRefresh(slot, refreshAgeMs);
+  drawHeader();
+  drawRouteBar();
+  drawSubHeader();
+  paintBoard(slot);
+}
+
 static void applyPresetByIndex(int idx) {
   if (idx < 0 || idx >= g_presetCount) return;
+  const uint32_t t0 = millis();
   g_from = g_presets[idx].from;
   g_to   = g_presets[idx].to;
-  buildApiUrl();
-  forceRedrawNow();
-}
-
-// =========================== Fetch & redraw ===================
-static uint32_t lastHeaderUpdate = 0;
-static void doFetchAndRedraw() {
-  drawStatus("Aggiornamento...");
-  Row rows[ROWS_MAX]; int n = 0;
-  bool ok = fetchDepartures(rows, n);
-  if (ok) {
-    clearContentArea();
-    drawSubHeader();
-    for (int i = 0; i < n; ++i) {
-      uint16_t col = rows[i].delayMin > 0 ? RGB565_RED : RGB565_WHITE;
-      gfx->setTextColor(col);
-      drawRow(i, rows[i].timeHHMM, rows[i].line, rows[i].duration, rows[i].transfers);
-    }
+  const int slot = 1 + idx;
+  xSemaphoreTake(g_boardMutex, portMAX_DELAY);
+  bool hit = g_boards[slot].count > 0;
+  xSemaphoreGive(g_boardMutex);
+
+  showBoard(slot, TAP_REFRESH_AGE_MS);
+  g_tapCount++;
+  if (hit) {
+    g_tapHits++; g_tapPendingMs = 0;
+    noteTapPaint(millis() - t0);
   } else {
-    if (WiFi.status() != WL_CONNECTED) drawStatus("NET ERR: Wi-Fi"); else drawStatus("HTTP/JSON ERR");
+    g_tapPendingMs = t0 ? t0 : 1;          // latenza chiusa dal loop quando arriva la tabella
   }
-  g_lastFetchMs = millis();
+  Serial.printf("[CACHE] preset %d: %s, hit %lu/%lu, tap->schermo %lu ms\n", idx, hit ? "cache" : "attesa fetch",
+                (unsigned long)g_tapHits, (unsigned long)g_tapCount, hit ? (unsigned long)(millis() - t0) : 0UL);
 }
 
 // =========================== Setup / loop =====================
+static uint32_t lastClockCheck = 0;
+
+// Il primo schermo va subito: Wi-Fi, portale e ora arrivano dal loop (bootPoll)
 void setup() {
   Serial.begin(115200);
-  delay(50);
-  backlightOn();
-  panelKickstart();
+  bootPanel(gfx, GFX_BL, PWM_CHANNEL, PWM_FREQ, PWM_BITS);
+  bootStart(STA_TIMEOUT_MS, GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER);
 
+  int ph = bootPhaseBegin("nvs");
+  g_boardMutex = xSemaphoreCreateMutex();
   loadRouteFromNVS();
   loadPresetsFromNVS();
+  setBoardRoute(BOARD_BASE, g_from, g_to);
+  syncPresetBoards();
+  bootPhaseEnd(ph);
 
-  if (!tryConnectSTA()) { startAPWithPortal(); }
-  else { registerWebHandlers(false); }
-
+  ph = bootPhaseBegin("touch");
   initTouch(true);
-  syncTimeOnce();
-
-  gfx->fillScreen(RGB565_BLACK);
-  drawHeader();
-  drawRouteBar();
-  drawSubHeader();
-  lastHeaderUpdate = millis();
+  bootPhaseEnd(ph);
 
-  doFetchAndRedraw();
+  showBoard(BOARD_BASE, 0);                 // tabella vuota: la riempie il task appena c'è rete
+  bootMark("primo frame");
 }
 
 void loop() {
-  if (WiFi.getMode() == WIFI_AP) dnsServer.processNextRequest();
+  switch (bootPoll()) {
+    case BOOT_ONLINE: registerWebHandlers(false); startBoardTask(); break;   // rotta base per prima, poi i preset
+    case BOOT_PORTAL: startAPWithPortal(); break;
+    case BOOT_TIME:   g_timeSynced = true; break;                           // orologio al prossimo giro
+    default: break;
+  }
+  if (WiFi.getMode() == WIFI_AP) { dnsServer.processNextRequest(); web.handleClient(); delay(5); return; }
   web.handleClient();
 
   if (touchTapDetected()) {
     if (g_presetCount <= 0) {
       gfx->fillRect(0, HEADER_H, 480, ROUTE_H, RGB565_RED);
-      gfx->setTextSize(2);
-      gfx->setTextColor(RGB565_WHITE, RGB565_RED);
-      gfx->setCursor(16, HEADER_H + 2);
-      gfx->print("Nessun preset salvato");
+      drawAtlasText(gfx, 16, HEADER_H + 2, "Nessun preset salvato", RGB565_WHITE, RGB565_RED, false);
+      g_scrRouteOk = false;                 // la rotta torna al prossimo giro dell'orologio
     } else {
       if (g_touchPresetIdx < 0) g_touchPresetIdx = 0; else g_touchPresetIdx = (g_touchPresetIdx + 1) % g_presetCount;
-      gfx->fillRect(0, HEADER_H, 480, ROUTE_H, RGB565_RED);
-      gfx->setTextSize(2);
-      gfx->setTextColor(RGB565_WHITE, RGB565_RED);
-      gfx->setCursor(16, HEADER_H + 2);
-      String lbl = g_presets[g_touchPresetIdx].label;
-      String preview = lbl.length() ? ("Preset: " + lbl) : ("Preset: " + g_presets[g_touchPresetIdx].from + " -> " + g_presets[g_touchPresetIdx].to);
-      gfx->print(preview);
       applyPresetByIndex(g_touchPresetIdx);
     }
   }
 
-  if (!g_timeSynced || millis() - lastHeaderUpdate >= 30000) {
-    syncTimeOnce();
+  // Orologio ed età tabella: controllo ogni secondo, disegno solo se il testo cambia
+  if (millis() - lastClockCheck >= 1000) {
+    lastClockCheck = millis();
     drawHeader();
     drawRouteBar();
-    drawSubHeader();
-    lastHeaderUpdate = millis();
   }
 
   if (g_routeChanged) {
     g_routeChanged = false;
-    drawHeader();
-    drawRouteBar();
-    drawSubHeader();
-    doFetchAndRedraw();
+    setBoardRoute(BOARD_BASE, g_from, g_to);
+    showBoard(BOARD_BASE, 0);               // salvataggio da Web: refresh anche se in cache
   }
 
-  if (millis() - g_lastFetchMs >= g_refreshSec * 1000UL) { doFetchAndRedraw(); }
+  // Nuovo esito dal task per la tabella mostrata
+  const int shown = g_shownSlot;
+  if (g_boards[shown].version != g_shownVersion) {
+    paintBoard(shown);
+    drawRouteBar();
+    if (g_boards[shown].count > 0) bootMark("prima tabella");
+    if (g_tapPendingMs && g_boards[shown].count > 0) {
+      uint32_t ms = millis() - g_tapPendingMs;
+      noteTapPaint(ms);
+      g_tapPendingMs = 0;
+      Serial.printf("[CACHE] tabella arrivata: tap->schermo %lu ms\n", (unsigned long)ms);
+    }
+  }
   delay(5);
 }
@@ -10,23 +10,30 @@
   - Il display 480x480 (ST7701 via RGB) viene usato in portrait.
   - Area sinistra 400x480: griglia "pixel art" di 20x24 celle, cella = 20x20 px.
   - Colonna destra 80x480: palette verticale di 5 colori selezionabili.
-  - Barra inferiore (in basso, centrata sulla griglia): pulsanti CLEAR e EXPORT.
+  - Barra inferiore (in basso, centrata sulla griglia): pulsanti UNDO, REDO, CLEAR e EXPORT.
       • CLEAR  : pulisce l’intera griglia (riporta tutte le celle a bianco).
-      • EXPORT : salva l’area di griglia (400x480) su microSD come JPEG
-                 (se disponibile la libreria JPEGENC) oppure come BMP fallback.
-  - Il tocco è gestito con “edge detection” e cooldown per evitare ripetizioni.
+      • EXPORT : salva l’area di griglia (400x480) su microSD come PNG o BMP indicizzati
+                 (oppure JPEG con JPEGENC, vedi EXPORT_FORMAT), in un task in background
+                 con barra di avanzamento.
+      • UNDO/REDO : annulla/ripete tratti e CLEAR (giornale di delta per cella).
+  - Il touch è campionato in un task: si disegna anche trascinando, con i punti
+    uniti cella per cella; i pulsanti hanno un cooldown contro le ripetizioni.
   - Nessuna modifica al pilotaggio pannello e timing del display.
 
   Requisiti librerie:
   - Arduino_GFX_Library (display ST7701 via RGB + SWSPI per init)
   - TAMC_GT911 (touch GT911)
   - SD e SPI (core ESP32)
-  - JPEGENC (opzionale, per export JPEG; se assente → BMP di fallback)
+  - JPEGENC (opzionale, solo con EXPORT_FORMAT = EXPORT_JPEG; se assente → PNG)
 */
 
 #include <Arduino.h>
 #include <Wire.h>
 #include <Arduino_GFX_Library.h>
+
+// Contatori di disegno su Serial (1 = attivi, 0 = nessun costo)
+#define DRAW_STATS 0
+#include <DrawStats.h>
 #include <TAMC_GT911.h>
 #include <SPI.h>
 #include <SD.h>
@@ -68,7 +75,7 @@ Arduino_ESP32RGBPanel *rgbpanel = new Arduino_ESP32RGBPanel(
 );
 
 // --- DISPLAY ST7701 --- (non modificare)
-Arduino_RGB_Display *gfx = new Arduino_RGB_Display(
+DrawStatsDisplay *gfx = new DrawStatsDisplay(
   480, 480,
   rgbpanel, 0 /*rotation*/, true /*auto_flush*/,
   bus, GFX_NOT_DEFINED /*RST*/,
@@ -98,13 +105,15 @@ static const int PALETTE_W = 80;
 
 // Barra inferiore con pulsanti centrati
 static const int BOTTOM_BAR_H = 48;
-static const int BTN_W = 120;
+static const int BTN_W = 84;
 static const int BTN_H = 36;
-static const int BTN_GAP = 20;
+static const int BTN_GAP = 12;
 static const int BTN_Y = GRID_H - (BOTTOM_BAR_H + BTN_H) / 2;
-static const int CENTER_X = GRID_W / 2;
-static const int BTN1_X = CENTER_X - BTN_W - (BTN_GAP / 2); // CLEAR
-static const int BTN2_X = CENTER_X + (BTN_GAP / 2);          // EXPORT
+static const int BTN_X0 = (GRID_W - 4 * BTN_W - 3 * BTN_GAP) / 2;
+static const int BTN_UNDO_X = BTN_X0;                          // UNDO
+static const int BTN_REDO_X = BTN_X0 + (BTN_W + BTN_GAP);      // REDO
+static const int BTN1_X = BTN_X0 + 2 * (BTN_W + BTN_GAP);      // CLEAR
+static const int BTN2_X = BTN_X0 + 3 * (BTN_W + BTN_GAP);      // EXPORT
 
 // Griglia 20x24 (celle 20x20 px)
 static const int CELL = 20;
@@ -128,6 +137,89 @@ int currentColorIndex = 1; // default: Rosso
 // Stato celle della griglia
 uint16_t cellColor[ROWS][COLS];
 
+// ----------------------- CELLE DA RIDISEGNARE / UNDO -----------------------
+// Celle cambiate dall'ultimo frame: ognuna passa da drawCell una volta sola per frame
+static uint32_t g_dirty[(ROWS * COLS + 31) / 32];
+
+static bool     g_dirtyAny = false;
+
+static inline void markCellDirty(int idx) { g_dirty[idx >> 5] |= 1u << (idx & 31); g_dirtyAny = true; }
+
+// Giornale undo/redo: un delta per cella cambiata in 16 bit, in un anello fisso
+//   bit 0..8 indice cella, 9..11 colore vecchio, 12..14 colore nuovo, 15 inizio azione
+// Colori come indice: 0..4 palette, 5 bianco. Un'azione (tratto, CLEAR) è la sequenza
+// di delta fino al prossimo bit 15; se l'anello è pieno si perdono le azioni più vecchie.
+#define UNDO_RING 2048
+static const uint16_t UNDO_START = 0x8000;
+static uint16_t g_undo[UNDO_RING];
+static uint32_t g_undoTail = 0, g_undoHead = 0, g_undoTop = 0;   // [tail,head) undo, [head,top) redo
+static bool     g_undoNewAction = false;
+
+static inline uint8_t colorToIdx(uint16_t c)
+{
+  for (uint8_t i = 0; i < PALETTE_KEYS; ++i) if (palette[i] == c) return i;
+  return PALETTE_KEYS;                      // bianco
+}
+
+static inline uint16_t idxToColor(uint8_t i) { return i < PALETTE_KEYS ? palette[i] : WHITE; }
+
+static inline bool canUndo() { return g_undoHead != g_undoTail; }
+static inline bool canRedo() { return g_undoTop != g_undoHead; }
+
+// Le celle cambiate da qui in poi formano una nuova azione
+static inline void journalBeginAction() { g_undoNewAction = true; }
+
+// Cambia colore a una cella registrando il delta (niente se il colore è già quello)
+static bool setCellJournaled(int r, int c, uint16_t color)
+{
+  const uint16_t old = cellColor[r][c];
+  if (old == color) return false;
+  const int idx = r * COLS + c;
+  uint16_t e = (uint16_t)idx | (uint16_t)(colorToIdx(old) << 9) | (uint16_t)(colorToIdx(color) << 12);
+  if (g_undoNewAction) { e |= UNDO_START; g_undoNewAction = false; }
+
+  g_undoTop = g_undoHead;                   // una modifica nuova cancella il redo
+  if (g_undoHead - g_undoTail == UNDO_RING) {
+    // anello pieno: scarta l'azione più vecchia intera
+    do { ++g_undoTail; } while (g_undoTail != g_undoHead && !(g_undo[g_undoTail % UNDO_RING] & UNDO_START));
+  }
+  g_undo[g_undoHead++ % UNDO_RING] = e;
+  g_undoTop = g_undoHead;
+
+  cellColor[r][c] = color;
+  markCellDirty(idx);
+  return true;
+}
+
+static void journalApply(uint16_t e, bool redo)
+{
+  const int idx = e & 0x1FF;
+  cellColor[idx / COLS][idx % COLS] = idxToColor((e >> (redo ? 12 : 9)) & 7);
+  markCellDirty(idx);
+}
+
+// Annulla l'ultima azione; ritorna le celle toccate
+static int undoAction()
+{
+  int n = 0;
+  while (g_undoHead != g_undoTail) {
+    const uint16_t e = g_undo[--g_undoHead % UNDO_RING];
+    journalApply(e, false); ++n;
+    if (e & UNDO_START) break;
+  }
+  return n;
+}
+
+static int redoAction()
+{
+  int n = 0;
+  while (g_undoHead != g_undoTop) {
+    journalApply(g_undo[g_undoHead++ % UNDO_RING], true); ++n;
+    if (g_undoHead == g_undoTop || (g_undo[g_undoHead % UNDO_RING] & UNDO_START)) break;
+  }
+  return n;
+}
+
 // ----------------------- FUNZIONI UTILI GRAFICHE -----------------------
 static inline void drawCenteredTextInRect(int rx, int ry, int rw, int rh, const char* txt, uint16_t color, uint8_t size)
 {
@@ -157,18 +249,30 @@ inline void drawGrid()
   for (int y = 0; y <= GRID_H; y += CELL) gfx->drawFastHLine(0, y, GRID_W, BLACK);
 }
 
+inline void drawButton(int bx, const char* label, uint16_t color)
+{
+  gfx->drawRect(bx, BTN_Y, BTN_W, BTN_H, WHITE);
+  gfx->fillRect(bx+1, BTN_Y+1, BTN_W-2, BTN_H-2, gfx->color565(60,60,60));
+  drawCenteredTextInRect(bx, BTN_Y, BTN_W, BTN_H, label, color, 2);
+}
+
+// UNDO/REDO in grigio quando non c'è niente da annullare/ripetere
+static int8_t s_undoShown = -1, s_redoShown = -1;
+
+inline void drawUndoRedoButtons()
+{
+  s_undoShown = canUndo(); s_redoShown = canRedo();
+  drawButton(BTN_UNDO_X, "UNDO", s_undoShown ? WHITE : gfx->color565(110,110,110));
+  drawButton(BTN_REDO_X, "REDO", s_redoShown ? WHITE : gfx->color565(110,110,110));
+}
+
 inline void drawBottomBar()
 {
   // Barra inferiore + pulsanti centrati
   gfx->fillRect(0, GRID_H - BOTTOM_BAR_H, GRID_W, BOTTOM_BAR_H, gfx->color565(20,20,20));
-
-  gfx->drawRect(BTN1_X, BTN_Y, BTN_W, BTN_H, WHITE);
-  gfx->fillRect(BTN1_X+1, BTN_Y+1, BTN_W-2, BTN_H-2, gfx->color565(60,60,60));
-  drawCenteredTextInRect(BTN1_X, BTN_Y, BTN_W, BTN_H, "CLEAR", YELLOW, 2);
-
-  gfx->drawRect(BTN2_X, BTN_Y, BTN_W, BTN_H, WHITE);
-  gfx->fillRect(BTN2_X+1, BTN_Y+1, BTN_W-2, BTN_H-2, gfx->color565(60,60,60));
-  drawCenteredTextInRect(BTN2_X, BTN_Y, BTN_W, BTN_H, "EXPORT", CYAN, 2);
+  drawUndoRedoButtons();
+  drawButton(BTN1_X, "CLEAR", YELLOW);
+  drawButton(BTN2_X, "EXPORT", CYAN);
 }
 
 inline void drawPalette()
@@ -209,108 +313,550 @@ inline void fullRedrawFromState()
 // ----------------------- AZIONI: CLEAR / EXPORT -----------------------
 inline void clearCanvas()
 {
-  // Reset di tutta la griglia a bianco
+  DS_REFRESH_SCOPE("clear");
+  // Reset di tutta la griglia a bianco (una sola azione nel giornale, annullabile)
+  journalBeginAction();
   for (int r = 0; r < ROWS; ++r)
     for (int c = 0; c < COLS; ++c)
-      cellColor[r][c] = WHITE;
+      setCellJournaled(r, c, WHITE);
+  memset(g_dirty, 0, sizeof(g_dirty));     // ridisegna tutto qui sotto
+  g_dirtyAny = false;
   fullRedrawFromState();
 }
 
-static inline uint16_t getPixel565FromState(int x, int y)
+// ----------------------- EXPORT SU SD -----------------------
+// L'immagine (400x480) è fatta solo di linee nere e celle piene: ogni riga si genera a run
+// (1 px di linea + CELL-1 px di cella) e le 19 righe interne di una fila di celle sono uguali,
+// quindi la riga si ricostruisce solo quando cambia la fila.
+// I colori sono al massimo 7 (palette + bianco + nero): PNG e BMP usano pixel indicizzati a 8 bit.
+#define EXPORT_PNG  0   // PNG indicizzato, zlib "stored" (~188 KB)
+#define EXPORT_BMP  1   // BMP indicizzato a 8 bit (~188 KB)
+#define EXPORT_JPEG 2   // JPEG via JPEGENC (se la libreria manca → PNG)
+#define EXPORT_FORMAT EXPORT_PNG
+
+#if EXPORT_FORMAT == EXPORT_JPEG && !CAM_USE_JPEGENC
+  #undef  EXPORT_FORMAT
+  #define EXPORT_FORMAT EXPORT_PNG
+#endif
+
+static const size_t EXPORT_CHUNK = 4096;   // scritture su SD a blocchi interi da 4 KB
+
+enum ExportState : uint8_t { EXPORT_IDLE, EXPORT_RUNNING, EXPORT_DONE_OK, EXPORT_DONE_FAIL };
+static volatile uint8_t  g_exportState = EXPORT_IDLE;
+static volatile uint16_t g_exportRows = 0;        // righe scritte (progresso)
+static uint16_t g_exportCells[ROWS][COLS];        // copia della griglia al tocco di EXPORT
+static char     g_exportPath[40];
+static TaskHandle_t g_exportTask = nullptr;
+static bool g_sdMounted = false;                  // SD.begin una volta sola, rifatto solo dopo un errore
+
+// Tabella colori dell'immagine: palette + bianco + nero, senza doppioni
+static uint16_t g_exColors[PALETTE_KEYS + 2];
+static uint8_t  g_exColorN = 0;
+
+static uint8_t exportColorIndex(uint16_t c)
 {
-  // Ricostruisce il pixel della griglia (linee nere incluse)
-  if (x < 0 || x >= GRID_W || y < 0 || y >= GRID_H) return BLACK;
-  if ((x % CELL) == 0 || (y % CELL) == 0) return BLACK; // linee griglia
-  int c = x / CELL;
-  int r = y / CELL;
-  return cellColor[r][c];
+  for (uint8_t i = 0; i < g_exColorN; ++i) if (g_exColors[i] == c) return i;
+  if (g_exColorN == PALETTE_KEYS + 2) return 0;   // tabella piena (non succede con palette fissa)
+  g_exColors[g_exColorN] = c;
+  return g_exColorN++;
 }
 
-// Callback di scrittura per JPEGENC (se presente)
-#if CAM_USE_JPEGENC
-static int jpeg_write_cb(JPEGENC *j, void *pUser, const uint8_t *pBuf, int iLen)
+static void exportBuildColors()
 {
-  File *pf = (File *)pUser;
-  if (!pf || !pf->write(pBuf, iLen)) return 0;
-  return iLen;
+  g_exColorN = 0;
+  exportColorIndex(BLACK);
+  exportColorIndex(WHITE);
+  for (int i = 0; i < PALETTE_KEYS; ++i) exportColorIndex(palette[i]);
 }
-#endif
 
-bool exportJPEGtoSD()
+static inline void rgb888From565(uint16_t c, uint8_t &r, uint8_t &g, uint8_t &b)
 {
-  // Salva l’area griglia 400x480 su SD (JPEG se possibile, altrimenti BMP)
-  if (!SD.begin(SD_CS, sdSPI)) return false;
+  r = ((c >> 11) & 0x1F) * 255 / 31;
+  g = ((c >> 5) & 0x3F) * 255 / 63;
+  b = (c & 0x1F) * 255 / 31;
+}
+
+// Riga y a indici: linea orizzontale tutta nera, altrimenti run linea/cella
+static void exportRowIdx(uint8_t *row, int y)
+{
+  const uint8_t black = exportColorIndex(BLACK);
+  if (y % CELL == 0) { memset(row, black, GRID_W); return; }
+  const int r = y / CELL;
+  for (int c = 0; c < COLS; ++c) {
+    row[c * CELL] = black;
+    memset(row + c * CELL + 1, exportColorIndex(g_exportCells[r][c]), CELL - 1);
+  }
+}
+
+// Riga di indici valida per y? (cambia solo su linea orizzontale o prima riga di una fila)
+static inline bool exportRowChanges(int y, int prevY)
+{
+  return prevY < 0 || y % CELL == 0 || prevY % CELL == 0 || y / CELL != prevY / CELL;
+}
+
+// --- Uscita a blocchi con CRC32 (per i chunk PNG) ---
+struct ExportOut {
+  File     f;
+  bool     ok = true;
+  size_t   n = 0;
+  uint32_t bytes = 0;
+  uint32_t crc = 0;
+  uint8_t  buf[EXPORT_CHUNK];
+};
+static ExportOut s_exOut;
+static uint32_t  s_crcTab[256];
+
+static void exportCrcInit()
+{
+  if (s_crcTab[1]) return;
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t c = i;
+    for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+    s_crcTab[i] = c;
+  }
+}
+
+static void exportFlush()
+{
+  if (s_exOut.n && s_exOut.ok && s_exOut.f.write(s_exOut.buf, s_exOut.n) != s_exOut.n) s_exOut.ok = false;
+  s_exOut.n = 0;
+}
+
+static void exportPut(const uint8_t *p, size_t len)
+{
+  uint32_t crc = s_exOut.crc;
+  for (size_t i = 0; i < len; ++i) crc = s_crcTab[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+  s_exOut.crc = crc;
+  s_exOut.bytes += len;
+  while (len) {
+    size_t k = EXPORT_CHUNK - s_exOut.n;
+    if (k > len) k = len;
+    memcpy(s_exOut.buf + s_exOut.n, p, k);
+    s_exOut.n += k; p += k; len -= k;
+    if (s_exOut.n == EXPORT_CHUNK) exportFlush();
+  }
+}
+
+static inline void exportPutLE(uint32_t v, int n) { uint8_t b[4]; for (int i = 0; i < n; ++i) b[i] = v >> (8 * i); exportPut(b, n); }
+static inline void exportPutBE32(uint32_t v) { uint8_t b[4] = {(uint8_t)(v >> 24), (uint8_t)(v >> 16), (uint8_t)(v >> 8), (uint8_t)v}; exportPut(b, 4); }
 
-  char path[40];
-  snprintf(path, sizeof(path), "/pixel_%lu.%s", (unsigned long)millis(), CAM_USE_JPEGENC ? "jpg" : "bmp");
-  File f = SD.open(path, FILE_WRITE);
-  if (!f) return false;
+#if EXPORT_FORMAT == EXPORT_PNG
+// --- PNG indicizzato 8 bit, IDAT unico con blocchi deflate non compressi ---
+static void pngChunkBegin(const char *type, uint32_t len)
+{
+  exportPutBE32(len);
+  s_exOut.crc = 0xFFFFFFFFu;
+  exportPut((const uint8_t *)type, 4);
+}
+
+static void pngChunkEnd() { exportPutBE32(s_exOut.crc ^ 0xFFFFFFFFu); }
+
+static bool exportPNG()
+{
+  static const uint8_t sig[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  exportPut(sig, 8);
+
+  pngChunkBegin("IHDR", 13);
+  exportPutBE32(GRID_W); exportPutBE32(GRID_H);
+  const uint8_t ihdr[5] = {8, 3, 0, 0, 0};        // 8 bit, palette, deflate, filtro 0, no interlace
+  exportPut(ihdr, 5);
+  pngChunkEnd();
+
+  pngChunkBegin("PLTE", g_exColorN * 3);
+  for (uint8_t i = 0; i < g_exColorN; ++i) {
+    uint8_t rgb[3]; rgb888From565(g_exColors[i], rgb[0], rgb[1], rgb[2]);
+    exportPut(rgb, 3);
+  }
+  pngChunkEnd();
+
+  // Dati grezzi: per riga un byte di filtro (0) + GRID_W indici, in blocchi stored da max 65535
+  const uint32_t raw = (uint32_t)GRID_H * (GRID_W + 1);
+  const uint32_t nBlocks = (raw + 65534) / 65535;
+  pngChunkBegin("IDAT", 2 + raw + 5 * nBlocks + 4);
+  const uint8_t zhdr[2] = {0x78, 0x01};
+  exportPut(zhdr, 2);
+
+  static uint8_t row[GRID_W + 1];
+  uint32_t left = raw, blockLeft = 0, a = 1, b = 0;
+  int prevY = -1;
+  for (int y = 0; y < GRID_H; ++y) {
+    if (exportRowChanges(y, prevY)) { row[0] = 0; exportRowIdx(row + 1, y); }
+    prevY = y;
+    const uint8_t *p = row;
+    uint32_t n = GRID_W + 1;
+    for (uint32_t i = 0; i < n; ++i) { a += p[i]; b += a; }   // una riga non fa traboccare a/b
+    a %= 65521; b %= 65521;
+    while (n) {
+      if (!blockLeft) {
+        blockLeft = left < 65535 ? left : 65535;
+        const uint8_t h[5] = {(uint8_t)(blockLeft == left), (uint8_t)blockLeft, (uint8_t)(blockLeft >> 8),
+                              (uint8_t)~blockLeft, (uint8_t)(~blockLeft >> 8)};
+        exportPut(h, 5);
+      }
+      uint32_t k = n < blockLeft ? n : blockLeft;
+      exportPut(p, k);
+      p += k; n -= k; blockLeft -= k; left -= k;
+    }
+    g_exportRows = y + 1;
+  }
+  exportPutBE32((b << 16) | a);                   // Adler-32
+  pngChunkEnd();
+
+  pngChunkBegin("IEND", 0);
+  pngChunkEnd();
+  return true;
+}
+#endif
+
+#if EXPORT_FORMAT == EXPORT_BMP
+// --- BMP indicizzato 8 bit (righe dal basso) ---
+static bool exportBMP()
+{
+  const uint32_t rowBytes = (GRID_W + 3) & ~3;
+  const uint32_t palBytes = g_exColorN * 4;
+  const uint32_t offBits  = 54 + palBytes;
+  const uint32_t pixelData = rowBytes * GRID_H;
+
+  exportPut((const uint8_t *)"BM", 2);
+  exportPutLE(offBits + pixelData, 4); exportPutLE(0, 4); exportPutLE(offBits, 4);
+  exportPutLE(40, 4); exportPutLE(GRID_W, 4); exportPutLE(GRID_H, 4);
+  exportPutLE(1, 2); exportPutLE(8, 2); exportPutLE(0, 4); exportPutLE(pixelData, 4);
+  exportPutLE(2835, 4); exportPutLE(2835, 4);     // 72 dpi
+  exportPutLE(g_exColorN, 4); exportPutLE(g_exColorN, 4);
+  for (uint8_t i = 0; i < g_exColorN; ++i) {
+    uint8_t r, g, b; rgb888From565(g_exColors[i], r, g, b);
+    const uint8_t q[4] = {b, g, r, 0};
+    exportPut(q, 4);
+  }
 
-#if CAM_USE_JPEGENC
-  // --- Export JPEG tramite JPEGENC (RGB565) ---
-  JPEGENC j;
-  if (j.open(&jpeg_write_cb, (void *)&f, GRID_W, GRID_H, JPEGENC_PIXEL_RGB565,
-             JPEGENC_SUBSAMPLE_420, JPEGENC_QUALITY_HIGH) == 0) {
-    f.close();
-    return false;
+  static uint8_t row[(GRID_W + 3) & ~3];
+  int prevY = -1;
+  for (int y = GRID_H - 1; y >= 0; --y) {
+    if (exportRowChanges(y, prevY)) exportRowIdx(row, y);
+    prevY = y;
+    exportPut(row, rowBytes);
+    g_exportRows = GRID_H - y;
   }
+  return true;
+}
+#endif
+
+#if EXPORT_FORMAT == EXPORT_JPEG
+// Callback di scrittura per JPEGENC
+static int jpeg_write_cb(JPEGENC *j, void *pUser, const uint8_t *pBuf, int iLen)
+{
+  exportPut(pBuf, iLen);
+  return s_exOut.ok ? iLen : 0;
+}
+
+static bool exportJPEG()
+{
+  static JPEGENC j;                               // static: troppo grande per lo stack del task
+  if (j.open(&jpeg_write_cb, nullptr, GRID_W, GRID_H, JPEGENC_PIXEL_RGB565,
+             JPEGENC_SUBSAMPLE_420, JPEGENC_QUALITY_HIGH) == 0) return false;
+  static uint8_t idx[GRID_W];
   static uint16_t line[GRID_W];
+  int prevY = -1;
   for (int y = 0; y < GRID_H; ++y) {
-    for (int x = 0; x < GRID_W; ++x) line[x] = getPixel565FromState(x, y);
+    if (exportRowChanges(y, prevY)) {
+      exportRowIdx(idx, y);
+      for (int x = 0; x < GRID_W; ++x) line[x] = g_exColors[idx[x]];
+    }
+    prevY = y;
     j.addLine((uint8_t *)line);
+    g_exportRows = y + 1;
   }
   j.close();
-  f.close();
   return true;
+}
+#endif
+
+static bool exportOpen(const char *path)
+{
+  // SD montata una volta; se l'apertura fallisce (scheda tolta/cambiata) si rimonta e si riprova
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    if (!g_sdMounted) g_sdMounted = SD.begin(SD_CS, sdSPI);
+    if (!g_sdMounted) return false;
+    s_exOut.f = SD.open(path, FILE_WRITE);
+    if (s_exOut.f) return true;
+    SD.end();
+    g_sdMounted = false;
+  }
+  return false;
+}
 
+static bool exportToSD()
+{
+  static const char *ext[] = {"png", "bmp", "jpg"};
+  snprintf(g_exportPath, sizeof(g_exportPath), "/pixel_%lu.%s", (unsigned long)millis(), ext[EXPORT_FORMAT]);
+  if (!exportOpen(g_exportPath)) return false;
+
+  exportCrcInit();
+  exportBuildColors();
+  s_exOut.ok = true; s_exOut.n = 0; s_exOut.bytes = 0;
+
+#if EXPORT_FORMAT == EXPORT_PNG
+  bool ok = exportPNG();
+#elif EXPORT_FORMAT == EXPORT_BMP
+  bool ok = exportBMP();
 #else
-  // --- Export BMP 24-bit (fallback) ---
-  const uint32_t w = GRID_W, h = GRID_H;
-  const uint32_t rowBytes = ((w * 3 + 3) & ~3);
-  const uint32_t pixelData = rowBytes * h;
-  const uint32_t fileSize = 54 + pixelData;
-
-  uint8_t hdr[54] = {
-    'B','M',
-    (uint8_t)(fileSize), (uint8_t)(fileSize>>8), (uint8_t)(fileSize>>16), (uint8_t)(fileSize>>24),
-    0,0, 0,0,
-    54,0,0,0,
-    40,0,0,0,
-    (uint8_t)(w), (uint8_t)(w>>8), (uint8_t)(w>>16), (uint8_t)(w>>24),
-    (uint8_t)(h), (uint8_t)(h>>8), (uint8_t)(h>>16), (uint8_t)(h>>24),
-    1,0, 24,0, 0,0,0,0,
-    (uint8_t)(pixelData), (uint8_t)(pixelData>>8), (uint8_t)(pixelData>>16), (uint8_t)(pixelData>>24),
-    0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0
-  };
-  f.write(hdr, 54);
-
-  std::unique_ptr<uint8_t[]> row(new uint8_t[rowBytes]);
-  for (int y = h - 1; y >= 0; --y) {
-    uint8_t *p = row.get();
-    for (int x = 0; x < (int)w; ++x) {
-      uint16_t c = getPixel565FromState(x, y);
-      uint8_t r = ((c >> 11) & 0x1F) * 255 / 31;
-      uint8_t g = ((c >> 5) & 0x3F) * 255 / 63;
-      uint8_t b = (c & 0x1F) * 255 / 31;
-      *p++ = b; *p++ = g; *p++ = r;
-    }
-    while ((p - row.get()) < (int)rowBytes) *p++ = 0; // padding a 4 byte
-    f.write(row.get(), rowBytes);
+  bool ok = exportJPEG();
+#endif
+  exportFlush();
+  ok = ok && s_exOut.ok;
+  s_exOut.f.close();
+  if (!ok) { SD.remove(g_exportPath); SD.end(); g_sdMounted = false; }
+  return ok;
+}
+
+// Task sul core 0: l'export non ferma il touch né il disegno
+static void exportTask(void *)
+{
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    uint32_t t0 = millis();
+    bool ok = exportToSD();
+    Serial.printf("[EXPORT] %s %s: %lu byte, %lu ms\n", g_exportPath, ok ? "OK" : "FAIL",
+                  (unsigned long)s_exOut.bytes, (unsigned long)(millis() - t0));
+    g_exportState = ok ? EXPORT_DONE_OK : EXPORT_DONE_FAIL;
   }
-  f.close();
+}
+
+// Avvio export: copia la griglia e sveglia il task (false se ce n'è già uno in corso)
+static bool startExport()
+{
+  if (g_exportState != EXPORT_IDLE || !g_exportTask) return false;
+  memcpy(g_exportCells, cellColor, sizeof(g_exportCells));
+  g_exportRows = 0;
+  g_exportState = EXPORT_RUNNING;
+  xTaskNotifyGive(g_exportTask);
   return true;
-#endif
 }
 
-// ----------------------- GESTIONE TOUCH (DEBOUNCE) -----------------------
-static bool prevTouched = false;                 // stato tocco precedente
-static const uint32_t TAP_COOLDOWN_MS = 700;     // cooldown tap
+// Barra inferiore durante l'export: messaggio + barra di avanzamento, poi esito per 1,2 s
+static const int EXPORT_BAR_X = 20;
+static const int EXPORT_BAR_W = GRID_W - 40;
+static const int EXPORT_BAR_Y = GRID_H - 8;
+static int      s_exportBarW = 0;                 // larghezza già riempita
+static uint32_t s_exportResultUntil = 0;
+
+inline void drawExportStart()
+{
+  gfx->fillRect(0, GRID_H - BOTTOM_BAR_H, GRID_W, BOTTOM_BAR_H, gfx->color565(20,20,20));
+  drawCenteredTextInRect(0, GRID_H - BOTTOM_BAR_H, GRID_W, BOTTOM_BAR_H - 8, "Esportazione...", WHITE, 2);
+  gfx->fillRect(EXPORT_BAR_X, EXPORT_BAR_Y, EXPORT_BAR_W, 4, gfx->color565(60,60,60));
+  s_exportBarW = 0;
+}
+
+static void updateExportBar(uint32_t nowMs)
+{
+  if (g_exportState == EXPORT_RUNNING) {
+    int w = (int)g_exportRows * EXPORT_BAR_W / GRID_H;
+    if (w > s_exportBarW) {                        // solo il pezzo nuovo
+      gfx->fillRect(EXPORT_BAR_X + s_exportBarW, EXPORT_BAR_Y, w - s_exportBarW, 4, CYAN);
+      s_exportBarW = w;
+    }
+  } else if (g_exportState != EXPORT_IDLE) {
+    if (!s_exportResultUntil) {
+      const bool ok = (g_exportState == EXPORT_DONE_OK);
+      gfx->fillRect(0, GRID_H - BOTTOM_BAR_H, GRID_W, BOTTOM_BAR_H, gfx->color565(20,20,20));
+      drawCenteredTextInRect(0, GRID_H - BOTTOM_BAR_H, GRID_W, BOTTOM_BAR_H,
+                             ok ? "Export OK" : "Export FAIL", ok ? GREEN : RED, 2);
+      s_exportResultUntil = nowMs + 1200;
+    } else if ((int32_t)(nowMs - s_exportResultUntil) >= 0) {
+      drawBottomBar();
+      s_exportResultUntil = 0;
+      g_exportState = EXPORT_IDLE;
+    }
+  }
+}
+
+// ----------------------- GESTIONE TOUCH -----------------------
+// Il GT911 si legge in un task a parte ogni TOUCH_POLL_MS (il controller produce un report
+// ogni ~10 ms): ogni campione diventa un evento in coda con il suo istante. Il loop svuota
+// la coda a ogni frame, unisce i punti di un tratto con Bresenham sulle celle e ridisegna
+// le celle cambiate una volta sola.
+static const uint32_t TOUCH_POLL_MS = 5;
+static const uint32_t FRAME_MS = 16;             // attesa massima di un frame senza eventi
+static const uint32_t TAP_COOLDOWN_MS = 700;     // cooldown tap pulsanti
 static uint32_t lastClearMs  = 0;                // ultimo CLEAR
 static uint32_t lastExportMs = 0;                // ultimo EXPORT
 
+enum TouchType : uint8_t { TOUCH_DOWN, TOUCH_MOVE, TOUCH_UP };
+struct TouchEvent {
+  int16_t  x, y;
+  uint8_t  type;
+  uint32_t us;                                   // istante del campione (micros)
+};
+static QueueHandle_t g_touchQueue = nullptr;
+static volatile uint32_t g_touchDropped = 0;     // eventi persi a coda piena
+
+static void touchTask(void *)
+{
+  bool prev = false;
+  int16_t px = -1, py = -1;
+  for (;;) {
+    ts.read();
+    const bool now = ts.isTouched;
+    TouchEvent ev;
+    ev.us = micros();
+    if (now) {
+      // Mappa coordinate GT911 → schermo (portrait)
+      int x = ts.points[0].y;
+      int y = 480 - ts.points[0].x;
+      ev.x = x > 479 ? 479 : x;
+      ev.y = y > 479 ? 479 : (y < 0 ? 0 : y);
+      ev.type = prev ? TOUCH_MOVE : TOUCH_DOWN;
+      if (ev.type == TOUCH_DOWN || ev.x != px || ev.y != py) {
+        if (xQueueSend(g_touchQueue, &ev, 0) != pdTRUE) g_touchDropped++;
+        px = ev.x; py = ev.y;
+      }
+    } else if (prev) {
+      ev.x = px; ev.y = py; ev.type = TOUCH_UP;
+      if (xQueueSend(g_touchQueue, &ev, 0) != pdTRUE) g_touchDropped++;
+    }
+    prev = now;
+    vTaskDelay(pdMS_TO_TICKS(TOUCH_POLL_MS));
+  }
+}
+
+// Tratto in corso: colore deciso al tocco iniziale (cella bianca → colore, colorata → bianco)
+static bool     s_strokeOn = false;
+static bool     s_strokeEnded = false;           // TOUCH_UP arrivato, report dopo il frame
+static uint16_t s_strokeColor = WHITE;
+static int      s_lastR = -1, s_lastC = -1;      // ultima cella del tratto (-1: fuori griglia)
+static uint32_t s_strokeVisited[(ROWS * COLS + 31) / 32];
+
+// Statistiche del tratto: latenza tocco → cella a schermo, celle/s
+struct StrokeStats {
+  uint32_t t0Us = 0, t1Us = 0, samples = 0, cells = 0, frames = 0;
+  uint32_t latSumUs = 0, latMaxUs = 0;
+};
+static StrokeStats s_stroke;
+
+static void strokeCell(int r, int c)
+{
+  const int idx = r * COLS + c;
+  if (s_strokeVisited[idx >> 5] & (1u << (idx & 31))) return;   // una volta per tratto
+  s_strokeVisited[idx >> 5] |= 1u << (idx & 31);
+  setCellJournaled(r, c, s_strokeColor);
+}
+
+// Celle attraversate dal segmento (r0,c0) → (r1,c1), estremi inclusi
+static void strokeLine(int r0, int c0, int r1, int c1)
+{
+  const int dc = abs(c1 - c0), sc = c0 < c1 ? 1 : -1;
+  const int dr = -abs(r1 - r0), sr = r0 < r1 ? 1 : -1;
+  int err = dc + dr;
+  for (;;) {
+    strokeCell(r0, c0);
+    if (r0 == r1 && c0 == c1) break;
+    const int e2 = 2 * err;
+    if (e2 >= dr) { err += dr; c0 += sc; }
+    if (e2 <= dc) { err += dc; r0 += sr; }
+  }
+}
+
+static inline bool inPaintArea(int x, int y) { return x < GRID_W && y < GRID_H - BOTTOM_BAR_H; }
+
+static void strokePoint(int x, int y)
+{
+  if (!inPaintArea(x, y)) { s_lastR = s_lastC = -1; return; }
+  const int r = y / CELL, c = x / CELL;
+  if (s_lastR < 0) strokeCell(r, c);
+  else strokeLine(s_lastR, s_lastC, r, c);
+  s_lastR = r; s_lastC = c;
+}
+
+static void onBarTap(int x, int y, uint32_t nowMs)
+{
+  if (g_exportState != EXPORT_IDLE) return;      // barra occupata da avanzamento/esito
+  if (inRect(x, y, BTN_UNDO_X, BTN_Y, BTN_W, BTN_H)) {
+    undoAction();
+  } else if (inRect(x, y, BTN_REDO_X, BTN_Y, BTN_W, BTN_H)) {
+    redoAction();
+  } else if (inRect(x, y, BTN1_X, BTN_Y, BTN_W, BTN_H)) {
+    if (nowMs - lastClearMs > TAP_COOLDOWN_MS) {
+      lastClearMs = nowMs;
+      clearCanvas();
+    }
+  } else if (inRect(x, y, BTN2_X, BTN_Y, BTN_W, BTN_H)) {
+    if (nowMs - lastExportMs > TAP_COOLDOWN_MS) {
+      lastExportMs = nowMs;
+      // Export in background: qui solo il messaggio, l'avanzamento lo aggiorna il loop
+      if (startExport()) drawExportStart();
+    }
+  }
+}
+
+static void handleTouch(const TouchEvent &ev)
+{
+  if (ev.type == TOUCH_DOWN) {
+    if (ev.x >= PALETTE_X) {
+      // Tocco in colonna palette (destra): selezione colore
+      int key = ev.y / KEY_H;
+      if (key >= 0 && key < PALETTE_KEYS && key != currentColorIndex) {
+        currentColorIndex = key;
+        drawPalette();
+      }
+    } else if (!inPaintArea(ev.x, ev.y)) {
+      onBarTap(ev.x, ev.y, millis());
+    } else {
+      // Nuovo tratto: il colore lo decide la prima cella (toggle colore <-> bianco)
+      const uint16_t curr = cellColor[ev.y / CELL][ev.x / CELL];
+      s_strokeColor = (curr != WHITE) ? WHITE : palette[currentColorIndex];
+      s_strokeOn = true;
+      s_lastR = s_lastC = -1;
+      memset(s_strokeVisited, 0, sizeof(s_strokeVisited));
+      s_stroke = StrokeStats();
+      s_stroke.t0Us = ev.us;
+      journalBeginAction();
+      strokePoint(ev.x, ev.y);
+    }
+  } else if (s_strokeOn) {
+    s_stroke.samples++;
+    if (ev.type == TOUCH_MOVE) { strokePoint(ev.x, ev.y); return; }
+    s_strokeOn = false;
+    s_strokeEnded = true;
+    s_stroke.t1Us = ev.us;
+  }
+}
+
+// A fine tratto (dopo l'ultimo frame disegnato)
+static void reportStroke()
+{
+  const uint32_t dt = s_stroke.t1Us - s_stroke.t0Us;
+  if (s_stroke.frames)
+    Serial.printf("[TOUCH] tratto: %lu campioni, %lu celle in %lu ms (%lu celle/s), "
+                  "latenza tocco->cella media %lu us, max %lu us, persi %lu\n",
+                  (unsigned long)s_stroke.samples + 1, (unsigned long)s_stroke.cells, (unsigned long)(dt / 1000),
+                  (unsigned long)(dt ? (uint64_t)s_stroke.cells * 1000000 / dt : 0),
+                  (unsigned long)(s_stroke.latSumUs / s_stroke.frames), (unsigned long)s_stroke.latMaxUs,
+                  (unsigned long)g_touchDropped);
+}
+
+// Ridisegna le celle cambiate nel frame; ritorna quante
+static int flushDirtyCells()
+{
+  int n = 0;
+  for (int w = 0; w < (int)(sizeof(g_dirty) / sizeof(g_dirty[0])); ++w) {
+    uint32_t m = g_dirty[w];
+    if (!m) continue;
+    g_dirty[w] = 0;
+    while (m) {
+      const int idx = w * 32 + __builtin_ctz(m);
+      m &= m - 1;
+      drawCell(idx / COLS, idx % COLS, cellColor[idx / COLS][idx % COLS]);
+      ++n;
+    }
+  }
+  return n;
+}
+
 // ----------------------- SETUP -----------------------
 void setup()
 {
+  Serial.begin(115200);
   // Retroilluminazione
   ledcSetup(PWM_CHANNEL, PWM_FREQ, PWM_BITS);
   ledcAttachPin(GFX_BL, PWM_CHANNEL);
@@ -322,8 +868,13 @@ void setup()
   ts.begin();
   ts.setRotation(0);
 
-  // SD (SPI)
+  // SD (SPI): montata al primo export, dal task dedicato
   sdSPI.begin(SD_SCK, SD_MISO, SD_MOSI);
+  xTaskCreatePinnedToCore(exportTask, "export", 8192, nullptr, 1, &g_exportTask, 0);
+
+  // Touch: campionato in un task, eventi in coda per il loop
+  g_touchQueue = xQueueCreate(64, sizeof(TouchEvent));
+  xTaskCreatePinnedToCore(touchTask, "touch", 3072, nullptr, 2, nullptr, 0);
 
   // Inizializza griglia a bianco
   for (int r = 0; r < ROWS; ++r)
@@ -336,73 +887,32 @@ void setup()
 // ----------------------- LOOP PRINCIPALE -----------------------
 void loop()
 {
-  ts.read();
-  bool touchedNow = ts.isTouched;
-
-  // Attiva le azioni solo sul “fronte di discesa” del tocco (tap)
-  if (touchedNow && !prevTouched)
-  {
-    uint16_t tx = ts.points[0].x;
-    uint16_t ty = ts.points[0].y;
-
-    // Mappa coordinate GT911 → schermo (portrait)
-    uint16_t x = ty;
-    uint16_t y = 480 - tx;
-    if (x > 479) x = 479;
-    if (y > 479) y = 479;
-
-    uint32_t nowMs = millis();
+  // Primo evento con attesa (al massimo un frame), poi tutti quelli già in coda
+  TouchEvent ev;
+  uint32_t oldestUs = 0;
+  if (xQueueReceive(g_touchQueue, &ev, pdMS_TO_TICKS(FRAME_MS)) == pdTRUE) {
+    oldestUs = ev.us;
+    do handleTouch(ev); while (xQueueReceive(g_touchQueue, &ev, 0) == pdTRUE);
+  }
 
-    // Tocco in colonna palette (destra): selezione colore
-    if (x >= PALETTE_X) {
-      int key = y / KEY_H;
-      if (key >= 0 && key < PALETTE_KEYS && key != currentColorIndex) {
-        currentColorIndex = key;
-        drawPalette();
-      }
-    } else {
-      // Tocco in barra inferiore: CLEAR / EXPORT
-      if (y >= GRID_H - BOTTOM_BAR_H) {
-        if (inRect(x, y, BTN1_X, BTN_Y, BTN_W, BTN_H)) {
-          if (nowMs - lastClearMs > TAP_COOLDOWN_MS) {
-            lastClearMs = nowMs;
-            clearCanvas();
-          }
-        } else if (inRect(x, y, BTN2_X, BTN_Y, BTN_W, BTN_H)) {
-          if (nowMs - lastExportMs > TAP_COOLDOWN_MS) {
-            lastExportMs = nowMs;
-
-            // Messaggio centrato durante l’export
-            gfx->fillRect(0, GRID_H - BOTTOM_BAR_H, GRID_W, BOTTOM_BAR_H, gfx->color565(20,20,20));
-            drawCenteredTextInRect(0, GRID_H - BOTTOM_BAR_H, GRID_W, BOTTOM_BAR_H, "Esportazione...", WHITE, 2);
-
-            bool ok = exportJPEGtoSD();
-
-            // Esito centrato, poi ripristino barra
-            gfx->fillRect(0, GRID_H - BOTTOM_BAR_H, GRID_W, BOTTOM_BAR_H, gfx->color565(20,20,20));
-            drawCenteredTextInRect(0, GRID_H - BOTTOM_BAR_H, GRID_W, BOTTOM_BAR_H,
-                                   ok ? "Export OK" : "Export FAIL", ok ? GREEN : RED, 2);
-            delay(1200);
-            drawBottomBar();
-          }
-        }
-      } else {
-        // Disegno nella griglia: toggle colore <-> bianco
-        int c = x / CELL;
-        int r = y / CELL;
-        if (r >= 0 && r < ROWS && c >= 0 && c < COLS) {
-          uint16_t curr = cellColor[r][c];
-          // Se la cella è già colorata -> torna bianca; se è bianca -> colora
-          uint16_t next = (curr != WHITE) ? WHITE : palette[currentColorIndex];
-          if (curr != next) {
-            cellColor[r][c] = next;
-            drawCell(r, c, next);
-          }
-        }
-      }
+  // Celle cambiate nel frame (tratto, undo/redo): un drawCell per cella
+  if (g_dirtyAny) {
+    int n;
+    {
+      DS_FRAME_SCOPE("celle");
+      n = flushDirtyCells();
+      g_dirtyAny = false;
+    }
+    if (oldestUs && (s_strokeOn || s_strokeEnded)) {
+      const uint32_t lat = micros() - oldestUs;
+      s_stroke.cells += n; s_stroke.frames++;
+      s_stroke.latSumUs += lat;
+      if (lat > s_stroke.latMaxUs) s_stroke.latMaxUs = lat;
     }
   }
+  if (s_strokeEnded) { reportStroke(); s_strokeEnded = false; }
 
-  prevTouched = touchedNow;
-  delay(20); // piccoli ritardo per stabilizzare letture touch
+  if (g_exportState == EXPORT_IDLE && (s_undoShown != canUndo() || s_redoShown != canRedo()))
+    drawUndoRedoButtons();
+  updateExportBar(millis());
 }
@@ -0,0 +1,216 @@
+/*
+  FxPool.h – particelle degli effetti di Pongino in struttura di array (SoA)
+
+  Al posto di Particle particles[MAX_PARTICLES] (struct con float e flag, 160 slot
+  scorsi tutti a ogni tick):
+    - campi in array separati, posizioni e velocità in virgola fissa Q8 (niente float);
+    - le particelle vive stanno compatte in [0, n): una che muore prende il posto
+      dell'ultima (swap-remove), update e disegno toccano solo le vive;
+    - le zone sporche non vanno a damage() una per particella: si accumulano per
+      fascia di FX_BAND righe in al più FX_SPANS tratti e partono tutte insieme
+      con flushDamage() (le particelle sulla stessa riga finiscono nello stesso tratto);
+    - il disegno usa una lista costruita una volta per frame (buildDrawList): chiavi
+      ordinate per fascia, dimensione, colore, riga e x. La striscia del compositore
+      visita solo le fasce che tocca, e le particelle uguali e adiacenti sulla stessa
+      riga diventano un solo rettangolo.
+  Estetica pura: ha un generatore suo e non tocca lo stato della simulazione (simHash).
+
+  Uso nello sketch:
+    #include "FxPool.h"
+    static FxPool fx;
+    fx.spawn(x << FX_SHIFT, y << FX_SHIFT, vx, vy, life, color, sz, flags);
+    fx.update();                          // a ogni tick
+    fx.flushDamage(damage);               // inizio composeFrame
+    fx.buildDrawList();                   // poi, se c'è qualcosa da ridisegnare
+    fx.draw(ty, th, fill);                // per ogni striscia; fill(x, y, w, h, colore)
+
+  Senza Arduino: lo include anche tools/fxbench.cpp per misurare il costo su PC.
+*/
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+
+#ifndef FX_MAX
+#define FX_MAX 640                 // particelle vive al massimo
+#endif
+#ifndef FX_W
+#define FX_W 480
+#endif
+#ifndef FX_H
+#define FX_H 480
+#endif
+
+#define FX_SHIFT     8             // Q8
+#define FX_BAND_BITS 4             // fasce di 16 righe
+#define FX_BAND      (1 << FX_BAND_BITS)
+#define FX_BANDS     ((FX_H + FX_BAND - 1) >> FX_BAND_BITS)
+#define FX_SPANS     4             // tratti sporchi per fascia
+#define FX_SPAN_GAP  16            // due tratti più vicini di così si fondono
+#define FX_MAX_SZ    4
+#define FX_GRAVITY   20            // 0.08 px/tick² in Q8
+
+enum : uint8_t { FX_OOB_ONLY = 1 };  // vive finché non esce dallo schermo
+
+struct FxPool {
+  // Solo [0, n) è valido
+  int32_t  x[FX_MAX], y[FX_MAX];         // Q8
+  int16_t  vx[FX_MAX], vy[FX_MAX];       // Q8 px/tick
+  int16_t  px[FX_MAX], py[FX_MAX];       // posizione disegnata (pixel)
+  uint16_t color[FX_MAX];
+  uint8_t  life[FX_MAX], sz[FX_MAX], flags[FX_MAX];
+  uint16_t n = 0;
+  uint32_t rng = 1;
+
+  struct Span { int16_t x0, y0, x1, y1; };
+  Span     spans[FX_BANDS][FX_SPANS];
+  uint8_t  spanCount[FX_BANDS] = {};
+  uint32_t dirtyBands = 0;               // bit b: la fascia b ha tratti da mandare
+
+  uint32_t keys[FX_MAX];                 // lista di disegno, per fascia
+  uint16_t bandStart[FX_BANDS + 1] = {};
+
+  static_assert(FX_BANDS <= 32, "dirtyBands è a 32 bit");
+  static_assert(FX_W <= 512 && FX_BAND <= 16, "chiave di disegno: x su 9 bit, riga su 4");
+
+  // [lo, hi) come random(), generatore proprio
+  int rnd(int lo, int hi) {
+    if (hi <= lo) return lo;
+    rng = rng * 1664525u + 1013904223u;
+    return lo + (int)((rng >> 8) % (uint32_t)(hi - lo));
+  }
+
+  void clear() {
+    n = 0;
+    memset(spanCount, 0, sizeof(spanCount));
+    dirtyBands = 0;
+    memset(bandStart, 0, sizeof(bandStart));
+  }
+
+  // false solo a pool pieno; fuori schermo non nasce (la chiave di disegno vuole x, y >= 0)
+  bool spawn(int32_t qx, int32_t qy, int qvx, int qvy, uint8_t lf, uint16_t c, uint8_t s, uint8_t fl) {
+    if (n >= FX_MAX) return false;
+    if ((unsigned)(qx >> FX_SHIFT) >= FX_W || (unsigned)(qy >> FX_SHIFT) >= FX_H) return true;
+    const uint16_t i = n++;
+    x[i] = qx; y[i] = qy; vx[i] = (int16_t)qvx; vy[i] = (int16_t)qvy;
+    life[i] = lf; color[i] = c; sz[i] = s; flags[i] = fl;
+    px[i] = (int16_t)(qx >> FX_SHIFT); py[i] = (int16_t)(qy >> FX_SHIFT);
+    mark(px[i], py[i], s);
+    return true;
+  }
+
+  // Un tick: gravità, moto, vita; le morte lasciano il posto all'ultima
+  void update() {
+    for (uint16_t i = 0; i < n; ) {
+      vy[i] += FX_GRAVITY;
+      x[i]  += vx[i];
+      y[i]  += vy[i];
+      const int ix = x[i] >> FX_SHIFT, iy = y[i] >> FX_SHIFT;
+      bool dead = (unsigned)ix >= FX_W || (unsigned)iy >= FX_H;
+      if (!dead && !(flags[i] & FX_OOB_ONLY)) { if (life[i]) life[i]--; else dead = true; }
+      if (dead) { mark(px[i], py[i], sz[i]); remove(i); continue; }
+      if (ix != px[i] || iy != py[i]) {
+        mark(px[i], py[i], sz[i]);
+        mark(ix, iy, sz[i]);
+        px[i] = (int16_t)ix; py[i] = (int16_t)iy;
+      }
+      ++i;
+    }
+  }
+
+  // Spegne le particelle con il centro (posizione Q8) nel rettangolo
+  void killIn(int rx, int ry, int rw, int rh) {
+    for (uint16_t i = 0; i < n; ) {
+      const int ix = x[i] >> FX_SHIFT, iy = y[i] >> FX_SHIFT;
+      if (ix >= rx && ix < rx + rw && iy >= ry && iy < ry + rh) { mark(px[i], py[i], sz[i]); remove(i); continue; }
+      ++i;
+    }
+  }
+
+  // Manda i tratti accumulati a damage(x, y, w, h) e svuota le fasce
+  template <class F>
+  void flushDamage(F damage) {
+    while (dirtyBands) {
+      const int b = __builtin_ctz(dirtyBands);
+      dirtyBands &= dirtyBands - 1;
+      for (int k = 0; k < spanCount[b]; ++k) {
+        const Span &s = spans[b][k];
+        damage(s.x0, s.y0, s.x1 - s.x0, s.y1 - s.y0);
+      }
+      spanCount[b] = 0;
+    }
+  }
+
+  // Chiave: dimensione (2 bit) | colore (16) | riga nella fascia (4) | x (9); la fascia è l'indice
+  void buildDrawList() {
+    uint16_t cnt[FX_BANDS + 1] = {};
+    for (uint16_t i = 0; i < n; ++i) cnt[(py[i] >> FX_BAND_BITS) + 1]++;
+    for (int b = 0; b < FX_BANDS; ++b) cnt[b + 1] += cnt[b];
+    memcpy(bandStart, cnt, sizeof(bandStart));
+    for (uint16_t i = 0; i < n; ++i) {
+      const int b = py[i] >> FX_BAND_BITS;
+      keys[cnt[b]++] = (uint32_t)(sz[i] - 2) << 29 | (uint32_t)color[i] << 13
+                     | (uint32_t)(py[i] & (FX_BAND - 1)) << 9 | (uint32_t)px[i];
+    }
+    for (int b = 0; b < FX_BANDS; ++b) {
+      if (bandStart[b + 1] - bandStart[b] > 1) std::sort(keys + bandStart[b], keys + bandStart[b + 1]);
+    }
+  }
+
+  // Particelle che toccano le righe [ty, ty + th): un fill per tratto di riga uguale
+  template <class F>
+  void draw(int ty, int th, F fill) const {
+    const int b0 = std::max(0, ty - (FX_MAX_SZ - 1)) >> FX_BAND_BITS;
+    const int b1 = std::min(FX_BANDS - 1, (ty + th - 1) >> FX_BAND_BITS);
+    for (int b = b0; b <= b1; ++b) {
+      uint32_t run = 0xFFFFFFFF;           // chiave senza x del tratto aperto
+      int rx0 = 0, rx1 = 0, ry = 0, rs = 0;
+      uint16_t rc = 0;
+      for (uint16_t k = bandStart[b]; k < bandStart[b + 1]; ++k) {
+        const uint32_t key = keys[k];
+        const int s  = (int)(key >> 29) + 2;
+        const int yy = (b << FX_BAND_BITS) | (int)((key >> 9) & (FX_BAND - 1));
+        if (yy >= ty + th || yy + s <= ty) continue;
+        const int xx = (int)(key & 511);
+        if ((key >> 9) == run && xx <= rx1) { if (xx + s > rx1) rx1 = xx + s; continue; }
+        if (run != 0xFFFFFFFF) fill(rx0, ry, rx1 - rx0, rs, rc);
+        run = key >> 9; rx0 = xx; rx1 = xx + s; ry = yy; rs = s; rc = (uint16_t)(key >> 13);
+      }
+      if (run != 0xFFFFFFFF) fill(rx0, ry, rx1 - rx0, rs, rc);
+    }
+  }
+
+private:
+  void remove(uint16_t i) {
+    const uint16_t j = --n;
+    if (i == j) return;
+    x[i] = x[j]; y[i] = y[j]; vx[i] = vx[j]; vy[i] = vy[j];
+    px[i] = px[j]; py[i] = py[j]; color[i] = color[j];
+    life[i] = life[j]; sz[i] = sz[j]; flags[i] = flags[j];
+  }
+
+  // Rettangolo sporco nella fascia della sua prima riga: allarga il tratto vicino o ne apre uno
+  void mark(int rx, int ry, int s) {
+    int x0 = std::max(rx, 0), y0 = std::max(ry, 0);
+    int x1 = std::min(rx + s, FX_W), y1 = std::min(ry + s, FX_H);
+    if (x0 >= x1 || y0 >= y1) return;
+    const int b = y0 >> FX_BAND_BITS;
+    Span *sp = spans[b];
+    uint8_t &c = spanCount[b];
+    int best = -1, bestGap = 0x7FFF;
+    for (int k = 0; k < c; ++k) {
+      const int gap = std::max(sp[k].x0 - x1, x0 - sp[k].x1);   // <= 0: si toccano
+      if (gap < bestGap) { bestGap = gap; best = k; }
+    }
+    if (best < 0 || (bestGap > FX_SPAN_GAP && c < FX_SPANS)) {
+      sp[c++] = { (int16_t)x0, (int16_t)y0, (int16_t)x1, (int16_t)y1 };
+      dirtyBands |= 1u << b;
+      return;
+    }
+    Span &t = sp[best];
+    if (x0 < t.x0) t.x0 = (int16_t)x0;
+    if (y0 < t.y0) t.y0 = (int16_t)y0;
+    if (x1 > t.x1) t.x1 = (int16_t)x1;
+    if (y1 > t.y1) t.y1 = (int16_t)y1;
+  }
+};
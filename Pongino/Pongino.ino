@@ -6,11 +6,17 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <Arduino_GFX_Library.h>
+
+// Contatori di disegno su Serial (1 = attivi, 0 = nessun costo)
+#define DRAW_STATS 0
+#include <DrawStats.h>
+#include "FxPool.h"    // particelle degli effetti: array separati, solo le vive (tools/fxbench.cpp)
 #include <TAMC_GT911.h>
 #include <math.h>
 
 // === Splash image ===
-#include "Pongino.h"   // definisce PONGINO_WIDTH/HEIGHT e const uint16_t Pongino[] PROGMEM
+#include <Q565.h>      // decoder a righe (asset generati con tools/img2q565.py)
+#include "Pongino.h"   // definisce PONGINO_WIDTH/HEIGHT e const uint8_t Pongino_q565[] PROGMEM
 
 // ---------- BUS SWSPI per init ST7701 (come OraQuadra) ----------
 Arduino_DataBus *bus = new Arduino_SWSPI(
@@ -31,7 +37,7 @@ Arduino_ESP32RGBPanel *rgbpanel = new Arduino_ESP32RGBPanel(
 );
 
 // ---------- Display ST7701 type9 (come OraQuadra) ----------
-Arduino_RGB_Display *gfx = new Arduino_RGB_Display(
+DrawStatsDisplay *gfx = new DrawStatsDisplay(
   480, 480, rgbpanel, 0 /* rotation */, true /* auto_flush */,
   bus, GFX_NOT_DEFINED /* RST */,
   st7701_type9_init_operations, sizeof(st7701_type9_init_operations)
@@ -77,7 +83,9 @@ static const uint16_t COL_HINT   = 0x7BEF;
 static uint16_t COL_PADDLE = COL_PADDLE_DEF;
 static uint16_t COL_PEND   = COL_PEND_DEF;
 
-static const int   FRAME_INTERVAL_MS = 11;
+// Simulazione a passo fisso: un tick = il vecchio frame, la velocità di gioco non cambia
+static const uint32_t SIM_TICK_MS     = 11;
+static const uint32_t SIM_MAX_CATCHUP = 4;   // tick massimi recuperati in un giro di loop()
 static const int   PADDLE_W_BASE = 90;
 static const int   PADDLE_H = 12;
 static const int   PADDLE_Y = SCREEN_H - 40;
@@ -87,10 +95,13 @@ static const int   PADDLE_W_BUFF   = (int)(PADDLE_W_BASE * 1.3f + 0.5f);
 static const int   PADDLE_W_DEBUFF = (PADDLE_W_BASE / 2 > 10) ? (PADDLE_W_BASE / 2) : 10;
 
 // === Palla ===
+// Posizione e velocità in Q8 (1/256 px): solo interi, stesso risultato su ESP32 e su PC
+static const int     FIX_SHIFT = 8;
+static const int32_t FIX_ONE   = 1 << FIX_SHIFT;
 static const int   BALL_SIZE = 10;
-static const float BALL_SPEED_INIT = 3.0f;
-static const float BALL_SPEED_INC  = 0.04f;
-static const float BALL_SPEED_MAX  = 6.0f;
+static const int32_t BALL_SPEED_INIT = 3 * FIX_ONE;   // px/tick
+static const int32_t BALL_SPEED_INC  = 10;            // ~0.04 px/tick a ogni rimbalzo sul paddle
+static const int32_t BALL_SPEED_MAX  = 6 * FIX_ONE;
 
 static const int BRICK_ROWS = 6;
 static const int BRICK_COLS = 8;
@@ -107,21 +118,14 @@ Star stars[STAR_COUNT];
 static const uint16_t STAR_COLORS[3] = { 0x2104, 0x4208, 0x6318 };
 
 // ---------- Particelle esplosione ----------
-static const int MAX_PARTICLES = 160;
-struct Particle {
-  float x,y,vx,vy;
-  uint8_t life;
-  uint16_t color;
-  bool alive;
-  int px,py;
-  uint8_t sz;
-  bool oobOnly;
-  bool behindPaddle;
-};
-Particle particles[MAX_PARTICLES];
+// Pool in FxPool.h (FX_MAX vive al massimo); quante ne lancia ogni esplosione:
+static const int FX_BRICK_COUNT   = 24;   // mattone rotto (cadono fino a uscire dallo schermo)
+static const int FX_MISSILE_COUNT = 32;   // missile sul paddle
+static const int FX_PADDLE_COUNT  = 56;   // navicella (due colori: questo e 7/8)
+static FxPool fx;
 
 // ---------- Stati ----------
-struct BallS { float x, y, vx, vy; };
+struct BallS { int32_t x, y, vx, vy; };   // Q8
 struct PaddleS { int x, y, w, h; };
 struct Brick { int x, y, w, h; bool alive; uint16_t color; };
 
@@ -161,17 +165,17 @@ struct Bonus {
   int px,py;
   int vy;
   uint16_t color;
-  // S-curve
+  // S-curve (angoli in 1/256 di giro, niente sinf: deve dare lo stesso x ovunque)
   int   baseX;
   int   sAmp;
-  float sOmega;
-  float sPhase;
+  int   sOmega;   // Q8: giri/256 per pixel di caduta (188 = 0.018 rad/px)
+  int   sPhase;
 };
-Bonus bonusDrop = { false, 0,0, 18,14, 0,0, 3, 0x07FF, 0, 20, 0.018f, 0.0f };
+Bonus bonusDrop = { false, 0,0, 18,14, 0,0, 3, 0x07FF, 0, 20, 188, 0 };
 uint32_t lastBonusMs = 0;
 const uint32_t BONUS_PERIOD_MS = 8000;
 
-Bonus pdownDrop = { false, 0,0, 18,14, 0,0, 3, 0xF81F, 0, 20, 0.018f, 0.0f };
+Bonus pdownDrop = { false, 0,0, 18,14, 0,0, 3, 0xF81F, 0, 20, 188, 0 };
 uint32_t lastPowerDownMs = 0;
 const uint32_t PDOWN_PERIOD_MS = 16000;
 
@@ -198,6 +202,8 @@ struct Missile {
   int px,py;
   int vy;
   uint16_t color;
+  int  flick;    // tremolio fiamma, scelto nell'update (il disegno deve essere ripetibile)
+  bool flame2;
 };
 static const int MAX_MISSILES = 10;
 Missile missiles[MAX_MISSILES];
@@ -210,10 +216,9 @@ static const uint32_t PADDLE_BLINK_MS   = 90;
 static const uint32_t PADDLE_BLINK_DUR  = 2600;
 static uint8_t paddleBlinkStep = 0;
 
-// ---------- HUD anti-flicker ----------
+// ---------- HUD ----------
 static int lastScore = -1;
 static int lastLives = -1;
-static uint32_t lastHUDms = 0;
 
 // ---------- Hover bricks ----------
 static int8_t   BRICK_HOVER_DELTA = 0;
@@ -221,7 +226,6 @@ static int8_t   BRICK_HOVER_DIR   = 1;
 static uint32_t BRICK_HOVER_LAST  = 0;
 static const uint32_t BRICK_HOVER_STEP_MS = 35;
 static const int8_t   BRICK_HOVER_MAX     = 22;
-static bool     BRICK_NEED_REPAINT = false;
 
 // ---------- Shuffle periodico ----------
 static uint32_t lastShuffleMs = 0;
@@ -230,6 +234,20 @@ static uint32_t shuffleMsgUntilMs = 0;
 // ---------- Quad ----------
 enum Quad { Q_NONE, Q_TL, Q_TR, Q_BL, Q_BR };
 
+// ---------- Compositor (tipi) ----------
+struct DRect { int16_t x0, y0, x1, y1; };   // zona sporca, estremi x1/y1 esclusivi
+struct Drawn { bool on; int x, y, w, h; };  // ultimo rettangolo disegnato di uno sprite
+
+// ---------- Fisica (tipi) ----------
+enum SweepKind { SW_NONE, SW_WALL, SW_PADDLE, SW_BRICK };
+struct SweepHit {
+  int64_t t;               // istante di contatto sul segmento
+  bool    hitX, hitY;      // faccia colpita (entrambe = spigolo)
+  SweepKind kind;
+  int     idx;             // mattone
+  int     x, y, w, h;      // box colpito, pixel
+};
+
 // ===== Utilità colore =====
 static inline uint16_t clamp565(int r,int g,int b){
   if (r<0) r=0; if(r>31) r=31;
@@ -266,6 +284,37 @@ static inline int rngRange(uint32_t &s, int lo, int hi){ // [lo,hi]
   return lo + (int)(r % (uint32_t)(hi - lo + 1));
 }
 
+// ===== Stato della simulazione =====
+// Tutto ciò che decide la partita usa simTick/simMs() e simRandom(): con lo stesso seme
+// e gli stessi input una partita si ripete identica (vedi Registrazione / replay).
+// Particelle, fiamme e stelle restano su random(): sono solo estetica.
+static uint32_t simTick = 0;
+static uint32_t simRng  = 1;
+static bool     simHeadless = false;   // benchmark: niente disegno né animazioni bloccanti
+
+static inline uint32_t simMs() { return simTick * SIM_TICK_MS; }
+static inline int ballPX() { return ball.x >> FIX_SHIFT; }   // angolo in alto a sinistra, pixel
+static inline int ballPY() { return ball.y >> FIX_SHIFT; }
+static inline long simRandom(long lo, long hi) {   // [lo,hi) come random()
+  if (hi <= lo) return lo;
+  return lo + (long)((rngNext(simRng) >> 8) % (uint32_t)(hi - lo));
+}
+
+// Seno intero: angolo in 1/256 di giro, risultato in Q8 (-256..256)
+static const int16_t SIN_Q8[65] = {
+  0, 6, 13, 19, 25, 31, 38, 44, 50, 56, 62, 68, 74, 80, 86, 92,
+  98, 104, 109, 115, 121, 126, 132, 137, 142, 147, 152, 157, 162, 167, 172, 177,
+  181, 185, 190, 194, 198, 202, 206, 209, 213, 216, 220, 223, 226, 229, 231, 234,
+  237, 239, 241, 243, 245, 247, 248, 250, 251, 252, 253, 254, 255, 255, 256, 256, 256
+};
+static inline int isin256(int a) {
+  a &= 255;
+  if (a < 64)  return  SIN_Q8[a];
+  if (a < 128) return  SIN_Q8[128 - a];
+  if (a < 192) return -SIN_Q8[a - 128];
+  return -SIN_Q8[256 - a];
+}
+
 // ===== Helpers missili/powerup richiesti =====
 static inline int missilesActiveCount() {
   int n=0; for (int i=0;i<MAX_MISSILES;++i) if (missiles[i].active) ++n;
@@ -273,8 +322,108 @@ static inline int missilesActiveCount() {
 }
 static inline bool anyPickupActive() { return bonusDrop.active || pdownDrop.active; }
 
-// ======= FORWARD DECL =======
-static inline void safeClearRegion(int x,int y,int w,int h, bool redrawBricks=true);
+// ======= Compositor (damage list + buffer a strisce) =======
+// Durante il frame chi cambia aspetto segnala solo il rettangolo sporco con damage().
+// A fine frame composeFrame() fonde i rettangoli (restano disgiunti) e ridisegna ogni
+// area una sola volta, dal fondo verso l'alto, in una striscia in SRAM interna che poi
+// va sul framebuffer con un solo draw16bitRGBBitmap: niente overdraw né sfarfallio.
+static const int HUD_H           = 32;             // testo size 2 a y=16 arriva a riga 31
+static const int CRACK_SPILL     = 14;             // le crepe sbordano dal mattone fino a ~13 px
+static const int TILE_PX         = SCREEN_W * 24;  // 23 KB: striscia 480x24
+static const int MAX_DAMAGE      = 24;
+static const int DAMAGE_SLACK_PX = 1024;           // fondi se l'unione spreca meno di così
+
+class TileCanvas : public Arduino_GFX {
+public:
+  TileCanvas() : Arduino_GFX(SCREEN_W, SCREEN_H) {}
+  bool begin(int32_t speed = GFX_NOT_DEFINED) override { (void)speed; return true; }
+
+  // Coordinate schermo: il clipping a 0..479 lo fa Arduino_GFX, qui solo quello sulla striscia
+  void setTile(int x, int y, int w, int h) { tx = x; ty = y; tw = w; th = h; }
+  bool hits(int x, int y, int w, int h) const { return x < tx + tw && x + w > tx && y < ty + th && y + h > ty; }
+
+  void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override {
+    const int lx = x - tx, ly = y - ty;
+    if (lx >= 0 && lx < tw && ly >= 0 && ly < th) buf[ly * tw + lx] = color;
+  }
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override {
+    if (w < 0) { x += w + 1; w = -w; }
+    writeFillRectPreclipped(x, y, w, 1, color);
+  }
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override {
+    if (h < 0) { y += h + 1; h = -h; }
+    writeFillRectPreclipped(x, y, 1, h, color);
+  }
+  void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override {
+    const int x0 = max((int)x, tx), y0 = max((int)y, ty);
+    const int x1 = min(x + w, tx + tw), y1 = min(y + h, ty + th);
+    for (int yy = y0; yy < y1; ++yy) {
+      uint16_t *p = &buf[(yy - ty) * tw + (x0 - tx)];
+      for (int xx = x0; xx < x1; ++xx) *p++ = color;
+    }
+  }
+  void push() { gfx->draw16bitRGBBitmap(tx, ty, buf, tw, th); }
+
+  int tx = 0, ty = 0, tw = 0, th = 0;
+private:
+  uint16_t buf[TILE_PX];
+};
+static TileCanvas tile;
+
+static DRect damageList[MAX_DAMAGE];
+static int   damageCount = 0;
+
+static inline int dArea(const DRect &r) { return (r.x1 - r.x0) * (r.y1 - r.y0); }
+static inline bool dOverlap(const DRect &a, const DRect &b) {
+  return a.x0 < b.x1 && b.x0 < a.x1 && a.y0 < b.y1 && b.y0 < a.y1;
+}
+static inline DRect dUnion(const DRect &a, const DRect &b) {
+  return { min(a.x0, b.x0), min(a.y0, b.y0), max(a.x1, b.x1), max(a.y1, b.y1) };
+}
+
+static void damage(int x, int y, int w, int h) {
+  if (w <= 0 || h <= 0) return;
+  DRect r = { (int16_t)max(x, 0), (int16_t)max(y, 0),
+              (int16_t)min(x + w, SCREEN_W), (int16_t)min(y + h, SCREEN_H) };
+  if (r.x0 >= r.x1 || r.y0 >= r.y1) return;
+
+  for (;;) {
+    // Fonde con chi si sovrappone o è abbastanza vicino; riparte da capo a ogni fusione
+    for (int i = 0; i < damageCount; ) {
+      const DRect u = dUnion(r, damageList[i]);
+      if (dOverlap(r, damageList[i]) || dArea(u) <= dArea(r) + dArea(damageList[i]) + DAMAGE_SLACK_PX) {
+        r = u;
+        damageList[i] = damageList[--damageCount];
+        i = 0;
+      } else {
+        ++i;
+      }
+    }
+    if (damageCount < MAX_DAMAGE) break;
+
+    // Lista piena: assorbe il rettangolo la cui unione cresce meno
+    int best = 0, bestGrow = INT32_MAX;
+    for (int i = 0; i < damageCount; ++i) {
+      const int grow = dArea(dUnion(r, damageList[i])) - dArea(damageList[i]);
+      if (grow < bestGrow) { bestGrow = grow; best = i; }
+    }
+    r = dUnion(r, damageList[best]);
+    damageList[best] = damageList[--damageCount];
+  }
+  damageList[damageCount++] = r;
+}
+static inline void damageAll() { damageCount = 0; damage(0, 0, SCREEN_W, SCREEN_H); }
+
+// ---------- Flash bianchi (non bloccanti) ----------
+struct FlashFx { bool on; int x, y, w, h; uint32_t untilMs; };
+static const int MAX_FLASH = 4;
+static const uint32_t FLASH_MS = 16;
+static FlashFx flashes[MAX_FLASH];
+
+// ---------- Anello esplosione navicella ----------
+static int fxRingX = 0, fxRingY = 0, fxRingR = 0;   // R = 0: spento
+
+static void composeFrame();   // definita dopo la scena
 
 // ===== Overlay testuale anti-flicker =====
 struct OverlayMsg {
@@ -288,10 +437,10 @@ static OverlayMsg overlay = { false, "", 2, 0,0, 0,0,0,0 };
 
 static inline void drawOverlayNow() {
   if (!overlay.active || overlay.text[0] == '\0') return;
-  gfx->setTextSize(overlay.size);
-  gfx->setTextColor(COL_TEXT, COL_BG); // background impostato: nessun alone
-  gfx->setCursor(overlay.tx, overlay.ty + (8 * overlay.size));
-  gfx->print(overlay.text);
+  tile.setTextSize(overlay.size);
+  tile.setTextColor(COL_TEXT, COL_BG); // background impostato: nessun alone
+  tile.setCursor(overlay.tx, overlay.ty + (8 * overlay.size));
+  tile.print(overlay.text);
 }
 static inline void computeOverlayBox(const char* msg, uint8_t size, int &x, int &y, int &w, int &h) {
   const int len = strlen(msg);
@@ -308,7 +457,7 @@ static inline void computeOverlayBox(const char* msg, uint8_t size, int &x, int
 static inline void showOverlayCentered(const char* msg, uint8_t size) {
   int bx, by, bw, bh;
   computeOverlayBox(msg, size, bx, by, bw, bh);
-  gfx->fillRect(bx, by, bw, bh, COL_BG);
+  if (overlay.active) damage(overlay.bx, overlay.by, overlay.bw, overlay.bh);
   const int len = strlen(msg);
   const int tx = bx + (bw - len*6*size)/2;
   const int ty = by + (bh - 8*size)/2;
@@ -317,66 +466,18 @@ static inline void showOverlayCentered(const char* msg, uint8_t size) {
   strncpy(overlay.text, msg, sizeof(overlay.text)-1);
   overlay.text[sizeof(overlay.text)-1] = '\0';
   overlay.tx = tx; overlay.ty = ty;
-  overlay.bx = bx; overlay.by = by; overlay.bw = bw; overlay.bh = bh;
-  drawOverlayNow();
+  // il testo parte da ty + 8*size: il box lo deve contenere tutto
+  overlay.bx = bx; overlay.by = by; overlay.bw = bw; overlay.bh = bh + 8*size;
+  damage(overlay.bx, overlay.by, overlay.bw, overlay.bh);
 }
 
-// ---- HUD ----
-static void drawHUD_ifDirty(); // forward
-
-// Nuovo: forziamo il ridisegno dell'HUD (senza check "dirty")
-static inline void drawHUD_force() {
-  const int HUD_H = 26;
-  // pulizia banda
-  gfx->fillRect(0, 0, SCREEN_W, HUD_H, COL_BG);
-  for (int i=0;i<STAR_COUNT;++i) {
-    if (stars[i].y < HUD_H) { gfx->drawPixel(stars[i].x, stars[i].y, stars[i].color); }
-  }
-  // contenuto HUD identico a drawHUD_ifDirty()
-  gfx->setTextColor(COL_TEXT, COL_BG);
-  gfx->setTextSize(2);
-  gfx->setCursor(10, 16);
-  gfx->print(score);
-
-  const int pad = 8;
-  const int iconW = BALL_SIZE;
-  const int totalW = 3*iconW + 2*pad;
-  const int baseX = SCREEN_W - 10 - totalW;
-  const int baseY = 2;
-
-  for (int i=0;i<3;i++) {
-    const int x = baseX + i*(iconW + pad);
-    if (i < lives) {
-      const int w = BALL_SIZE;
-      const int h = BALL_SIZE + 2;
-      const int cx = x + (w>>1);
-      gfx->fillTriangle(cx, baseY, x, baseY + h/2, x + w, baseY + h/2, COL_BALL);
-      gfx->fillTriangle(cx, baseY + h/2, x + w/4, baseY + h, x + (3*w)/4, baseY + h, COL_GRAYL);
-      gfx->fillTriangle(x, baseY + h/2, x + w/5, baseY + h, cx, baseY + h - 2, 0xF800);
-      gfx->fillTriangle(x + w, baseY + h/2, x + w - w/5, baseY + h, cx, baseY + h - 2, 0xF800);
-    }
-  }
-  lastHUDms = millis();
-  lastScore = score;
-  lastLives = lives;
-}
-
-// >>> FIX per rimozione senza residui <<<
 static inline void hideOverlay() {
   if (!overlay.active) return;
-  // Salva box e DISATTIVA prima di pulire: evitare redraw del testo
-  int bx = overlay.bx, by = overlay.by, bw = overlay.bw, bh = overlay.bh;
+  damage(overlay.bx, overlay.by, overlay.bw, overlay.bh);
   overlay.active = false;
   overlay.text[0] = '\0';
   overlay.tx = overlay.ty = 0;
   overlay.bx = overlay.by = overlay.bw = overlay.bh = 0;
-
-  // Ripristina area (stelle + mattoni + HUD/frecce se necessario)
-  safeClearRegion(bx, by, bw, bh, true);
-}
-
-static inline bool rectsOverlap(int x,int y,int w,int h, int X,int Y,int W,int H) {
-  return !(X > x+w  || X+W < x || Y > y+h || Y+H < y);
 }
 
 // ----- Disegni base -----
@@ -385,13 +486,13 @@ static inline void drawPaddleRounded(const PaddleS &p) {
   int coreX = p.x + r;
   int coreW = p.w - (r<<1);
   if (coreW < 0) coreW = 0;
-  gfx->fillCircle(p.x + r,       p.y + r, r, COL_PEND);
-  gfx->fillCircle(p.x + p.w - r, p.y + r, r, COL_PEND);
-  if (coreW > 0) gfx->fillRect(coreX, p.y, coreW, p.h, COL_PADDLE);
+  tile.fillCircle(p.x + r,       p.y + r, r, COL_PEND);
+  tile.fillCircle(p.x + p.w - r, p.y + r, r, COL_PEND);
+  if (coreW > 0) tile.fillRect(coreX, p.y, coreW, p.h, COL_PADDLE);
 }
 static inline void drawBallNow() {
   const int r = BALL_SIZE>>1;
-  gfx->fillCircle((int)ball.x + r, (int)ball.y + r, r, COL_BALL);
+  tile.fillCircle(ballPX() + r, ballPY() + r, r, COL_BALL);
 }
 static inline bool rectIntersect(int ax,int ay,int aw,int ah, int bx,int by,int bw,int bh) {
   return !(bx > ax+aw  || bx+bw < ax || by > ay+ah || by+bh < ay);
@@ -402,8 +503,8 @@ static inline bool rectIntersectInflated(int ax,int ay,int aw,int ah, int bx,int
 
 // ---------- Stelle ----------
 static inline void drawStar(const Star &s) {
-  if (s.size == 1) gfx->drawPixel(s.x, s.y, s.color);
-  else             gfx->fillRect(s.x, s.y, s.size, s.size, s.color);
+  if (s.size == 1) tile.drawPixel(s.x, s.y, s.color);
+  else             tile.fillRect(s.x, s.y, s.size, s.size, s.color);
 }
 static void initStars() {
   for (int i=0;i<STAR_COUNT;++i) {
@@ -413,63 +514,6 @@ static void initStars() {
     stars[i].size = (random(0,100) < 80) ? 1 : 2;
   }
 }
-static inline void drawStars() { for (int i=0;i<STAR_COUNT;++i) drawStar(stars[i]); }
-
-// ---------- Clear con ripristino stelle ----------
-static inline void clearRegion(int x,int y,int w,int h) {
-  if (w<=0 || h<=0) return;
-  if (x<0) { w += x; x = 0; }
-  if (y<0) { h += y; y = 0; }
-  if (x+w>SCREEN_W) w = SCREEN_W - x;
-  if (y+h>SCREEN_H) h = SCREEN_H - y;
-  if (w<=0 || h<=0) return;
-  gfx->fillRect(x,y,w,h,COL_BG);
-  for (int i=0;i<STAR_COUNT;++i) {
-    if (stars[i].x >= x && stars[i].x < x+w && stars[i].y >= y && stars[i].y < y+h) {
-      drawStar(stars[i]);
-    }
-  }
-}
-
-// ---------- Safe clear ----------
-static inline void redrawBricksInRegion(int rx,int ry,int rw,int rh);
-static inline void safeClearRegion(int x,int y,int w,int h, bool redrawBricks) {
-  const int px = paddle.x, py = paddle.y, pw = paddle.w, ph = paddle.h;
-  const int bx = (int)ball.x, by = (int)ball.y, bw = BALL_SIZE, bh = BALL_SIZE;
-
-  const bool hitPaddle = rectIntersect(x,y,w,h, px,py,pw,ph);
-  const bool hitBall   = rectIntersect(x,y,w,h, bx,by,bw,bh);
-
-  clearRegion(x,y,w,h);
-  if (redrawBricks) redrawBricksInRegion(x,y,w,h);
-
-  // Nuovo: se l'area tocca HUD o frecce, ridisegnali per evitare residui
-  const int HUD_H = 26;
-  if (y < HUD_H) { drawHUD_force(); }
-  // frecce in basso: triangoli h=12 a ~SCREEN_H-14..SCREEN_H-2
-  if (y + h >= SCREEN_H - 32) { 
-    // ripassiamo la zona bassa in sicurezza
-    // (stelle già ripristinate da clearRegion)
-    drawCornerHints();
-  }
-
-  // Se overlay è attivo e l’area si sovrappone, ridisegnalo
-  if (overlay.active && rectsOverlap(x,y,w,h, overlay.bx, overlay.by, overlay.bw, overlay.bh)) {
-    drawOverlayNow();
-  }
-
-  if (hitPaddle) drawPaddleRounded(paddle);
-  if (hitBall)   drawBallNow();
-}
-
-// ---------- Pulizie estese mirate ----------
-static inline void clearPaddleRegionExpanded(int x,int y,int w,int h) { clearRegion(x-3, y-3, w+6, h+6); }
-static inline void clearBallRegionExpanded(int x,int y) { clearRegion(x-2, y-2, BALL_SIZE+4, BALL_SIZE+4); }
-static inline void clearPaddleSafeBand() {
-  const int bandH = 80;
-  int bandY = max(0, PADDLE_Y - (bandH/2));
-  clearRegion(0, bandY, SCREEN_W, bandH);
-}
 
 // ---------- Bricks (3D) + crepe random ----------
 static inline void drawCrackOverlayRandom(int x,int y,int w,int h, uint32_t seed) {
@@ -485,20 +529,20 @@ static inline void drawCrackOverlayRandom(int x,int y,int w,int h, uint32_t seed
     const int dy = rngRange(s,-(h/3), (h/3));
     const int x1 = x0 + dx/2;
     const int y1 = y0 + dy/2;
-    gfx->drawLine(x0, y0, x1, y1, cc);
+    tile.drawLine(x0, y0, x1, y1, cc);
 
     if ((rngNext(s) & 1u) == 0u) {
       const int ox = ((int)(rngNext(s)%3))-1; // -1..1
       const int oy = ((int)(rngNext(s)%3))-1;
-      gfx->drawLine(x0+ox, y0+oy, x1+ox, y1+oy, cc);
+      tile.drawLine(x0+ox, y0+oy, x1+ox, y1+oy, cc);
     }
 
     if ((rngNext(s) & 3u) == 0u) {
       const int x2 = x1 + rngRange(s,-6,6);
       const int y2 = y1 + rngRange(s,-6,6);
-      gfx->drawLine(x1, y1, x2, y2, cc);
-      gfx->drawPixel(x1+1, y1, cc);
-      gfx->drawPixel(x1, y1+1, cc);
+      tile.drawLine(x1, y1, x2, y2, cc);
+      tile.drawPixel(x1+1, y1, cc);
+      tile.drawPixel(x1, y1+1, cc);
     }
   }
 }
@@ -518,7 +562,7 @@ static inline uint16_t currentBrickBaseColor(int idx){
 }
 static inline void drawBrick3D_at(int x,int y,int w,int h, uint16_t base, int8_t hover){
   const uint16_t baseShade = shade565(base, hover);
-  gfx->fillRect(x, y, w, h, baseShade);
+  tile.fillRect(x, y, w, h, baseShade);
 
   const uint16_t hi1 = shade565(baseShade, +12);
   const uint16_t hi2 = shade565(baseShade, +8);
@@ -527,24 +571,24 @@ static inline void drawBrick3D_at(int x,int y,int w,int h, uint16_t base, int8_t
   const uint16_t lo2 = shade565(baseShade, -8);
   const uint16_t lo3 = shade565(baseShade, -5);
 
-  gfx->drawFastHLine(x+1, y+1, w-2, hi1);
-  gfx->drawFastHLine(x+1, y+2, w-2, hi2);
-  gfx->drawFastHLine(x+1, y+3, w-2, hi3);
-  gfx->drawFastVLine(x+1, y+1, h-2, hi1);
-  gfx->drawFastVLine(x+2, y+1, h-2, hi2);
-  gfx->drawFastVLine(x+3, y+1, h-2, hi3);
+  tile.drawFastHLine(x+1, y+1, w-2, hi1);
+  tile.drawFastHLine(x+1, y+2, w-2, hi2);
+  tile.drawFastHLine(x+1, y+3, w-2, hi3);
+  tile.drawFastVLine(x+1, y+1, h-2, hi1);
+  tile.drawFastVLine(x+2, y+1, h-2, hi2);
+  tile.drawFastVLine(x+3, y+1, h-2, hi3);
 
-  gfx->drawFastHLine(x+1, y+h-2, w-2, lo1);
-  gfx->drawFastHLine(x+1, y+h-3, w-2, lo2);
-  gfx->drawFastHLine(x+1, y+h-4, w-2, lo3);
-  gfx->drawFastVLine(x+w-2, y+1, h-2, lo1);
-  gfx->drawFastVLine(x+w-3, y+1, h-2, lo2);
-  gfx->drawFastVLine(x+w-4, y+1, h-2, lo3);
+  tile.drawFastHLine(x+1, y+h-2, w-2, lo1);
+  tile.drawFastHLine(x+1, y+h-3, w-2, lo2);
+  tile.drawFastHLine(x+1, y+h-4, w-2, lo3);
+  tile.drawFastVLine(x+w-2, y+1, h-2, lo1);
+  tile.drawFastVLine(x+w-3, y+1, h-2, lo2);
+  tile.drawFastVLine(x+w-4, y+1, h-2, lo3);
 
   if (w>6 && h>6) {
     const uint16_t face = shade565(baseShade, -4);
-    gfx->fillRect(x+4, y+4, w-8, h-8, face);
-    for (int d=0; d<min(w,h)/4; ++d) gfx->drawPixel(x+4+d, y+4+d, shade565(baseShade, +14));
+    tile.fillRect(x+4, y+4, w-8, h-8, face);
+    for (int d=0; d<min(w,h)/4; ++d) tile.drawPixel(x+4+d, y+4+d, shade565(baseShade, +14));
   }
 }
 static void initBricks() {
@@ -584,107 +628,87 @@ static void initBricks() {
   palFadeCycles = 0;
   hoverHitTop = false;
 }
-static inline void drawBricks(bool fullPaint = false) {
+// Mattoni nella striscia corrente (in ordine di indice: le crepe sbordano sul vicino)
+static inline void drawBricksInTile() {
   for (int i = 0; i < BRICK_ROWS * BRICK_COLS; ++i) {
     Brick &b = bricks[i];
-    if (b.alive) {
-      const uint16_t base = currentBrickBaseColor(i);
-      drawBrick3D_at(b.x, b.y, b.w, b.h, base, BRICK_HOVER_DELTA);
-      if (brickCrackSeed[i]) drawCrackOverlayRandom(b.x, b.y, b.w, b.h, brickCrackSeed[i]);
-    } else if (fullPaint) {
-      clearRegion(b.x, b.y, b.w, b.h);
-    }
+    if (!b.alive) continue;
+    if (!tile.hits(b.x - CRACK_SPILL, b.y - CRACK_SPILL, b.w + 2*CRACK_SPILL, b.h + 2*CRACK_SPILL)) continue;
+    const uint16_t base = currentBrickBaseColor(i);
+    drawBrick3D_at(b.x, b.y, b.w, b.h, base, BRICK_HOVER_DELTA);
+    if (brickCrackSeed[i]) drawCrackOverlayRandom(b.x, b.y, b.w, b.h, brickCrackSeed[i]);
   }
 }
-static inline void redrawBricksInRegion(int rx,int ry,int rw,int rh) {
-  for (int i = 0; i < BRICK_ROWS * BRICK_COLS; ++i) {
-    Brick &b = bricks[i];
+static inline void damageBrick(int i) {
+  const Brick &b = bricks[i];
+  damage(b.x - CRACK_SPILL, b.y - CRACK_SPILL, b.w + 2*CRACK_SPILL, b.h + 2*CRACK_SPILL);
+}
+// Hover/palette/shuffle: cambia l'aspetto di tutti i mattoni insieme
+static inline void damageBrickArea() {
+  damage(0, BRICK_TOP - CRACK_SPILL, SCREEN_W, BRICK_ROWS * (BRICK_H + BRICK_PAD) + 2*CRACK_SPILL);
+}
+// Sfumatura/hover: cambia il colore di tutti i mattoni vivi, non le zone vuote
+static void damageAliveBricks() {
+  int x0 = SCREEN_W, y0 = SCREEN_H, x1 = 0, y1 = 0;
+  for (int i=0;i<BRICK_ROWS*BRICK_COLS;++i) {
+    const Brick &b = bricks[i];
     if (!b.alive) continue;
-    if (rectIntersect(rx, ry, rw, rh, b.x, b.y, b.w, b.h)) {
-      const uint16_t base = currentBrickBaseColor(i);
-      drawBrick3D_at(b.x, b.y, b.w, b.h, base, BRICK_HOVER_DELTA);
-      if (brickCrackSeed[i]) drawCrackOverlayRandom(b.x, b.y, b.w, b.h, brickCrackSeed[i]);
-    }
+    x0 = min(x0, b.x); y0 = min(y0, b.y);
+    x1 = max(x1, b.x + b.w); y1 = max(y1, b.y + b.h);
   }
+  damage(x0, y0, x1 - x0, y1 - y0);
+}
+static inline void crackBrick(int i) {
+  if (brickCrackSeed[i] != 0) return;
+  brickCrackSeed[i] = (uint32_t)simRandom(1, 0x7FFFFFFF);
+  damageBrick(i);
 }
 
 // ---------- Particelle / Esplosioni ----------
-static inline void resetParticles() { for (int i=0;i<MAX_PARTICLES;++i) particles[i].alive = false; }
+static inline void resetParticles() { fx.clear(); }
 static inline void flashRect(int x,int y,int w,int h) {
-  gfx->fillRect(x, y, w, h, 0xFFFF);
-  delay(16);
-  safeClearRegion(x, y, w, h, true);
+  for (int i=0;i<MAX_FLASH;++i) {
+    if (flashes[i].on) continue;
+    flashes[i] = { true, x, y, w, h, millis() + FLASH_MS };
+    damage(x, y, w, h);
+    return;
+  }
+}
+static inline void expireFlashes() {
+  const uint32_t now = millis();
+  for (int i=0;i<MAX_FLASH;++i) {
+    if (!flashes[i].on || (int32_t)(now - flashes[i].untilMs) < 0) continue;
+    flashes[i].on = false;
+    damage(flashes[i].x, flashes[i].y, flashes[i].w, flashes[i].h);
+  }
 }
-static void spawnExplosion(int cx,int cy,int w,int h, uint16_t color, int count = 8, bool oobOnly = false, bool behindPaddle = false) {
+// Angoli in 1/256 di giro e velocità in Q8, come la palla; il generatore è quello di fx
+static void spawnExplosion(int cx,int cy,int w,int h, uint16_t color, int count = 8, bool oobOnly = false) {
+  const uint8_t fl = oobOnly ? FX_OOB_ONLY : 0;
+  const uint16_t dim = (((color & 0xF800) >> 1) & 0xF800)
+                     | (((color & 0x07E0) >> 1) & 0x07E0)
+                     | (((color & 0x001F) >> 1) & 0x001F);
   for (int n=0;n<count;++n) {
-    int idx = -1;
-    for (int i=0;i<MAX_PARTICLES;++i) { if (!particles[i].alive) { idx=i; break; } }
-    if (idx<0) break;
-    Particle &p = particles[idx];
-    p.alive = true;
-    p.x = cx + w/2 + (random(-w/2, w/2));
-    p.y = cy + h/2 + (random(-h/2, h/2));
-    const float angle = (float)random(0, 628) / 100.0f;
-    const float speed = 1.0f + (float)random(0, 200)/100.0f;
-    p.vx = cosf(angle)*speed;
-    p.vy = sinf(angle)*speed - 0.35f;
-    p.oobOnly = oobOnly;
-    p.behindPaddle = behindPaddle;
-    p.life = oobOnly ? 220 : (uint8_t)((16 + random(0,6)) * 1.1f);
-
-    const uint16_t core = color;
-    const uint16_t dim  = (((core & 0xF800) >> 1) & 0xF800)
-                        | (((core & 0x07E0) >> 1) & 0x07E0)
-                        | (((core & 0x001F) >> 1) & 0x001F);
-    p.color = (n % 3 == 0) ? core : dim;
-
-    p.sz = (random(0,10) == 0) ? 3 : 2;
-    p.px = (int)p.x; p.py = (int)p.y;
+    const int x = cx + w/2 + fx.rnd(-w/2, w/2);
+    const int y = cy + h/2 + fx.rnd(-h/2, h/2);
+    const int a = fx.rnd(0, 256);
+    const int speed = 256 + fx.rnd(0, 512);               // 1..3 px/tick
+    const uint8_t life = oobOnly ? 220 : (uint8_t)((16 + fx.rnd(0,6)) * 11 / 10);
+    const uint8_t sz = (fx.rnd(0,10) == 0) ? 3 : 2;
+    if (!fx.spawn(x << FX_SHIFT, y << FX_SHIFT, isin256(a + 64) * speed >> 8, (isin256(a) * speed >> 8) - 90,
+                  life, (n % 3 == 0) ? color : dim, sz, fl)) return;
   }
   // frammento grosso
-  int idx = -1;
-  for (int i=0;i<MAX_PARTICLES;++i) { if (!particles[i].alive) { idx=i; break; } }
-  if (idx>=0) {
-    Particle &p = particles[idx];
-    p.alive = true;
-    p.x = cx + (w/2) + random(-w/4, w/4);
-    p.y = cy + (h/2) + random(-h/4, h/4);
-    const float angle = (float)random(0, 628) / 100.0f;
-    const float speed = 1.2f + (float)random(0, 120)/100.0f;
-    p.vx = cosf(angle)*speed;
-    p.vy = sinf(angle)*speed - 0.3f;
-    p.oobOnly = oobOnly;
-    p.behindPaddle = behindPaddle;
-    p.life = oobOnly ? 220 : (uint8_t)(22);
-    p.color = color;
-    p.sz = 4;
-    p.px = (int)p.x; p.py = (int)p.y;
-  }
+  const int x = cx + (w/2) + fx.rnd(-w/4, w/4);
+  const int y = cy + (h/2) + fx.rnd(-h/4, h/4);
+  const int a = fx.rnd(0, 256);
+  const int speed = 307 + fx.rnd(0, 307);                 // 1.2..2.4 px/tick
+  fx.spawn(x << FX_SHIFT, y << FX_SHIFT, isin256(a + 64) * speed >> 8, (isin256(a) * speed >> 8) - 77,
+           oobOnly ? 220 : 22, color, 4, fl);
 }
-static void updateParticles() {
-  for (int i=0;i<MAX_PARTICLES;++i) {
-    if (!particles[i].alive) continue;
-    safeClearRegion(particles[i].px, particles[i].py, particles[i].sz, particles[i].sz, true);
-  }
-  for (int i=0;i<MAX_PARTICLES;++i) {
-    Particle &p = particles[i];
-    if (!p.alive) continue;
-
-    p.vy += 0.08f;
-    p.x  += p.vx;
-    p.y  += p.vy;
-
-    if (p.x<0 || p.x>=SCREEN_W || p.y<0 || p.y>=SCREEN_H) { p.alive=false; continue; }
-    if (!p.oobOnly) { if (p.life>0) p.life--; else { p.alive=false; continue; } }
-
-    const int ix = (int)p.x, iy = (int)p.y;
-    gfx->fillRect(ix, iy, p.sz, p.sz, p.color);
-    redrawBricksInRegion(ix, iy, p.sz, p.sz);
-    if (overlay.active && rectsOverlap(ix, iy, p.sz, p.sz, overlay.bx, overlay.by, overlay.bw, overlay.bh)) {
-      drawOverlayNow();
-    }
-    p.px = ix; p.py = iy;
-  }
+static inline void updateParticles() { fx.update(); }
+static inline void drawParticlesInTile() {
+  fx.draw(tile.ty, tile.th, [](int x, int y, int w, int h, uint16_t c) { tile.writeFillRectPreclipped(x, y, w, h, c); });
 }
 
 // ---------- HUD ----------
@@ -692,60 +716,35 @@ static inline void drawSmallShipIcon(int x, int y) {
   const int w = BALL_SIZE;
   const int h = BALL_SIZE + 2;
   const int cx = x + (w>>1);
-  gfx->fillTriangle(cx, y, x, y + h/2, x + w, y + h/2, COL_BALL);
-  gfx->fillTriangle(cx, y + h/2, x + w/4, y + h, x + (3*w)/4, y + h, COL_GRAYL);
-  gfx->fillTriangle(x, y + h/2, x + w/5, y + h, cx, y + h - 2, 0xF800);
-  gfx->fillTriangle(x + w, y + h/2, x + w - w/5, y + h, cx, y + h - 2, 0xF800);
+  tile.fillTriangle(cx, y, x, y + h/2, x + w, y + h/2, COL_BALL);
+  tile.fillTriangle(cx, y + h/2, x + w/4, y + h, x + (3*w)/4, y + h, COL_GRAYL);
+  tile.fillTriangle(x, y + h/2, x + w/5, y + h, cx, y + h - 2, 0xF800);
+  tile.fillTriangle(x + w, y + h/2, x + w - w/5, y + h, cx, y + h - 2, 0xF800);
 }
-static void drawHUD_ifDirty() {
-  const uint32_t now = millis();
-  const bool dirty = (score != lastScore) || (lives != lastLives) || (now - lastHUDms >= 1000);
-  if (!dirty) return;
-
-  safeClearRegion(0, 0, SCREEN_W, 26, true);
-
-  gfx->setTextColor(COL_TEXT, COL_BG);
-  gfx->setTextSize(2);
-  gfx->setCursor(10, 16);
-  gfx->print(score);
+static inline void drawHUD() {
+  tile.setTextColor(COL_TEXT, COL_BG);
+  tile.setTextSize(2);
+  tile.setCursor(10, 16);
+  tile.print(score);
 
   const int pad = 8;
   const int iconW = BALL_SIZE;
   const int totalW = 3*iconW + 2*pad;
   const int baseX = SCREEN_W - 10 - totalW;
   const int baseY = 2;
-  safeClearRegion(baseX-2, 0, totalW+6, 26, true);
+
   for (int i=0;i<3;i++) {
     const int x = baseX + i*(iconW + pad);
     if (i < lives) drawSmallShipIcon(x, baseY);
   }
-
+}
+static inline void markHUDIfDirty() {
+  if (score == lastScore && lives == lastLives) return;
+  damage(0, 0, SCREEN_W, HUD_H);
   lastScore = score;
   lastLives = lives;
-  lastHUDms = now;
 }
 
-// ---------- Testi centrati legacy ----------
-static inline void drawCenteredMessageSized(const char *msg, uint8_t size) {
-  const int len = strlen(msg);
-  const int w = len * 6 * size;
-  const int h = 8 * size;
-  const int x = (SCREEN_W - w) / 2;
-  const int y = (SCREEN_H - h) / 2;
-  safeClearRegion(x - 10, y - 10, w + 20, h + 20, true);
-  gfx->setTextSize(size);
-  gfx->setTextColor(COL_TEXT, COL_BG);
-  gfx->setCursor(x, y + h);
-  gfx->print(msg);
-}
-static inline void clearCenteredMessageSized(const char *msg, uint8_t size) {
-  const int len = strlen(msg);
-  const int w = len * 6 * size;
-  const int h = 8 * size;
-  const int x = (SCREEN_W - w) / 2;
-  const int y = (SCREEN_H - h) / 2;
-  safeClearRegion(x - 20, y - 20, w + 40, h + 40, true);
-}
 static inline void clearAnyShuffleMessage() {
   hideOverlay();
   shuffleMsgUntilMs = 0;
@@ -771,19 +770,21 @@ static inline void drawGameOverHard() {
 static inline void drawPowerUpDiamond(int x,int y,int w,int h, uint16_t core, uint16_t edge) {
   const int cx = x + (w>>1);
   const int cy = y + (h>>1);
-  gfx->fillTriangle(cx, y,     x, cy,   x+w, cy, core);
-  gfx->fillTriangle(cx, y+h,   x, cy,   x+w, cy, core);
-  gfx->drawLine(x, cy, cx, y, edge);
-  gfx->drawLine(cx, y, x+w, cy, edge);
-  gfx->drawLine(x, cy, cx, y+h, edge);
-  gfx->drawLine(cx, y+h, x+w, cy, edge);
-}
-static inline void drawBlinkingBonusLike(int x,int y,int w,int h, uint16_t coreBase) {
-  const uint32_t now = millis();
+  tile.fillTriangle(cx, y,     x, cy,   x+w, cy, core);
+  tile.fillTriangle(cx, y+h,   x, cy,   x+w, cy, core);
+  tile.drawLine(x, cy, cx, y, edge);
+  tile.drawLine(cx, y, x+w, cy, edge);
+  tile.drawLine(x, cy, cx, y+h, edge);
+  tile.drawLine(cx, y+h, x+w, cy, edge);
+}
+// Il lampeggio avanza nell'update: durante la composizione il colore non deve cambiare
+static inline void stepBonusBlink(uint32_t now) {
   if (now - bonusBlinkLastMs >= BONUS_BLINK_MS) {
     bonusBlinkToggle = !bonusBlinkToggle;
     bonusBlinkLastMs = now;
   }
+}
+static inline void drawBlinkingBonusLike(int x,int y,int w,int h, uint16_t coreBase) {
   const uint16_t core = bonusBlinkToggle ? COL_YELLOW : coreBase;
   const uint16_t edge = COL_PURPLE;
   drawPowerUpDiamond(x,y,w,h, core, edge);
@@ -791,72 +792,62 @@ static inline void drawBlinkingBonusLike(int x,int y,int w,int h, uint16_t coreB
 static inline int randXForDrop(int amp, int objW) {
   const int minX = amp;
   const int maxX = SCREEN_W - amp - objW;
-  return random(minX, maxX > minX ? maxX : minX+1);
+  return simRandom(minX, maxX > minX ? maxX : minX+1);
+}
+
+// x della traiettoria a S alla quota corrente
+static inline int dropX(const Bonus &d) {
+  return d.baseX + (d.sAmp * isin256(((d.sOmega * d.y) >> 8) + d.sPhase)) / 256;
 }
 
 static inline bool canSpawnPickup() { return !anyPickupActive() && missilesActiveCount()==0; }
 
 static void spawnBonus() {
-  if (!canSpawnPickup()) { lastBonusMs = millis(); return; }
+  if (!canSpawnPickup()) { lastBonusMs = simMs(); return; }
   bonusDrop.active = true;
   bonusDrop.sAmp   = 22;
-  bonusDrop.sOmega = 0.018f;
-  bonusDrop.sPhase = (float)random(0,628)/100.0f;
+  bonusDrop.sOmega = 188;
+  bonusDrop.sPhase = simRandom(0,256);
   bonusDrop.w = 18; bonusDrop.h = 14;
 
   bonusDrop.baseX = randXForDrop(bonusDrop.sAmp, bonusDrop.w);
   bonusDrop.y = 0;
-  bonusDrop.x  = bonusDrop.baseX + (int)(bonusDrop.sAmp * sinf(bonusDrop.sPhase));
+  bonusDrop.x  = dropX(bonusDrop);
   bonusDrop.px = bonusDrop.x; bonusDrop.py = bonusDrop.y;
-  bonusDrop.vy = 3 + (random(0,2));
+  bonusDrop.vy = 3 + (simRandom(0,2));
   bonusDrop.color = COL_CYAN;
 }
 static void spawnPowerDown() {
-  if (!canSpawnPickup()) { lastPowerDownMs = millis(); return; }
+  if (!canSpawnPickup()) { lastPowerDownMs = simMs(); return; }
   pdownDrop.active = true;
   pdownDrop.sAmp   = 22;
-  pdownDrop.sOmega = 0.018f;
-  pdownDrop.sPhase = (float)random(0,628)/100.0f;
+  pdownDrop.sOmega = 188;
+  pdownDrop.sPhase = simRandom(0,256);
   pdownDrop.w = 18; pdownDrop.h = 14;
 
   pdownDrop.baseX = randXForDrop(pdownDrop.sAmp, pdownDrop.w);
   pdownDrop.y = 0;
-  pdownDrop.x  = pdownDrop.baseX + (int)(pdownDrop.sAmp * sinf(pdownDrop.sOmega * pdownDrop.y + pdownDrop.sPhase));
+  pdownDrop.x  = dropX(pdownDrop);
   pdownDrop.px = pdownDrop.x; pdownDrop.py = pdownDrop.y;
-  pdownDrop.vy = 3 + (random(0,2));
+  pdownDrop.vy = 3 + (simRandom(0,2));
   pdownDrop.color = COL_MAG;
 }
-static inline void clearBonusTrailStrip(int x, int y0, int y1, int w, int h) {
-  int top = min(y0, y1) - 4;
-  int bot = max(y0, y1) + h + 6;
-  if (top < 0) top = 0; if (bot > SCREEN_H) bot = SCREEN_H;
-  const int hh = bot - top; if (hh > 0) safeClearRegion(x-2, top, w+4, hh, true);
-}
-static inline void clearBonusLast()     { safeClearRegion(bonusDrop.px,  bonusDrop.py,  bonusDrop.w,  bonusDrop.h, true); }
-static inline void clearPowerDownLast() { safeClearRegion(pdownDrop.px, pdownDrop.py, pdownDrop.w, pdownDrop.h, true); }
-static inline void drawBonusNow() {
-  if (!bonusDrop.active) return;
-  drawBlinkingBonusLike(bonusDrop.x, bonusDrop.y, bonusDrop.w, bonusDrop.h, bonusDrop.color);
-  redrawBricksInRegion(bonusDrop.x, bonusDrop.y, bonusDrop.w, bonusDrop.h);
-}
-static inline void drawPowerDownNow() {
-  if (!pdownDrop.active) return;
-  drawBlinkingBonusLike(pdownDrop.x, pdownDrop.y, pdownDrop.w, pdownDrop.h, pdownDrop.color);
-  redrawBricksInRegion(pdownDrop.x, pdownDrop.y, pdownDrop.w, pdownDrop.h);
+static inline void drawDropInTile(const Bonus &d) {
+  if (!d.active || !tile.hits(d.x, d.y, d.w + 1, d.h + 1)) return;
+  drawBlinkingBonusLike(d.x, d.y, d.w, d.h, d.color);
 }
-static inline void deactivateBonus()     { safeClearRegion(bonusDrop.x,  bonusDrop.y,  bonusDrop.w,  bonusDrop.h, true);  bonusDrop.active  = false; }
-static inline void deactivatePowerDown() { safeClearRegion(pdownDrop.x, pdownDrop.y, pdownDrop.w, pdownDrop.h, true);    pdownDrop.active  = false; }
+static inline void deactivateBonus()     { bonusDrop.active = false; }
+static inline void deactivatePowerDown() { pdownDrop.active = false; }
 
 // ---------- Paddle FX lampeggio ----------
+// (colori e dimensione cambiano solo lo stato: il ridisegno lo fa trackSprites())
 static inline void maybeUpdatePaddleBlinkFx() {
   if (!paddleBlinkFxActive) return;
-  const uint32_t now = millis();
+  const uint32_t now = simMs();
   if ((int32_t)(now - paddleBlinkEndMs) >= 0) {
     COL_PADDLE = COL_PADDLE_DEF;
     COL_PEND   = COL_PEND_DEF;
     paddleBlinkFxActive = false;
-    clearPaddleRegionExpanded(paddle.x, paddle.y, paddle.w, paddle.h);
-    drawPaddleRounded(paddle);
     return;
   }
   if (now - paddleBlinkLastMs >= PADDLE_BLINK_MS) {
@@ -872,8 +863,6 @@ static inline void maybeUpdatePaddleBlinkFx() {
       case 6: COL_PADDLE = 0x001F;     COL_PEND = 0xFFE0;     break;
       default:COL_PADDLE = COL_GRAYL;  COL_PEND = COL_CYAN;    break;
     }
-    clearPaddleRegionExpanded(paddle.x, paddle.y, paddle.w, paddle.h);
-    drawPaddleRounded(paddle);
   }
 }
 
@@ -886,45 +875,39 @@ static inline void applyPaddleBuff() {
   if (paddleBuffActive && paddleSizeState == PS_BUFF) return;
   const int cx = paddle.x + (paddle.w>>1);
   const int newW = PADDLE_W_BUFF;
-  clearPaddleRegionExpanded(paddle.x, paddle.y, paddle.w, paddle.h);
   paddle.x = cx - (newW>>1);
   paddle.w = newW;
   clampPaddleInside();
   paddleBuffActive = true;
   paddleSizeState  = PS_BUFF;
-  paddleBuffEndMs = millis() + PADDLE_BUFF_MS;
+  paddleBuffEndMs = simMs() + PADDLE_BUFF_MS;
   paddleBlinkFxActive = true;
-  paddleBlinkEndMs    = millis() + PADDLE_BLINK_DUR;
+  paddleBlinkEndMs    = simMs() + PADDLE_BLINK_DUR;
   paddleBlinkLastMs   = 0;
   paddleBlinkStep     = 0;
-  drawPaddleRounded(paddle);
 }
 static inline void applyPaddleDebuff() {
   if (paddleBuffActive && paddleSizeState == PS_DEBUFF) return;
   const int cx = paddle.x + (paddle.w>>1);
   const int newW = PADDLE_W_DEBUFF;
-  clearPaddleRegionExpanded(paddle.x, paddle.y, paddle.w, paddle.h);
   paddle.x = cx - (newW>>1);
   paddle.w = newW;
   clampPaddleInside();
   paddleBuffActive = true;
   paddleSizeState  = PS_DEBUFF;
-  paddleBuffEndMs = millis() + PADDLE_BUFF_MS;
+  paddleBuffEndMs = simMs() + PADDLE_BUFF_MS;
   paddleBlinkFxActive = true;
-  paddleBlinkEndMs    = millis() + PADDLE_BLINK_DUR;
+  paddleBlinkEndMs    = simMs() + PADDLE_BLINK_DUR;
   paddleBlinkLastMs   = 0;
   paddleBlinkStep     = 0;
-  drawPaddleRounded(paddle);
 }
 static inline void maybeExpirePaddleBuff() {
   if (!paddleBuffActive) return;
-  if ((int32_t)(millis() - paddleBuffEndMs) >= 0) {
-    clearPaddleRegionExpanded(paddle.x, paddle.y, paddle.w, paddle.h);
+  if ((int32_t)(simMs() - paddleBuffEndMs) >= 0) {
     const int cx = paddle.x + (paddle.w>>1);
     paddle.w = PADDLE_W_BASE;
     paddle.x = cx - (paddle.w>>1);
     clampPaddleInside();
-    drawPaddleRounded(paddle);
     paddleBuffActive = false;
     paddleSizeState  = PS_NORMAL;
   }
@@ -935,29 +918,26 @@ static inline void normalizePaddleWidth() {
     (paddleSizeState == PS_BUFF) ? PADDLE_W_BUFF : PADDLE_W_DEBUFF;
 
   if (paddle.w != targetW) {
-    clearPaddleRegionExpanded(paddle.x, paddle.y, paddle.w, paddle.h);
     const int cx = paddle.x + (paddle.w>>1);
     paddle.w = targetW;
     paddle.x = cx - (paddle.w>>1);
     clampPaddleInside();
-    drawPaddleRounded(paddle);
   }
 }
 
 // ---------- Missili ----------
-static inline void drawMissileStylized(int x,int y,int w,int h, uint16_t nose, uint16_t body, uint16_t fin, uint16_t flame1, uint16_t flame2) {
+static inline void drawMissileStylized(int x,int y,int w,int h, int flick, bool flame2On, uint16_t nose, uint16_t body, uint16_t fin, uint16_t flame1, uint16_t flame2) {
   const int cx = x + (w>>1);
   const int neckY = y + (h * 4) / 10;
   const int finY  = y + (h * 7) / 10;
-  const int flick = random(0,3);
-  gfx->fillTriangle(cx, y, x, neckY, x+w, neckY, nose);
+  tile.fillTriangle(cx, y, x, neckY, x+w, neckY, nose);
   const int mid1 = (neckY + finY) / 2;
-  gfx->fillTriangle(cx, neckY, x + w/4, mid1, x + (3*w)/4, mid1, body);
-  gfx->fillTriangle(cx, mid1, x + w/3, finY, x + (2*w)/3, finY, body);
-  gfx->fillTriangle(x, finY, x + w/4, finY, cx, finY + h/10, fin);
-  gfx->fillTriangle(x+w, finY, x + (3*w)/4, finY, cx, finY + h/10, fin);
-  gfx->fillTriangle(cx, y+h + flick, cx - w/6, y+h - h/12, cx + w/6, y+h - h/12, flame1);
-  if (random(0,2)) gfx->fillTriangle(cx, y+h + flick + 2, cx - w/10, y+h - h/20, cx + w/10, y+h - h/20, flame2);
+  tile.fillTriangle(cx, neckY, x + w/4, mid1, x + (3*w)/4, mid1, body);
+  tile.fillTriangle(cx, mid1, x + w/3, finY, x + (2*w)/3, finY, body);
+  tile.fillTriangle(x, finY, x + w/4, finY, cx, finY + h/10, fin);
+  tile.fillTriangle(x+w, finY, x + (3*w)/4, finY, cx, finY + h/10, fin);
+  tile.fillTriangle(cx, y+h + flick, cx - w/6, y+h - h/12, cx + w/6, y+h - h/12, flame1);
+  if (flame2On) tile.fillTriangle(cx, y+h + flick + 2, cx - w/10, y+h - h/20, cx + w/10, y+h - h/20, flame2);
 }
 static inline void resetMissiles() { for (int i=0;i<MAX_MISSILES;++i) missiles[i].active = false; }
 static void spawnMissile(int sx, int sy) {
@@ -970,50 +950,41 @@ static void spawnMissile(int sx, int sy) {
     missiles[i].y = sy + BRICK_H;
     missiles[i].px = missiles[i].x; missiles[i].py = missiles[i].y;
     missiles[i].vy = 4; missiles[i].color = 0xFBE0;
+    missiles[i].flick = 0; missiles[i].flame2 = false;
     return;
   }
 }
-static inline void clearMissileTrailStrip(int x, int y0, int y1, int w, int h) {
-  int top = min(y0, y1) - 4;
-  int bot = max(y0, y1) + h + 6;
-  if (top < 0) top = 0; if (bot > SCREEN_H) bot = SCREEN_H;
-  const int hh = bot - top; if (hh > 0) safeClearRegion(x-2, top, w+4, hh, true);
-}
-static inline void drawMissileNow(int i) {
-  const int x = missiles[i].x, y = missiles[i].y, w = missiles[i].w, h = missiles[i].h;
-  drawMissileStylized(x,y,w,h, missiles[i].color, COL_GRAYL, 0xF800, COL_YELLOW, COL_ORANGE);
-  redrawBricksInRegion(x, y, w, h + 6);
-}
-static inline void cleanupParticlesInRect(int x,int y,int w,int h) {
-  for (int i=0;i<MAX_PARTICLES;++i) {
-    Particle &p = particles[i];
-    if (!p.alive) continue;
-    const int ix = (int)p.x, iy = (int)p.y;
-    if (ix >= x && ix < x+w && iy >= y && iy < y+h) {
-      safeClearRegion(p.px, p.py, p.sz, p.sz, true);
-      p.alive = false;
-    }
+// Ingombro del missile: la fiamma scende fino a h + flick(2) + 2
+static inline int missileDrawH(const Missile &m) { return m.h + 5; }
+static inline void drawMissilesInTile() {
+  for (int i=0;i<MAX_MISSILES;++i) {
+    const Missile &m = missiles[i];
+    if (!m.active || !tile.hits(m.x, m.y, m.w + 1, missileDrawH(m))) continue;
+    drawMissileStylized(m.x, m.y, m.w, m.h, m.flick, m.flame2, m.color, COL_GRAYL, 0xF800, COL_YELLOW, COL_ORANGE);
   }
 }
+static inline void cleanupParticlesInRect(int x,int y,int w,int h) { fx.killIn(x, y, w, h); }
 static inline void animateMissileExplosion(int x,int y,int w,int h,uint16_t color) {
+  if (simHeadless) return;   // solo estetica
   flashRect(x-1, y-1, w+2, h+2);
-  spawnExplosion(x, y, w, h, color, 8, false, false);
+  spawnExplosion(x, y, w, h, color, FX_MISSILE_COUNT, false);
   const uint32_t t0 = millis();
-  while (millis() - t0 < 220) { updateParticles(); delay(12); }
-  const int cx = x-8, cy = y-8, cw = w+16, ch = h+16;
-  safeClearRegion(cx, cy, cw, ch, true);
-  cleanupParticlesInRect(cx, cy, cw, ch);
+  while (millis() - t0 < 220) { updateParticles(); composeFrame(); delay(12); }
+  cleanupParticlesInRect(x-8, y-8, w+16, h+16);
+  composeFrame();
 }
 
 // ---------- Frecce guida ----------
+static const int HINT_M = 14, HINT_H = 12, HINT_W = 16;
+static const int HINT_Y = SCREEN_H - HINT_M - HINT_H;
 static inline void drawCornerHints() {
-  const int m = 14;
-  const int h = 12;
-  const int w = 16;
-  const int ay = SCREEN_H - m - h;
+  const int m = HINT_M;
+  const int h = HINT_H;
+  const int w = HINT_W;
+  const int ay = HINT_Y;
 
-  gfx->fillTriangle(m+w, ay,    m+w, ay+h,    m,    ay + h/2, COL_HINT);
-  gfx->fillTriangle(SCREEN_W - m - w, ay,
+  tile.fillTriangle(m+w, ay,    m+w, ay+h,    m,    ay + h/2, COL_HINT);
+  tile.fillTriangle(SCREEN_W - m - w, ay,
                     SCREEN_W - m - w, ay+h,
                     SCREEN_W - m,     ay + h/2, COL_HINT);
 }
@@ -1029,21 +1000,96 @@ static inline void resetBallAndPaddle(bool centerBall = true) {
   paddle.x = (SCREEN_W - paddle.w) / 2;
   paddle.y = PADDLE_Y;
   if (centerBall) {
-    ball.x = paddle.x + paddle.w/2 - BALL_SIZE/2;
-    ball.y = paddle.y - BALL_SIZE - 2;
+    ball.x = (int32_t)(paddle.x + paddle.w/2 - BALL_SIZE/2) << FIX_SHIFT;
+    ball.y = (int32_t)(paddle.y - BALL_SIZE - 2) << FIX_SHIFT;
   }
-  ball.vx = 0.0f; ball.vy = 0.0f; ballOnPaddle = true;
+  ball.vx = 0; ball.vy = 0; ballOnPaddle = true;
+}
+
+// ======= Scena e composizione =======
+// Ultimo rettangolo disegnato per ogni sprite: se cambia, si sporcano vecchio e nuovo
+static Drawn paddleDrawn, ballDrawn, bonusDrawn, pdownDrawn, missileDrawn[MAX_MISSILES];
+static uint16_t paddleColDrawn = 0, pendColDrawn = 0;
+static bool     blinkDrawn = false;
+
+static inline void track(Drawn &d, bool on, int x, int y, int w, int h, bool force = false) {
+  if (!force && d.on == on && (!on || (d.x == x && d.y == y && d.w == w && d.h == h))) return;
+  if (d.on) damage(d.x, d.y, d.w, d.h);
+  if (on)   damage(x, y, w, h);
+  d.on = on; d.x = x; d.y = y; d.w = w; d.h = h;
+}
+static void trackSprites() {
+  const bool paddleRecolor = (COL_PADDLE != paddleColDrawn) || (COL_PEND != pendColDrawn);
+  paddleColDrawn = COL_PADDLE; pendColDrawn = COL_PEND;
+  track(paddleDrawn, true, paddle.x, paddle.y, paddle.w + 1, paddle.h + 1, paddleRecolor);
+  track(ballDrawn, true, ballPX(), ballPY(), BALL_SIZE + 1, BALL_SIZE + 1);
+
+  const bool blink = (bonusBlinkToggle != blinkDrawn);
+  blinkDrawn = bonusBlinkToggle;
+  track(bonusDrawn, bonusDrop.active, bonusDrop.x, bonusDrop.y, bonusDrop.w + 1, bonusDrop.h + 1, blink);
+  track(pdownDrawn, pdownDrop.active, pdownDrop.x, pdownDrop.y, pdownDrop.w + 1, pdownDrop.h + 1, blink);
+
+  for (int i=0;i<MAX_MISSILES;++i) {
+    const Missile &m = missiles[i];
+    track(missileDrawn[i], m.active, m.x, m.y, m.w + 1, missileDrawH(m), m.active); // la fiamma cambia ogni frame
+  }
+}
+
+static inline void setRingFx(int cx, int cy, int r) {
+  if (fxRingR > 0) damage(fxRingX - fxRingR, fxRingY - fxRingR, 2*fxRingR + 1, 2*fxRingR + 1);
+  fxRingX = cx; fxRingY = cy; fxRingR = r;
+  if (fxRingR > 0) damage(fxRingX - fxRingR, fxRingY - fxRingR, 2*fxRingR + 1, 2*fxRingR + 1);
+}
+
+// Ridisegna la striscia corrente dal fondo verso l'alto.
+// Particelle, gemme e missili stanno dietro ai mattoni (escono "da sotto"), come prima.
+static void renderTile() {
+  tile.writeFillRectPreclipped(tile.tx, tile.ty, tile.tw, tile.th, COL_BG);
+  for (int i=0;i<STAR_COUNT;++i) {
+    if (tile.hits(stars[i].x, stars[i].y, stars[i].size, stars[i].size)) drawStar(stars[i]);
+  }
+  drawParticlesInTile();
+  drawDropInTile(bonusDrop);
+  drawDropInTile(pdownDrop);
+  drawMissilesInTile();
+  drawBricksInTile();
+  for (int i=0;i<MAX_FLASH;++i) {
+    if (flashes[i].on) tile.fillRect(flashes[i].x, flashes[i].y, flashes[i].w, flashes[i].h, 0xFFFF);
+  }
+  if (tile.hits(paddle.x, paddle.y, paddle.w + 1, paddle.h + 1)) drawPaddleRounded(paddle);
+  if (tile.hits(ballPX(), ballPY(), BALL_SIZE + 1, BALL_SIZE + 1)) drawBallNow();
+  if (fxRingR > 0) {
+    tile.drawCircle(fxRingX, fxRingY, fxRingR, COL_YELLOW);
+    tile.drawCircle(fxRingX, fxRingY, fxRingR - 2, COL_ORANGE);
+  }
+  if (tile.hits(0, 0, SCREEN_W, HUD_H)) drawHUD();
+  if (tile.hits(0, HINT_Y, SCREEN_W, HINT_H + 1)) drawCornerHints();
+  if (overlay.active && tile.hits(overlay.bx, overlay.by, overlay.bw, overlay.bh)) drawOverlayNow();
+}
+
+static void composeFrame() {
+  expireFlashes();
+  markHUDIfDirty();
+  trackSprites();
+  fx.flushDamage(damage);                   // zone delle particelle, già raccolte per fascia
+  if (damageCount) fx.buildDrawList();
+  for (int i=0;i<damageCount;++i) {
+    const DRect &r = damageList[i];
+    const int w = r.x1 - r.x0;
+    const int bandH = max(1, TILE_PX / w);
+    for (int y = r.y0; y < r.y1; y += bandH) {
+      tile.setTile(r.x0, y, w, min(bandH, (int)r.y1 - y));
+      renderTile();
+      tile.push();
+    }
+  }
+  damageCount = 0;
 }
 
 static inline void fullRedraw() {
-  gfx->fillScreen(COL_BG);
-  drawStars();
-  drawBricks(true);
-  drawPaddleRounded(paddle);
-  drawBallNow();
-  drawHUD_force();           // assicura stato coerente subito
-  drawCornerHints();
-  if (overlay.active) drawOverlayNow();
+  lastScore = score; lastLives = lives;
+  damageAll();
+  composeFrame();
 }
 
 static inline void showCenteredMessage(const char *msg) {
@@ -1052,34 +1098,30 @@ static inline void showCenteredMessage(const char *msg) {
 
 // ---------- Esplosione navicella ----------
 static inline void animatePaddleExplosion() {
-  clearPaddleRegionExpanded(paddle.x, paddle.y, paddle.w, paddle.h);
+  if (simHeadless) return;   // solo estetica
   flashRect(paddle.x-2, paddle.y-2, paddle.w+4, paddle.h+4);
   const int cx = paddle.x + (paddle.w>>1);
   const int cy = paddle.y + (paddle.h>>1);
   const int maxR = (paddle.w > 40 ? paddle.w : 40);
   for (int r = 6; r <= maxR; r += 6) {
-    gfx->drawCircle(cx, cy, r, COL_YELLOW);
-    gfx->drawCircle(cx, cy, r-2, COL_ORANGE);
+    setRingFx(cx, cy, r);
+    composeFrame();
     delay(8);
-    safeClearRegion(cx - r - 3, cy - r - 3, (r + 3) * 2, (r + 3) * 2, true);
   }
-  spawnExplosion(paddle.x, paddle.y, paddle.w, paddle.h, COL_PADDLE_DEF, 14, false, false);
-  spawnExplosion(paddle.x, paddle.y, paddle.w, paddle.h, COL_PEND_DEF,   12, false, false);
+  setRingFx(cx, cy, 0);
+  spawnExplosion(paddle.x, paddle.y, paddle.w, paddle.h, COL_PADDLE_DEF, FX_PADDLE_COUNT, false);
+  spawnExplosion(paddle.x, paddle.y, paddle.w, paddle.h, COL_PEND_DEF,   FX_PADDLE_COUNT * 7 / 8, false);
 
   const uint32_t t0 = millis();
-  while (millis() - t0 < 420) { updateParticles(); delay(12); }
+  while (millis() - t0 < 420) { updateParticles(); composeFrame(); delay(12); }
 
-  const int cxr = paddle.x - 16, cyr = paddle.y - 16, cwr = paddle.w + 32, chr = paddle.h + 32;
-  safeClearRegion(cxr, cyr, cwr, chr, true);
-  cleanupParticlesInRect(cxr, cyr, cwr, chr);
+  cleanupParticlesInRect(paddle.x - 16, paddle.y - 16, paddle.w + 32, paddle.h + 32);
+  composeFrame();
 }
 
 // --- Perdita vita ---
-static inline void loseLifeAfterAnimation(int oldBX, int oldBY) {
+static inline void loseLifeAfterAnimation() {
   lives--;
-  clearBallRegionExpanded(oldBX, oldBY);
-  clearBallRegionExpanded((int)ball.x, (int)ball.y);
-  clearPaddleSafeBand();
 
   paddleBuffActive = false;
   paddleSizeState  = PS_NORMAL;
@@ -1091,8 +1133,6 @@ static inline void loseLifeAfterAnimation(int oldBX, int oldBY) {
     return;
   } else {
     resetBallAndPaddle(true);
-    drawPaddleRounded(paddle);
-    drawBallNow();
   }
 }
 
@@ -1114,8 +1154,12 @@ static inline Quad readQuadrant() {
 
 // ---------- Splash screen (6s) ----------
 static inline void showSplash(uint32_t ms = 6000) {
-  gfx->fillScreen(0x0000);
-  gfx->draw16bitRGBBitmap(0, 0, (uint16_t*)Pongino, PONGINO_WIDTH, PONGINO_HEIGHT);
+  {
+    DS_REFRESH_SCOPE("splash");
+    // lo splash copre tutto lo schermo: niente fillScreen, una riga decodificata alla volta
+    drawQ565(gfx, (SCREEN_W - PONGINO_WIDTH) / 2, (SCREEN_H - PONGINO_HEIGHT) / 2,
+             Pongino_q565, sizeof(Pongino_q565));
+  }
   const uint32_t t0 = millis();
   while ((millis() - t0) < ms) delay(10);
   gfx->fillScreen(COL_BG);
@@ -1129,7 +1173,7 @@ static void suddenShuffle() {
   const int TOT = BRICK_ROWS*BRICK_COLS;
   int indices[TOT];
   for (int i=0;i<TOT;++i) indices[i]=i;
-  for (int i=TOT-1;i>0;--i){ int j = random(0, i+1); int t = indices[i]; indices[i]=indices[j]; indices[j]=t; }
+  for (int i=TOT-1;i>0;--i){ int j = simRandom(0, i+1); int t = indices[i]; indices[i]=indices[j]; indices[j]=t; }
 
   for (int i=0;i<TOT;++i) bricks[i].alive=false;
 
@@ -1151,11 +1195,190 @@ static void suddenShuffle() {
   }
   bricksAlive = aliveCount;
 
-  drawBricks(true);
+  damageBrickArea();
+}
+
+// ---------- Fisica palla: collisioni swept sulla griglia dei mattoni ----------
+// La palla percorre il tick a segmenti: per ogni segmento si cerca il primo ostacolo
+// toccato (muri, paddle, mattoni nelle sole celle attraversate), ci si ferma lì,
+// si rimbalza e si prosegue col tempo rimasto. Niente "salti" dentro ai mattoni
+// anche a velocità ben sopra BALL_SPEED_MAX.
+static const int     BRICK_PITCH_X = BRICK_W + BRICK_PAD;
+static const int     BRICK_PITCH_Y = BRICK_H + BRICK_PAD;
+static const int64_t SWEEP_ONE     = 1 << 16;   // tempi in Q16 del segmento
+static const int     SWEEP_MAX_HITS = 4;        // urti gestiti in un solo tick
+
+
+// Intervallo di tempo in cui la palla (lato BALL_SIZE, angolo p) sta dentro [lo,hi) su un asse.
+// Intervallo aperto: sfiorarsi non è un urto (quello lo gestisce grazeBricks()).
+static inline bool sweepAxis(int32_t p, int32_t d, int32_t lo, int32_t hi, int64_t &tIn, int64_t &tOut) {
+  const int32_t a = lo - (BALL_SIZE << FIX_SHIFT);
+  if (d == 0) {
+    if (p <= a || p >= hi) return false;
+    tIn = INT64_MIN; tOut = INT64_MAX;
+    return true;
+  }
+  int64_t t0 = ((int64_t)(a  - p) * SWEEP_ONE) / d;
+  int64_t t1 = ((int64_t)(hi - p) * SWEEP_ONE) / d;
+  if (t0 > t1) { const int64_t t = t0; t0 = t1; t1 = t; }
+  tIn = t0; tOut = t1;
+  return true;
+}
+static inline void sweepBox(int32_t dx, int32_t dy, int x, int y, int w, int h, SweepKind kind, int idx, SweepHit &best) {
+  int64_t inX, outX, inY, outY;
+  if (!sweepAxis(ball.x, dx, (int32_t)x << FIX_SHIFT, (int32_t)(x + w) << FIX_SHIFT, inX, outX)) return;
+  if (!sweepAxis(ball.y, dy, (int32_t)y << FIX_SHIFT, (int32_t)(y + h) << FIX_SHIFT, inY, outY)) return;
+  const int64_t tIn  = max(inX, inY);
+  const int64_t tOut = min(outX, outY);
+  if (tIn >= tOut || tIn >= SWEEP_ONE || tOut <= 0) return;
+  const int64_t t = tIn < 0 ? 0 : tIn;    // già sovrapposti: urto subito
+  if (t >= best.t) return;
+  best.t = t; best.hitX = inX >= inY; best.hitY = inY >= inX;
+  best.kind = kind; best.idx = idx;
+  best.x = x; best.y = y; best.w = w; best.h = h;
+}
+// Rimbalzo "lontano dal centro del box" sull'asse colpito: giusto anche se si parte sovrapposti
+static inline void reflectFrom(const SweepHit &h) {
+  const int32_t bcx = ball.x + ((BALL_SIZE << FIX_SHIFT) >> 1);
+  const int32_t bcy = ball.y + ((BALL_SIZE << FIX_SHIFT) >> 1);
+  const int32_t ocx = ((int32_t)h.x << FIX_SHIFT) + (((int32_t)h.w << FIX_SHIFT) >> 1);
+  const int32_t ocy = ((int32_t)h.y << FIX_SHIFT) + (((int32_t)h.h << FIX_SHIFT) >> 1);
+  if (h.hitX) ball.vx = (bcx < ocx) ? -abs(ball.vx) : abs(ball.vx);
+  if (h.hitY) ball.vy = (bcy < ocy) ? -abs(ball.vy) : abs(ball.vy);
+}
+
+static inline void bounceOnPaddle() {
+  ball.y  = (int32_t)(paddle.y - BALL_SIZE - 1) << FIX_SHIFT;
+  ball.vy = -abs(ball.vy);
+  // effetto: fino a ±1.1 px/tick in base al punto d'impatto
+  const int32_t center = (int32_t)(paddle.x + paddle.w/2) << FIX_SHIFT;
+  const int32_t off    = ball.x + ((BALL_SIZE/2) << FIX_SHIFT) - center;
+  ball.vx += off * 11 / (10 * (paddle.w/2));
+  const int32_t spx = constrain(abs(ball.vx), (int32_t)307, BALL_SPEED_MAX);                  // min 1.2
+  ball.vx = (ball.vx < 0 ? -spx : spx);
+  const int32_t spy = constrain(abs(ball.vy) + BALL_SPEED_INC, (int32_t)410, BALL_SPEED_MAX); // min 1.6
+  ball.vy = -spy;
+}
+
+// Celle della griglia toccate dal rettangolo in pixel [x0,x1] x [y0,y1]
+static inline void brickCells(int x0, int y0, int x1, int y1, int &r0, int &c0, int &r1, int &c1) {
+  c0 = max(0, (x0 - BRICK_PAD) / BRICK_PITCH_X);
+  c1 = min(BRICK_COLS - 1, (x1 - BRICK_PAD) / BRICK_PITCH_X);
+  r0 = max(0, (y0 - BRICK_TOP) / BRICK_PITCH_Y);
+  r1 = (y1 < BRICK_TOP) ? -1 : min(BRICK_ROWS - 1, (y1 - BRICK_TOP) / BRICK_PITCH_Y);
+}
+
+static inline void crackNeighbor(int r, int c) {
+  if (r<0 || r>=BRICK_ROWS || c<0 || c>=BRICK_COLS) return;
+  const int ni = r*BRICK_COLS + c;
+  if (!bricks[ni].alive) return;
+  crackBrick(ni);
+}
+static void breakBrick(int i) {
+  Brick &b = bricks[i];
+  b.alive = false; bricksAlive--; score += 10;
+  brickCrackSeed[i] = 0; brickHits[i] = 0;
+  damageBrick(i);
+
+  const int r = i / BRICK_COLS, c = i % BRICK_COLS;
+  crackNeighbor(r, c-1); crackNeighbor(r, c+1); crackNeighbor(r-1, c); crackNeighbor(r+1, c);
+
+  flashRect(b.x, b.y, b.w, b.h);
+  spawnExplosion(b.x, b.y, b.w, b.h, b.color, FX_BRICK_COUNT, true);
+  if (brickHasMissile[i]) { spawnMissile(b.x, b.y); brickHasMissile[i] = false; }
+}
+
+// Muove la palla di un tick; true se ha rotto almeno un mattone
+static bool moveBallSwept() {
+  bool broke = false;
+  int64_t left = SWEEP_ONE;                 // frazione di tick ancora da percorrere
+  for (int n = 0; n < SWEEP_MAX_HITS && left > 0; ++n) {
+    const int32_t dx = (int32_t)((int64_t)ball.vx * left / SWEEP_ONE);
+    const int32_t dy = (int32_t)((int64_t)ball.vy * left / SWEEP_ONE);
+
+    SweepHit hit; hit.t = INT64_MAX; hit.kind = SW_NONE;
+    sweepBox(dx, dy, -64, -SCREEN_H, 64, 3*SCREEN_H, SW_WALL, -1, hit);          // sinistra
+    sweepBox(dx, dy, SCREEN_W, -SCREEN_H, 64, 3*SCREEN_H, SW_WALL, -1, hit);     // destra
+    sweepBox(dx, dy, -64, -64, SCREEN_W + 128, 64, SW_WALL, -1, hit);            // alto
+    if (ball.vy > 0) sweepBox(dx, dy, paddle.x, paddle.y, paddle.w, paddle.h, SW_PADDLE, -1, hit);
+
+    const int x0 = min(ball.x, ball.x + dx) >> FIX_SHIFT, x1 = (max(ball.x, ball.x + dx) >> FIX_SHIFT) + BALL_SIZE;
+    const int y0 = min(ball.y, ball.y + dy) >> FIX_SHIFT, y1 = (max(ball.y, ball.y + dy) >> FIX_SHIFT) + BALL_SIZE;
+    int r0, c0, r1, c1;
+    brickCells(x0, y0, x1, y1, r0, c0, r1, c1);
+    for (int r = r0; r <= r1; ++r) {
+      for (int c = c0; c <= c1; ++c) {
+        const int i = r*BRICK_COLS + c;
+        const Brick &b = bricks[i];
+        if (b.alive) sweepBox(dx, dy, b.x, b.y, b.w, b.h, SW_BRICK, i, hit);
+      }
+    }
+
+    if (hit.kind == SW_NONE) { ball.x += dx; ball.y += dy; break; }
+
+    ball.x += (int32_t)((int64_t)dx * hit.t / SWEEP_ONE);
+    ball.y += (int32_t)((int64_t)dy * hit.t / SWEEP_ONE);
+    left -= left * hit.t / SWEEP_ONE;
+
+    if (hit.kind == SW_PADDLE) { bounceOnPaddle(); break; }
+    reflectFrom(hit);
+    if (hit.kind == SW_BRICK) { breakBrick(hit.idx); broke = true; }
+  }
+  return broke;
+}
+
+// Passaggio radente (entro 2 px): rimbalza e crepa, al secondo colpo il mattone cade
+static void grazeBricks() {
+  const int INF = 2;
+  const int bx = ballPX(), by = ballPY();
+  int r0, c0, r1, c1;
+  brickCells(bx - INF, by - INF, bx + BALL_SIZE + INF, by + BALL_SIZE + INF, r0, c0, r1, c1);
+  for (int r = r0; r <= r1; ++r) {
+    for (int c = c0; c <= c1; ++c) {
+      const int i = r*BRICK_COLS + c;
+      Brick &b = bricks[i];
+      if (!b.alive) continue;
+      if (!rectIntersectInflated(bx, by, BALL_SIZE, BALL_SIZE, b.x, b.y, b.w, b.h, INF)) continue;
+
+      const int dx = (bx + (BALL_SIZE>>1)) - (b.x + (b.w>>1));
+      const int dy = (by + (BALL_SIZE>>1)) - (b.y + (b.h>>1));
+      if (abs(dx) > abs(dy)) ball.vx = (dx > 0) ?  abs(ball.vx) : -abs(ball.vx);
+      else                   ball.vy = (dy > 0) ?  abs(ball.vy) : -abs(ball.vy);
+
+      brickHits[i] = (uint8_t)min(255, (int)brickHits[i] + 1);
+      crackBrick(i);
+      if (brickHits[i] >= 2) breakBrick(i);
+      return;
+    }
+  }
+}
+
+// ---------- Nuova partita ----------
+// Riporta la partita allo stato iniziale; il seme e il contatore dei tick proseguono
+static void resetGameState() {
+  score = 0; lives = 3; victory = false; gameOver = false; gameOverDrawn = false;
+  paddleBuffActive = false; paddleSizeState = PS_NORMAL; paddleBuffEndMs = 0;
+  paddleBlinkFxActive = false;
+  bonusDrop.active = false; pdownDrop.active = false;
+  bonusBlinkToggle = false; bonusBlinkLastMs = simMs();
+  resetMissiles(); resetParticles(); initBricks();
+  BRICK_HOVER_DELTA = 0; BRICK_HOVER_DIR = 1; BRICK_HOVER_LAST = simMs();
+  COL_PADDLE = COL_PADDLE_DEF; COL_PEND = COL_PEND_DEF;
+  lastBonusMs = lastPowerDownMs = lastShuffleMs = simMs();
+  overlay.active = false; overlay.text[0] = '\0';
+  shuffleMsgUntilMs = 0;
+  resetBallAndPaddle(true);
+}
+// Partita da zero con un seme noto: base della registrazione e del replay
+static void newGame(uint32_t seed) {
+  simRng  = seed ? seed : 1;
+  simTick = 0;
+  resetGameState();
 }
 
 // ---------- Setup ----------
 void setup() {
+  Serial.begin(115200);   // contatori DRAW_STATS e comandi di registrazione/replay
   delay(50);
   pinMode(GFX_BL, OUTPUT);
   digitalWrite(GFX_BL, HIGH);
@@ -1173,27 +1396,7 @@ void setup() {
   randomSeed((analogRead(A0) ^ micros()));
 
   initStars();
-  resetParticles();
-  resetMissiles();
-  initBricks();
-
-  lives = 3; victory = false; gameOver = false; score = 0;
-  gameOverDrawn = false;
-
-  paddleBuffActive = false;
-  paddleSizeState  = PS_NORMAL;
-  paddleBuffEndMs  = 0;
-
-  lastBonusMs = millis();
-  lastPowerDownMs = millis();
-  lastShuffleMs = millis();
-  bonusDrop.active = false;
-  pdownDrop.active = false;
-  bonusBlinkToggle = false; bonusBlinkLastMs = 0;
-
-  overlay.active = false; overlay.text[0] = '\0';
-
-  resetBallAndPaddle(true);
+  newGame(esp_random());
   fullRedraw();
 }
 
@@ -1222,32 +1425,196 @@ static inline void stepPalettePhase(){
 }
 
 // ---------- Loop ----------
+// Un tick di simulazione: aggiorna lo stato e segnala le aree sporche; il disegno lo fa composeFrame()
+static void stepGame(uint32_t now, Quad q);
+
+// ---------- Registrazione / replay ----------
+// Comandi da Serial (115200, uno per riga):
+//   rec    nuova partita con seme casuale, registra gli input (solo i cambi, per tick)
+//   stop   chiude la registrazione (si chiude da sola al GAME OVER)
+//   dump   stampa la sessione: "PONGREC 1 <seme> <tick> <hash>", righe "<tick> <quad>", "END"
+//   load   legge una sessione nello stesso formato (incollata nel monitor seriale)
+//   play   rigioca la sessione a schermo e alla fine confronta l'hash dello stato
+//   bench  rigioca senza disegno e senza attese: costo della simulazione per tick
+// L'hash copre solo lo stato di gioco (palla, paddle, mattoni, gemme, missili, punteggio,
+// timer, seme): particelle, stelle e colori animati sono estetica e restano fuori.
+struct RecEvent { uint32_t tick; uint8_t q; };
+static const int REC_MAX = 4096;            // 32 KB: ~20 minuti di gioco tipico
+static RecEvent recEv[REC_MAX];
+static int      recCount = 0, recPos = 0;
+static uint32_t recSeed = 0, recTicks = 0, recHash = 0;
+static Quad     recQ = Q_NONE;
+enum RecMode { REC_IDLE, REC_RECORDING, REC_PLAYING, REC_LOADING };
+static RecMode  recMode = REC_IDLE;
+
+static inline void fnvMix(uint32_t &h, uint32_t v) {
+  for (int k = 0; k < 4; ++k) { h ^= (v >> (8*k)) & 0xFF; h *= 16777619u; }
+}
+static uint32_t simHash() {
+  uint32_t h = 2166136261u;
+  fnvMix(h, simTick); fnvMix(h, simRng);
+  fnvMix(h, ball.x); fnvMix(h, ball.y); fnvMix(h, ball.vx); fnvMix(h, ball.vy); fnvMix(h, ballOnPaddle);
+  fnvMix(h, paddle.x); fnvMix(h, paddle.w);
+  fnvMix(h, score); fnvMix(h, lives); fnvMix(h, bricksAlive); fnvMix(h, victory | (gameOver << 1));
+  for (int i=0;i<BRICK_ROWS*BRICK_COLS;++i) {
+    fnvMix(h, bricks[i].alive | (brickHits[i] << 1) | (brickHasMissile[i] << 9));
+    fnvMix(h, brickCrackSeed[i]);
+  }
+  const Bonus *drops[2] = { &bonusDrop, &pdownDrop };
+  for (int k=0;k<2;++k) { fnvMix(h, drops[k]->active); fnvMix(h, drops[k]->x); fnvMix(h, drops[k]->y); }
+  for (int i=0;i<MAX_MISSILES;++i) { fnvMix(h, missiles[i].active); fnvMix(h, missiles[i].x); fnvMix(h, missiles[i].y); }
+  fnvMix(h, paddleBuffActive | (paddleSizeState << 1)); fnvMix(h, paddleBuffEndMs);
+  fnvMix(h, lastBonusMs); fnvMix(h, lastPowerDownMs); fnvMix(h, lastShuffleMs);
+  return h;
+}
+
+static void stopRecording() {
+  recMode  = REC_IDLE;
+  recTicks = simTick;
+  recHash  = simHash();
+  Serial.printf("[REC] fine: seme=%08lx tick=%lu eventi=%d hash=%08lx\n",
+                (unsigned long)recSeed, (unsigned long)recTicks, recCount, (unsigned long)recHash);
+}
+static void finishReplay() {
+  recMode = REC_IDLE;
+  const uint32_t h = simHash();
+  Serial.printf("[REC] replay: tick=%lu hash=%08lx atteso=%08lx %s\n", (unsigned long)simTick,
+                (unsigned long)h, (unsigned long)recHash, h == recHash ? "OK" : "DIVERSO");
+}
+
+// Input del tick: dal touch, registrato se serve, oppure dalla sessione in replay
+static Quad simInput(Quad live) {
+  if (recMode == REC_PLAYING) {
+    while (recPos < recCount && recEv[recPos].tick <= simTick) recQ = (Quad)recEv[recPos++].q;
+    return recQ;
+  }
+  if (recMode == REC_RECORDING && live != recQ) {
+    if (recCount == REC_MAX) { stopRecording(); return live; }
+    recEv[recCount++] = { simTick, (uint8_t)live };
+    recQ = live;
+  }
+  return live;
+}
+static void simStep(Quad live) {
+  stepGame(simMs(), simInput(live));
+  simTick++;
+  if (recMode == REC_RECORDING && gameOver) stopRecording();
+  if (recMode == REC_PLAYING && simTick >= recTicks) finishReplay();
+}
+
+static void startReplay() {
+  newGame(recSeed);
+  recPos = 0; recQ = Q_NONE;
+  recMode = REC_PLAYING;
+}
+static void benchReplay() {
+  startReplay();
+  simHeadless = true;
+  uint32_t usMax = 0;
+  const uint32_t t0 = micros();
+  while (recMode == REC_PLAYING && !gameOver) {
+    const uint32_t t1 = micros();
+    simStep(Q_NONE);
+    fx.flushDamage([](int, int, int, int) {});
+    damageCount = 0;                         // nessuno ridisegna: la lista non deve saturarsi
+    const uint32_t dt = micros() - t1;
+    if (dt > usMax) usMax = dt;
+  }
+  const uint32_t us = micros() - t0;
+  simHeadless = false;
+  if (recMode == REC_PLAYING) finishReplay();
+  Serial.printf("[REC] bench: tick=%lu tot=%lu us avg=%lu.%02lu us max=%lu us\n",
+                (unsigned long)simTick, (unsigned long)us,
+                (unsigned long)(us / max<uint32_t>(1, simTick)),
+                (unsigned long)((us * 100 / max<uint32_t>(1, simTick)) % 100), (unsigned long)usMax);
+  fullRedraw();
+}
+
+static void dumpRecording() {
+  Serial.printf("PONGREC 1 %08lx %lu %08lx\n", (unsigned long)recSeed, (unsigned long)recTicks, (unsigned long)recHash);
+  for (int i=0;i<recCount;++i) Serial.printf("%lu %u\n", (unsigned long)recEv[i].tick, (unsigned)recEv[i].q);
+  Serial.println("END");
+}
+
+static void handleSerialLine(const char *line) {
+  if (recMode == REC_LOADING) {
+    unsigned long a = 0, b = 0, c = 0;
+    if (strcmp(line, "END") == 0) {
+      recMode = REC_IDLE;
+      Serial.printf("[REC] caricata: tick=%lu eventi=%d\n", (unsigned long)recTicks, recCount);
+    } else if (sscanf(line, "PONGREC 1 %lx %lu %lx", &a, &b, &c) == 3) {
+      recSeed = a; recTicks = b; recHash = c; recCount = 0;
+    } else if (sscanf(line, "%lu %lu", &a, &b) == 2 && recCount < REC_MAX) {
+      recEv[recCount++] = { (uint32_t)a, (uint8_t)b };
+    }
+    return;
+  }
+  if (strcmp(line, "rec") == 0) {
+    newGame(esp_random());
+    recSeed = simRng; recCount = 0; recQ = Q_NONE;
+    recMode = REC_RECORDING;
+    fullRedraw();
+    Serial.printf("[REC] registrazione: seme=%08lx\n", (unsigned long)recSeed);
+  } else if (strcmp(line, "stop") == 0) {
+    if (recMode == REC_RECORDING) stopRecording();
+  } else if (strcmp(line, "dump") == 0) {
+    dumpRecording();
+  } else if (strcmp(line, "load") == 0) {
+    recMode = REC_LOADING; recCount = 0;
+  } else if (strcmp(line, "play") == 0 || strcmp(line, "bench") == 0) {
+    if (recTicks == 0) { Serial.println("[REC] nessuna sessione"); return; }
+    if (line[0] == 'b') benchReplay();
+    else { startReplay(); fullRedraw(); }
+  }
+}
+static void pollSerial() {
+  static char    buf[48];
+  static uint8_t len = 0;
+  while (Serial.available() > 0) {
+    const char c = (char)Serial.read();
+    if (c == '\r') continue;
+    if (c != '\n') { if (len < sizeof(buf) - 1) buf[len++] = c; continue; }
+    buf[len] = '\0'; len = 0;
+    handleSerialLine(buf);
+  }
+}
+
 void loop() {
-  static uint32_t lastFrame = 0;
+  static uint32_t lastMs = 0, acc = 0;
+  pollSerial();
+
   const uint32_t now = millis();
-  if (now - lastFrame < (uint32_t)FRAME_INTERVAL_MS) return;
-  lastFrame = now;
+  acc += now - lastMs; lastMs = now;
+  if (acc < SIM_TICK_MS) return;
+  if (acc > SIM_TICK_MS * SIM_MAX_CATCHUP) acc = SIM_TICK_MS * SIM_MAX_CATCHUP;
+  DS_FRAME_SCOPE("frame");
 
-  Quad q = readQuadrant();
+  const Quad q = readQuadrant();
 
   if (gameOver) {
+    acc = 0;
     if (!gameOverDrawn) {
       drawGameOverHard();
       gameOverDrawn = true;
     }
     if (q != Q_NONE) {
-      score = 0; lives = 3; victory = false; gameOver = false; gameOverDrawn = false;
-      paddleBuffActive = false; paddleSizeState = PS_NORMAL; paddleBuffEndMs = 0;
-      bonusDrop.active = false; pdownDrop.active = false;
-      resetMissiles(); resetParticles(); initBricks();
-      COL_PADDLE = COL_PADDLE_DEF; COL_PEND = COL_PEND_DEF;
-      overlay.active = false; overlay.text[0] = '\0';
-      resetBallAndPaddle(true);
+      resetGameState();
       fullRedraw();
     }
     return;
   }
 
+  // Tick a passo fisso finché c'è tempo accumulato, poi un solo disegno
+  while (acc >= SIM_TICK_MS && !gameOver) {
+    acc -= SIM_TICK_MS;
+    simStep(q);
+  }
+  // Le animazioni bloccanti (esplosioni) fermano il gioco: quel tempo non si recupera
+  if (millis() - now > SIM_TICK_MS * SIM_MAX_CATCHUP) { acc = 0; lastMs = millis(); }
+  composeFrame();
+}
+
+static void stepGame(uint32_t now, Quad q) {
   if (now - BRICK_HOVER_LAST >= BRICK_HOVER_STEP_MS){
     BRICK_HOVER_LAST = now;
     BRICK_HOVER_DELTA += BRICK_HOVER_DIR;
@@ -1265,12 +1632,13 @@ void loop() {
       }
     }
     stepPalettePhase();
-    BRICK_NEED_REPAINT = true;
+    damageAliveBricks();
   }
 
   maybeExpirePaddleBuff();
   maybeUpdatePaddleBlinkFx();
   normalizePaddleWidth();
+  stepBonusBlink(now);
 
   // Shuffle ogni 40s + messaggio per 2s
   if ((uint32_t)(now - lastShuffleMs) >= 40000) {
@@ -1294,24 +1662,14 @@ void loop() {
     if (!(overlay.active && strcmp(overlay.text, "VICTORY! - tap to restart") == 0)) {
       showOverlayCentered("VICTORY! - tap to restart", 2);
     }
-    if (BRICK_NEED_REPAINT) { drawBricks(false); BRICK_NEED_REPAINT = false; }
-    drawHUD_ifDirty();
-    drawCornerHints();
     if (q != Q_NONE) {
-      score = 0; lives = 3; victory = false; gameOver = false; gameOverDrawn = false;
-      paddleBuffActive = false; paddleSizeState = PS_NORMAL; paddleBuffEndMs = 0;
-      bonusDrop.active = false; pdownDrop.active = false;
-      resetMissiles(); resetParticles(); initBricks();
-      COL_PADDLE = COL_PADDLE_DEF; COL_PEND = COL_PEND_DEF;
-      overlay.active = false; overlay.text[0] = '\0';
-      resetBallAndPaddle(true);
+      resetGameState();
       fullRedraw();
     }
     return;
   }
 
   const int oldPX = paddle.x, oldPY = paddle.y, oldPW = paddle.w;
-  const int oldBX = (int)ball.x, oldBY = (int)ball.y;
 
   if (q == Q_BL) paddle.x -= PADDLE_SPEED;
   else if (q == Q_BR) paddle.x += PADDLE_SPEED;
@@ -1320,132 +1678,32 @@ void loop() {
 
   if (ballOnPaddle) {
     if ((oldPX != paddle.x) || (oldPY != paddle.y) || (oldPW != paddle.w)) {
-      ball.x = paddle.x + paddle.w/2 - BALL_SIZE/2;
-      ball.y = paddle.y - BALL_SIZE - 2;
+      ball.x = (int32_t)(paddle.x + paddle.w/2 - BALL_SIZE/2) << FIX_SHIFT;
+      ball.y = (int32_t)(paddle.y - BALL_SIZE - 2) << FIX_SHIFT;
     }
     if (q == Q_BL)  { ball.vx = -BALL_SPEED_INIT; ball.vy = -BALL_SPEED_INIT; ballOnPaddle = false; }
     else if (q == Q_BR) { ball.vx =  BALL_SPEED_INIT; ball.vy = -BALL_SPEED_INIT; ballOnPaddle = false; }
   } else {
-    ball.x += ball.vx; ball.y += ball.vy;
-
-    if (ball.x <= 0) { ball.x = 0; ball.vx = fabs(ball.vx); }
-    if (ball.x + BALL_SIZE >= SCREEN_W) { ball.x = SCREEN_W - BALL_SIZE; ball.vx = -fabs(ball.vx); }
-    if (ball.y <= 0) { ball.y = 0; ball.vy = fabs(ball.vy); }
-
-    if (rectIntersect((int)ball.x, (int)ball.y, BALL_SIZE, BALL_SIZE, paddle.x, paddle.y, paddle.w, paddle.h) && ball.vy > 0) {
-      ball.y  = paddle.y - BALL_SIZE - 1;
-      ball.vy = -fabs(ball.vy);
-      const float hit = ((ball.x + BALL_SIZE/2) - (paddle.x + paddle.w/2)) / (float)(paddle.w/2);
-      ball.vx += hit * 1.1f;
-      const float spx = constrain(fabs(ball.vx), 1.2f, BALL_SPEED_MAX);
-      ball.vx = (ball.vx < 0 ? -spx : spx);
-      const float spy = constrain(fabs(ball.vy)+BALL_SPEED_INC, 1.6f, BALL_SPEED_MAX);
-      ball.vy = (ball.vy < 0 ? -spy : spy);
-    }
+    if (!moveBallSwept()) grazeBricks();
 
-    bool brokeBrick = false;
-    for (int i = 0; i < BRICK_ROWS * BRICK_COLS; ++i) {
-      Brick &b = bricks[i];
-      if (!b.alive) continue;
-      if (rectIntersect((int)ball.x, (int)ball.y, BALL_SIZE, BALL_SIZE, b.x, b.y, b.w, b.h)) {
-        b.alive = false; bricksAlive--; score += 10;
-        brickCrackSeed[i] = 0; brickHits[i] = 0;
-
-        const int r = i / BRICK_COLS, c = i % BRICK_COLS;
-        auto crackNeighbor = [&](int rr, int cc){
-          if (rr<0 || rr>=BRICK_ROWS || cc<0 || cc>=BRICK_COLS) return;
-          const int ni = rr*BRICK_COLS + cc;
-          if (!bricks[ni].alive) return;
-          if (brickCrackSeed[ni] == 0) brickCrackSeed[ni] = (uint32_t)random(1, 0x7FFFFFFF);
-          drawCrackOverlayRandom(bricks[ni].x, bricks[ni].y, bricks[ni].w, bricks[ni].h, brickCrackSeed[ni]);
-        };
-        crackNeighbor(r, c-1); crackNeighbor(r, c+1); crackNeighbor(r-1, c); crackNeighbor(r+1, c);
-
-        flashRect(b.x, b.y, b.w, b.h);
-        spawnExplosion(b.x, b.y, b.w, b.h, b.color, 6, true, true);
-        if (brickHasMissile[i]) { spawnMissile(b.x, b.y); brickHasMissile[i] = false; }
-
-        const int bxC = (int)ball.x + (BALL_SIZE>>1);
-        const int byC = (int)ball.y + (BALL_SIZE>>1);
-        const int bcx = b.x + (b.w>>1);
-        const int bcy = b.y + (b.h>>1);
-        const int dx = bxC - bcx;
-        const int dy = byC - bcy;
-        if (abs(dx) > abs(dy)) ball.vx = (dx > 0) ?  fabs(ball.vx) : -fabs(ball.vx);
-        else                   ball.vy = (dy > 0) ?  fabs(ball.vy) : -fabs(ball.vy);
-
-        brokeBrick = true;
-        break;
-      }
-    }
-
-    if (!brokeBrick) {
-      const int INF = 2;
-      for (int i = 0; i < BRICK_ROWS * BRICK_COLS; ++i) {
-        Brick &b = bricks[i];
-        if (!b.alive) continue;
-        if (rectIntersectInflated((int)ball.x, (int)ball.y, BALL_SIZE, BALL_SIZE, b.x, b.y, b.w, b.h, INF)) {
-          const int bxC = (int)ball.x + (BALL_SIZE>>1);
-          const int byC = (int)ball.y + (BALL_SIZE>>1);
-          const int bcx = b.x + (b.w>>1);
-          const int bcy = b.y + (b.h>>1);
-          const int dx = bxC - bcx;
-          const int dy = byC - bcy;
-          if (abs(dx) > abs(dy)) ball.vx = (dx > 0) ?  fabs(ball.vx) : -fabs(ball.vx);
-          else                   ball.vy = (dy > 0) ?  fabs(ball.vy) : -fabs(ball.vy);
-
-          brickHits[i] = (uint8_t)min(255, (int)brickHits[i] + 1);
-
-          if (brickCrackSeed[i] == 0) brickCrackSeed[i] = (uint32_t)random(1, 0x7FFFFFFF);
-          drawCrackOverlayRandom(b.x, b.y, b.w, b.h, brickCrackSeed[i]);
-
-          if (brickHits[i] >= 2) {
-            b.alive = false; bricksAlive--; score += 10;
-            brickCrackSeed[i] = 0; brickHits[i] = 0;
-
-            const int r = i / BRICK_COLS, c = i % BRICK_COLS;
-            auto crackNeighbor2 = [&](int rr, int cc){
-              if (rr<0 || rr>=BRICK_ROWS || cc<0 || cc>=BRICK_COLS) return;
-              const int ni = rr*BRICK_COLS + cc;
-              if (!bricks[ni].alive) return;
-              if (brickCrackSeed[ni] == 0) brickCrackSeed[ni] = (uint32_t)random(1, 0x7FFFFFFF);
-              drawCrackOverlayRandom(bricks[ni].x, bricks[ni].y, bricks[ni].w, bricks[ni].h, brickCrackSeed[ni]);
-            };
-            crackNeighbor2(r, c-1); crackNeighbor2(r, c+1); crackNeighbor2(r-1, c); crackNeighbor2(r+1, c);
-
-            flashRect(b.x, b.y, b.w, b.h);
-            spawnExplosion(b.x, b.y, b.w, b.h, b.color, 6, true, true);
-            if (brickHasMissile[i]) { spawnMissile(b.x, b.y); brickHasMissile[i] = false; }
-          }
-          break;
-        }
-      }
-    }
-
-    if (ball.y > SCREEN_H) {
+    if (ballPY() > SCREEN_H) {
       animatePaddleExplosion();
-      loseLifeAfterAnimation(oldBX, oldBY);
+      loseLifeAfterAnimation();
       return;
     }
 
     if (bricksAlive == 0) {
       victory = true;
       showOverlayCentered("VICTORY! - tap to restart", 2);
-      drawHUD_ifDirty(); drawCornerHints();
       return;
     }
   }
 
   // Power-up con traiettoria a S
   if (bonusDrop.active) {
-    const int prevY = bonusDrop.y, prevX = bonusDrop.x;
-    clearBonusLast();
-
     bonusDrop.py = bonusDrop.y; bonusDrop.px = bonusDrop.x;
     bonusDrop.y += bonusDrop.vy;
-    bonusDrop.x = bonusDrop.baseX + (int)(bonusDrop.sAmp * sinf(bonusDrop.sOmega * bonusDrop.y + bonusDrop.sPhase));
-
-    clearBonusTrailStrip(prevX, prevY, bonusDrop.y, bonusDrop.w, bonusDrop.h);
+    bonusDrop.x = dropX(bonusDrop);
 
     if (bonusDrop.y > SCREEN_H) {
       deactivateBonus();
@@ -1453,22 +1711,15 @@ void loop() {
       if (rectIntersect(bonusDrop.x, bonusDrop.y, bonusDrop.w, bonusDrop.h, paddle.x, paddle.y, paddle.w, paddle.h)) {
         deactivateBonus();
         applyPaddleBuff();
-      } else {
-        drawBonusNow();
       }
     }
   }
 
   // Power-down con traiettoria a S
   if (pdownDrop.active) {
-    const int prevY = pdownDrop.y, prevX = pdownDrop.x;
-    clearPowerDownLast();
-
     pdownDrop.py = pdownDrop.y; pdownDrop.px = pdownDrop.x;
     pdownDrop.y += pdownDrop.vy;
-    pdownDrop.x = pdownDrop.baseX + (int)(pdownDrop.sAmp * sinf(pdownDrop.sOmega * pdownDrop.y + pdownDrop.sPhase));
-
-    clearBonusTrailStrip(prevX, prevY, pdownDrop.y, pdownDrop.w, pdownDrop.h);
+    pdownDrop.x = dropX(pdownDrop);
 
     if (pdownDrop.y > SCREEN_H) {
       deactivatePowerDown();
@@ -1476,8 +1727,6 @@ void loop() {
       if (rectIntersect(pdownDrop.x, pdownDrop.y, pdownDrop.w, pdownDrop.h, paddle.x, paddle.y, paddle.w, paddle.h)) {
         deactivatePowerDown();
         applyPaddleDebuff();
-      } else {
-        drawPowerDownNow();
       }
     }
   }
@@ -1485,29 +1734,22 @@ void loop() {
   // Missili
   for (int i=0;i<MAX_MISSILES;++i) {
     if (!missiles[i].active) continue;
-    const int prevY = missiles[i].y, prevX = missiles[i].x;
     missiles[i].y += missiles[i].vy;
-    clearMissileTrailStrip(prevX, prevY, missiles[i].y, missiles[i].w, missiles[i].h);
+    missiles[i].flick  = random(0,3);
+    missiles[i].flame2 = random(0,2) != 0;
 
     if (rectIntersect(missiles[i].x, missiles[i].y, missiles[i].w, missiles[i].h, paddle.x, paddle.y, paddle.w, paddle.h)) {
-      animateMissileExplosion(missiles[i].x, missiles[i].y, missiles[i].w, missiles[i].h, missiles[i].color);
       missiles[i].active = false;
+      animateMissileExplosion(missiles[i].x, missiles[i].y, missiles[i].w, missiles[i].h, missiles[i].color);
       animatePaddleExplosion();
-      loseLifeAfterAnimation(oldBX, oldBY);
+      loseLifeAfterAnimation();
       return;
     }
     if (missiles[i].y > SCREEN_H) { missiles[i].active = false; continue; }
 
     missiles[i].px = missiles[i].x; missiles[i].py = missiles[i].y;
-    drawMissileNow(i);
   }
 
-  // Repaint hover/palette
-  if (BRICK_NEED_REPAINT) {
-    drawBricks(false);
-    BRICK_NEED_REPAINT = false;
-    if (overlay.active) drawOverlayNow();
-  }
 
   // Messaggio "SUDDEN SHUFFLE" -> scade dopo 2s
   if (shuffleMsgUntilMs) {
@@ -1516,19 +1758,6 @@ void loop() {
     }
   }
 
-  // Layering finale
+  // Stato finale: il disegno lo fa composeFrame() in loop()
   updateParticles();
-  if (oldPX != paddle.x || oldPY != paddle.y || oldPW != paddle.w) {
-    clearPaddleRegionExpanded(oldPX, oldPY, oldPW, PADDLE_H);
-    drawPaddleRounded(paddle);
-    if (overlay.active) drawOverlayNow();
-  }
-  if (oldBX != (int)ball.x || oldBY != (int)ball.y) {
-    clearBallRegionExpanded(oldBX, oldBY);
-    drawBallNow();
-    if (overlay.active) drawOverlayNow();
-  }
-  drawHUD_ifDirty();
-  drawCornerHints();
-  if (overlay.active) drawOverlayNow();
 }
@@ -0,0 +1,240 @@
+/*
+  DialFace.h – quadrante con lancette da pacchetti .qd (tools/dialpack.py), ridisegno a tasselli
+
+  Il pacchetto (header, indice dei tasselli, uno stream Q565 per tassello) si decodifica una
+  volta sola nello sfondo in PSRAM con load(). Da lì lo schermo si compone a strisce alte un
+  tassello: sfondo copiato nella striscia, lancette sopra con il bordo sfumato, una
+  draw16bitRGBBitmap per tratto di tasselli contigui.
+  A ogni secondo tick() ricompone solo i tasselli sotto la posizione vecchia e quella nuova
+  delle lancette che si sono mosse. La lancetta dei minuti scatta al minuto (come negli
+  orologi di stazione) e quella delle ore avanza con i minuti: tra un minuto e l'altro si
+  muove solo quella dei secondi.
+
+  Uso nello sketch:
+    #include "DialFace.h"
+    static DialFace face;
+    face.bg = (uint16_t *)ps_malloc(DIAL_W * DIAL_H * 2);
+    face.load(pack, len);              // false: pacchetto non valido o di un'altra misura
+    face.drawAll(h, m, s, push);       // schermo intero; push(x, y, buf, w, h)
+    face.tick(h, m, s, push);          // ogni secondo
+    face.lastPx, face.lastBlits        // pixel e blit dell'ultima chiamata
+
+  Senza Arduino: lo include anche tools/dialbench.cpp per misurare su PC.
+*/
+#pragma once
+#include <Q565.h>
+#include <math.h>
+
+#ifndef DIAL_W
+#define DIAL_W 480
+#endif
+#ifndef DIAL_H
+#define DIAL_H 480
+#endif
+
+#define DIAL_HEADER    24
+#define DIAL_MIN_TILE  8
+#define DIAL_MAX_TILE  32          // altezza della striscia di composizione
+#define DIAL_MAX_TILES (((DIAL_W + DIAL_MIN_TILE - 1) / DIAL_MIN_TILE) * ((DIAL_H + DIAL_MIN_TILE - 1) / DIAL_MIN_TILE))
+
+// Tratto con spessore: tutti i punti a distanza <= r dal segmento (ax,ay)-(bx,by)
+struct DialStroke {
+  float    ax, ay, bx, by, r;
+  uint16_t color;
+
+  bool operator==(const DialStroke &o) const {
+    return ax == o.ax && ay == o.ay && bx == o.bx && by == o.by && r == o.r && color == o.color;
+  }
+};
+
+enum : uint8_t { DIAL_HOUR, DIAL_MIN, DIAL_SEC, DIAL_HUB, DIAL_PIN, DIAL_STROKES };
+
+struct DialHeader {
+  uint8_t  tile, cols, rows;
+  uint16_t w, h, cx, cy, radius, hand, sec;
+};
+
+struct DialFace {
+  uint16_t  *bg = nullptr;               // DIAL_W*DIAL_H pixel, lo alloca lo sketch
+  DialHeader hd = {};
+  bool       ready = false;
+  uint32_t   lastPx = 0, lastBlits = 0;
+
+  // Decodifica tutti i tasselli nello sfondo; lo schermo non cambia finché non si chiama drawAll
+  bool load(const uint8_t *p, uint32_t len) {
+    ready = false;
+    if (!bg || len < DIAL_HEADER || memcmp(p, "QDIA", 4) != 0 || p[4] != 1) return false;
+    hd.tile = p[5]; hd.cols = p[6]; hd.rows = p[7];
+    hd.w = u16(p + 8);   hd.h = u16(p + 10);
+    hd.cx = u16(p + 12); hd.cy = u16(p + 14); hd.radius = u16(p + 16);
+    hd.hand = u16(p + 18); hd.sec = u16(p + 20);
+    const int t = hd.tile;
+    if (hd.w != DIAL_W || hd.h != DIAL_H || t < DIAL_MIN_TILE || t > DIAL_MAX_TILE) return false;
+    if (hd.cols != (DIAL_W + t - 1) / t || hd.rows != (DIAL_H + t - 1) / t) return false;
+
+    const uint32_t n = (uint32_t)hd.cols * hd.rows;
+    const uint8_t *index = p + DIAL_HEADER;
+    const uint32_t dataAt = DIAL_HEADER + (n + 1) * 4;
+    if (dataAt > len || u32(index + n * 4) > len - dataAt) return false;
+    const uint8_t *data = p + dataAt;
+
+    for (uint32_t i = 0; i < n; ++i) {
+      const uint32_t o0 = u32(index + i * 4), o1 = u32(index + i * 4 + 4);
+      const int tx = (int)(i % hd.cols) * t, ty = (int)(i / hd.cols) * t;
+      Q565Decoder d;
+      if (o1 < o0 || !d.begin(data + o0, o1 - o0) || d.w != tileW(tx) || d.h != tileH(ty)) return false;
+      for (int r = 0; r < d.h; ++r)
+        if (!d.readLine(bg + (ty + r) * DIAL_W + tx)) return false;
+    }
+    ready = true;
+    return true;
+  }
+
+  // Schermo intero all'ora data
+  template <class F>
+  void drawAll(int h, int m, int s, F push) {
+    if (!ready) return;
+    geometry(h, m, s, cur);
+    memset(dirty, 0xFF, sizeof(dirty));
+    flush(push);
+  }
+
+  // Un secondo: solo i tasselli toccati dalle lancette che si sono mosse
+  template <class F>
+  void tick(int h, int m, int s, F push) {
+    lastPx = lastBlits = 0;
+    if (!ready) return;
+    DialStroke next[DIAL_STROKES];
+    geometry(h, m, s, next);
+    memset(dirty, 0, sizeof(dirty));
+    for (int k = 0; k < DIAL_STROKES; ++k) {
+      if (next[k] == cur[k]) continue;
+      mark(cur[k]);
+      mark(next[k]);
+      cur[k] = next[k];
+    }
+    flush(push);
+  }
+
+private:
+  DialStroke cur[DIAL_STROKES] = {};
+  uint32_t   dirty[(DIAL_MAX_TILES + 31) / 32];
+  uint16_t   strip[DIAL_W * DIAL_MAX_TILE];
+
+  static uint16_t u16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+  static uint32_t u32(const uint8_t *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+  int tileW(int tx) const { return std::min((int)hd.tile, DIAL_W - tx); }
+  int tileH(int ty) const { return std::min((int)hd.tile, DIAL_H - ty); }
+
+  // Lancette in pixel; 'turns' in giri da mezzogiorno in senso orario
+  void geometry(int h, int m, int s, DialStroke *out) const {
+    const float cx = hd.cx, cy = hd.cy, R = hd.radius;
+    auto hand = [&](DialStroke &k, float turns, float len, float tail, float r, uint16_t c) {
+      const float a = turns * 6.2831853f, dx = sinf(a), dy = -cosf(a);
+      k = DialStroke{ cx - dx * tail, cy - dy * tail, cx + dx * len, cy + dy * len, r, c };
+    };
+    hand(out[DIAL_HOUR], ((h % 12) * 60 + m) / 720.0f, R * 0.62f, R * 0.12f, 6.0f, hd.hand);
+    hand(out[DIAL_MIN],  m / 60.0f,                    R,         R * 0.12f, 4.0f, hd.hand);
+    hand(out[DIAL_SEC],  s / 60.0f,                    R * 1.08f, R * 0.25f, 1.5f, hd.sec);
+    out[DIAL_HUB] = DialStroke{ cx, cy, cx, cy, 8.0f, hd.hand };
+    out[DIAL_PIN] = DialStroke{ cx, cy, cx, cy, 3.5f, hd.sec };
+  }
+
+  static float pointSeg2(float px, float py, const DialStroke &k) {
+    const float ex = k.bx - k.ax, ey = k.by - k.ay, l2 = ex * ex + ey * ey;
+    float t = l2 > 0 ? ((px - k.ax) * ex + (py - k.ay) * ey) / l2 : 0;
+    t = t < 0 ? 0 : (t > 1 ? 1 : t);
+    const float dx = px - k.ax - t * ex, dy = py - k.ay - t * ey;
+    return dx * dx + dy * dy;
+  }
+
+  // Distanza tra il segmento e il rettangolo [x0,x1]x[y0,y1]: 0 se si tagliano (Liang-Barsky),
+  // altrimenti la minima tra estremi-rettangolo e spigoli-segmento
+  static float segRect(const DialStroke &k, float x0, float y0, float x1, float y1) {
+    const float dx = k.bx - k.ax, dy = k.by - k.ay;
+    const float pp[4] = { -dx, dx, -dy, dy }, qq[4] = { k.ax - x0, x1 - k.ax, k.ay - y0, y1 - k.ay };
+    float t0 = 0, t1 = 1;
+    bool cut = true;
+    for (int i = 0; i < 4 && cut; ++i) {
+      if (pp[i] == 0) { cut = qq[i] >= 0; continue; }
+      const float t = qq[i] / pp[i];
+      if (pp[i] < 0) { if (t > t1) cut = false; else if (t > t0) t0 = t; }
+      else           { if (t < t0) cut = false; else if (t < t1) t1 = t; }
+    }
+    if (cut) return 0;
+    auto ptRect2 = [&](float x, float y) {
+      const float ex = x < x0 ? x0 - x : (x > x1 ? x - x1 : 0), ey = y < y0 ? y0 - y : (y > y1 ? y - y1 : 0);
+      return ex * ex + ey * ey;
+    };
+    float d2 = std::min(ptRect2(k.ax, k.ay), ptRect2(k.bx, k.by));
+    d2 = std::min(d2, std::min(pointSeg2(x0, y0, k), pointSeg2(x1, y0, k)));
+    d2 = std::min(d2, std::min(pointSeg2(x0, y1, k), pointSeg2(x1, y1, k)));
+    return sqrtf(d2);
+  }
+
+  // Tasselli in cui il tratto (bordo sfumato compreso) cambia almeno un pixel
+  void mark(const DialStroke &k) {
+    const float e = k.r + 0.5f;
+    const int t = hd.tile;
+    const int c0 = std::max(0, (int)floorf(std::min(k.ax, k.bx) - e) / t);
+    const int c1 = std::min(hd.cols - 1, (int)floorf(std::max(k.ax, k.bx) + e) / t);
+    const int r0 = std::max(0, (int)floorf(std::min(k.ay, k.by) - e) / t);
+    const int r1 = std::min(hd.rows - 1, (int)floorf(std::max(k.ay, k.by) + e) / t);
+    for (int r = r0; r <= r1; ++r)
+      for (int c = c0; c <= c1; ++c) {
+        const float x0 = c * t, y0 = r * t;
+        if (segRect(k, x0 + 0.5f, y0 + 0.5f, x0 + tileW(c * t) - 0.5f, y0 + tileH(r * t) - 0.5f) < e) {
+          const int i = r * hd.cols + c;
+          dirty[i >> 5] |= 1u << (i & 31);
+        }
+      }
+  }
+
+  bool isDirty(int i) const { return dirty[i >> 5] >> (i & 31) & 1; }
+
+  static uint16_t blend(uint16_t bgc, uint16_t fg, uint32_t a) {   // a = 0..32
+    const uint32_t b = (bgc | ((uint32_t)bgc << 16)) & 0x07E0F81F;
+    const uint32_t f = (fg  | ((uint32_t)fg  << 16)) & 0x07E0F81F;
+    const uint32_t v = ((f * a + b * (32 - a)) >> 5) & 0x07E0F81F;
+    return (uint16_t)(v | (v >> 16));
+  }
+
+  // Tratto sulla striscia che copre [sx, sx+sw) x [sy, sy+sh); coordinate dei pixel al centro
+  void paint(const DialStroke &k, int sx, int sy, int sw, int sh) {
+    const float e = k.r + 0.5f;
+    const int x0 = std::max(sx, (int)floorf(std::min(k.ax, k.bx) - e));
+    const int x1 = std::min(sx + sw, (int)ceilf(std::max(k.ax, k.bx) + e) + 1);
+    const int y0 = std::max(sy, (int)floorf(std::min(k.ay, k.by) - e));
+    const int y1 = std::min(sy + sh, (int)ceilf(std::max(k.ay, k.by) + e) + 1);
+    for (int y = y0; y < y1; ++y) {
+      uint16_t *row = strip + (y - sy) * sw - sx;
+      for (int x = x0; x < x1; ++x) {
+        const float d2 = pointSeg2(x + 0.5f, y + 0.5f, k);
+        if (d2 >= e * e) continue;
+        const float a = e - sqrtf(d2);
+        row[x] = a >= 1 ? k.color : blend(row[x], k.color, (uint32_t)(a * 32));
+      }
+    }
+  }
+
+  // Tratti contigui di tasselli sporchi, riga per riga: sfondo, lancette, un push per tratto
+  template <class F>
+  void flush(F push) {
+    lastPx = lastBlits = 0;
+    const int t = hd.tile;
+    for (int r = 0; r < hd.rows; ++r) {
+      const int sy = r * t, sh = tileH(sy);
+      for (int c = 0; c < hd.cols; ) {
+        if (!isDirty(r * hd.cols + c)) { ++c; continue; }
+        const int c0 = c;
+        while (c < hd.cols && isDirty(r * hd.cols + c)) ++c;
+        const int sx = c0 * t, sw = std::min(c * t, DIAL_W) - sx;
+        for (int y = 0; y < sh; ++y) memcpy(strip + y * sw, bg + (sy + y) * DIAL_W + sx, sw * 2);
+        for (int k = 0; k < DIAL_STROKES; ++k) paint(cur[k], sx, sy, sw, sh);
+        push(sx, sy, strip, sw, sh);
+        lastPx += (uint32_t)sw * sh;
+        lastBlits++;
+      }
+    }
+  }
+};
@@ -0,0 +1,346 @@
+/*
+  QuadrantiOraQuadra – orologio a lancette con i quadranti della cartella, ESP32-S3 4848S040
+  Autore: Davide Nasato (gat)
+  Funzioni principali:
+  - Pilotaggio pannello ST7701 480×480 via Arduino_GFX (type9), touch GT911.
+  - Quadranti da SD (file .qd nella cartella /quadranti), preparati offline con tools/dialpack.py:
+    RGB565 a tasselli compressi Q565 con un piccolo indice, niente JPEG da decodificare qui.
+  - DialFace.h: il quadrante attivo si decodifica una volta sola in PSRAM; a ogni secondo si
+    ricompongono dallo sfondo in cache solo i tasselli sotto le lancette che si sono mosse.
+  - Tocco a destra / a sinistra: quadrante successivo / precedente (ricordato in NVS).
+  - Ora da SNTP con le credenziali Wi-Fi già salvate dagli altri sketch (BootSeq.h, namespace
+    NVS "wifi"); senza rete l'orologio parte dalle 10:08:00 e si regola da Serial.
+  - Su Serial (115200): tempi di cambio quadrante e pixel spinti al secondo ([DIAL]),
+    comandi "lista", "quadrante <n|nome>", "avanti", "indietro", "ora HH:MM:SS".
+*/
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Preferences.h>
+#include <Arduino_GFX_Library.h>
+
+// Contatori di disegno su Serial (1 = attivi, 0 = nessun costo)
+#define DRAW_STATS 0
+#include <DrawStats.h>
+#include <BootSeq.h>
+#include "DialFace.h"   // sfondo in PSRAM e ridisegno a tasselli (tools/dialbench.cpp)
+#include <TAMC_GT911.h>
+#include <SPI.h>
+#include <SD.h>
+#include <time.h>
+
+// ----------------------------- Retroilluminazione LCD -----------------------------
+#define GFX_BL      38
+#define PWM_CHANNEL 0
+#define PWM_FREQ    1000
+#define PWM_BITS    8
+
+// ----------------------------- NTP / Fuso orario -----------------------------
+// CET (+1h) e DST (+1h) per area CH/IT
+static const char* NTP_SERVER = "pool.ntp.org";
+static const long   GMT_OFFSET_SEC      = 3600;
+static const int    DAYLIGHT_OFFSET_SEC = 3600;
+static const uint32_t STA_TIMEOUT_MS = 8000;       // poi si va avanti con l'ora da Serial
+static bool g_timeSynced = false;                   // primo sync SNTP arrivato (BootSeq.h)
+
+// ----------------------------- SD (HSPI) -----------------------------
+#define SD_CS_PIN   42
+#define SD_MOSI_PIN 47
+#define SD_CLK_PIN  48
+#define SD_MISO_PIN 41
+#define SD_SPI_FREQ 10000000UL
+
+SPIClass spiSD(HSPI);
+static bool sd_ok = false;
+static const char* DIAL_DIR = "/quadranti";
+#define MAX_DIALS 64
+
+// ----------------------------- Bus & Pannello LCD -----------------------------
+Arduino_DataBus *bus = new Arduino_SWSPI(
+  GFX_NOT_DEFINED, 39, 48, 47, GFX_NOT_DEFINED // DC, SCK, MOSI, MISO, CS
+);
+
+// Parametri del pannello RGB e timing per ST7701 (type9)
+Arduino_ESP32RGBPanel *rgbpanel = new Arduino_ESP32RGBPanel(
+  18, 17, 16, 21,      // DE, VSYNC, HSYNC, PCLK
+  11, 12, 13, 14, 0,   // R0..R4
+  8, 20, 3, 46, 9, 10, // G0..G5
+  4, 5, 6, 7, 15,      // B0..B4
+  1, 10, 8, 50,        // HSYNC params
+  1, 10, 8, 20,        // VSYNC params
+  0, 12000000, false, 0, 0, 0
+);
+
+// Display 480×480 con sequenza init type9 (fornita dalla libreria)
+DrawStatsDisplay *gfx = new DrawStatsDisplay(
+  480, 480, rgbpanel, 0, true,
+  bus, GFX_NOT_DEFINED,
+  st7701_type9_init_operations, sizeof(st7701_type9_init_operations)
+);
+
+// ----------------------------- Touch GT911 -----------------------------
+#define I2C_SDA_PIN 19
+#define I2C_SCL_PIN 45
+#define TOUCH_INT   -1
+#define TOUCH_RST   -1
+#define TOUCH_MAP_X1 480
+#define TOUCH_MAP_X2 0
+
+TAMC_GT911 ts(I2C_SDA_PIN, I2C_SCL_PIN, TOUCH_INT, TOUCH_RST, 480, 480);
+
+// ----------------------------- Quadranti -----------------------------
+static const uint16_t COL_BG   = 0x0000;           // messaggi senza quadrante
+static const uint16_t COL_TEXT = 0xFFFF;
+static DialFace face;
+static char     g_dials[MAX_DIALS][32];            // nomi dei .qd trovati, in ordine alfabetico
+static int      g_dialCount = 0, g_dial = -1;
+static uint8_t *g_pack = nullptr;                  // pacchetto letto dalla SD (PSRAM)
+static size_t   g_packCap = 0;
+Preferences prefs;
+
+// Ora senza SNTP: secondi dalla mezzanotte a g_manualMs
+static uint32_t g_manualBase = 10 * 3600 + 8 * 60, g_manualMs = 0;
+static int32_t  g_lastSec = -1;
+
+// Statistiche del minuto in corso, stampate al cambio di minuto
+static uint32_t st_n = 0, st_px = 0, st_pxMax = 0, st_blits = 0, st_us = 0;
+
+static void pushRect(int x, int y, uint16_t *buf, int w, int h) {
+  gfx->draw16bitRGBBitmap(x, y, buf, w, h);
+}
+
+// ----------------------------- Ora -----------------------------
+static void readClock(int &h, int &m, int &s) {
+  uint32_t sec;
+  if (g_timeSynced) {
+    time_t now = time(nullptr);
+    struct tm t;
+    localtime_r(&now, &t);
+    sec = t.tm_hour * 3600 + t.tm_min * 60 + t.tm_sec;
+  } else {
+    sec = (g_manualBase + (millis() - g_manualMs) / 1000) % 86400;
+  }
+  h = sec / 3600; m = sec / 60 % 60; s = sec % 60;
+}
+
+// ----------------------------- SD e lista -----------------------------
+static bool initSD() {
+  pinMode(SD_CS_PIN, OUTPUT);
+  digitalWrite(SD_CS_PIN, HIGH);
+  spiSD.begin(SD_CLK_PIN, SD_MISO_PIN, SD_MOSI_PIN, SD_CS_PIN);
+  delay(10);
+  if (!SD.begin(SD_CS_PIN, spiSD, SD_SPI_FREQ) || SD.cardType() == CARD_NONE) return false;
+  Serial.printf("[SD] OK (HSPI) — %llu MB @ %lu Hz\n",
+                (unsigned long long)(SD.cardSize() / (1024ULL * 1024ULL)), (unsigned long)SD_SPI_FREQ);
+  return true;
+}
+
+static void scanDials() {
+  g_dialCount = 0;
+  File dir = SD.open(DIAL_DIR);
+  if (!dir || !dir.isDirectory()) return;
+  for (File f = dir.openNextFile(); f && g_dialCount < MAX_DIALS; f = dir.openNextFile()) {
+    const char *n = strrchr(f.name(), '/');
+    n = n ? n + 1 : f.name();
+    const size_t len = strlen(n);
+    if (!f.isDirectory() && len > 3 && len < sizeof(g_dials[0]) && !strcasecmp(n + len - 3, ".qd"))
+      strcpy(g_dials[g_dialCount++], n);
+    f.close();
+  }
+  dir.close();
+  qsort(g_dials, g_dialCount, sizeof(g_dials[0]), [](const void *a, const void *b) {
+    return strcmp((const char *)a, (const char *)b);
+  });
+  Serial.printf("[DIAL] %d quadranti in %s\n", g_dialCount, DIAL_DIR);
+}
+
+static void drawMessage(const char *l1, const char *l2) {
+  gfx->fillScreen(COL_BG);
+  gfx->setTextColor(COL_TEXT);
+  gfx->setTextSize(2);
+  gfx->setCursor(20, 210); gfx->print(l1);
+  gfx->setCursor(20, 240); gfx->print(l2);
+}
+
+// ----------------------------- Cambio quadrante -----------------------------
+// Lettura dalla SD, decodifica in PSRAM, primo frame: i tre tempi vanno su Serial
+static bool loadDial(int i) {
+  char path[48];
+  snprintf(path, sizeof(path), "%s/%s", DIAL_DIR, g_dials[i]);
+  const uint32_t t0 = micros();
+  File f = SD.open(path, FILE_READ);
+  if (!f) { Serial.printf("[DIAL] %s: non si apre\n", path); return false; }
+  const size_t len = f.size();
+  if (len > g_packCap) {
+    uint8_t *p = (uint8_t *)ps_realloc(g_pack, len);
+    if (!p) { f.close(); Serial.printf("[DIAL] %s: %u byte, PSRAM esaurita\n", path, (unsigned)len); return false; }
+    g_pack = p; g_packCap = len;
+  }
+  const size_t got = f.read(g_pack, len);
+  f.close();
+  const uint32_t t1 = micros();
+  if (got != len || !face.load(g_pack, len)) {
+    Serial.printf("[DIAL] %s: pacchetto non valido (rifare con tools/dialpack.py)\n", path);
+    return false;
+  }
+  const uint32_t t2 = micros();
+  int h, m, s;
+  readClock(h, m, s);
+  {
+    DS_REFRESH_SCOPE("quadrante");
+    face.drawAll(h, m, s, pushRect);
+  }
+  g_lastSec = h * 3600 + m * 60 + s;
+  const uint32_t t3 = micros();
+  Serial.printf("[DIAL] %s: %u byte, lettura %lu ms, decodifica %lu ms, primo frame %lu ms (totale %lu ms)\n",
+                g_dials[i], (unsigned)len, (unsigned long)((t1 - t0) / 1000), (unsigned long)((t2 - t1) / 1000),
+                (unsigned long)((t3 - t2) / 1000), (unsigned long)((t3 - t0) / 1000));
+  g_dial = i;
+  prefs.begin("quadranti", false);
+  prefs.putString("nome", g_dials[i]);
+  prefs.end();
+  return true;
+}
+
+// Dal quadrante i in direzione step, saltando i pacchetti che non si caricano
+static void showDial(int i, int step) {
+  for (int k = 0; k < g_dialCount; ++k) {
+    const int j = ((i + k * step) % g_dialCount + g_dialCount) % g_dialCount;
+    if (loadDial(j)) return;
+  }
+  g_dial = -1;
+  drawMessage("Nessun quadrante valido", "rifare i .qd con tools/dialpack.py");
+}
+
+static int findDial(const char *name) {
+  for (int i = 0; i < g_dialCount; ++i) {
+    if (!strcmp(g_dials[i], name)) return i;
+    const size_t n = strlen(name);
+    if (!strncmp(g_dials[i], name, n) && !strcmp(g_dials[i] + n, ".qd")) return i;
+  }
+  return -1;
+}
+
+// ----------------------------- Secondi -----------------------------
+static void tickSecond(int h, int m, int s) {
+  const uint32_t t0 = micros();
+  {
+    DS_FRAME_SCOPE("secondo");
+    face.tick(h, m, s, pushRect);
+  }
+  st_us += micros() - t0;
+  st_px += face.lastPx; st_blits += face.lastBlits; st_n++;
+  if (face.lastPx > st_pxMax) st_pxMax = face.lastPx;
+  if (s == 0 && st_n) {
+    Serial.printf("[DIAL] ultimo minuto: %lu px/s medi (max %lu), %lu blit/s, %lu us/s\n",
+                  (unsigned long)(st_px / st_n), (unsigned long)st_pxMax,
+                  (unsigned long)(st_blits / st_n), (unsigned long)(st_us / st_n));
+    st_n = st_px = st_pxMax = st_blits = st_us = 0;
+  }
+}
+
+// ----------------------------- Touch e Serial -----------------------------
+static void pollTouch() {
+  static bool wasDown = false;
+  ts.read();
+  const bool down = ts.isTouched && ts.touches > 0;
+  if (down && !wasDown && g_dialCount) {
+    const int x = map(ts.points[0].x, TOUCH_MAP_X1, TOUCH_MAP_X2, 0, 479);
+    const int step = x < 240 ? -1 : 1;
+    showDial(g_dial < 0 ? 0 : g_dial + step, step);
+  }
+  wasDown = down;
+}
+
+static void handleSerialLine(const char *line) {
+  int h, m, s;
+  if (sscanf(line, "ora %d:%d:%d", &h, &m, &s) == 3) {
+    g_manualBase = (h % 24) * 3600 + (m % 60) * 60 + s % 60;
+    g_manualMs = millis();
+    if (g_timeSynced) Serial.println("[DIAL] ora da SNTP: il comando vale solo senza rete");
+  } else if (strcmp(line, "lista") == 0) {
+    for (int i = 0; i < g_dialCount; ++i) Serial.printf("%2d %s%s\n", i, g_dials[i], i == g_dial ? "  <" : "");
+  } else if (strcmp(line, "avanti") == 0 || strcmp(line, "indietro") == 0) {
+    const int step = line[0] == 'a' ? 1 : -1;
+    if (g_dialCount) showDial(g_dial < 0 ? 0 : g_dial + step, step);
+  } else if (strncmp(line, "quadrante ", 10) == 0) {
+    const char *arg = line + 10;
+    int i = isdigit((unsigned char)arg[0]) ? atoi(arg) : findDial(arg);
+    if (i < 0 || i >= g_dialCount) Serial.println("[DIAL] quadrante sconosciuto (vedi 'lista')");
+    else showDial(i, 1);
+  }
+}
+
+static void pollSerial() {
+  static char    buf[48];
+  static uint8_t len = 0;
+  while (Serial.available() > 0) {
+    const char c = (char)Serial.read();
+    if (c == '\r') continue;
+    if (c != '\n') { if (len < sizeof(buf) - 1) buf[len++] = c; continue; }
+    buf[len] = '\0'; len = 0;
+    handleSerialLine(buf);
+  }
+}
+
+// ----------------------------- Setup / Loop -----------------------------
+void setup() {
+  Serial.begin(115200);
+  bootPanel(gfx, GFX_BL, PWM_CHANNEL, PWM_FREQ, PWM_BITS);
+  bootStart(STA_TIMEOUT_MS, GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER);
+  g_manualMs = millis();
+
+  Wire.begin(I2C_SDA_PIN, I2C_SCL_PIN, 400000);
+  ts.begin();
+
+  int ph = bootPhaseBegin("psram");
+  face.bg = (uint16_t *)ps_malloc(DIAL_W * DIAL_H * sizeof(uint16_t));
+  bootPhaseEnd(ph);
+  if (!face.bg) { drawMessage("PSRAM non disponibile", "serve per lo sfondo (450 KB)"); return; }
+
+  ph = bootPhaseBegin("sd");
+  sd_ok = initSD();
+  if (sd_ok) scanDials();
+  bootPhaseEnd(ph);
+  if (!g_dialCount) {
+    drawMessage(sd_ok ? "Nessun quadrante in /quadranti" : "SD non trovata",
+                "python3 tools/dialpack.py ... -o quadranti/");
+    return;
+  }
+
+  ph = bootPhaseBegin("quadrante");
+  prefs.begin("quadranti", true);
+  const int last = findDial(prefs.getString("nome", "").c_str());
+  prefs.end();
+  showDial(last < 0 ? 0 : last, 1);
+  bootPhaseEnd(ph);
+  bootMark("primo frame");
+}
+
+void loop() {
+  switch (bootPoll()) {
+    case BOOT_TIME:
+      g_timeSynced = true;
+      break;
+    case BOOT_PORTAL:
+      Serial.println("[DIAL] niente rete: ora da Serial con 'ora HH:MM:SS'");
+      break;
+    case BOOT_ONLINE:               // anche dopo il ripiego: l'ora manuale vale fino a BOOT_TIME
+      Serial.println("[DIAL] rete connessa: ora da SNTP al primo sync");
+      break;
+    default:
+      break;
+  }
+  pollSerial();
+  pollTouch();
+
+  if (g_dial < 0) { delay(20); return; }
+  int h, m, s;
+  readClock(h, m, s);
+  const int32_t sec = h * 3600 + m * 60 + s;
+  if (sec != g_lastSec) {
+    g_lastSec = sec;
+    tickSecond(h, m, s);
+  }
+  delay(5);
+}
@@ -1,6 +1,10 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <Arduino_GFX_Library.h>
+
+// Contatori di disegno su Serial (1 = attivi, 0 = nessun costo)
+#define DRAW_STATS 0
+#include <DrawStats.h>
 #include <TAMC_GT911.h>
 #include <QRCodeGenerator.h>   // Libreria Felix Erdmann (API C-style: qrcode_initText, qrcode_getModule)
 
@@ -42,13 +46,28 @@ Arduino_ESP32RGBPanel *rgbpanel = new Arduino_ESP32RGBPanel(
 );
 
 // Oggetto display principale 480x480 + init ST7701 type9
-Arduino_RGB_Display *gfx = new Arduino_RGB_Display(
+DrawStatsDisplay *gfx = new DrawStatsDisplay(
   480, 480,
   rgbpanel, 0 /*rotation*/, true /*auto_flush*/,
   bus, GFX_NOT_DEFINED /*RST*/,
   st7701_type9_init_operations, sizeof(st7701_type9_init_operations)
 );
 
+// ====================== QR: PARAMETRI ======================
+// Versione e correzione scelte per ogni URL: la versione più piccola (moduli più grandi a schermo) in cui l'URL entra con
+// almeno QR_MIN_ECC, poi la correzione più alta che ci sta in quella versione.
+#define QR_MAX_VERSION 10
+#define QR_MIN_ECC     ECC_MEDIUM
+#define QR_BUF_BYTES   (((4 * QR_MAX_VERSION + 17) * (4 * QR_MAX_VERSION + 17) + 7) / 8)
+
+// Un QR pronto da disegnare: URL + matrice dei moduli
+struct QRSlot {
+  char     url[64];
+  QRCode   qr;
+  uint8_t  modules[QR_BUF_BYTES];
+  uint32_t buildUs;
+};
+
 // ====================== GENERAZIONE LINK YOUTUBE ======================
 // Solo caratteri alfanumerici A–Z, a–z, 0–9 (niente '-' o '_')
 static const char ALNUM[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
@@ -94,63 +113,142 @@ static String nextYouTubeURL() {
   return String("https://www.youtube.com/watch?v=") + generateYouTubeID();
 }
 
-// ====================== RENDER: MOSTRA URL + QR ======================
-// Mostra l’URL per 3 s (debug a schermo), poi disegna il QR a pieno schermo (versione 5, ECC medio)
-static void drawQRCodeFullScreen(const String &url) {
-  // 1) URL in chiaro per 3 secondi
-  gfx->fillScreen(BLACK);
-  gfx->setTextColor(WHITE, BLACK);
-  gfx->setTextSize(1);
-  // Stampa con wrap molto semplice
-  int x = 10, y = 220;
-  const int maxWidth = 460; // 480-20 margini
-  int cursor = 0;
-  while (cursor < (int)url.length()) {
-    int len = 0, w = 0;
-    while (cursor + len < (int)url.length() && w < maxWidth) {
-      w += 6; // ~6px per char con TextSize=1
-      len++;
-    }
-    gfx->setCursor(x, y);
-    gfx->print(url.substring(cursor, cursor + len));
-    y += 12;
-    cursor += len;
+// ====================== QR: VERSIONE/ECC AUTOMATICI ======================
+// Capacità in byte (modalità byte) per versione 1..10 e ECC L/M/Q/H (tabella ISO 18004)
+static const uint16_t QR_BYTE_CAP[QR_MAX_VERSION][4] = {
+  {  17,  14,  11,   7 }, {  32,  26,  20,  14 }, {  53,  42,  32,  24 }, {  78,  62,  46,  34 },
+  { 106,  84,  60,  44 }, { 134, 106,  74,  58 }, { 154, 122,  86,  64 }, { 192, 152, 108,  84 },
+  { 230, 180, 130,  98 }, { 271, 213, 151, 119 }
+};
+
+static bool pickQRVersion(size_t len, uint8_t &version, uint8_t &ecc) {
+  for (uint8_t v = 1; v <= QR_MAX_VERSION; ++v) {
+    if (QR_BYTE_CAP[v - 1][QR_MIN_ECC] < len) continue;
+    version = v;
+    ecc = QR_MIN_ECC;
+    while (ecc < ECC_HIGH && QR_BYTE_CAP[v - 1][ecc + 1] >= len) ecc++;
+    return true;
   }
-  delay(3000);
+  return false;
+}
 
-  // 2) QR centrato a pieno schermo
-  gfx->fillScreen(BLACK);
+static bool buildQRSlot(QRSlot &s) {
+  uint32_t t0 = micros();
+  String url = nextYouTubeURL();
+  strlcpy(s.url, url.c_str(), sizeof(s.url));
+  uint8_t version, ecc;
+  if (!pickQRVersion(strlen(s.url), version, ecc)) return false;
+  qrcode_initText(&s.qr, s.modules, version, ecc, s.url);
+  s.buildUs = micros() - t0;
+  return true;
+}
+
+// ====================== PRECALCOLO SUL CORE 0 ======================
+// Mentre un QR è a schermo, il task prepara il successivo: al tocco c'è solo da disegnare.
+static QRSlot g_slots[2];
+static QRSlot *g_shown = &g_slots[0];
+static QRSlot *g_next  = &g_slots[1];
+static volatile bool g_nextReady = false;
+static TaskHandle_t g_qrTask = nullptr;
+
+static void qrTask(void *) {
+  for (;;) {
+    if (!g_nextReady) {
+      if (buildQRSlot(*g_next)) g_nextReady = true;
+    }
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+}
 
-  const uint8_t version = 5;       // 37x37 moduli (sufficiente per URL brevi)
-  const uint8_t ecc     = ECC_MEDIUM;
+// ====================== RENDER: URL + QR ======================
+#define URL_PREVIEW_MS 3000    // URL in chiaro prima del QR (un tocco lo salta)
 
-  QRCode qrcode;
-  size_t bufSize = qrcode_getBufferSize(version);
-  uint8_t *qrcodeData = (uint8_t*)malloc(bufSize);
-  if (!qrcodeData) return;
+// Riga di moduli scalata: 'scale' righe di pixel identiche, un solo blit per riga di moduli
+static uint16_t *g_qrLine = nullptr;
 
-  qrcode_initText(&qrcode, qrcodeData, version, ecc, url.c_str());
+static void drawURLPreview(const char *url) {
+  gfx->fillScreen(BLACK);
+  gfx->setTextColor(WHITE, BLACK);
+  gfx->setTextSize(1);
+  // Stampa con wrap molto semplice: 76 caratteri (~6 px l'uno) per riga
+  const int perLine = 460 / 6;
+  int y = 220;
+  char buf[perLine + 1];
+  for (size_t cursor = 0, n = strlen(url); cursor < n; cursor += perLine, y += 12) {
+    strlcpy(buf, url + cursor, sizeof(buf));
+    gfx->setCursor(10, y);
+    gfx->print(buf);
+  }
+}
 
-  int qrSize = qrcode.size;
-  int scale  = 480 / qrSize;       // scala intera massima
+// QR centrato a pieno schermo: moduli chiari su nero, run orizzontali uniti in span.
+// Senza il buffer di riga (malloc fallita) ogni span diventa un fillRect.
+static void drawQRCode(QRCode &qr) {
+  DS_REFRESH_SCOPE("qr");
+  const int qrSize = qr.size;
+  int scale = 480 / qrSize;        // scala intera massima
   if (scale < 1) scale = 1;
-  int used   = qrSize * scale;
-  int offX   = (480 - used) / 2;
-  int offY   = (480 - used) / 2;
-
-  for (int y2 = 0; y2 < qrSize; y2++) {
-    for (int x2 = 0; x2 < qrSize; x2++) {
-      if (qrcode_getModule(&qrcode, x2, y2))
-        gfx->fillRect(offX + x2 * scale, offY + y2 * scale, scale, scale, WHITE);
+  const int used = qrSize * scale;
+  const int off  = (480 - used) / 2;
+
+  // Bordi fuori dal QR (il QR copre il resto riga per riga)
+  gfx->fillRect(0, 0, 480, off, BLACK);
+  gfx->fillRect(0, off + used, 480, 480 - off - used, BLACK);
+  gfx->fillRect(0, off, off, used, BLACK);
+  gfx->fillRect(off + used, off, 480 - off - used, used, BLACK);
+
+  uint32_t spans = 0;
+  for (int my = 0; my < qrSize; my++) {
+    uint16_t *row = g_qrLine;
+    int mx = 0;
+    while (mx < qrSize) {
+      const bool dark = qrcode_getModule(&qr, mx, my);
+      int run = 1;
+      while (mx + run < qrSize && qrcode_getModule(&qr, mx + run, my) == dark) run++;
+      const uint16_t c = dark ? WHITE : BLACK;
+      if (row) for (int i = 0, n = run * scale; i < n; ++i) *row++ = c;
+      else     gfx->fillRect(off + mx * scale, off + my * scale, run * scale, scale, c);
+      if (dark) spans++;
+      mx += run;
     }
+    if (!g_qrLine) continue;
+    for (int k = 1; k < scale; ++k) memcpy(g_qrLine + k * used, g_qrLine, used * sizeof(uint16_t));
+    gfx->draw16bitRGBBitmap(off, off + my * scale, g_qrLine, used, scale);
   }
-
-  free(qrcodeData);
+  Serial.printf("[QR] v%u-%c %ux%u moduli, scala %d, %lu span, %d blit\n", qr.version, "LMQH"[qr.ecc],
+                qrSize, qrSize, scale, (unsigned long)spans, g_qrLine ? qrSize : 0);
 }
 
 // ====================== CICLO PRINCIPALE: TOUCH ======================
-// Edge-detect sul tocco GT911: ogni tap genera nuovo URL e relativo QR
+// Edge-detect sul tocco GT911. Stati: URL in chiaro → QR; un tocco sul QR passa al
+// successivo (già pronto), un tocco sull'URL mostra subito il QR.
+enum ViewState : uint8_t { VIEW_URL, VIEW_QR };
+static ViewState g_view = VIEW_URL;
+static uint32_t  g_viewSince = 0;
+static uint32_t  g_tapUs = 0;          // istante del tocco che ha avviato il QR corrente
 static bool prevTouched = false;
+static bool g_tapPending = false;      // tocco arrivato prima che il prossimo QR fosse pronto
+
+static void showQR() {
+  uint32_t t0 = micros();
+  drawQRCode(g_shown->qr);
+  uint32_t now = micros();
+  if (g_tapUs) Serial.printf("[QR] disegno %lu us, tocco->QR %lu us (anteprima URL inclusa)\n",
+                             (unsigned long)(now - t0), (unsigned long)(now - g_tapUs));
+  g_view = VIEW_QR;
+}
+
+static void showNext() {
+  QRSlot *s = g_shown; g_shown = g_next; g_next = s;
+  g_nextReady = false;
+  if (g_qrTask) xTaskNotifyGive(g_qrTask);        // via al successivo
+  Serial.println(g_shown->url);                   // debug: URL in chiaro
+  Serial.printf("[QR] preparato in %lu us sul core 0\n", (unsigned long)g_shown->buildUs);
+  drawURLPreview(g_shown->url);
+  Serial.printf("[QR] tocco->URL %lu us\n", (unsigned long)(micros() - g_tapUs));
+  g_view = VIEW_URL;
+  g_viewSince = millis();
+}
 
 void setup() {
   Serial.begin(115200); // Debug: stampa gli URL in chiaro
@@ -166,10 +264,19 @@ void setup() {
   ts.begin();
   ts.setRotation(0);
 
-  // Primo URL+QR all’avvio (conteggiato nel modulo 5 per l’easter egg)
-  String url = nextYouTubeURL();
-  Serial.println(url);
-  drawQRCodeFullScreen(url);
+  // Buffer per una riga di moduli scalata (caso peggiore: versione 1, scala 22)
+  const size_t lineBytes = 480 * (480 / 21) * sizeof(uint16_t);
+  g_qrLine = (uint16_t*)(psramFound() ? ps_malloc(lineBytes) : malloc(lineBytes));
+  if (!g_qrLine && psramFound()) g_qrLine = (uint16_t*)malloc(lineBytes);
+  if (!g_qrLine) Serial.printf("[QR] buffer di riga da %u byte non allocato: QR a fillRect per span\n",
+                               (unsigned)lineBytes);
+
+  // Primo URL+QR all’avvio (conteggiato nel modulo 5 per l’easter egg), poi il task
+  // prepara il secondo
+  g_tapUs = micros();
+  g_nextReady = buildQRSlot(*g_next);
+  xTaskCreatePinnedToCore(qrTask, "qr", 4096, nullptr, 1, &g_qrTask, 0);
+  showNext();
 }
 
 void loop() {
@@ -177,11 +284,13 @@ void loop() {
   bool touchedNow = ts.isTouched;
 
   if (touchedNow && !prevTouched) {
-    String url = nextYouTubeURL();     // genera nuovo URL (con easter egg ogni 5)
-    Serial.println(url);               // debug su seriale
-    drawQRCodeFullScreen(url);         // mostra URL 3s → QR fullscreen
+    if (g_view == VIEW_URL) { g_tapUs = micros(); showQR(); }   // salta l'attesa
+    else { g_tapUs = micros(); g_tapPending = true; }
   }
-
   prevTouched = touchedNow;
+
+  if (g_tapPending && g_nextReady) { g_tapPending = false; showNext(); }
+  if (g_view == VIEW_URL && millis() - g_viewSince >= URL_PREVIEW_MS) showQR();
+
   delay(20); // piccolo debounce/pace del loop
 }
@@ -0,0 +1,216 @@
+/*
+  BootSeq.h – avvio non bloccante: pannello, Wi-Fi STA, portale di ripiego, SNTP (Panel-4848S040)
+
+  Sostituisce backlightOn/panelKickstart/tryConnectSTA/waitForValidTime, che aspettavano
+  in loop di delay: il setup disegna subito il primo schermo e il resto avanza dal loop.
+    - bootPanel   : retroilluminazione + init controller (l'unica parte sincrona);
+    - bootStart   : legge ssid/pass dal namespace NVS "wifi" e lancia WiFi.begin, senza attendere;
+    - bootPoll    : da chiamare a ogni giro di loop, ritorna un evento alla volta.
+  Connessione e ora arrivano dai callback (WiFi.onEvent, notifica SNTP), che toccano solo
+  due variabili: bootPoll le trasforma in eventi nel contesto del loop.
+
+  Libreria condivisa dagli sketch con Wi-Fi (libraries/BootSeq, vedi README).
+
+  Uso nello sketch:
+    #include <BootSeq.h>
+    setup:  bootPanel(gfx, GFX_BL, PWM_CHANNEL, PWM_FREQ, PWM_BITS);
+            bootStart(8000, GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER);
+            ...primo schermo...; bootMark("primo frame");
+    loop:   switch (bootPoll()) {
+              case BOOT_ONLINE: ...WebUI, task di rete...; break;   // prima connessione (anche dopo il portale)
+              case BOOT_PORTAL: startAPWithPortal(); break;         // niente credenziali o timeout
+              case BOOT_TIME:   g_timeSynced = true; break;         // primo sync SNTP
+              default: break;                                       // BOOT_LOST / BOOT_BACK
+            }
+
+  Timeline: una fase va da bootPhaseBegin a bootPhaseEnd (ms dal reset); bootMark registra
+  una tappa una sola volta, da 0 a adesso. A sequenza conclusa (ora valida o portale) la
+  timeline va su Serial; bootFormatTimeline la scrive in un buffer per la WebUI (/boot).
+    [BOOT] pannello        12 ->   298 ms  (286)
+*/
+#pragma once
+#include <Arduino.h>
+#include <Arduino_GFX_Library.h>
+#include <WiFi.h>
+#include <Preferences.h>
+#include <esp_sntp.h>
+#include <time.h>
+
+#ifndef BOOT_MAX_PHASES
+#define BOOT_MAX_PHASES 12
+#endif
+
+#ifndef BOOT_RETRY_MS
+#define BOOT_RETRY_MS 10000        // senza rete dopo la prima connessione: WiFi.reconnect() ogni 10 s
+#endif
+
+enum BootEvent : uint8_t { BOOT_NONE, BOOT_ONLINE, BOOT_PORTAL, BOOT_TIME, BOOT_LOST, BOOT_BACK };
+enum BootState : uint8_t { BS_IDLE, BS_CONNECTING, BS_ONLINE, BS_OFFLINE, BS_PORTAL };
+
+struct BootPhase {
+  const char *name;
+  uint32_t t0, t1;                 // ms dal reset
+  bool     done;
+};
+
+static BootPhase s_bsPhase[BOOT_MAX_PHASES];
+static uint8_t   s_bsCount = 0;
+static BootState s_bsState = BS_IDLE;
+static uint32_t  s_bsT0 = 0, s_bsTimeout = 0, s_bsRetryMs = 0;
+static int       s_bsWifiPh = -1, s_bsNtpPh = -1;
+static bool      s_bsTimeSeen = false, s_bsPrinted = false;
+static long      s_bsGmt = 0;
+static int       s_bsDst = 0;
+static const char *s_bsNtp = nullptr;
+static volatile bool     s_bsUp = false;       // da WiFi.onEvent
+static volatile uint32_t s_bsSyncs = 0;        // da callback SNTP
+
+static int bootPhaseBegin(const char *name) {
+  if (s_bsCount >= BOOT_MAX_PHASES) return -1;
+  s_bsPhase[s_bsCount] = BootPhase{name, millis(), 0, false};
+  return s_bsCount++;
+}
+
+static void bootPhaseEnd(int i) {
+  if (i < 0 || i >= s_bsCount || s_bsPhase[i].done) return;
+  s_bsPhase[i].t1 = millis();
+  s_bsPhase[i].done = true;
+}
+
+// Tappa dal reset a ora, registrata solo la prima volta
+static void bootMark(const char *name) {
+  for (uint8_t i = 0; i < s_bsCount; ++i) if (!strcmp(s_bsPhase[i].name, name)) return;
+  int i = bootPhaseBegin(name);
+  if (i < 0) return;
+  s_bsPhase[i].t0 = 0;
+  bootPhaseEnd(i);
+}
+
+static size_t bootFormatTimeline(char *out, size_t n, const char *prefix = "") {
+  size_t k = 0;
+  if (n) out[0] = 0;
+  for (uint8_t i = 0; i < s_bsCount && k < n; ++i) {
+    const BootPhase &p = s_bsPhase[i];
+    int w = p.done
+      ? snprintf(out + k, n - k, "%s%-14s %6lu -> %6lu ms  (%lu)\n", prefix, p.name,
+                 (unsigned long)p.t0, (unsigned long)p.t1, (unsigned long)(p.t1 - p.t0))
+      : snprintf(out + k, n - k, "%s%-14s %6lu -> in corso (%lu ms)\n", prefix, p.name,
+                 (unsigned long)p.t0, (unsigned long)(millis() - p.t0));
+    if (w < 0) break;
+    k += (size_t)w;
+  }
+  return k < n ? k : n - 1;
+}
+
+static void bootPrintTimeline() {
+  char buf[BOOT_MAX_PHASES * 56];
+  bootFormatTimeline(buf, sizeof(buf), "[BOOT] ");
+  Serial.print(buf);
+}
+
+static inline bool bootOnline() { return s_bsState == BS_ONLINE; }
+
+// Callback: girano nei task di sistema, qui solo variabili
+static void bootWiFiEvent(WiFiEvent_t e) {
+  if (e == ARDUINO_EVENT_WIFI_STA_GOT_IP) s_bsUp = true;
+  else if (e == ARDUINO_EVENT_WIFI_STA_DISCONNECTED || e == ARDUINO_EVENT_WIFI_STA_LOST_IP) s_bsUp = false;
+}
+
+static void bootTimeSynced(struct timeval *) { s_bsSyncs++; }
+
+template <class GFX>
+static void bootPanel(GFX *g, int blPin, uint8_t pwmChannel, uint32_t pwmFreq, uint8_t pwmBits) {
+  int ph = bootPhaseBegin("pannello");
+  ledcSetup(pwmChannel, pwmFreq, pwmBits);
+  ledcAttachPin(blPin, pwmChannel);
+  ledcWrite(pwmChannel, 255);
+  delay(50);
+  g->begin();
+  g->setRotation(0);
+  delay(120);
+  g->displayOn();
+  delay(20);
+  g->fillScreen(0x0000);                     // nero
+  bootPhaseEnd(ph);
+}
+
+// Credenziali dall'NVS e WiFi.begin; senza ssid il portale scatta al primo bootPoll
+static void bootStart(uint32_t staTimeoutMs, long gmtOffsetSec, int dstOffsetSec, const char *ntpServer) {
+  s_bsGmt = gmtOffsetSec; s_bsDst = dstOffsetSec; s_bsNtp = ntpServer;
+  s_bsTimeout = staTimeoutMs;
+  sntp_set_time_sync_notification_cb(bootTimeSynced);
+  WiFi.onEvent(bootWiFiEvent);
+
+  int ph = bootPhaseBegin("nvs wifi");
+  Preferences p;
+  p.begin("wifi", true);
+  String ssid = p.getString("ssid", "");
+  String pass = p.getString("pass", "");
+  p.end();
+  bootPhaseEnd(ph);
+  if (ssid.isEmpty()) { s_bsState = BS_CONNECTING; s_bsT0 = millis(); s_bsTimeout = 0; return; }
+
+  WiFi.persistent(false);
+  WiFi.mode(WIFI_STA);
+  WiFi.setSleep(false);
+  WiFi.setAutoReconnect(true);
+  s_bsWifiPh = bootPhaseBegin("wifi");
+  WiFi.begin(ssid.c_str(), pass.c_str());
+  s_bsT0 = millis();
+  s_bsState = BS_CONNECTING;
+}
+
+// Prima connessione, dall'avvio o dopo il portale: parte l'SNTP
+static BootEvent bootGoOnline(uint32_t now) {
+  bootPhaseEnd(s_bsWifiPh);
+  s_bsState = BS_ONLINE;
+  s_bsNtpPh = bootPhaseBegin("ntp");
+  configTime(s_bsGmt, s_bsDst, s_bsNtp);     // da qui l'SNTP si risincronizza da solo
+  Serial.printf("[BOOT] Wi-Fi connesso in %lu ms, IP %s\n", (unsigned long)(now - s_bsT0),
+                WiFi.localIP().toString().c_str());
+  return BOOT_ONLINE;
+}
+
+static BootEvent bootPoll() {
+  const uint32_t now = millis();
+  switch (s_bsState) {
+    case BS_CONNECTING:
+      if (s_bsUp) return bootGoOnline(now);
+      if (now - s_bsT0 >= s_bsTimeout) {
+        bootPhaseEnd(s_bsWifiPh);
+        s_bsState = BS_PORTAL;
+        bootMark("portale");
+        Serial.println("[BOOT] Wi-Fi non disponibile: portale AP");
+        bootPrintTimeline();
+        s_bsPrinted = true;
+        return BOOT_PORTAL;
+      }
+      return BOOT_NONE;
+
+    case BS_ONLINE:
+    case BS_OFFLINE:
+      if (s_bsSyncs && !s_bsTimeSeen) {
+        s_bsTimeSeen = true;
+        bootPhaseEnd(s_bsNtpPh);
+        if (!s_bsPrinted) { bootPrintTimeline(); s_bsPrinted = true; }
+        return BOOT_TIME;
+      }
+      if (s_bsState == BS_ONLINE && !s_bsUp) {
+        s_bsState = BS_OFFLINE; s_bsRetryMs = now;
+        Serial.println("[BOOT] Wi-Fi perso");
+        return BOOT_LOST;
+      }
+      if (s_bsState == BS_OFFLINE) {
+        if (s_bsUp) { s_bsState = BS_ONLINE; Serial.println("[BOOT] Wi-Fi di nuovo connesso"); return BOOT_BACK; }
+        if (now - s_bsRetryMs >= BOOT_RETRY_MS) { s_bsRetryMs = now; WiFi.reconnect(); }
+      }
+      return BOOT_NONE;
+
+    case BS_PORTAL:                            // l'STA riprova da sola: se arriva l'IP si esce dal ripiego
+      if (s_bsUp) return bootGoOnline(now);
+      return BOOT_NONE;
+
+    default:
+      return BOOT_NONE;
+  }
+}
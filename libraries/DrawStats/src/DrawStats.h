@@ -0,0 +1,142 @@
+/*
+  DrawStats.h – contatori di disegno per Arduino_RGB_Display (Panel-4848S040)
+
+  Sottoclasse del display che conta, senza cambiare cosa finisce a schermo:
+    - fill     : rettangoli pieni e linee H/V (fillRect, fillScreen, testo scalato, ...)
+    - bitmap   : chiamate draw16bitRGBBitmap (splash, JPEG, blocchi)
+    - pixel    : scritture di singolo pixel (testo size 1, cerchi, linee oblique)
+    - px       : pixel totali spinti nel framebuffer PSRAM
+
+  Libreria condivisa da tutti gli sketch del repo (libraries/DrawStats, vedi README).
+
+  Uso nello sketch:
+    #define DRAW_STATS 1            // prima dell'include; 0 = nessun costo
+    #include <DrawStats.h>
+    DrawStatsDisplay *gfx = new DrawStatsDisplay(...stessi argomenti di Arduino_RGB_Display...);
+
+    { DS_FRAME_SCOPE("nome");   ...disegno... }   // frame ricorrenti: media ogni DS_REPORT_MS
+    { DS_REFRESH_SCOPE("nome"); ...disegno... }   // refresh singoli: report immediato
+
+  La misura si chiude all'uscita dal blocco (anche con return anticipati).
+  Gli scope non vanno annidati: condividono lo snapshot dei contatori.
+
+  Report su Serial:
+    [DS] nome: n=.. us avg/max=../.. fill=.. bmp=.. pix=.. px=.. (per frame)
+*/
+#pragma once
+#include <Arduino.h>
+#include <Arduino_GFX_Library.h>
+
+#ifndef DRAW_STATS
+#define DRAW_STATS 0
+#endif
+
+#ifndef DS_REPORT_MS
+#define DS_REPORT_MS 5000
+#endif
+
+#ifndef DS_CLOCK_US
+#define DS_CLOCK_US micros         // la build su PC (tools/host) passa l'orologio reale
+#endif
+
+#if DRAW_STATS
+
+struct DrawCounters {
+  uint32_t fill = 0, bitmap = 0, pixel = 0;
+  uint64_t px = 0;
+};
+
+static DrawCounters g_ds;          // contatori cumulativi dall'avvio
+static DrawCounters g_dsMark;      // snapshot all'apertura dello scope
+static uint32_t     g_dsMarkUs = 0;
+
+class DrawStatsDisplay : public Arduino_RGB_Display {
+public:
+  using Arduino_RGB_Display::Arduino_RGB_Display;
+  using Arduino_RGB_Display::draw16bitRGBBitmap;
+
+  void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override {
+    g_ds.pixel++; g_ds.px++;
+    Arduino_RGB_Display::writePixelPreclipped(x, y, color);
+  }
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override {
+    if (h > 0) { g_ds.fill++; g_ds.px += h; }
+    Arduino_RGB_Display::writeFastVLine(x, y, h, color);
+  }
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override {
+    if (w > 0) { g_ds.fill++; g_ds.px += w; }
+    Arduino_RGB_Display::writeFastHLine(x, y, w, color);
+  }
+  void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override {
+    g_ds.fill++; g_ds.px += (uint32_t)w * (uint32_t)h;
+    Arduino_RGB_Display::writeFillRectPreclipped(x, y, w, h, color);
+  }
+  void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override {
+    // conteggio della sola parte visibile (come fa il clipping del display)
+    int16_t x0 = max<int16_t>(x, 0), y0 = max<int16_t>(y, 0);
+    int16_t x1 = min<int16_t>(x + w, width()), y1 = min<int16_t>(y + h, height());
+    g_ds.bitmap++;
+    if (x1 > x0 && y1 > y0) g_ds.px += (uint32_t)(x1 - x0) * (uint32_t)(y1 - y0);
+    Arduino_RGB_Display::draw16bitRGBBitmap(x, y, bitmap, w, h);
+  }
+};
+
+// Accumulatore per un punto di misura (uno per ogni DS_FRAME_SCOPE/DS_REFRESH_SCOPE)
+struct DrawStatsWindow {
+  const char *tag;
+  uint32_t n = 0, usSum = 0, usMax = 0, startMs = 0;
+  DrawCounters sum;
+
+  explicit DrawStatsWindow(const char *t) : tag(t) {}
+
+  void add(uint32_t us) {
+    if (n == 0) startMs = millis();
+    n++; usSum += us; if (us > usMax) usMax = us;
+    sum.fill   += g_ds.fill   - g_dsMark.fill;
+    sum.bitmap += g_ds.bitmap - g_dsMark.bitmap;
+    sum.pixel  += g_ds.pixel  - g_dsMark.pixel;
+    sum.px     += g_ds.px     - g_dsMark.px;
+  }
+
+  void report() {
+    if (!n) return;
+    Serial.printf("[DS] %s: n=%lu us avg/max=%lu/%lu fill=%lu bmp=%lu pix=%lu px=%lu\n",
+                  tag, (unsigned long)n,
+                  (unsigned long)(usSum / n), (unsigned long)usMax,
+                  (unsigned long)(sum.fill / n), (unsigned long)(sum.bitmap / n),
+                  (unsigned long)(sum.pixel / n), (unsigned long)(sum.px / n));
+    n = 0; usSum = 0; usMax = 0; sum = DrawCounters();
+  }
+};
+
+static inline void dsBegin() { g_dsMark = g_ds; g_dsMarkUs = DS_CLOCK_US(); }
+
+// Frame ricorrente: accumula e stampa la media ogni DS_REPORT_MS
+static inline void dsFrame(DrawStatsWindow &w) {
+  w.add(DS_CLOCK_US() - g_dsMarkUs);
+  if (millis() - w.startMs >= DS_REPORT_MS) w.report();
+}
+
+// Refresh singolo (pagina, JPEG, QR): stampa subito
+static inline void dsRefresh(DrawStatsWindow &w) {
+  w.add(DS_CLOCK_US() - g_dsMarkUs);
+  w.report();
+}
+
+struct DrawStatsScope {
+  DrawStatsWindow &w; bool once;
+  DrawStatsScope(DrawStatsWindow &win, bool o) : w(win), once(o) { dsBegin(); }
+  ~DrawStatsScope() { if (once) dsRefresh(w); else dsFrame(w); }
+};
+
+#define DS_FRAME_SCOPE(tag)    static DrawStatsWindow _dsw(tag); DrawStatsScope _dss(_dsw, false)
+#define DS_REFRESH_SCOPE(tag)  static DrawStatsWindow _dsw(tag); DrawStatsScope _dss(_dsw, true)
+
+#else
+
+typedef Arduino_RGB_Display DrawStatsDisplay;
+
+#define DS_FRAME_SCOPE(tag)    do {} while (0)
+#define DS_REFRESH_SCOPE(tag)  do {} while (0)
+
+#endif
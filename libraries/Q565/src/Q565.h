@@ -0,0 +1,137 @@
+/*
+  Q565.h – decoder a righe per immagini RGB565 compresse (formato Q565)
+
+  Gli asset si generano offline con tools/img2q565.py (PNG/JPEG -> header C):
+    NAME_WIDTH, NAME_HEIGHT e static const uint8_t NAME_q565[] PROGMEM
+
+  Il decoder espande una riga alla volta in un buffer da 'width' pixel:
+  niente copia in RAM dell'immagine intera, stato di ~150 byte.
+
+  Libreria condivisa da Pongino e QuadrantiOraQuadra (libraries/Q565, vedi README).
+
+  Uso nello sketch:
+    #include <Q565.h>
+    #include "Splash.h"
+    drawQ565(gfx, 0, 0, Splash_q565, sizeof(Splash_q565));   // una draw16bitRGBBitmap per riga
+
+  oppure, per comporre a mano:
+    Q565Decoder d;
+    if (d.begin(data, len)) while (d.readLine(line)) { ... }
+
+  Formato (dettagli in tools/img2q565.py):
+    header 'Q565' + larghezza/altezza u16 LE, poi op da 1-3 byte:
+    INDEX (cache hash 64 colori), PAIR (2 pixel dagli 8 colori recenti),
+    LUMA (delta da prev), RUN (1..62 ripetizioni), RGB (pixel letterale).
+*/
+#pragma once
+#if __has_include(<Arduino.h>)
+#include <Arduino.h>
+#else                              // su PC (tools/dialbench.cpp)
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+using std::min;
+#endif
+
+#ifndef Q565_MAX_WIDTH
+#define Q565_MAX_WIDTH 480
+#endif
+
+struct Q565Decoder {
+  const uint8_t *p = nullptr, *end = nullptr;
+  uint16_t w = 0, h = 0, row = 0;
+  uint16_t prev = 0;
+  uint16_t index[64];
+  uint16_t mru[8];
+  uint8_t  run = 0;          // ripetizioni di prev ancora da emettere
+  bool     pending = false;  // secondo pixel di un PAIR rimasto sulla riga precedente
+  uint16_t pendingPx = 0;
+
+  static inline uint8_t hash(uint16_t c) {
+    return (uint8_t)(((c >> 11) * 3 + ((c >> 5) & 63) * 5 + (c & 31) * 7) & 63);
+  }
+
+  // Valida l'header e azzera lo stato; false se lo stream non è Q565 o è troppo largo
+  bool begin(const uint8_t *data, uint32_t len) {
+    if (len < 8 || data[0] != 'Q' || data[1] != '5' || data[2] != '6' || data[3] != '5') return false;
+    w = data[4] | (data[5] << 8);
+    h = data[6] | (data[7] << 8);
+    if (w == 0 || w > Q565_MAX_WIDTH) return false;
+    p = data + 8; end = data + len;
+    row = 0; prev = 0; run = 0; pending = false;
+    memset(index, 0, sizeof(index));
+    memset(mru, 0, sizeof(mru));
+    return true;
+  }
+
+  // Pixel non-RUN: aggiorna cache hash e lista recenti (move-to-front)
+  inline void emitted(uint16_t c) {
+    index[hash(c)] = c;
+    uint8_t i = 0;
+    while (i < 7 && mru[i] != c) i++;
+    for (; i > 0; --i) mru[i] = mru[i - 1];
+    mru[0] = c;
+    prev = c;
+  }
+
+  // Espande la riga successiva in 'line' (w pixel); false a immagine finita o stream troncato
+  bool readLine(uint16_t *line) {
+    if (row >= h) return false;
+    uint16_t x = 0;
+    if (pending) { line[x++] = pendingPx; pending = false; }
+    while (x < w) {
+      if (run) {
+        uint16_t n = min<uint16_t>(run, w - x);
+        for (uint16_t k = 0; k < n; ++k) line[x + k] = prev;
+        x += n; run -= n;
+        continue;
+      }
+      if (p >= end) return false;
+      uint8_t op = *p++;
+      if (op == 0xFE) {
+        if (end - p < 2) return false;
+        uint16_t c = p[0] | (p[1] << 8); p += 2;
+        emitted(c); line[x++] = c;
+      } else if (op >= 0xC0) {
+        if (op == 0xFF) return false;           // riservato
+        run = (op & 63) + 1;
+      } else if (op >= 0x80) {
+        if (p >= end) return false;
+        int dg = (op & 63) - 32;
+        int dr = dg + (*p >> 4) - 8;
+        int db = dg + (*p & 15) - 8;
+        p++;
+        uint16_t c = (uint16_t)(((((prev >> 11) + dr) & 31) << 11) |
+                                ((((prev >> 5) + dg) & 63) << 5) |
+                                (((prev & 31) + db) & 31));
+        emitted(c); line[x++] = c;
+      } else if (op >= 0x40) {
+        uint16_t a = mru[(op >> 3) & 7];
+        emitted(a); line[x++] = a;
+        uint16_t b = mru[op & 7];
+        emitted(b);
+        if (x < w) line[x++] = b;
+        else { pending = true; pendingPx = b; }
+      } else {
+        uint16_t c = index[op];
+        emitted(c); line[x++] = c;
+      }
+    }
+    row++;
+    return true;
+  }
+};
+
+// Disegna uno stream Q565 in (x,y) una riga alla volta; ritorna le righe disegnate
+template <class GFX>
+static int drawQ565(GFX *g, int16_t x, int16_t y, const uint8_t *data, uint32_t len) {
+  static uint16_t line[Q565_MAX_WIDTH];
+  Q565Decoder d;
+  if (!d.begin(data, len)) return 0;
+  int rows = 0;
+  while (d.readLine(line)) {
+    g->draw16bitRGBBitmap(x, y + rows, line, d.w, 1);
+    rows++;
+  }
+  return rows;
+}
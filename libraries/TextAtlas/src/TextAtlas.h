@@ -0,0 +1,122 @@
+/*
+  TextAtlas.h – testo 2x (normale o "bold") da un atlante di glifi (Panel-4848S040)
+
+  Il font classico 6x8 di Arduino_GFX si rasterizza una volta per carattere, alla
+  prima occorrenza, passando da drawChar della libreria: stessi glifi di print().
+  L'atlante tiene per ogni glifo le righe 1x e la maschera bold 2x già pronta
+  (glifo | spostato di 1 px a destra, in basso e in diagonale: 13x17 pixel).
+
+  Ogni glifo finisce a schermo con una sola draw16bitRGBBitmap opaca (fg/bg),
+  invece di un fillRect per pixel del font e, per il bold, quattro passate.
+
+  Libreria condivisa da NewsTicker e PartenzeCH (libraries/TextAtlas, vedi README).
+
+  Uso nello sketch:
+    #include <TextAtlas.h>
+    drawAtlasText(gfx, x, y, "Partenze", fg, bg, true);        // bold
+    drawAtlasText(gfx, x, y, "12:34", fg, bg, false, 108);     // normale, sfondo fino a 108 px
+
+  padW > 0 riempie di bg fino a padW pixel dopo il testo: cancella un testo precedente
+  più lungo senza ripulire prima l'area (niente sfarfallio). Il testo oltre padW si tronca.
+  L'atlante (~10 KB) si alloca alla prima chiamata, in PSRAM se c'è.
+*/
+#pragma once
+#include <Arduino.h>
+#include <Arduino_GFX_Library.h>
+
+#define TA_CELL_W 12                 // avanzamento di un carattere a 2x
+#define TA_CELL_H 16
+#define TA_BOLD_W (TA_CELL_W + 1)    // il bold sborda di 1 px a destra e in basso
+#define TA_BOLD_H (TA_CELL_H + 1)
+
+struct TextAtlasGlyph {
+  uint8_t  rows[8];                  // font 1x: bit x = colonna x (0..5)
+  uint16_t bold[TA_BOLD_H];          // maschera bold 2x: bit x = colonna x (0..12)
+};
+
+// Registra i pixel che drawChar scrive in una cella 6x8
+class TextAtlasRecorder : public Arduino_GFX {
+public:
+  TextAtlasRecorder() : Arduino_GFX(6, 8) {}
+  bool begin(int32_t = GFX_NOT_DEFINED) override { return true; }
+  void writePixelPreclipped(int16_t x, int16_t y, uint16_t) override { rows[y] |= (uint8_t)(1 << x); }
+  uint8_t rows[8];
+};
+
+static TextAtlasGlyph *g_taGlyphs = nullptr;
+static uint32_t g_taHave[8];         // bitset: glifi già rasterizzati
+
+// 6 bit -> 12 bit, ogni colonna raddoppiata
+static inline uint16_t taDouble(uint8_t r) {
+  uint16_t o = 0;
+  for (uint8_t i = 0; i < 6; ++i) if (r & (1 << i)) o |= (uint16_t)(3u << (2 * i));
+  return o;
+}
+
+static const TextAtlasGlyph *taGlyph(uint8_t c) {
+  if (!g_taGlyphs) {
+    size_t sz = 256 * sizeof(TextAtlasGlyph);
+    g_taGlyphs = (TextAtlasGlyph *)(psramFound() ? ps_malloc(sz) : malloc(sz));
+    if (!g_taGlyphs) return nullptr;
+    memset(g_taHave, 0, sizeof(g_taHave));
+  }
+  TextAtlasGlyph &g = g_taGlyphs[c];
+  if (g_taHave[c >> 5] & (1u << (c & 31))) return &g;
+
+  static TextAtlasRecorder rec;
+  memset(rec.rows, 0, sizeof(rec.rows));
+  if (c != '\n' && c != '\r') {      // print() li tratta come controlli: cella vuota
+    rec.setTextSize(1);
+    rec.setTextColor(1);             // trasparente: solo i pixel del glifo
+    rec.setCursor(0, 0);
+    rec.write(c);
+  }
+  memcpy(g.rows, rec.rows, sizeof(g.rows));
+  uint16_t prev = 0;
+  for (uint8_t y = 0; y < TA_BOLD_H; ++y) {
+    uint16_t r = (y < TA_CELL_H) ? taDouble(g.rows[y >> 1]) : 0;
+    uint16_t h = r | (uint16_t)(r << 1);
+    g.bold[y] = h | prev;            // riga sopra spostata in basso di 1 px
+    prev = h;
+  }
+  g_taHave[c >> 5] |= 1u << (c & 31);
+  return &g;
+}
+
+static inline int16_t atlasTextWidth(const char *s, bool bold) {
+  size_t n = strlen(s);
+  return n ? (int16_t)(n * TA_CELL_W + (bold ? 1 : 0)) : 0;
+}
+
+// Disegna s con glifi opachi, una draw16bitRGBBitmap per glifo; ritorna la larghezza disegnata
+template <class GFX>
+static int16_t drawAtlasText(GFX *g, int16_t x, int16_t y, const char *s, uint16_t fg, uint16_t bg,
+                             bool bold, int16_t padW = 0) {
+  static uint16_t px[TA_BOLD_W * TA_BOLD_H];
+  const int16_t h = bold ? TA_BOLD_H : TA_CELL_H;
+  size_t n = strlen(s);
+  if (padW > 0) {                    // tronca a padW (il bold tiene il pixel in più)
+    size_t fit = (size_t)((padW - (bold ? 1 : 0)) / TA_CELL_W);
+    if (n > fit) n = fit;
+  }
+  uint16_t carry[TA_BOLD_H] = {0};   // colonna 12 del glifo bold precedente
+  int16_t cx = x;
+  for (size_t i = 0; i < n; ++i) {
+    const TextAtlasGlyph *gl = taGlyph((uint8_t)s[i]);
+    if (!gl) return 0;
+    const bool last = (i + 1 == n);
+    const int16_t w = (bold && last) ? TA_BOLD_W : TA_CELL_W;
+    uint16_t *p = px;
+    for (int16_t r = 0; r < h; ++r) {
+      uint16_t m;
+      if (bold) { m = gl->bold[r] | carry[r]; carry[r] = gl->bold[r] >> TA_CELL_W; }
+      else      { m = taDouble(gl->rows[r >> 1]); }
+      for (int16_t c = 0; c < w; ++c) *p++ = (m & (1u << c)) ? fg : bg;
+    }
+    g->draw16bitRGBBitmap(cx, y, px, w, h);
+    cx += TA_CELL_W;
+  }
+  int16_t drawn = n ? (int16_t)(n * TA_CELL_W + (bold ? 1 : 0)) : 0;
+  if (padW > drawn) g->fillRect(x + drawn, y, padW - drawn, h, bg);
+  return drawn;
+}
@@ -0,0 +1,160 @@
+/*
+  WebChunk.h – pagine web a pezzi con transfer chunked (WebServer ESP32)
+
+  Invece di concatenare la pagina in una String e passarla a web.send, i pezzi
+  si accodano a un buffer fisso di WC_BUF byte che parte come chunk HTTP
+  (sendContent) appena è pieno:
+    - le parti fisse stanno in flash: i blocchi lunghi vanno al client senza copia;
+    - i campi dinamici si scrivono già con l'escape (HTML o stringa JS), senza
+      String temporanee;
+    - un WebFrag tiene un frammento già renderizzato (in PSRAM se c'è), da
+      invalidare quando cambiano i dati NVS da cui dipende.
+
+  Libreria condivisa da NewsTicker e PartenzeCH (libraries/WebChunk, vedi README).
+
+  Uso nello sketch:
+    #include <WebChunk.h>
+    WebChunk w(web, "/route");
+    w.begin("text/html");
+    w.put(PAGE_HEAD);            // static const char PAGE_HEAD[] PROGMEM = "...";
+    w.esc(g_from);               // & < > " ' -> entità
+    w.num(g_refreshSec);
+    w.end();                     // chunk finale + report su Serial
+
+  Report su Serial a fine pagina:
+    [WEB] /route: <byte> byte in <n> chunk, primo chunk <ms> ms, totale <ms> ms, heap picco <byte> B
+  "primo chunk" va dall'ingresso nell'handler (begin) all'invio del primo pezzo di
+  body; "heap picco" è il calo massimo di heap libero visto ai flush.
+*/
+#pragma once
+#include <Arduino.h>
+#include <WebServer.h>
+
+#ifndef WC_BUF
+#define WC_BUF 1024
+#endif
+
+// Frammento già pronto: si riusa finché valid, si rigenera dopo invalidate()
+struct WebFrag {
+  char  *buf = nullptr;
+  size_t len = 0, cap = 0;
+  bool   valid = false;
+  void invalidate() { valid = false; }
+};
+
+class WebChunk {
+public:
+  WebChunk(WebServer &web, const char *name) : _web(&web), _name(name) {}
+  // Render verso un frammento invece che verso il client
+  explicit WebChunk(WebFrag &f) : _frag(&f) { f.valid = false; f.len = 0; }
+
+  void begin(const char *type, int code = 200) {
+    _t0 = micros();
+    _heap0 = _heapMin = ESP.getFreeHeap();
+    _web->setContentLength(CONTENT_LENGTH_UNKNOWN);
+    _web->send(code, type, "");
+  }
+
+  void write(const char *s, size_t n) {
+    if (_web && n >= WC_BUF / 2) {             // blocco lungo: dritto dalla sorgente
+      flush();
+      sendChunk(s, n);
+      return;
+    }
+    while (n) {
+      size_t k = WC_BUF - _n;
+      if (k > n) k = n;
+      memcpy(_buf + _n, s, k);
+      _n += k; s += k; n -= k;
+      if (_n == WC_BUF) flush();
+    }
+  }
+  void put(const char *s)     { write(s, strlen(s)); }
+  void put(const String &s)   { write(s.c_str(), s.length()); }
+  void put(char c)            { if (_n == WC_BUF) flush(); _buf[_n++] = c; }
+  void num(long v)            { char b[12]; int k = snprintf(b, sizeof(b), "%ld", v); write(b, (size_t)k); }
+  void frag(const WebFrag &f) { if (f.valid) write(f.buf, f.len); }
+
+  // Testo dentro HTML o attributi (anche tra apici singoli)
+  void esc(const char *s) {
+    for (; *s; ++s) {
+      switch (*s) {
+        case '&':  put("&amp;");  break;
+        case '<':  put("&lt;");   break;
+        case '>':  put("&gt;");   break;
+        case '"':  put("&quot;"); break;
+        case '\'': put("&#39;");  break;
+        default:   put(*s);
+      }
+    }
+  }
+  void esc(const String &s) { esc(s.c_str()); }
+
+  // Contenuto di una stringa JS tra apici singoli dentro <script>
+  void js(const char *s) {
+    for (; *s; ++s) {
+      switch (*s) {
+        case '\\': put("\\\\");  break;
+        case '\'': put("\\'");   break;
+        case '<':  put("\\x3c"); break;    // niente </script> anticipati
+        case '\n': put("\\n");   break;
+        case '\r': break;
+        default:   put(*s);
+      }
+    }
+  }
+  void js(const String &s) { js(s.c_str()); }
+
+  // Chiude la risposta (o il frammento); false se il frammento non ha trovato memoria
+  bool end() {
+    flush();
+    if (_frag) { _frag->valid = !_fail; return !_fail; }
+    _web->sendContent("");                     // chunk vuoto: fine risposta
+    uint32_t tot = micros() - _t0;
+    Serial.printf("[WEB] %s: %lu byte in %lu chunk, primo chunk %lu.%lu ms, totale %lu.%lu ms, heap picco %lu B\n",
+                  _name, (unsigned long)_bytes, (unsigned long)_chunks,
+                  (unsigned long)(_first / 1000), (unsigned long)(_first / 100 % 10),
+                  (unsigned long)(tot / 1000), (unsigned long)(tot / 100 % 10),
+                  (unsigned long)(_heap0 > _heapMin ? _heap0 - _heapMin : 0));
+    return true;
+  }
+
+private:
+  void flush() {
+    if (!_n) return;                           // un chunk vuoto chiuderebbe la risposta
+    if (_frag) appendFrag(_buf, _n);
+    else       sendChunk(_buf, _n);
+    _n = 0;
+  }
+
+  void sendChunk(const char *s, size_t n) {
+    sampleHeap();
+    _web->sendContent(s, n);
+    if (!_chunks++) _first = micros() - _t0;
+    _bytes += n;
+    sampleHeap();
+  }
+
+  void appendFrag(const char *s, size_t n) {
+    if (_fail) return;
+    if (_frag->len + n > _frag->cap) {
+      size_t cap = (_frag->len + n + 1023) & ~(size_t)1023;
+      char *p = (char *)(psramFound() ? ps_realloc(_frag->buf, cap) : realloc(_frag->buf, cap));
+      if (!p) { _fail = true; return; }
+      _frag->buf = p; _frag->cap = cap;
+    }
+    memcpy(_frag->buf + _frag->len, s, n);
+    _frag->len += n;
+  }
+
+  void sampleHeap() { uint32_t h = ESP.getFreeHeap(); if (h < _heapMin) _heapMin = h; }
+
+  WebServer  *_web  = nullptr;
+  WebFrag    *_frag = nullptr;
+  const char *_name = nullptr;
+  char     _buf[WC_BUF];
+  size_t   _n = 0;
+  bool     _fail = false;
+  uint32_t _t0 = 0, _first = 0, _bytes = 0, _chunks = 0;
+  uint32_t _heap0 = 0, _heapMin = 0;
+};
@@ -0,0 +1,95 @@
+/*
+  dialbench.cpp – quadranti di QuadrantiOraQuadra su un framebuffer del PC
+
+  Compilazione ed esecuzione (dalla radice del repo):
+    python3 tools/dialpack.py QuadrantiOraQuadra/classic.jpg QuadrantiOraQuadra/neon.jpg -o quadranti/
+    g++ -O2 -std=c++17 -Ilibraries/Q565/src -o dialbench tools/dialbench.cpp && ./dialbench quadranti/classic.qd quadranti/neon.qd
+    ./dialbench -s 600 quadranti/classic.qd      # secondi simulati (default 3600, dalle 10:08:00)
+  Entrambi accettano più file: con i glob della shell si convertono e misurano tutti i quadranti.
+
+  Per ogni pacchetto, con DialFace.h dello sketch e un push che copia nel framebuffer:
+    byte     dimensione del .qd (quanto si legge dalla SD al cambio quadrante)
+    decod    ms per decodificare tutti i tasselli nello sfondo (load)
+    frame    ms per comporre e spingere lo schermo intero (drawAll)
+    px/s     pixel spinti a ogni secondo, media e massimo (il massimo cade al cambio di minuto)
+    blit     push per secondo, media
+    us/s     us di composizione e push per secondo, media
+    diff     pixel del framebuffer diversi da uno schermo ricomposto da zero, su tutti i
+             secondi: deve restare 0 (nessuna lancetta fuori dai tasselli ridisegnati)
+  I tempi sono del PC; la lettura dalla SD e il push verso il pannello qui non ci sono.
+  Sul pannello lo sketch stampa gli stessi numeri su Serial ([DIAL]).
+*/
+#include "../QuadrantiOraQuadra/DialFace.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static uint16_t fb[DIAL_W * DIAL_H], ref[DIAL_W * DIAL_H];
+static DialFace face;
+
+static double msSince(std::chrono::steady_clock::time_point t0) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static auto pushTo(uint16_t *dst) {
+  return [dst](int x, int y, const uint16_t *buf, int w, int h) {
+    for (int r = 0; r < h; ++r) memcpy(dst + (y + r) * DIAL_W + x, buf + r * w, w * 2);
+  };
+}
+
+int main(int argc, char **argv) {
+  int seconds = 3600, first = 1;
+  if (argc > 2 && !strcmp(argv[1], "-s")) { seconds = atoi(argv[2]); first = 3; }
+  if (first >= argc) { fprintf(stderr, "uso: dialbench [-s secondi] file.qd...\n"); return 1; }
+
+  face.bg = new uint16_t[DIAL_W * DIAL_H];
+  printf("%-18s %7s %7s %7s %8s %8s %5s %7s %5s\n",
+         "quadrante", "byte", "decod", "frame", "px/s", "max", "blit", "us/s", "diff");
+  double sumPx = 0, sumDec = 0, sumFrame = 0;
+  int dials = 0;
+  for (int a = first; a < argc; ++a) {
+    FILE *f = fopen(argv[a], "rb");
+    if (!f) { fprintf(stderr, "%s: non si apre\n", argv[a]); continue; }
+    std::vector<uint8_t> pack;
+    uint8_t chunk[4096];
+    for (size_t n; (n = fread(chunk, 1, sizeof(chunk), f)) > 0; ) pack.insert(pack.end(), chunk, chunk + n);
+    fclose(f);
+
+    auto t0 = std::chrono::steady_clock::now();
+    if (!face.load(pack.data(), (uint32_t)pack.size())) { fprintf(stderr, "%s: pacchetto non valido\n", argv[a]); continue; }
+    const double dec = msSince(t0);
+    int h = 10, m = 8, s = 0;
+    t0 = std::chrono::steady_clock::now();
+    face.drawAll(h, m, s, pushTo(fb));
+    const double frame = msSince(t0);
+
+    double px = 0, us = 0, blits = 0;
+    uint32_t pxMax = 0;
+    uint64_t diff = 0;
+    for (int k = 0; k < seconds; ++k) {
+      if (++s == 60) { s = 0; if (++m == 60) { m = 0; h = (h + 1) % 24; } }
+      t0 = std::chrono::steady_clock::now();
+      face.tick(h, m, s, pushTo(fb));
+      us += msSince(t0) * 1000.0;
+      px += face.lastPx; blits += face.lastBlits;
+      if (face.lastPx > pxMax) pxMax = face.lastPx;
+
+      face.drawAll(h, m, s, pushTo(ref));           // stessa ora: lo stato non cambia
+      for (int i = 0; i < DIAL_W * DIAL_H; ++i) diff += fb[i] != ref[i];
+    }
+
+    const char *name = strrchr(argv[a], '/') ? strrchr(argv[a], '/') + 1 : argv[a];
+    printf("%-18s %7zu %7.2f %7.2f %8.0f %8u %5.1f %7.1f %5llu\n", name, pack.size(), dec, frame,
+           px / seconds, pxMax, blits / seconds, us / seconds, (unsigned long long)diff);
+    sumPx += px / seconds; sumDec += dec; sumFrame += frame;
+    dials++;
+  }
+  if (dials > 1)
+    printf("%-18s %7s %7.2f %7.2f %8.0f   (media su %d quadranti)\n", "media", "", sumDec / dials,
+           sumFrame / dials, sumPx / dials, dials);
+  printf("(ms e us di questo PC; schermo intero = %d px)\n", DIAL_W * DIAL_H);
+  return 0;
+}
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""
+dialpack.py – converte i quadranti (JPEG/PNG) in pacchetti a tasselli RGB565 per QuadrantiOraQuadra
+
+Uso:
+  python3 tools/dialpack.py QuadrantiOraQuadra/*.jpg -o quadranti/
+  python3 tools/dialpack.py QuadrantiOraQuadra/classic.jpg --lancette 2104 --secondi f800 -o quadranti/
+
+Per ogni immagine scrive <nome>.qd, da copiare sulla SD in /quadranti/. Lo sketch decodifica
+il pacchetto una volta sola in PSRAM; tools/dialbench.cpp lo misura su PC.
+
+Formato .qd (little endian):
+  header  24 byte
+            'Q' 'D' 'I' 'A', versione u8 (1), lato del tassello u8, colonne u8, righe u8,
+            larghezza u16, altezza u16, centro x u16, centro y u16,
+            raggio u16 (lunghezza della lancetta dei minuti),
+            colore ore/minuti u16, colore secondi u16, riservato u16
+  indice  colonne*righe + 1 offset u32 dall'inizio dei dati: il tassello i sta in [off[i], off[i+1])
+  dati    uno stream Q565 per tassello (formato in tools/img2q565.py), tasselli per righe;
+          l'ultima colonna/riga è più stretta se il lato non divide l'immagine
+
+Senza --lancette il colore di ore e minuti è scuro o chiaro a seconda della luminosità media
+del quadrante attorno al centro, dove passano le lancette.
+"""
+import argparse
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from img2q565 import decode, encode, load_image  # noqa: E402
+
+MAGIC = b"QDIA"
+VERSION = 1
+HEADER = struct.Struct("<4sBBBBHHHHHHHH")   # 24 byte
+DARK, LIGHT, RED, YELLOW = 0x18E3, 0xFFFF, 0xF800, 0xFFE0
+
+
+def rgb(c):
+    return (c >> 11) << 3, ((c >> 5) & 63) << 2, (c & 31) << 3
+
+
+def auto_colors(px, w, h, cx, cy, radius):
+    """Lancette scure su fondo chiaro e viceversa; secondi rossi, gialli se il fondo è già rosso."""
+    n = lum = red = 0
+    r0, r1 = (radius * 0.15) ** 2, (radius * 0.9) ** 2
+    for y in range(0, h, 3):
+        for x in range(0, w, 3):
+            d = (x - cx) ** 2 + (y - cy) ** 2
+            if r0 <= d <= r1:
+                r, g, b = rgb(px[y * w + x])
+                lum += 0.299 * r + 0.587 * g + 0.114 * b
+                red += r > 150 and r > 2 * g and r > 2 * b
+                n += 1
+    n = max(n, 1)
+    return (DARK if lum / n > 128 else LIGHT), (YELLOW if red / n > 0.25 else RED)
+
+
+def pack(px, w, h, tile, cx, cy, radius, hand, sec):
+    cols, rows = (w + tile - 1) // tile, (h + tile - 1) // tile
+    offsets, data = [], bytearray()
+    for ty in range(0, h, tile):
+        th = min(tile, h - ty)
+        for tx in range(0, w, tile):
+            tw = min(tile, w - tx)
+            sub = [px[(ty + r) * w + tx + c] for r in range(th) for c in range(tw)]
+            stream, _ = encode(sub, tw, th)
+            if decode(stream)[2] != sub:
+                sys.exit("verifica fallita sul tassello (%d,%d)" % (tx, ty))
+            offsets.append(len(data))
+            data += stream
+    offsets.append(len(data))
+    head = HEADER.pack(MAGIC, VERSION, tile, cols, rows, w, h, cx, cy, radius, hand, sec, 0)
+    return head + struct.pack("<%dI" % len(offsets), *offsets) + data, cols * rows
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Converte quadranti in pacchetti .qd a tasselli RGB565 (Q565).")
+    ap.add_argument("input", nargs="+", help="immagini dei quadranti (JPEG/PNG/BMP)")
+    ap.add_argument("-o", "--output", default=".", help="cartella di uscita (default: corrente)")
+    ap.add_argument("--tile", type=int, default=32, help="lato del tassello in pixel, 8..32 (default 32)")
+    ap.add_argument("--size", default="480x480", help="WxH dello schermo (default 480x480)")
+    ap.add_argument("--centro", help="X,Y del perno delle lancette (default: centro dell'immagine)")
+    ap.add_argument("--raggio", type=int, help="lunghezza della lancetta dei minuti (default: 5/16 del lato corto)")
+    ap.add_argument("--lancette", help="colore RGB565 esadecimale di ore e minuti (default: automatico)")
+    ap.add_argument("--secondi", help="colore RGB565 esadecimale dei secondi (default: automatico)")
+    args = ap.parse_args()
+
+    if not 8 <= args.tile <= 32:
+        sys.exit("--tile deve stare tra 8 e 32 (la striscia dello sketch è alta 32 righe)")
+    size = tuple(int(v) for v in args.size.lower().split("x"))
+    os.makedirs(args.output, exist_ok=True)
+
+    for path in args.input:
+        w, h, px = load_image(path, size)
+        cx, cy = (int(v) for v in args.centro.split(",")) if args.centro else (w // 2, h // 2)
+        radius = args.raggio or min(w, h) * 5 // 16
+        hand, sec = auto_colors(px, w, h, cx, cy, radius)
+        if args.lancette:
+            hand = int(args.lancette, 16)
+        if args.secondi:
+            sec = int(args.secondi, 16)
+
+        data, tiles = pack(px, w, h, args.tile, cx, cy, radius, hand, sec)
+        name = os.path.splitext(os.path.basename(path))[0] + ".qd"
+        with open(os.path.join(args.output, name), "wb") as f:
+            f.write(data)
+        print("%-22s %dx%d, %d tasselli da %d, %d -> %d byte (%.2fx), lancette %04x secondi %04x"
+              % (name, w, h, tiles, args.tile, w * h * 2, len(data), w * h * 2 / len(data), hand, sec))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""
+feedserver.py – server HTTP locale che serve feed di prova (es. NewsTicker/fixtures)
+
+Uso:
+  python3 tools/feedserver.py                               # NewsTicker/fixtures su :8000
+  python3 tools/feedserver.py --dir mie_fixture --port 8080 --delay 1.5
+
+Poi nella WebUI /rss del pannello: http://<IP del PC>:8000/ansa.xml, ecc.
+
+Per ogni file manda ETag (hash del contenuto) e Last-Modified (mtime) e risponde 304
+a If-None-Match / If-Modified-Since quando il file non è cambiato: modificando o
+toccando un file si forza un 200 al giro successivo.
+  --delay   secondi di attesa prima della risposta (rete lenta)
+  --rate    byte/s in uscita (0 = nessun limite), per vedere lo streaming a blocchi
+  --fail    percentuale di richieste che rispondono 503
+"""
+import argparse
+import email.utils
+import hashlib
+import os
+import random
+import sys
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+ARGS = None
+
+
+class FeedHandler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.0"   # come il pannello (useHTTP10): niente chunked
+
+    def do_GET(self):
+        name = os.path.basename(self.path.split("?", 1)[0]) or "index"
+        path = os.path.join(ARGS.dir, name)
+        if ARGS.delay:
+            time.sleep(ARGS.delay)
+        if ARGS.fail and random.uniform(0, 100) < ARGS.fail:
+            self.send_error(503, "errore simulato")
+            return
+        if not os.path.isfile(path):
+            self.send_error(404)
+            return
+
+        with open(path, "rb") as f:
+            body = f.read()
+        etag = '"%s"' % hashlib.sha1(body).hexdigest()[:16]
+        mtime = int(os.path.getmtime(path))
+        last_mod = email.utils.formatdate(mtime, usegmt=True)
+
+        inm = self.headers.get("If-None-Match")
+        ims = self.headers.get("If-Modified-Since")
+        not_modified = False
+        if inm is not None:
+            not_modified = etag in [t.strip() for t in inm.split(",")]
+        elif ims is not None:
+            try:
+                not_modified = mtime <= email.utils.parsedate_to_datetime(ims).timestamp()
+            except (TypeError, ValueError):
+                pass
+
+        if not_modified:
+            self.send_response(304)
+            self.send_header("ETag", etag)
+            self.send_header("Last-Modified", last_mod)
+            self.end_headers()
+            return
+
+        self.send_response(200)
+        self.send_header("Content-Type", "application/xml; charset=utf-8")
+        self.send_header("Content-Length", str(len(body)))
+        self.send_header("ETag", etag)
+        self.send_header("Last-Modified", last_mod)
+        self.end_headers()
+        if ARGS.rate <= 0:
+            self.wfile.write(body)
+            return
+        step = max(1, ARGS.rate // 10)
+        for i in range(0, len(body), step):
+            self.wfile.write(body[i:i + step])
+            self.wfile.flush()
+            time.sleep(0.1)
+
+    def log_message(self, fmt, *args):
+        sys.stderr.write("[%s] %s\n" % (self.address_string(), fmt % args))
+
+
+def main():
+    global ARGS
+    here = os.path.dirname(os.path.abspath(__file__))
+    ap = argparse.ArgumentParser(description="Serve feed di prova con ETag/Last-Modified e 304.")
+    ap.add_argument("--dir", default=os.path.join(here, "..", "NewsTicker", "fixtures"))
+    ap.add_argument("--port", type=int, default=8000)
+    ap.add_argument("--delay", type=float, default=0.0)
+    ap.add_argument("--rate", type=int, default=0)
+    ap.add_argument("--fail", type=float, default=0.0)
+    ARGS = ap.parse_args()
+    ARGS.dir = os.path.abspath(ARGS.dir)
+    srv = ThreadingHTTPServer(("0.0.0.0", ARGS.port), FeedHandler)
+    print("feedserver: %s su http://0.0.0.0:%d/" % (ARGS.dir, ARGS.port))
+    for n in sorted(os.listdir(ARGS.dir)):
+        print("  /" + n)
+    try:
+        srv.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
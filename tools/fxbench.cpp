@@ -0,0 +1,284 @@
+/*
+  fxbench.cpp – costo delle particelle di Pongino su PC, in funzione di quante sono vive
+
+  Compilazione ed esecuzione (dalla radice del repo):
+    g++ -O2 -std=c++17 -o fxbench tools/fxbench.cpp && ./fxbench
+    ./fxbench 3000                  # tick per misura (default 2000)
+
+  Per ogni numero di particelle vive confronta:
+    vecchio  struct con float, 160 slot scorsi tutti (qui tanti quanti il pool),
+             due damage() per particella mossa, fillRect virtuale per particella e striscia;
+    nuovo    FxPool.h: array separati in Q8, solo le vive, tratti sporchi per fascia,
+             lista di disegno per fascia/colore con le righe uguali fuse.
+  Lo scenario è quello dei mattoni rotti: esplosioni da 24+1 particelle che cadono fino
+  al bordo, rilanciate appena le vive scendono sotto il numero voluto.
+
+  Colonne (medie per tick, un frame per tick):
+    update   us di spawn + moto + zone sporche, damage() compresa (copia di quella di
+             Pongino.ino, 24 rettangoli)
+    disegno  us per comporre le strisce: sfondo + particelle (niente stelle né mattoni)
+    rett     rettangoli nella damage list a fine frame
+    px       pixel ridisegnati: sul pannello ognuno passa anche da stelle, mattoni e push
+  I tempi sono del PC e servono solo al confronto tra le due versioni; sul pannello vanno
+  misurati con DRAW_STATS.
+*/
+#define FX_MAX 2560
+#include "../Pongino/FxPool.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+static const int W = 480, H = 480;
+static const int TILE_PX = W * 24;
+static const int MAX_DAMAGE = 24;
+static const int DAMAGE_SLACK_PX = 1024;
+
+// ---------- damage list (come Pongino.ino) ----------
+struct DRect { int16_t x0, y0, x1, y1; };
+static DRect damageList[MAX_DAMAGE];
+static int   damageCount = 0;
+
+static inline int dArea(const DRect &r) { return (r.x1 - r.x0) * (r.y1 - r.y0); }
+static inline bool dOverlap(const DRect &a, const DRect &b) {
+  return a.x0 < b.x1 && b.x0 < a.x1 && a.y0 < b.y1 && b.y0 < a.y1;
+}
+static inline DRect dUnion(const DRect &a, const DRect &b) {
+  return { std::min(a.x0, b.x0), std::min(a.y0, b.y0), std::max(a.x1, b.x1), std::max(a.y1, b.y1) };
+}
+static void damage(int x, int y, int w, int h) {
+  if (w <= 0 || h <= 0) return;
+  DRect r = { (int16_t)std::max(x, 0), (int16_t)std::max(y, 0),
+              (int16_t)std::min(x + w, W), (int16_t)std::min(y + h, H) };
+  if (r.x0 >= r.x1 || r.y0 >= r.y1) return;
+  for (;;) {
+    for (int i = 0; i < damageCount; ) {
+      const DRect u = dUnion(r, damageList[i]);
+      if (dOverlap(r, damageList[i]) || dArea(u) <= dArea(r) + dArea(damageList[i]) + DAMAGE_SLACK_PX) {
+        r = u;
+        damageList[i] = damageList[--damageCount];
+        i = 0;
+      } else {
+        ++i;
+      }
+    }
+    if (damageCount < MAX_DAMAGE) break;
+    int best = 0, bestGrow = INT32_MAX;
+    for (int i = 0; i < damageCount; ++i) {
+      const int grow = dArea(dUnion(r, damageList[i])) - dArea(damageList[i]);
+      if (grow < bestGrow) { bestGrow = grow; best = i; }
+    }
+    r = dUnion(r, damageList[best]);
+    damageList[best] = damageList[--damageCount];
+  }
+  damageList[damageCount++] = r;
+}
+
+// ---------- striscia del compositore ----------
+struct Tile {
+  int tx = 0, ty = 0, tw = 0, th = 0;
+  uint16_t buf[TILE_PX];
+  void fillPreclipped(int x, int y, int w, int h, uint16_t c) {
+    const int x0 = std::max(x, tx), y0 = std::max(y, ty);
+    const int x1 = std::min(x + w, tx + tw), y1 = std::min(y + h, ty + th);
+    for (int yy = y0; yy < y1; ++yy) {
+      uint16_t *p = &buf[(yy - ty) * tw + (x0 - tx)];
+      for (int xx = x0; xx < x1; ++xx) *p++ = c;
+    }
+  }
+  bool hits(int x, int y, int w, int h) const { return x < tx + tw && x + w > tx && y < ty + th && y + h > ty; }
+};
+static Tile tile;
+
+// Percorso di Arduino_GFX::fillRect: chiamata virtuale e clipping allo schermo
+struct Canvas {
+  virtual ~Canvas() {}
+  virtual void fillRect(int x, int y, int w, int h, uint16_t c) {
+    if (x >= W || y >= H || w <= 0 || h <= 0) return;
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > W) w = W - x;
+    if (y + h > H) h = H - y;
+    tile.fillPreclipped(x, y, w, h, c);
+  }
+};
+static Canvas *canvas = new Canvas();
+
+// ---------- vecchia versione (Pongino.ino prima di FxPool.h) ----------
+struct Particle {
+  float x, y, vx, vy;
+  uint8_t life;
+  uint16_t color;
+  bool alive;
+  int px, py;
+  uint8_t sz;
+  bool oobOnly;
+  bool behindPaddle;
+};
+static Particle particles[FX_MAX];
+static uint32_t oldRng = 1;
+static int oldRandom(int lo, int hi) {
+  if (hi <= lo) return lo;
+  oldRng = oldRng * 1664525u + 1013904223u;
+  return lo + (int)((oldRng >> 8) % (uint32_t)(hi - lo));
+}
+
+static int oldSpawn(int cx, int cy, int w, int h, uint16_t color, int count) {
+  int made = 0;
+  for (int n = 0; n <= count; ++n) {
+    int idx = -1;
+    for (int i = 0; i < FX_MAX; ++i) { if (!particles[i].alive) { idx = i; break; } }
+    if (idx < 0) break;
+    Particle &p = particles[idx];
+    const bool big = n == count;
+    p.alive = true;
+    p.x = cx + w/2 + oldRandom(big ? -w/4 : -w/2, big ? w/4 : w/2);
+    p.y = cy + h/2 + oldRandom(big ? -h/4 : -h/2, big ? h/4 : h/2);
+    const float angle = (float)oldRandom(0, 628) / 100.0f;
+    const float speed = big ? 1.2f + (float)oldRandom(0, 120)/100.0f : 1.0f + (float)oldRandom(0, 200)/100.0f;
+    p.vx = cosf(angle)*speed;
+    p.vy = sinf(angle)*speed - (big ? 0.3f : 0.35f);
+    p.oobOnly = true; p.behindPaddle = true;
+    p.life = 220;
+    p.color = big ? color : ((n % 3 == 0) ? color : (uint16_t)(color >> 1 & 0x7BEF));
+    p.sz = big ? 4 : (oldRandom(0, 10) == 0 ? 3 : 2);
+    p.px = (int)p.x; p.py = (int)p.y;
+    damage(p.px, p.py, p.sz, p.sz);
+    made++;
+  }
+  return made;
+}
+static int oldUpdate() {
+  int live = 0;
+  for (int i = 0; i < FX_MAX; ++i) {
+    Particle &p = particles[i];
+    if (!p.alive) continue;
+    p.vy += 0.08f;
+    p.x  += p.vx;
+    p.y  += p.vy;
+    const int ix = (int)p.x, iy = (int)p.y;
+    bool dead = false;
+    if (p.x < 0 || p.x >= W || p.y < 0 || p.y >= H) dead = true;
+    else if (!p.oobOnly) { if (p.life > 0) p.life--; else dead = true; }
+    if (dead) { damage(p.px, p.py, p.sz, p.sz); p.alive = false; continue; }
+    live++;
+    if (ix == p.px && iy == p.py) continue;
+    damage(p.px, p.py, p.sz, p.sz);
+    damage(ix, iy, p.sz, p.sz);
+    p.px = ix; p.py = iy;
+  }
+  return live;
+}
+static void oldDrawTile() {
+  for (int i = 0; i < FX_MAX; ++i) {
+    const Particle &p = particles[i];
+    if (!p.alive || !tile.hits(p.px, p.py, p.sz, p.sz)) continue;
+    canvas->fillRect(p.px, p.py, p.sz, p.sz, p.color);
+  }
+}
+
+// ---------- nuova versione ----------
+static FxPool fx;
+static void newSpawn(int cx, int cy, int w, int h, uint16_t color, int count) {
+  for (int n = 0; n < count; ++n) {
+    const int x = cx + w/2 + fx.rnd(-w/2, w/2);
+    const int y = cy + h/2 + fx.rnd(-h/2, h/2);
+    const int a = fx.rnd(0, 256);
+    const int speed = 256 + fx.rnd(0, 512);
+    const double ang = a * 2 * M_PI / 256;
+    if (!fx.spawn(x << FX_SHIFT, y << FX_SHIFT, (int)(cos(ang) * speed), (int)(sin(ang) * speed) - 90,
+                  220, (n % 3 == 0) ? color : (uint16_t)(color >> 1 & 0x7BEF), fx.rnd(0, 10) == 0 ? 3 : 2,
+                  FX_OOB_ONLY)) return;
+  }
+  const int x = cx + w/2 + fx.rnd(-w/4, w/4);
+  const int y = cy + h/2 + fx.rnd(-h/4, h/4);
+  const double ang = fx.rnd(0, 256) * 2 * M_PI / 256;
+  const int speed = 307 + fx.rnd(0, 307);
+  fx.spawn(x << FX_SHIFT, y << FX_SHIFT, (int)(cos(ang) * speed), (int)(sin(ang) * speed) - 77,
+           220, color, 4, FX_OOB_ONLY);
+}
+
+// ---------- misura ----------
+static const uint16_t COLORS[5] = { 0xF800, 0x07E0, 0x001F, 0xFFE0, 0xF81F };
+static uint32_t sceneRng = 7;
+static int sceneRandom(int lo, int hi) {
+  sceneRng = sceneRng * 1664525u + 1013904223u;
+  return lo + (int)((sceneRng >> 8) % (uint32_t)(hi - lo));
+}
+
+typedef std::chrono::steady_clock Clock;
+static inline double usSince(Clock::time_point t) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - t).count();
+}
+
+struct Result { double update, draw, rects, px, live; };
+
+template <class DrawTile>
+static void compose(DrawTile drawTile, Result &r) {
+  for (int i = 0; i < damageCount; ++i) {
+    const DRect &d = damageList[i];
+    const int w = d.x1 - d.x0;
+    const int bandH = std::max(1, TILE_PX / w);
+    for (int y = d.y0; y < d.y1; y += bandH) {
+      tile.tx = d.x0; tile.ty = y; tile.tw = w; tile.th = std::min(bandH, (int)d.y1 - y);
+      tile.fillPreclipped(tile.tx, tile.ty, tile.tw, tile.th, 0x0000);
+      drawTile();
+      r.px += tile.tw * tile.th;
+    }
+  }
+  r.rects += damageCount;
+  damageCount = 0;
+}
+
+static Result run(bool useNew, int target, int ticks) {
+  Result r = {}, warmup = {};
+  damageCount = 0;
+  fx.clear(); fx.rng = 1;
+  for (int i = 0; i < FX_MAX; ++i) particles[i].alive = false;
+  oldRng = 1; sceneRng = 7;
+  int live = 0;
+  const int warm = 200;
+  for (int t = 0; t < warm + ticks; ++t) {
+    Result &acc = t >= warm ? r : warmup;
+    auto t0 = Clock::now();
+    int spawned = 0;
+    while (live + spawned < target) {
+      const int bx = 4 + sceneRandom(0, 8) * 59, by = 60 + sceneRandom(0, 6) * 24;
+      const uint16_t c = COLORS[sceneRandom(0, 5)];
+      const int before = fx.n;
+      const int k = useNew ? (newSpawn(bx, by, 55, 20, c, 24), fx.n - before) : oldSpawn(bx, by, 55, 20, c, 24);
+      if (!k) break;
+      spawned += k;
+    }
+    if (useNew) { fx.update(); fx.flushDamage(damage); live = fx.n; }
+    else        { live = oldUpdate(); }
+    acc.update += usSince(t0);
+
+    auto t1 = Clock::now();
+    if (useNew) {
+      if (damageCount) fx.buildDrawList();
+      compose([] { fx.draw(tile.ty, tile.th, [](int x, int y, int w, int h, uint16_t c) { tile.fillPreclipped(x, y, w, h, c); }); }, acc);
+    } else {
+      compose(oldDrawTile, acc);
+    }
+    acc.draw += usSince(t1);
+    acc.live += live;
+  }
+  r.update /= ticks; r.draw /= ticks; r.rects /= ticks; r.px /= ticks; r.live /= ticks;
+  return r;
+}
+
+int main(int argc, char **argv) {
+  const int ticks = argc > 1 ? atoi(argv[1]) : 2000;
+  const int targets[] = { 160, 320, 640, 1280, 2560 };
+  printf("%-6s %-7s %9s %9s %9s %6s %8s\n", "vive", "", "update", "disegno", "totale", "rett", "px");
+  for (int target : targets) {
+    const Result o = run(false, target, ticks);
+    const Result n = run(true, target, ticks);
+    printf("%-6.0f %-7s %9.1f %9.1f %9.1f %6.1f %8.0f\n", o.live, "vecchio", o.update, o.draw, o.update + o.draw, o.rects, o.px);
+    printf("%-6.0f %-7s %9.1f %9.1f %9.1f %6.1f %8.0f\n", n.live, "nuovo", n.update, n.draw, n.update + n.draw, n.rects, n.px);
+  }
+  printf("(us per tick su questo PC, media su %d tick)\n", ticks);
+  return 0;
+}
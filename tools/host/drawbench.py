@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+"""
+drawbench.py – tabella di disegno per scenario, dalla build su PC degli sketch
+
+Uso (dalla radice del repo, dopo cmake --build build):
+  python3 tools/host/drawbench.py build                       # tutti gli scenari
+  python3 tools/host/drawbench.py build tools/host/scenari/pongino-replay.txt
+
+Per confrontare con una versione precedente degli sketch (stessi scenari, stesse controfigure):
+  git worktree add /tmp/prima <commit>
+  cmake -S . -B build-prima -DSKETCH_ROOT=/tmp/prima && cmake --build build-prima -j
+  python3 tools/host/drawbench.py build-prima
+
+Colonne (un frame è un giro di loop() che ha disegnato, vedi tools/host/main.cpp):
+  frame       giri che hanno disegnato
+  fill        rettangoli pieni e linee H/V per frame, media e massimo
+  bitmap      draw16bitRGBBitmap per frame, media e massimo
+  pixel       scritture di singolo pixel per frame, media
+  px          pixel spinti nel framebuffer per frame, media e massimo
+  us          microsecondi reali di questo PC per frame, media e massimo
+I contatori dipendono solo da sketch e scenario; gli us cambiano da PC a PC.
+"""
+import glob
+import os
+import re
+import subprocess
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+DRAW = re.compile(r"^\[HOST\] draw (.*)$", re.M)
+
+
+def run(build, scenario):
+    sketch = None
+    for line in open(scenario, encoding="utf-8"):
+        if line.startswith("sketch "):
+            sketch = line.split()[1]
+    exe = os.path.join(build, "host_%s" % sketch)
+    name = os.path.splitext(os.path.basename(scenario))[0]
+    if not sketch or not os.path.exists(exe):
+        return name, None
+    out = os.path.join(build, "scenari", name)
+    res = subprocess.run([exe, scenario, "-o", out], capture_output=True, text=True)
+    m = DRAW.search(res.stdout)
+    if not m:
+        sys.stderr.write("%s: nessun riepilogo (uscita %d)\n%s" % (name, res.returncode, res.stderr))
+        return name, None
+    return name, {k: int(v) for k, v in (kv.split("=") for kv in m.group(1).split())}
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+    build = sys.argv[1]
+    scenari = sys.argv[2:] or sorted(glob.glob(os.path.join(HERE, "scenari", "*.txt")))
+    print("%-22s %6s %12s %12s %7s %16s %12s" %
+          ("scenario", "frame", "fill", "bitmap", "pixel", "px", "us"))
+    for sc in scenari:
+        name, d = run(build, sc)
+        if d is None:
+            print("%-22s %6s" % (name, "-"))
+            continue
+        f = max(d["frames"], 1)
+        print("%-22s %6d %6.1f/%-5d %6.1f/%-5d %7.1f %8.0f/%-7d %5.0f/%-6d" %
+              (name, d["frames"], d["fill"] / f, d["maxfill"], d["bitmap"] / f, d["maxbitmap"],
+               d["pixel"] / f, d["px"] / f, d["maxpx"], d["us"] / f, d["maxus"]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,817 @@
+/*
+  host.cpp – il pannello simulato: scheduler, FreeRTOS, heap, SD, rete e NVS per gli sketch
+
+  Vedi include/Host.h per il modello. Qui le regole che contano per leggere i numeri:
+    - un task alla volta; si cambia solo nei punti bloccanti, a giro tra i pronti;
+    - la heap "interna" è un budget di 320 KB da cui si tolgono le malloc vive del processo
+      dopo heapBaseline() (chiamata da main.cpp subito prima di setup); le malloc del runtime
+      del PC prima di quel momento non contano;
+    - la PSRAM (ps_malloc, heap_caps SPIRAM, framebuffer) è un conto separato da 8 MB.
+*/
+#include "Arduino.h"
+#include "FS.h"
+#include "SD.h"
+#include "SPI.h"
+#include "Wire.h"
+#include "WiFi.h"
+#include "HTTPClient.h"
+#include "WebServer.h"
+#include "Preferences.h"
+#include "esp_sntp.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <malloc.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+extern "C" {
+void *__libc_malloc(size_t);
+void *__libc_calloc(size_t, size_t);
+void *__libc_realloc(void *, size_t);
+void *__libc_memalign(size_t, size_t);
+void  __libc_free(void *);
+}
+
+HardwareSerial Serial;
+EspClass ESP;
+TwoWire Wire;
+SPIClass SPI;
+fs::SDFS SD;
+WiFiClass WiFi;
+
+namespace host {
+
+bool cpuClock = false;
+uint64_t endUs = FOREVER;
+Counters draw;
+uint16_t *framebuffer = nullptr;
+int fbWidth = 0, fbHeight = 0;
+Touch touch;
+std::string sdRoot, wwwRoot, outDir;
+
+// =====================================================================
+// Orologio e scheduler
+// =====================================================================
+struct Task {
+  std::string name;
+  std::condition_variable cv;
+  uint64_t wakeAt = 0;                  // pronto da questo istante...
+  std::function<bool()> ready;          // ...o appena questo diventa vero
+  uint32_t notify = 0;
+  bool dead = false;
+};
+
+struct Timer { uint64_t at; uint32_t seq; std::function<void()> fn; };
+
+static std::mutex g_m;
+static std::vector<Task *> g_tasks;
+static Task *g_cur = nullptr;
+static std::vector<Timer> g_timers;     // pochi: lista ordinata per (at, seq)
+static uint32_t g_timerSeq = 0;
+static uint64_t g_simUs = 0;
+static std::chrono::steady_clock::time_point g_lastRun = std::chrono::steady_clock::now();
+
+static uint64_t cpuSinceRun() {
+  if (!cpuClock) return 0;
+  return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - g_lastRun).count();
+}
+
+uint64_t nowUs() { return g_simUs + cpuSinceRun(); }
+
+uint64_t wallUs() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void advanceUs(uint64_t us) { g_simUs += us; }
+
+void at(uint64_t us, std::function<void()> fn) {
+  std::lock_guard<std::mutex> lk(g_m);
+  Timer t{us, g_timerSeq++, std::move(fn)};
+  auto it = g_timers.begin();
+  while (it != g_timers.end() && it->at <= us) ++it;
+  g_timers.insert(it, std::move(t));
+}
+
+static Task *mainTask() {
+  static Task *t = [] {
+    Task *m = new Task;
+    m->name = "loopTask";
+    g_tasks.push_back(m);
+    g_cur = m;
+    return m;
+  }();
+  return t;
+}
+
+static bool runnable(Task *t) {
+  return !t->dead && (g_simUs >= t->wakeAt || (t->ready && t->ready()));
+}
+
+// Sceglie chi gira dopo `me` (che si è appena bloccato). Esegue gli eventi dello scenario
+// scaduti e, se nessuno è pronto, fa saltare l'orologio al primo risveglio.
+static Task *pick(Task *me, std::unique_lock<std::mutex> &lk) {
+  for (;;) {
+    while (!g_timers.empty() && g_timers.front().at <= g_simUs) {
+      auto fn = std::move(g_timers.front().fn);
+      g_timers.erase(g_timers.begin());
+      lk.unlock();
+      fn();
+      lk.lock();
+    }
+    if (g_simUs >= endUs) { lk.unlock(); finish("fine dello scenario"); }
+
+    const size_t n = g_tasks.size();
+    size_t self = 0;
+    while (self < n && g_tasks[self] != me) ++self;
+    for (size_t k = 1; k <= n; ++k) {
+      Task *t = g_tasks[(self + k) % n];
+      if (runnable(t)) return t;
+    }
+
+    uint64_t next = endUs;
+    for (Task *t : g_tasks) if (!t->dead && t->wakeAt < next) next = t->wakeAt;
+    if (!g_timers.empty() && g_timers.front().at < next) next = g_timers.front().at;
+    if (next == FOREVER) {
+      fprintf(stderr, "[HOST] stallo a %llu ms: tutti i task aspettano per sempre\n",
+              (unsigned long long)(g_simUs / 1000));
+      for (Task *t : g_tasks) if (!t->dead) fprintf(stderr, "[HOST]   %s\n", t->name.c_str());
+      lk.unlock();
+      finish("stallo");
+    }
+    g_simUs = next;
+  }
+}
+
+// Blocca il task corrente fino a wakeAt (o a ready()) e passa il turno
+static void block(uint64_t wakeAt, std::function<bool()> ready) {
+  std::unique_lock<std::mutex> lk(g_m);
+  Task *me = g_cur ? g_cur : mainTask();
+  g_simUs += cpuSinceRun();
+  me->wakeAt = wakeAt;
+  me->ready = std::move(ready);
+  Task *next = pick(me, lk);
+  if (next != me) {
+    g_cur = next;
+    next->cv.notify_one();
+    me->cv.wait(lk, [me] { return g_cur == me; });
+  }
+  me->ready = nullptr;
+  g_lastRun = std::chrono::steady_clock::now();
+}
+
+void sleepUs(uint64_t us) { block(us == FOREVER ? FOREVER : nowUs() + us, nullptr); }
+
+bool waitFor(const std::function<bool()> &ready, uint64_t timeoutUs) {
+  if (ready()) return true;
+  if (timeoutUs == 0) return false;
+  block(timeoutUs == FOREVER ? FOREVER : nowUs() + timeoutUs, ready);
+  return ready();
+}
+
+void *spawn(void (*fn)(void *), void *arg, const char *name) {
+  mainTask();
+  Task *t = new Task;
+  t->name = name ? name : "task";
+  {
+    std::lock_guard<std::mutex> lk(g_m);
+    t->wakeAt = g_simUs;
+    g_tasks.push_back(t);
+  }
+  std::thread([t, fn, arg] {
+    {
+      std::unique_lock<std::mutex> lk(g_m);
+      t->cv.wait(lk, [t] { return g_cur == t; });
+      g_lastRun = std::chrono::steady_clock::now();
+    }
+    fn(arg);
+    exitTask();                          // un task FreeRTOS non dovrebbe ritornare
+  }).detach();
+  return t;
+}
+
+void *currentTask() { return g_cur ? g_cur : mainTask(); }
+
+void exitTask() {
+  std::unique_lock<std::mutex> lk(g_m);
+  Task *me = g_cur;
+  me->dead = true;
+  Task *next = pick(me, lk);
+  g_cur = next;
+  next->cv.notify_one();
+  me->cv.wait(lk, [] { return false; });
+  abort();
+}
+
+static uint32_t &notifyOf(void *task) { return ((Task *)(task ? task : currentTask()))->notify; }
+
+// =====================================================================
+// Heap: malloc contate, PSRAM in una tabella a parte
+// =====================================================================
+static const size_t HEAP_SIZE = 320 * 1024;
+static const size_t PSRAM_SIZE = 8 * 1024 * 1024;
+static std::atomic<long long> g_live{0}, g_base{0}, g_maxLive{0}, g_mark{0}, g_markMax{0};
+static std::atomic<long long> g_psLive{0};
+
+static void countAlloc(void *p) {
+  if (!p) return;
+  long long v = g_live += (long long)malloc_usable_size(p);
+  long long m = g_maxLive.load();
+  while (v > m && !g_maxLive.compare_exchange_weak(m, v)) {}
+  m = g_markMax.load();
+  while (v > m && !g_markMax.compare_exchange_weak(m, v)) {}
+}
+
+// Puntatori PSRAM vivi: indirizzamento aperto, niente malloc (siamo dentro free)
+static const size_t PS_SLOTS = 4096;
+static void *g_psPtr[PS_SLOTS];
+static size_t g_psLen[PS_SLOTS];
+static std::mutex g_psM;
+
+static size_t psSlot(void *p) { return ((uintptr_t)p >> 4) * 2654435761u % PS_SLOTS; }
+
+static void psAdd(void *p, size_t n) {
+  std::lock_guard<std::mutex> lk(g_psM);
+  for (size_t i = psSlot(p), k = 0; k < PS_SLOTS; ++k, i = (i + 1) % PS_SLOTS)
+    if (!g_psPtr[i]) { g_psPtr[i] = p; g_psLen[i] = n; g_psLive += (long long)n; return; }
+  fprintf(stderr, "[HOST] tabella PSRAM piena\n");
+  abort();
+}
+
+// Toglie p dalla tabella (con spostamento all'indietro, niente lapidi); ritorna la
+// dimensione, 0 se non è PSRAM
+static size_t psTake(void *p) {
+  std::lock_guard<std::mutex> lk(g_psM);
+  size_t i = psSlot(p);
+  while (g_psPtr[i] && g_psPtr[i] != p) i = (i + 1) % PS_SLOTS;
+  if (!g_psPtr[i]) return 0;
+  const size_t n = g_psLen[i];
+  g_psLive -= (long long)n;
+  g_psPtr[i] = nullptr;
+  for (size_t j = (i + 1) % PS_SLOTS; g_psPtr[j]; j = (j + 1) % PS_SLOTS) {
+    const size_t k = psSlot(g_psPtr[j]);
+    const bool stays = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+    if (stays) continue;
+    g_psPtr[i] = g_psPtr[j]; g_psLen[i] = g_psLen[j];
+    g_psPtr[j] = nullptr;
+    i = j;
+  }
+  return n;
+}
+
+void *psramAlloc(size_t n, bool zero) {
+  if (n == 0) n = 1;
+  if ((size_t)g_psLive.load() + n > PSRAM_SIZE) return nullptr;
+  void *p = zero ? __libc_calloc(1, n) : __libc_malloc(n);
+  if (p) psAdd(p, n);
+  return p;
+}
+
+void *psramRealloc(void *p, size_t n) {
+  if (!p) return psramAlloc(n, false);
+  size_t old = psTake(p);
+  if (!old) return realloc(p, n);        // era in heap interna: resta lì
+  void *q = __libc_realloc(p, n);
+  psAdd(q ? q : p, q ? n : old);
+  return q;
+}
+
+size_t heapFree() {
+  long long used = g_live.load() - g_base.load();
+  return used >= (long long)HEAP_SIZE ? 0 : (size_t)((long long)HEAP_SIZE - (used > 0 ? used : 0));
+}
+size_t heapMinFree() {
+  long long used = g_maxLive.load() - g_base.load();
+  return used >= (long long)HEAP_SIZE ? 0 : (size_t)((long long)HEAP_SIZE - (used > 0 ? used : 0));
+}
+size_t heapPeak() {
+  long long used = g_maxLive.load() - g_base.load();
+  return used > 0 ? (size_t)used : 0;
+}
+size_t heapLargestFree() { return heapFree(); }   // niente frammentazione nel modello
+size_t psramFree() { return PSRAM_SIZE - (size_t)g_psLive.load(); }
+
+void heapBaseline() { g_base = g_live.load(); g_maxLive = g_live.load(); }
+void heapMark() { g_mark = g_live.load(); g_markMax = g_live.load(); }
+size_t heapPeakSinceMark() { return (size_t)(g_markMax.load() - g_mark.load()); }
+
+}  // namespace host
+
+extern "C" {
+void *malloc(size_t n) {
+  void *p = __libc_malloc(n);
+  host::countAlloc(p);
+  return p;
+}
+void *calloc(size_t a, size_t n) {
+  void *p = __libc_calloc(a, n);
+  host::countAlloc(p);
+  return p;
+}
+void free(void *p) {
+  if (!p) return;
+  if (!host::psTake(p)) host::g_live -= (long long)malloc_usable_size(p);
+  __libc_free(p);
+}
+void *realloc(void *p, size_t n) {
+  if (!p) return malloc(n);
+  if (host::psTake(p)) {                 // realloc su un blocco PSRAM: resta in PSRAM
+    void *q = __libc_realloc(p, n);
+    host::psAdd(q ? q : p, n);
+    return q;
+  }
+  long long old = (long long)malloc_usable_size(p);
+  void *q = __libc_realloc(p, n);
+  if (q) { host::g_live -= old; host::countAlloc(q); }
+  return q;
+}
+void *memalign(size_t al, size_t n) {
+  void *p = __libc_memalign(al, n);
+  host::countAlloc(p);
+  return p;
+}
+void *aligned_alloc(size_t al, size_t n) { return memalign(al, n); }
+int posix_memalign(void **out, size_t al, size_t n) {
+  void *p = memalign(al, n);
+  if (!p) return 12;                     // ENOMEM
+  *out = p;
+  return 0;
+}
+}
+
+namespace host {
+
+// =====================================================================
+// Serial: buffer fisso, così le righe dello scenario non pesano sulla heap
+// =====================================================================
+static char g_rx[1 << 18];
+static size_t g_rxHead = 0, g_rxTail = 0;
+
+void serialFeed(const std::string &bytes) {
+  for (char c : bytes) {
+    size_t nx = (g_rxTail + 1) % sizeof(g_rx);
+    if (nx == g_rxHead) break;
+    g_rx[g_rxTail] = c;
+    g_rxTail = nx;
+  }
+}
+int serialAvailable() { return (int)((g_rxTail + sizeof(g_rx) - g_rxHead) % sizeof(g_rx)); }
+int serialPeek() { return g_rxHead == g_rxTail ? -1 : (uint8_t)g_rx[g_rxHead]; }
+int serialRead() {
+  int c = serialPeek();
+  if (c >= 0) g_rxHead = (g_rxHead + 1) % sizeof(g_rx);
+  return c;
+}
+
+// =====================================================================
+// Rete: Wi-Fi a eventi, SNTP, ora
+// =====================================================================
+static const uint64_t WIFI_CONNECT_US = 1200 * 1000;   // da begin a GOT_IP
+static const uint64_t NTP_SYNC_US = 300 * 1000;        // da configTime alla prima risposta
+static bool g_netOn = true, g_staWanted = false, g_staUp = false, g_synced = false;
+static uint32_t g_staGen = 0;
+static int64_t g_epoch = 1768471680;                   // 2026-01-15 10:08:00 UTC
+static uint64_t g_syncUs = 0;
+static sntp_sync_time_cb_t g_sntpCb = nullptr;
+
+static void staConnectLater() {
+  const uint32_t gen = ++g_staGen;
+  at(nowUs() + WIFI_CONNECT_US, [gen] {
+    if (gen != g_staGen || !g_netOn || !g_staWanted || g_staUp) return;
+    g_staUp = true;
+    WiFi.fire(ARDUINO_EVENT_WIFI_STA_CONNECTED);
+    WiFi.fire(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+  });
+}
+
+void wifiSet(bool on) {
+  g_netOn = on;
+  if (!on && g_staUp) {
+    g_staUp = false;
+    WiFi.fire(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+  } else if (on && g_staWanted && !g_staUp) {
+    staConnectLater();                   // autoreconnect del core
+  }
+}
+bool wifiUp() { return g_staUp; }
+void wifiBegin(const char *ssid) {
+  g_staWanted = ssid && *ssid;
+  if (g_staWanted && g_netOn && !g_staUp) staConnectLater();
+}
+
+void ntpStart() {
+  at(nowUs() + NTP_SYNC_US, [] {
+    if (!g_staUp) return;
+    if (!g_synced) g_syncUs = g_simUs;
+    g_synced = true;
+    struct timeval tv = {(time_t)epochNow(), 0};
+    if (g_sntpCb) g_sntpCb(&tv);
+  });
+}
+
+void setEpoch(int64_t epoch) { g_epoch = epoch; }
+int64_t epochNow() {
+  // Prima della sincronizzazione il core conta i secondi dall'accensione
+  return g_synced ? g_epoch + (int64_t)((nowUs() - g_syncUs) / 1000000) : (int64_t)(nowUs() / 1000000);
+}
+
+// =====================================================================
+// WebServer e NVS
+// =====================================================================
+static std::deque<WebRequest> g_web;
+void queueWebRequest(const WebRequest &r) { g_web.push_back(r); }
+bool takeWebRequest(WebRequest &r) {
+  if (g_web.empty()) return false;
+  r = std::move(g_web.front());
+  g_web.pop_front();
+  return true;
+}
+
+static std::map<std::string, std::map<std::string, std::string>> g_nvs;
+void nvsSet(const std::string &ns, const std::string &key, const std::string &value) { g_nvs[ns][key] = value; }
+
+// =====================================================================
+// random: xorshift32, ripetibile tra una corsa e l'altra
+// =====================================================================
+static uint32_t g_rng = 0x2545F491u;
+
+}  // namespace host
+
+extern "C" time_t time(time_t *t) __THROW {
+  time_t v = (time_t)host::epochNow();
+  if (t) *t = v;
+  return v;
+}
+
+uint32_t esp_random() {
+  uint32_t x = host::g_rng;
+  x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+  return host::g_rng = x;
+}
+void randomSeed(unsigned long seed) { if (seed) host::g_rng = (uint32_t)seed; }
+long random(long howbig) {
+  if (howbig <= 0) return 0;
+  return (long)(esp_random() % (uint32_t)howbig);
+}
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) return howsmall;
+  return random(howbig - howsmall) + howsmall;
+}
+
+size_t Print::printf(const char *fmt, ...) {
+  char loc[256];
+  va_list ap;
+  va_start(ap, fmt);
+  int n = vsnprintf(loc, sizeof(loc), fmt, ap);
+  va_end(ap);
+  if (n < 0) return 0;
+  if ((size_t)n < sizeof(loc)) return write((const uint8_t *)loc, (size_t)n);
+  std::vector<char> big((size_t)n + 1);
+  va_start(ap, fmt);
+  vsnprintf(big.data(), big.size(), fmt, ap);
+  va_end(ap);
+  return write((const uint8_t *)big.data(), (size_t)n);
+}
+
+void EspClass::restart() {
+  fflush(stdout);
+  host::finish("ESP.restart()");
+}
+
+// ---------- ora ----------
+static void setTimeZone(long offset, int daylight) {
+  // Come esp32-hal-time.c: "UTC-1" e, con l'ora legale, il suffisso DST
+  char tz[40];
+  if (offset % 3600)
+    snprintf(tz, sizeof(tz), "UTC%ld:%02u:%02u%s", offset / 3600, (unsigned)abs((int)(offset % 3600) / 60),
+             (unsigned)abs((int)(offset % 60)), daylight ? "DST" : "");
+  else
+    snprintf(tz, sizeof(tz), "UTC%ld%s", offset / 3600, daylight ? "DST" : "");
+  setenv("TZ", tz, 1);
+  tzset();
+}
+
+void configTime(long gmtOffset_sec, int daylightOffset_sec, const char *, const char *, const char *) {
+  setTimeZone(-gmtOffset_sec, daylightOffset_sec);
+  host::ntpStart();
+}
+void configTzTime(const char *tz, const char *, const char *, const char *) {
+  setenv("TZ", tz, 1);
+  tzset();
+  host::ntpStart();
+}
+bool getLocalTime(struct tm *info, uint32_t ms) {
+  if (!host::waitFor([] { return host::g_synced; }, (uint64_t)ms * 1000)) return false;
+  time_t now = time(nullptr);
+  localtime_r(&now, info);
+  return true;
+}
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t cb) { host::g_sntpCb = cb; }
+sntp_sync_status_t sntp_get_sync_status(void) {
+  return host::g_synced ? SNTP_SYNC_STATUS_COMPLETED : SNTP_SYNC_STATUS_RESET;
+}
+
+// ---------- WiFi ----------
+wifi_event_id_t WiFiClass::onEvent(WiFiEventCb cb, arduino_event_id_t ev) {
+  _cbs.push_back([cb, ev](arduino_event_id_t e, WiFiEventInfo_t) { if (ev == ARDUINO_EVENT_MAX || ev == e) cb(e); });
+  return _cbs.size();
+}
+wifi_event_id_t WiFiClass::onEvent(WiFiEventFuncCb cb, arduino_event_id_t ev) {
+  _cbs.push_back([cb, ev](arduino_event_id_t e, WiFiEventInfo_t i) { if (ev == ARDUINO_EVENT_MAX || ev == e) cb(e, i); });
+  return _cbs.size();
+}
+wifi_event_id_t WiFiClass::onEvent(WiFiEventSysCb cb, arduino_event_id_t ev) {
+  _cbs.push_back([cb, ev](arduino_event_id_t e, WiFiEventInfo_t i) { if (ev == ARDUINO_EVENT_MAX || ev == e) cb(e, i); });
+  return _cbs.size();
+}
+wl_status_t WiFiClass::begin(const char *ssid, const char *) {
+  _ssid = ssid ? ssid : "";
+  _sta = !_ssid.empty();
+  if (_mode == WIFI_OFF) _mode = WIFI_STA;
+  host::wifiBegin(_ssid.c_str());
+  return WL_DISCONNECTED;
+}
+void WiFiClass::fire(arduino_event_id_t e) {
+  WiFiEventInfo_t info = {0};
+  for (auto &cb : _cbs) cb(e, info);
+}
+
+// ---------- FreeRTOS ----------
+struct HostSemaphore { int count, max; };
+struct HostQueue { uint8_t *buf; size_t len, item, head, count; };
+
+static uint64_t ticksUs(TickType_t t) { return t == portMAX_DELAY ? host::FOREVER : (uint64_t)t * 1000; }
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t, void *arg, UBaseType_t,
+                                   TaskHandle_t *handle, BaseType_t) {
+  void *t = host::spawn(fn, arg, name);
+  if (handle) *handle = t;
+  return pdPASS;
+}
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg, UBaseType_t prio,
+                       TaskHandle_t *handle) {
+  return xTaskCreatePinnedToCore(fn, name, stack, arg, prio, handle, tskNO_AFFINITY);
+}
+void vTaskDelete(TaskHandle_t task) {
+  if (!task || task == host::currentTask()) host::exitTask();
+  ((host::Task *)task)->dead = true;
+}
+void vTaskDelay(TickType_t ticks) { host::sleepUs((uint64_t)ticks * 1000); }
+TickType_t xTaskGetTickCount() { return (TickType_t)(host::nowUs() / 1000); }
+TaskHandle_t xTaskGetCurrentTaskHandle() { return host::currentTask(); }
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+  uint32_t &n = host::notifyOf(nullptr);
+  if (!host::waitFor([&n] { return n > 0; }, ticksUs(ticks))) return 0;
+  uint32_t v = n;
+  n = clearOnExit ? 0 : n - 1;
+  return v;
+}
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  host::notifyOf(task)++;
+  return pdPASS;
+}
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t) { return 0; }   // non misurabile qui
+BaseType_t xPortGetCoreID() { return 1; }
+
+SemaphoreHandle_t xSemaphoreCreateMutex() { return new HostSemaphore{1, 1}; }
+SemaphoreHandle_t xSemaphoreCreateBinary() { return new HostSemaphore{0, 1}; }
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks) {
+  if (!host::waitFor([s] { return s->count > 0; }, ticksUs(ticks))) return pdFALSE;
+  s->count--;
+  return pdTRUE;
+}
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+  if (s->count >= s->max) return pdFALSE;
+  s->count++;
+  return pdTRUE;
+}
+void vSemaphoreDelete(SemaphoreHandle_t s) { delete s; }
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+  // Come FreeRTOS: un blocco solo, struttura e spazio per gli elementi
+  uint8_t *mem = (uint8_t *)malloc(sizeof(HostQueue) + (size_t)length * itemSize);
+  if (!mem) return nullptr;
+  return new (mem) HostQueue{mem + sizeof(HostQueue), length, itemSize, 0, 0};
+}
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t ticks) {
+  if (!host::waitFor([q] { return q->count < q->len; }, ticksUs(ticks))) return pdFALSE;
+  memcpy(q->buf + ((q->head + q->count) % q->len) * q->item, item, q->item);
+  q->count++;
+  return pdTRUE;
+}
+BaseType_t xQueueSendToBack(QueueHandle_t q, const void *item, TickType_t ticks) { return xQueueSend(q, item, ticks); }
+BaseType_t xQueueOverwrite(QueueHandle_t q, const void *item) {
+  q->head = 0;
+  q->count = 0;
+  return xQueueSend(q, item, 0);
+}
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks) {
+  if (!host::waitFor([q] { return q->count > 0; }, ticksUs(ticks))) return pdFALSE;
+  memcpy(item, q->buf + q->head * q->item, q->item);
+  q->head = (q->head + 1) % q->len;
+  q->count--;
+  return pdTRUE;
+}
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) { return (UBaseType_t)q->count; }
+BaseType_t xQueueReset(QueueHandle_t q) {
+  q->head = q->count = 0;
+  return pdPASS;
+}
+
+// ---------- SD ----------
+namespace fs {
+
+static std::string full(const char *path) { return host::sdRoot + (path[0] == '/' ? "" : "/") + path; }
+
+File FS::open(const char *path, const char *mode, bool) {
+  if (!_mounted || !path) return File();
+  const std::string f = full(path);
+  auto p = std::make_shared<FileImpl>();
+  p->path = path;
+  struct stat st;
+  if (!strcmp(mode, FILE_READ) && stat(f.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+    p->dir = true;
+    if (DIR *d = opendir(f.c_str())) {
+      while (struct dirent *e = readdir(d))
+        if (strcmp(e->d_name, ".") && strcmp(e->d_name, "..")) p->entries.push_back(e->d_name);
+      closedir(d);
+    }
+    std::sort(p->entries.begin(), p->entries.end());
+    return File(p);
+  }
+  const char *m = !strcmp(mode, FILE_WRITE) ? "wb" : !strcmp(mode, FILE_APPEND) ? "ab" : "rb";
+  p->fp = fopen(f.c_str(), m);
+  return p->fp ? File(p) : File();
+}
+bool FS::exists(const char *path) {
+  struct stat st;
+  return _mounted && stat(full(path).c_str(), &st) == 0;
+}
+bool FS::remove(const char *path) { return _mounted && unlink(full(path).c_str()) == 0; }
+bool FS::rename(const char *from, const char *to) {
+  return _mounted && ::rename(full(from).c_str(), full(to).c_str()) == 0;
+}
+bool FS::mkdir(const char *path) { return _mounted && ::mkdir(full(path).c_str(), 0755) == 0; }
+bool FS::rmdir(const char *path) { return _mounted && ::rmdir(full(path).c_str()) == 0; }
+
+File File::openNextFile(const char *mode) {
+  if (!_p || !_p->dir || _p->next >= _p->entries.size()) return File();
+  std::string child = _p->path;
+  if (child.empty() || child.back() != '/') child += '/';
+  child += _p->entries[_p->next++];
+  return SD.open(child.c_str(), mode);
+}
+
+bool SDFS::begin(uint8_t, SPIClass &, uint32_t, const char *, uint8_t, bool) {
+  struct stat st;
+  _mounted = !host::sdRoot.empty() && stat(host::sdRoot.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+  return _mounted;
+}
+
+}  // namespace fs
+
+// ---------- HTTPClient ----------
+// dir finisce con "/": ci accoda il primo index.* in ordine alfabetico, false se non c'è
+static bool wwwIndex(char *dir, size_t n) {
+  DIR *d = opendir(dir);
+  if (!d) return false;
+  std::string best;
+  while (dirent *e = readdir(d))
+    if (!strncmp(e->d_name, "index.", 6) && (best.empty() || best > e->d_name)) best = e->d_name;
+  closedir(d);
+  const size_t len = strlen(dir);
+  if (best.empty() || len + best.size() >= n) return false;
+  memcpy(dir + len, best.c_str(), best.size() + 1);
+  return true;
+}
+
+int HTTPClient::GET() {
+  if (!host::wifiUp() || host::wwwRoot.empty()) return HTTPC_ERROR_CONNECTION_REFUSED;
+  host::sleepUs(1000);                   // un giro agli altri task, come l'attesa del socket
+  const char *u = strstr(_url, "://");
+  u = u ? u + 3 : _url;
+  const char *slash = strchr(u, '/');
+  char hostName[128], path[384];
+  snprintf(hostName, sizeof(hostName), "%.*s", (int)(slash ? slash - u : (long)strlen(u)), u);
+  snprintf(path, sizeof(path), "%s", slash ? slash : "/");
+  if (char *q = strchr(path, '?')) *q = 0;
+  if (char *c = strchr(hostName, ':')) *c = 0;
+
+  char file[PATH_MAX];
+  snprintf(file, sizeof(file), "%s/%s%s", host::wwwRoot.c_str(), hostName, path);
+  if (path[strlen(path) - 1] == '/') wwwIndex(file, sizeof(file));
+  if (!_body.open(file)) {
+    const char *base = strrchr(path, '/');
+    snprintf(file, sizeof(file), "%s/%s", host::wwwRoot.c_str(), base && base[1] ? base + 1 : "index.html");
+    if (!_body.open(file)) return HTTP_CODE_NOT_FOUND;
+  }
+
+  uint32_t h = 2166136261u;              // ETag: FNV-1a del file
+  uint8_t chunk[1460];
+  for (int n; (n = _body.read(chunk, sizeof(chunk))) > 0;)
+    for (int i = 0; i < n; ++i) { h ^= chunk[i]; h *= 16777619u; }
+  _body.open(file);
+  snprintf(_etag, sizeof(_etag), "\"%08x\"", h);
+  if (_ifNoneMatch[0] && !strcmp(_ifNoneMatch, _etag)) {
+    _body.stop();
+    return HTTP_CODE_NOT_MODIFIED;
+  }
+
+  const char *ext = strrchr(file, '.');
+  const char *type = "application/octet-stream";
+  if (ext && (!strcasecmp(ext, ".xml") || !strcasecmp(ext, ".rss"))) type = "application/rss+xml";
+  else if (ext && !strcasecmp(ext, ".json")) type = "application/json";
+  else if (ext && (!strcasecmp(ext, ".jpg") || !strcasecmp(ext, ".jpeg"))) type = "image/jpeg";
+  else if (ext && !strcasecmp(ext, ".html")) type = "text/html";
+  strlcpy(_ctype, type, sizeof(_ctype));
+  _size = (int)_body.size();
+  return HTTP_CODE_OK;
+}
+
+// ---------- WebServer ----------
+static std::string urlDecode(const std::string &s) {
+  std::string r;
+  for (size_t i = 0; i < s.size(); ++i) {
+    if (s[i] == '+') r += ' ';
+    else if (s[i] == '%' && i + 2 < s.size()) { r += (char)strtol(s.substr(i + 1, 2).c_str(), nullptr, 16); i += 2; }
+    else r += s[i];
+  }
+  return r;
+}
+
+static void parseArgs(const std::string &q, std::vector<std::pair<std::string, std::string>> &out) {
+  size_t p = 0;
+  while (p < q.size()) {
+    size_t e = q.find('&', p);
+    if (e == std::string::npos) e = q.size();
+    std::string kv = q.substr(p, e - p);
+    size_t eq = kv.find('=');
+    if (!kv.empty())
+      out.push_back({urlDecode(kv.substr(0, eq)), eq == std::string::npos ? "" : urlDecode(kv.substr(eq + 1))});
+    p = e + 1;
+  }
+}
+
+void WebServer::handleClient() {
+  host::WebRequest r;
+  if (!_begun || !host::takeWebRequest(r)) return;
+  _method = r.method == "POST" ? HTTP_POST : HTTP_GET;
+  size_t qm = r.uri.find('?');
+  _uri = r.uri.substr(0, qm);
+  _args.clear();
+  if (qm != std::string::npos) parseArgs(r.uri.substr(qm + 1), _args);
+  if (!r.body.empty()) parseArgs(r.body, _args);
+  _bytes = 0;
+  _code = 0;
+  _contentLength = CONTENT_LENGTH_NOT_SET;
+
+  host::heapMark();
+  bool served = false;
+  for (auto &rt : _routes)
+    if (rt.uri == _uri && (rt.method == HTTP_ANY || rt.method == _method)) { rt.fn(); served = true; break; }
+  if (!served) {
+    if (_notFound) _notFound();
+    else send(404, "text/plain", "Not found");
+  }
+  printf("[HOST] %s %s: %d, %zu byte, picco heap %zu\n", r.method.c_str(), r.uri.c_str(), _code, _bytes,
+         host::heapPeakSinceMark());
+}
+
+// ---------- Preferences ----------
+bool Preferences::begin(const char *name, bool readOnly) {
+  _ns = name ? name : "";
+  _ro = readOnly;
+  return !_ns.empty();
+}
+bool Preferences::clear() {
+  if (_ro) return false;
+  host::g_nvs.erase(_ns);
+  return true;
+}
+bool Preferences::remove(const char *key) { return !_ro && host::g_nvs[_ns].erase(key) > 0; }
+bool Preferences::isKey(const char *key) {
+  auto ns = host::g_nvs.find(_ns);
+  return ns != host::g_nvs.end() && ns->second.count(key);
+}
+size_t Preferences::putString(const char *key, const char *value) {
+  if (_ro || _ns.empty()) return 0;
+  host::g_nvs[_ns][key] = value;
+  return strlen(value);
+}
+String Preferences::getString(const char *key, const String &def) {
+  return isKey(key) ? String(host::g_nvs[_ns][key]) : def;
+}
+size_t Preferences::getString(const char *key, char *value, size_t maxLen) {
+  if (!isKey(key) || !maxLen) return 0;
+  return strlcpy(value, host::g_nvs[_ns][key].c_str(), maxLen) + 1;
+}
@@ -0,0 +1,360 @@
+/*
+  Arduino.h – controfigura del core ESP32 2.0.x per la build su PC (tools/host)
+
+  Solo quello che usano gli sketch del repo. Tempo, heap e Serial passano da Host.h:
+  millis/micros sono l'orologio simulato, ESP.getFreeHeap conta le malloc vere del processo.
+  String è costruita su std::string: stesse API, ma le allocazioni non sono quelle del core
+  (niente crescita a raddoppi di WString), quindi i picchi di heap sono indicativi.
+*/
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <ctype.h>
+#include <time.h>
+#include <sys/time.h>
+#include <algorithm>
+#include <string>
+
+#include "Host.h"
+
+using std::min;
+using std::max;
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PROGMEM
+#define IRAM_ATTR
+#define F(x) (x)
+#define PSTR(x) (x)
+#define FPSTR(x) (x)
+typedef const char *PGM_P;
+#define pgm_read_byte(a) (*(const uint8_t *)(a))
+#define pgm_read_word(a) (*(const uint16_t *)(a))
+#define pgm_read_dword(a) (*(const uint32_t *)(a))
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define A0 1
+#define DEC 10
+#define HEX 16
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+#define sq(x) ((x) * (x))
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+inline uint32_t millis() { return (uint32_t)(host::nowUs() / 1000); }
+inline uint32_t micros() { return (uint32_t)host::nowUs(); }
+inline void delay(uint32_t ms) { host::sleepUs((uint64_t)ms * 1000); }
+inline void delayMicroseconds(uint32_t us) { host::advanceUs(us); }
+inline void yield() { host::sleepUs(0); }
+inline int64_t esp_timer_get_time() { return (int64_t)host::nowUs(); }
+// Orologio reale per DrawStats.h: la CMakeLists lo passa come DS_CLOCK_US
+inline uint32_t hostWallMicros() { return (uint32_t)host::wallUs(); }
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+uint32_t esp_random();
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return LOW; }
+inline uint16_t analogRead(uint8_t) { return 0; }
+inline double ledcSetup(uint8_t, double freq, uint8_t) { return freq; }
+inline void ledcAttachPin(uint8_t, uint8_t) {}
+inline void ledcWrite(uint8_t, uint32_t) {}
+
+// ---------- String ----------
+class String {
+  std::string s;
+public:
+  String() {}
+  String(const char *c) : s(c ? c : "") {}
+  String(const std::string &x) : s(x) {}
+  explicit String(char c) : s(1, c) {}
+  String(int v, unsigned char base = 10) { num((long)v, base); }
+  String(unsigned v, unsigned char base = 10) { unum(v, base); }
+  String(long v, unsigned char base = 10) { num(v, base); }
+  String(unsigned long v, unsigned char base = 10) { unum(v, base); }
+  String(long long v) : s(std::to_string(v)) {}
+  String(unsigned long long v) : s(std::to_string(v)) {}
+  String(float v, unsigned char d = 2) { fnum(v, d); }
+  String(double v, unsigned char d = 2) { fnum(v, d); }
+
+  unsigned length() const { return (unsigned)s.size(); }
+  const char *c_str() const { return s.c_str(); }
+  bool reserve(unsigned n) { s.reserve(n); return true; }
+  bool isEmpty() const { return s.empty(); }
+  char operator[](unsigned i) const { return i < s.size() ? s[i] : 0; }
+  char &operator[](unsigned i) { return s[i]; }
+  char charAt(unsigned i) const { return (*this)[i]; }
+  void setCharAt(unsigned i, char c) { if (i < s.size()) s[i] = c; }
+
+  String &operator+=(const String &o) { s += o.s; return *this; }
+  String &operator+=(const char *o) { if (o) s += o; return *this; }
+  String &operator+=(char c) { s += c; return *this; }
+  String &operator+=(int v) { s += std::to_string(v); return *this; }
+  String &operator+=(unsigned v) { s += std::to_string(v); return *this; }
+  String &operator+=(long v) { s += std::to_string(v); return *this; }
+  String &operator+=(unsigned long v) { s += std::to_string(v); return *this; }
+  bool concat(const String &o) { s += o.s; return true; }
+  bool concat(const char *o) { if (o) s += o; return true; }
+  bool concat(const char *o, unsigned n) { s.append(o, n); return true; }
+  bool concat(char c) { s += c; return true; }
+  bool concat(int v) { s += std::to_string(v); return true; }
+  bool concat(unsigned v) { s += std::to_string(v); return true; }
+  bool concat(long v) { s += std::to_string(v); return true; }
+  bool concat(unsigned long v) { s += std::to_string(v); return true; }
+
+  friend String operator+(const String &a, const String &b) { return String(a.s + b.s); }
+  friend String operator+(const String &a, const char *b) { return String(a.s + (b ? b : "")); }
+  friend String operator+(const char *a, const String &b) { return String(std::string(a ? a : "") + b.s); }
+  friend String operator+(const String &a, char b) { return String(a.s + b); }
+  friend String operator+(const String &a, int b) { return a + String(b); }
+  friend String operator+(const String &a, unsigned b) { return a + String(b); }
+  friend String operator+(const String &a, long b) { return a + String(b); }
+  friend String operator+(const String &a, unsigned long b) { return a + String(b); }
+  friend String operator+(const String &a, float b) { return a + String(b); }
+  friend String operator+(const String &a, double b) { return a + String(b); }
+  // Come StringSumHelper: una catena "a" + s + "b" + ... accoda allo stesso buffer
+  friend String operator+(String &&a, const String &b) { a.s += b.s; return std::move(a); }
+  friend String operator+(String &&a, const char *b) { if (b) a.s += b; return std::move(a); }
+  friend String operator+(String &&a, char b) { a.s += b; return std::move(a); }
+  friend String operator+(String &&a, int b) { a.s += String(b).s; return std::move(a); }
+  friend String operator+(String &&a, unsigned b) { a.s += String(b).s; return std::move(a); }
+  friend String operator+(String &&a, long b) { a.s += String(b).s; return std::move(a); }
+  friend String operator+(String &&a, unsigned long b) { a.s += String(b).s; return std::move(a); }
+  friend String operator+(String &&a, float b) { a.s += String(b).s; return std::move(a); }
+  friend String operator+(String &&a, double b) { a.s += String(b).s; return std::move(a); }
+
+  bool operator==(const String &o) const { return s == o.s; }
+  bool operator==(const char *o) const { return s == (o ? o : ""); }
+  bool operator!=(const String &o) const { return s != o.s; }
+  bool operator!=(const char *o) const { return !(*this == o); }
+  bool operator<(const String &o) const { return s < o.s; }
+  bool equals(const String &o) const { return s == o.s; }
+  bool equalsIgnoreCase(const String &o) const { return strcasecmp(s.c_str(), o.s.c_str()) == 0; }
+  int compareTo(const String &o) const { return s.compare(o.s); }
+  bool startsWith(const String &p) const { return s.compare(0, p.s.size(), p.s) == 0; }
+  bool endsWith(const String &p) const {
+    return s.size() >= p.s.size() && s.compare(s.size() - p.s.size(), p.s.size(), p.s) == 0;
+  }
+
+  int indexOf(char c, unsigned from = 0) const { return pos(s.find(c, from)); }
+  int indexOf(const String &c, unsigned from = 0) const { return pos(s.find(c.s, from)); }
+  int indexOf(const char *c, unsigned from = 0) const { return pos(s.find(c, from)); }
+  int lastIndexOf(char c) const { return pos(s.rfind(c)); }
+  int lastIndexOf(const String &c) const { return pos(s.rfind(c.s)); }
+  String substring(unsigned a) const { return a >= s.size() ? String() : String(s.substr(a)); }
+  String substring(unsigned a, unsigned b) const {
+    if (a > b) std::swap(a, b);
+    if (a >= s.size()) return String();
+    return String(s.substr(a, std::min<size_t>(b, s.size()) - a));
+  }
+  void replace(const String &f, const String &r) {
+    if (f.s.empty()) return;
+    for (size_t p = 0; (p = s.find(f.s, p)) != std::string::npos; p += r.s.size()) s.replace(p, f.s.size(), r.s);
+  }
+  void replace(char f, char r) { for (auto &c : s) if (c == f) c = r; }
+  void remove(unsigned i) { if (i < s.size()) s.erase(i); }
+  void remove(unsigned i, unsigned n) { if (i < s.size()) s.erase(i, n); }
+  void trim() {
+    size_t a = s.find_first_not_of(" \t\r\n\f\v");
+    if (a == std::string::npos) { s.clear(); return; }
+    s = s.substr(a, s.find_last_not_of(" \t\r\n\f\v") - a + 1);
+  }
+  void toLowerCase() { for (auto &c : s) c = (char)tolower((unsigned char)c); }
+  void toUpperCase() { for (auto &c : s) c = (char)toupper((unsigned char)c); }
+  long toInt() const { return atol(s.c_str()); }
+  float toFloat() const { return (float)atof(s.c_str()); }
+  void toCharArray(char *buf, unsigned n, unsigned index = 0) const {
+    if (!n) return;
+    std::string t = index < s.size() ? s.substr(index) : std::string();
+    strncpy(buf, t.c_str(), n - 1);
+    buf[n - 1] = 0;
+  }
+  void getBytes(unsigned char *buf, unsigned n) const { toCharArray((char *)buf, n); }
+
+private:
+  static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+  void num(long v, unsigned char base) {
+    char b[40];
+    if (base == 16) snprintf(b, sizeof(b), "%lx", v);
+    else snprintf(b, sizeof(b), "%ld", v);
+    s = b;
+  }
+  void unum(unsigned long v, unsigned char base) {
+    char b[40];
+    if (base == 16) snprintf(b, sizeof(b), "%lx", v);
+    else snprintf(b, sizeof(b), "%lu", v);
+    s = b;
+  }
+  void fnum(double v, unsigned char d) {
+    char b[64];
+    snprintf(b, sizeof(b), "%.*f", d, v);
+    s = b;
+  }
+};
+
+// ---------- Print / Stream ----------
+class Print;
+class Printable {
+public:
+  virtual ~Printable() {}
+  virtual size_t printTo(Print &p) const = 0;
+};
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *b, size_t n) {
+    size_t k = 0;
+    while (k < n && write(b[k])) k++;
+    return k;
+  }
+  size_t write(const char *s) { return s ? write((const uint8_t *)s, strlen(s)) : 0; }
+  size_t write(const char *s, size_t n) { return write((const uint8_t *)s, n); }
+  size_t print(const String &s) { return write((const uint8_t *)s.c_str(), s.length()); }
+  size_t print(const char *s) { return write(s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(unsigned char v, int base = DEC) { return print(String((unsigned)v, base)); }
+  size_t print(int v, int base = DEC) { return print(String(v, base)); }
+  size_t print(unsigned v, int base = DEC) { return print(String(v, base)); }
+  size_t print(long v, int base = DEC) { return print(String(v, base)); }
+  size_t print(unsigned long v, int base = DEC) { return print(String(v, base)); }
+  size_t print(long long v) { return print(String(v)); }
+  size_t print(unsigned long long v) { return print(String(v)); }
+  size_t print(double v, int digits = 2) { return print(String(v, digits)); }
+  size_t print(const Printable &x) { return x.printTo(*this); }
+  size_t println() { return write("\r\n"); }
+  template <class T> size_t println(const T &v) { size_t n = print(v); return n + println(); }
+  template <class T> size_t println(const T &v, int f) { size_t n = print(v, f); return n + println(); }
+  size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+  virtual void flush() {}
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+  virtual size_t readBytes(uint8_t *b, size_t n) {
+    size_t i = 0;
+    for (; i < n; ++i) {
+      int c = read();
+      if (c < 0) break;
+      b[i] = (uint8_t)c;
+    }
+    return i;
+  }
+  size_t readBytes(char *b, size_t n) { return readBytes((uint8_t *)b, n); }
+  void setTimeout(unsigned long) {}
+  String readStringUntil(char term) {
+    String r;
+    for (int c; (c = read()) >= 0 && c != term;) r += (char)c;
+    return r;
+  }
+  bool find(const char *t) { return findUntil(t, nullptr); }
+  bool findUntil(const char *target, const char *term) {
+    size_t ti = 0, ui = 0, tl = strlen(target), ul = term ? strlen(term) : 0;
+    for (int c; (c = read()) >= 0;) {
+      ti = (c == target[ti]) ? ti + 1 : (c == target[0] ? 1 : 0);
+      if (ti == tl) return true;
+      if (ul) {
+        ui = (c == term[ui]) ? ui + 1 : (c == term[0] ? 1 : 0);
+        if (ui == ul) return false;
+      }
+    }
+    return false;
+  }
+};
+
+// Uscita su stdout, ingresso dalle righe "serial" dello scenario
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long) {}
+  void end() {}
+  size_t write(uint8_t c) override { return fwrite(&c, 1, 1, stdout); }
+  size_t write(const uint8_t *b, size_t n) override { return fwrite(b, 1, n, stdout); }
+  using Print::write;
+  int available() override { return host::serialAvailable(); }
+  int read() override { return host::serialRead(); }
+  int peek() override { return host::serialPeek(); }
+  void flush() override { fflush(stdout); }
+  operator bool() const { return true; }
+};
+extern HardwareSerial Serial;
+
+// ---------- ESP / heap ----------
+struct EspClass {
+  uint32_t getFreeHeap() { return (uint32_t)host::heapFree(); }
+  uint32_t getMinFreeHeap() { return (uint32_t)host::heapMinFree(); }
+  uint32_t getMaxAllocHeap() { return (uint32_t)host::heapLargestFree(); }
+  uint32_t getHeapSize() { return 320 * 1024; }
+  uint32_t getFreePsram() { return (uint32_t)host::psramFree(); }
+  uint32_t getPsramSize() { return 8 * 1024 * 1024; }
+  void restart();
+};
+extern EspClass ESP;
+
+#define MALLOC_CAP_EXEC      (1 << 0)
+#define MALLOC_CAP_32BIT     (1 << 1)
+#define MALLOC_CAP_8BIT      (1 << 2)
+#define MALLOC_CAP_DMA       (1 << 3)
+#define MALLOC_CAP_SPIRAM    (1 << 10)
+#define MALLOC_CAP_INTERNAL  (1 << 11)
+#define MALLOC_CAP_DEFAULT   (1 << 12)
+inline void *heap_caps_malloc(size_t n, uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? host::psramAlloc(n, false) : malloc(n);
+}
+inline void *heap_caps_calloc(size_t a, size_t n, uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? host::psramAlloc(a * n, true) : calloc(a, n);
+}
+inline void heap_caps_free(void *p) { free(p); }
+inline size_t heap_caps_get_free_size(uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? host::psramFree() : host::heapFree();
+}
+inline size_t heap_caps_get_largest_free_block(uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? host::psramFree() : host::heapLargestFree();
+}
+inline size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? host::psramFree() : host::heapMinFree();
+}
+inline void *ps_malloc(size_t n) { return host::psramAlloc(n, false); }
+inline void *ps_calloc(size_t a, size_t n) { return host::psramAlloc(a * n, true); }
+inline void *ps_realloc(void *p, size_t n) { return host::psramRealloc(p, n); }
+inline bool psramFound() { return true; }
+
+// ---------- ora ----------
+void configTime(long gmtOffset_sec, int daylightOffset_sec, const char *server1,
+                const char *server2 = nullptr, const char *server3 = nullptr);
+void configTzTime(const char *tz, const char *server1, const char *server2 = nullptr,
+                  const char *server3 = nullptr);
+bool getLocalTime(struct tm *info, uint32_t ms = 5000);
+
+#if !defined(__GLIBC__) || !__GLIBC_PREREQ(2, 38)   // glibc la ha da 2.38
+inline size_t strlcpy(char *d, const char *s, size_t n) {
+  size_t l = strlen(s);
+  if (n) { size_t c = l < n - 1 ? l : n - 1; memcpy(d, s, c); d[c] = 0; }
+  return l;
+}
+#endif
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
@@ -0,0 +1,365 @@
+/*
+  Arduino_GFX_Library.h – controfigura di GFX Library for Arduino 1.6.0 per la build su PC
+
+  Arduino_RGB_Display scrive in un framebuffer RGB565 in memoria (host::framebuffer) e conta
+  ogni primitiva che arriva al pannello, con le stesse categorie di DrawStats.h:
+    fill   rettangoli pieni e linee H/V      bitmap  chiamate draw16bitRGBBitmap
+    pixel  scritture di singolo pixel        px      pixel totali scritti
+  Il percorso delle chiamate (fillRect -> writeFillRect -> writeFillRectPreclipped, testo via
+  drawChar, clipping) segue quello della libreria, così i conteggi sono quelli del pannello.
+  Il font è HostFont.h (vedi mkfont.py), non il glcdfont della libreria.
+*/
+#pragma once
+#include "Arduino.h"
+#include "HostFont.h"
+#include "SPI.h"
+#include "Wire.h"     // come la libreria vera, che li tira dentro con i bus (es. Arduino_XCA9554SWSPI)
+
+#define GFX_NOT_DEFINED -1
+#define GFX_SKIP_OUTPUT_BEGIN -2
+#define RGB565(r, g, b) ((((r) & 0xF8) << 8) | (((g) & 0xFC) << 3) | ((b) >> 3))
+#define BLACK   0x0000
+#define WHITE   0xFFFF
+#define RED     0xF800
+#define GREEN   0x07E0
+#define BLUE    0x001F
+#define CYAN    0x07FF
+#define MAGENTA 0xF81F
+#define YELLOW  0xFFE0
+#define ORANGE  0xFD20
+#define RGB565_BLACK 0x0000   // stessi valori con cui li ridefiniscono gli sketch
+#define RGB565_WHITE 0xFFFF
+
+static const uint8_t st7701_type9_init_operations[] = {0};
+
+class Arduino_DataBus {
+public:
+  virtual ~Arduino_DataBus() {}
+};
+
+class Arduino_SWSPI : public Arduino_DataBus {
+public:
+  Arduino_SWSPI(int8_t, int8_t, int8_t, int8_t, int8_t = GFX_NOT_DEFINED) {}
+};
+
+class Arduino_ESP32RGBPanel {
+public:
+  Arduino_ESP32RGBPanel(int8_t /*de*/, int8_t /*vsync*/, int8_t /*hsync*/, int8_t /*pclk*/,
+                        int8_t /*r0*/, int8_t /*r1*/, int8_t /*r2*/, int8_t /*r3*/, int8_t /*r4*/,
+                        int8_t /*g0*/, int8_t /*g1*/, int8_t /*g2*/, int8_t /*g3*/, int8_t /*g4*/, int8_t /*g5*/,
+                        int8_t /*b0*/, int8_t /*b1*/, int8_t /*b2*/, int8_t /*b3*/, int8_t /*b4*/,
+                        uint16_t /*hsync_polarity*/, uint16_t /*hsync_front_porch*/,
+                        uint16_t /*hsync_pulse_width*/, uint16_t /*hsync_back_porch*/,
+                        uint16_t /*vsync_polarity*/, uint16_t /*vsync_front_porch*/,
+                        uint16_t /*vsync_pulse_width*/, uint16_t /*vsync_back_porch*/,
+                        uint16_t /*pclk_active_neg*/ = 0, int32_t /*prefer_speed*/ = GFX_NOT_DEFINED,
+                        bool /*useBigEndian*/ = false, uint16_t /*de_idle_high*/ = 0,
+                        uint16_t /*pclk_idle_high*/ = 0, size_t /*bounce_buffer_size_px*/ = 0) {}
+};
+
+class Arduino_G {
+public:
+  Arduino_G(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h) {}
+  virtual ~Arduino_G() {}
+  virtual bool begin(int32_t speed = GFX_NOT_DEFINED) = 0;
+protected:
+  int16_t WIDTH, HEIGHT;
+};
+
+class Arduino_GFX : public Print, public Arduino_G {
+public:
+  Arduino_GFX(int16_t w, int16_t h) : Arduino_G(w, h), _width(w), _height(h) {}
+
+  virtual void startWrite() {}
+  virtual void endWrite() {}
+  virtual void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) = 0;
+  virtual void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t j = 0; j < h; ++j)
+      for (int16_t i = 0; i < w; ++i) writePixelPreclipped(x + i, y + j, color);
+  }
+  virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    if (clipV(x, y, h)) writeFillRectPreclipped(x, y, 1, h, color);
+  }
+  virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    if (clipH(x, y, w)) writeFillRectPreclipped(x, y, w, 1, color);
+  }
+  void writePixel(int16_t x, int16_t y, uint16_t color) {
+    if (x >= 0 && y >= 0 && x < _width && y < _height) writePixelPreclipped(x, y, color);
+  }
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (w < 0) { x += w + 1; w = -w; }
+    if (h < 0) { y += h + 1; h = -h; }
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > _width) w = _width - x;
+    if (y + h > _height) h = _height - y;
+    if (w > 0 && h > 0) writeFillRectPreclipped(x, y, w, h, color);
+  }
+  void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    int dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1, dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1, e = dx + dy;
+    for (;;) {
+      writePixel(x0, y0, color);
+      if (x0 == x1 && y0 == y1) break;
+      int e2 = 2 * e;
+      if (e2 >= dy) { e += dy; x0 += sx; }
+      if (e2 <= dx) { e += dx; y0 += sy; }
+    }
+  }
+
+  virtual void drawPixel(int16_t x, int16_t y, uint16_t color) { startWrite(); writePixel(x, y, color); endWrite(); }
+  virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) { startWrite(); writeFastVLine(x, y, h, color); endWrite(); }
+  virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) { startWrite(); writeFastHLine(x, y, w, color); endWrite(); }
+  virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { startWrite(); writeFillRect(x, y, w, h, color); endWrite(); }
+  virtual void fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    if (x0 == x1) { if (y0 > y1) std::swap(y0, y1); drawFastVLine(x0, y0, y1 - y0 + 1, color); }
+    else if (y0 == y1) { if (x0 > x1) std::swap(x0, x1); drawFastHLine(x0, y0, x1 - x0 + 1, color); }
+    else { startWrite(); writeLine(x0, y0, x1, y1, color); endWrite(); }
+  }
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    startWrite();
+    writeFastHLine(x, y, w, color);
+    writeFastHLine(x, y + h - 1, w, color);
+    writeFastVLine(x, y, h, color);
+    writeFastVLine(x + w - 1, y, h, color);
+    endWrite();
+  }
+  void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+    drawLine(x0, y0, x1, y1, color);
+    drawLine(x1, y1, x2, y2, color);
+    drawLine(x2, y2, x0, y0, color);
+  }
+
+  // Cerchi, rettangoli arrotondati e triangoli pieni: stessi algoritmi (Adafruit) della libreria
+  void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    int16_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0, y = r;
+    startWrite();
+    writePixel(x0, y0 + r, color);
+    writePixel(x0, y0 - r, color);
+    writePixel(x0 + r, y0, color);
+    writePixel(x0 - r, y0, color);
+    while (x < y) {
+      if (f >= 0) { y--; ddF_y += 2; f += ddF_y; }
+      x++; ddF_x += 2; f += ddF_x;
+      writePixel(x0 + x, y0 + y, color); writePixel(x0 - x, y0 + y, color);
+      writePixel(x0 + x, y0 - y, color); writePixel(x0 - x, y0 - y, color);
+      writePixel(x0 + y, y0 + x, color); writePixel(x0 - y, y0 + x, color);
+      writePixel(x0 + y, y0 - x, color); writePixel(x0 - y, y0 - x, color);
+    }
+    endWrite();
+  }
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    startWrite();
+    writeFastVLine(x0, y0 - r, 2 * r + 1, color);
+    fillCircleHelper(x0, y0, r, 3, 0, color);
+    endWrite();
+  }
+  void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, uint16_t color) {
+    int16_t f = 1 - r, ddF_x = 1, ddF_y = -r - r, x = 0, y = r, px = x, py = y;
+    delta++;
+    while (x < y) {
+      if (f >= 0) { y--; ddF_y += 2; f += ddF_y; }
+      x++; ddF_x += 2; f += ddF_x;
+      if (x < y + 1) {
+        if (corners & 1) writeFastVLine(x0 + x, y0 - y, 2 * y + delta, color);
+        if (corners & 2) writeFastVLine(x0 - x, y0 - y, 2 * y + delta, color);
+      }
+      if (y != py) {
+        if (corners & 1) writeFastVLine(x0 + py, y0 - px, 2 * px + delta, color);
+        if (corners & 2) writeFastVLine(x0 - py, y0 - px, 2 * px + delta, color);
+        py = y;
+      }
+      px = x;
+    }
+  }
+  void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+    int16_t maxR = (w < h ? w : h) / 2;
+    if (r > maxR) r = maxR;
+    startWrite();
+    writeFillRect(x + r, y, w - 2 * r, h, color);
+    fillCircleHelper(x + w - r - 1, y + r, r, 1, h - 2 * r - 1, color);
+    fillCircleHelper(x + r, y + r, r, 2, h - 2 * r - 1, color);
+    endWrite();
+  }
+  void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+    int16_t maxR = (w < h ? w : h) / 2;
+    if (r > maxR) r = maxR;
+    startWrite();
+    writeFastHLine(x + r, y, w - 2 * r, color);
+    writeFastHLine(x + r, y + h - 1, w - 2 * r, color);
+    writeFastVLine(x, y + r, h - 2 * r, color);
+    writeFastVLine(x + w - 1, y + r, h - 2 * r, color);
+    int16_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, xx = 0, yy = r;
+    while (xx < yy) {
+      if (f >= 0) { yy--; ddF_y += 2; f += ddF_y; }
+      xx++; ddF_x += 2; f += ddF_x;
+      writePixel(x + w - r - 1 + xx, y + r - yy, color); writePixel(x + w - r - 1 + yy, y + r - xx, color);
+      writePixel(x + w - r - 1 + xx, y + h - r - 1 + yy, color); writePixel(x + w - r - 1 + yy, y + h - r - 1 + xx, color);
+      writePixel(x + r - xx, y + h - r - 1 + yy, color); writePixel(x + r - yy, y + h - r - 1 + xx, color);
+      writePixel(x + r - yy, y + r - xx, color); writePixel(x + r - xx, y + r - yy, color);
+    }
+    endWrite();
+  }
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+    if (y0 > y1) { std::swap(y0, y1); std::swap(x0, x1); }
+    if (y1 > y2) { std::swap(y2, y1); std::swap(x2, x1); }
+    if (y0 > y1) { std::swap(y0, y1); std::swap(x0, x1); }
+    startWrite();
+    if (y0 == y2) {
+      int16_t a = x0, b = x0;
+      if (x1 < a) a = x1; else if (x1 > b) b = x1;
+      if (x2 < a) a = x2; else if (x2 > b) b = x2;
+      writeFastHLine(a, y0, b - a + 1, color);
+      endWrite();
+      return;
+    }
+    int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0, dx12 = x2 - x1, dy12 = y2 - y1;
+    int32_t sa = 0, sb = 0;
+    int16_t y, last = (y1 == y2) ? y1 : y1 - 1;
+    for (y = y0; y <= last; y++) {
+      int16_t a = x0 + sa / dy01, b = x0 + sb / dy02;
+      sa += dx01; sb += dx02;
+      if (a > b) std::swap(a, b);
+      writeFastHLine(a, y, b - a + 1, color);
+    }
+    sa = (int32_t)dx12 * (y - y1);
+    sb = (int32_t)dx02 * (y - y0);
+    for (; y <= y2; y++) {
+      int16_t a = x1 + sa / dy12, b = x0 + sb / dy02;
+      sa += dx12; sb += dx02;
+      if (a > b) std::swap(a, b);
+      writeFastHLine(a, y, b - a + 1, color);
+    }
+    endWrite();
+  }
+
+  virtual void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) {
+    startWrite();
+    for (int16_t j = 0; j < h; ++j)
+      for (int16_t i = 0; i < w; ++i) writePixel(x + i, y + j, bitmap[j * w + i]);
+    endWrite();
+  }
+  void draw16bitRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[], int16_t w, int16_t h) {
+    draw16bitRGBBitmap(x, y, (uint16_t *)bitmap, w, h);
+  }
+
+  // Testo col font classico: stesso percorso di drawChar della libreria
+  void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t sx, uint8_t sy) {
+    if (x >= _width || y >= _height || x + 6 * sx - 1 < 0 || y + 8 * sy - 1 < 0) return;
+    startWrite();
+    for (int8_t i = 0; i < 5; i++) {
+      uint8_t line = HOST_FONT[c * 5 + i];
+      for (int8_t j = 0; j < 8; j++, line >>= 1) {
+        if (line & 1) {
+          if (sx == 1 && sy == 1) writePixel(x + i, y + j, color);
+          else writeFillRect(x + i * sx, y + j * sy, sx, sy, color);
+        } else if (bg != color) {
+          if (sx == 1 && sy == 1) writePixel(x + i, y + j, bg);
+          else writeFillRect(x + i * sx, y + j * sy, sx, sy, bg);
+        }
+      }
+    }
+    if (bg != color) {
+      if (sx == 1 && sy == 1) writeFastVLine(x + 5, y, 8, bg);
+      else writeFillRect(x + 5 * sx, y, sx, 8 * sy, bg);
+    }
+    endWrite();
+  }
+  size_t write(uint8_t c) override {
+    if (c == '\n') { cursor_x = 0; cursor_y += (int16_t)textsize_y * 8; return 1; }
+    if (c == '\r') return 1;
+    if (wrap && cursor_x + textsize_x * 6 > _width) { cursor_x = 0; cursor_y += (int16_t)textsize_y * 8; }
+    drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+    cursor_x += textsize_x * 6;
+    return 1;
+  }
+  using Print::write;
+
+  void setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+  int16_t getCursorX() const { return cursor_x; }
+  int16_t getCursorY() const { return cursor_y; }
+  void setTextSize(uint8_t s) { textsize_x = textsize_y = s > 0 ? s : 1; }
+  void setTextSize(uint8_t sx, uint8_t sy, uint8_t = 0) { textsize_x = sx > 0 ? sx : 1; textsize_y = sy > 0 ? sy : 1; }
+  void setTextColor(uint16_t c) { textcolor = textbgcolor = c; }
+  void setTextColor(uint16_t c, uint16_t bg) { textcolor = c; textbgcolor = bg; }
+  void setTextWrap(bool w) { wrap = w; }
+  virtual void setRotation(uint8_t r) { rotation = r & 3; }
+  virtual void invertDisplay(bool) {}
+  virtual void displayOn() {}
+  virtual void displayOff() {}
+  uint16_t color565(uint8_t r, uint8_t g, uint8_t b) { return RGB565(r, g, b); }
+  int16_t width() const { return _width; }
+  int16_t height() const { return _height; }
+  uint8_t getRotation() const { return rotation; }
+
+protected:
+  bool clipH(int16_t &x, int16_t y, int16_t &w) const {
+    if (y < 0 || y >= _height || w <= 0) return false;
+    if (x < 0) { w += x; x = 0; }
+    if (x + w > _width) w = _width - x;
+    return w > 0;
+  }
+  bool clipV(int16_t x, int16_t &y, int16_t &h) const {
+    if (x < 0 || x >= _width || h <= 0) return false;
+    if (y < 0) { h += y; y = 0; }
+    if (y + h > _height) h = _height - y;
+    return h > 0;
+  }
+
+  int16_t _width, _height, cursor_x = 0, cursor_y = 0;
+  uint16_t textcolor = 0xFFFF, textbgcolor = 0xFFFF;
+  uint8_t textsize_x = 1, textsize_y = 1, rotation = 0;
+  bool wrap = true;
+};
+
+// Pannello RGB: framebuffer in memoria e contatori in host::draw
+class Arduino_RGB_Display : public Arduino_GFX {
+public:
+  Arduino_RGB_Display(int16_t w, int16_t h, Arduino_ESP32RGBPanel * /*rgbpanel*/, uint8_t r = 0,
+                      bool /*auto_flush*/ = true, Arduino_DataBus * /*bus*/ = nullptr,
+                      int8_t /*rst*/ = GFX_NOT_DEFINED, const uint8_t * /*init_operations*/ = nullptr,
+                      size_t /*init_operations_len*/ = GFX_NOT_DEFINED, uint16_t /*col_offset1*/ = 0,
+                      uint16_t /*row_offset1*/ = 0, uint16_t /*col_offset2*/ = 0, uint16_t /*row_offset2*/ = 0)
+      : Arduino_GFX(w, h) {
+    _fb = (uint16_t *)host::psramAlloc((size_t)w * h * 2, true);   // come sul pannello: in PSRAM
+    host::framebuffer = _fb;
+    host::fbWidth = w;
+    host::fbHeight = h;
+    setRotation(r);
+  }
+  bool begin(int32_t = GFX_NOT_DEFINED) override { return true; }
+
+  void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override {
+    host::draw.pixel++; host::draw.px++;
+    _fb[(int32_t)y * _width + x] = color;
+  }
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override {
+    if (!clipV(x, y, h)) return;
+    host::draw.fill++; host::draw.px += h;
+    for (int16_t j = 0; j < h; ++j) _fb[(int32_t)(y + j) * _width + x] = color;
+  }
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override {
+    if (!clipH(x, y, w)) return;
+    host::draw.fill++; host::draw.px += w;
+    std::fill_n(_fb + (int32_t)y * _width + x, w, color);
+  }
+  void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override {
+    host::draw.fill++; host::draw.px += (uint32_t)w * (uint32_t)h;
+    for (int16_t j = 0; j < h; ++j) std::fill_n(_fb + (int32_t)(y + j) * _width + x, w, color);
+  }
+  void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override {
+    host::draw.bitmap++;
+    int16_t x0 = max<int16_t>(x, 0), y0 = max<int16_t>(y, 0);
+    int16_t x1 = min<int16_t>(x + w, _width), y1 = min<int16_t>(y + h, _height);
+    if (x1 <= x0 || y1 <= y0) return;
+    host::draw.px += (uint32_t)(x1 - x0) * (uint32_t)(y1 - y0);
+    for (int16_t j = y0; j < y1; ++j)
+      memcpy(_fb + (int32_t)j * _width + x0, bitmap + (int32_t)(j - y) * w + (x0 - x), (x1 - x0) * 2);
+  }
+  using Arduino_GFX::draw16bitRGBBitmap;
+  void flush(bool = false) {}
+  uint16_t *getFramebuffer() { return _fb; }
+
+protected:
+  uint16_t *_fb;
+};
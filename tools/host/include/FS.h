@@ -0,0 +1,101 @@
+/*
+  FS.h – controfigura di fs::File del core ESP32 per la build su PC
+
+  Un File è un FILE* su una cartella del PC (vedi SD.h); le copie condividono lo stesso
+  handle come sul core. Le cartelle si elencano in ordine alfabetico, per avere scenari
+  ripetibili (su FAT l'ordine è quello di creazione).
+*/
+#pragma once
+#include "Arduino.h"
+#include <memory>
+#include <vector>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+struct FileImpl {
+  FILE *fp = nullptr;
+  std::string path;                      // come lo vede lo sketch ("/quadranti/neon.qd")
+  bool dir = false;
+  std::vector<std::string> entries;      // cartella: nomi da restituire con openNextFile
+  size_t next = 0;
+  ~FileImpl() { if (fp) fclose(fp); }
+};
+
+class File : public Stream {
+public:
+  File() {}
+  explicit File(std::shared_ptr<FileImpl> p) : _p(std::move(p)) {}
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *b, size_t n) override { return fp() ? fwrite(b, 1, n, fp()) : 0; }
+  using Print::write;
+  int available() override {
+    if (!fp()) return 0;
+    long left = (long)size() - (long)position();
+    return left > 0 ? (int)left : 0;
+  }
+  int read() override { return fp() ? fgetc(fp()) : -1; }
+  size_t read(uint8_t *b, size_t n) { return fp() ? fread(b, 1, n, fp()) : 0; }
+  size_t readBytes(uint8_t *b, size_t n) override { return read(b, n); }
+  using Stream::readBytes;
+  int peek() override {
+    int c = read();
+    if (c >= 0) ungetc(c, fp());
+    return c;
+  }
+  bool seek(uint32_t pos) { return fp() && fseek(fp(), pos, SEEK_SET) == 0; }
+  size_t position() const { return fp() ? (size_t)ftell(fp()) : 0; }
+  size_t size() const {
+    if (!fp()) return 0;
+    long cur = ftell(fp());
+    fseek(fp(), 0, SEEK_END);
+    long end = ftell(fp());
+    fseek(fp(), cur, SEEK_SET);
+    return (size_t)end;
+  }
+  void flush() override { if (fp()) fflush(fp()); }
+  void close() { _p.reset(); }
+  operator bool() const { return _p && (_p->fp || _p->dir); }
+  const char *path() const { return _p ? _p->path.c_str() : ""; }
+  const char *name() const {                // core 2.x: solo il nome, senza cartella
+    if (!_p) return "";
+    const char *s = strrchr(_p->path.c_str(), '/');
+    return s ? s + 1 : _p->path.c_str();
+  }
+  bool isDirectory() const { return _p && _p->dir; }
+  File openNextFile(const char *mode = FILE_READ);
+  void rewindDirectory() { if (_p) _p->next = 0; }
+
+private:
+  FILE *fp() const { return _p ? _p->fp : nullptr; }
+  std::shared_ptr<FileImpl> _p;
+};
+
+class FS {
+public:
+  File open(const char *path, const char *mode = FILE_READ, bool create = false);
+  File open(const String &path, const char *mode = FILE_READ, bool create = false) {
+    return open(path.c_str(), mode, create);
+  }
+  bool exists(const char *path);
+  bool exists(const String &path) { return exists(path.c_str()); }
+  bool remove(const char *path);
+  bool remove(const String &path) { return remove(path.c_str()); }
+  bool rename(const char *from, const char *to);
+  bool rename(const String &from, const String &to) { return rename(from.c_str(), to.c_str()); }
+  bool mkdir(const char *path);
+  bool mkdir(const String &path) { return mkdir(path.c_str()); }
+  bool rmdir(const char *path);
+  bool rmdir(const String &path) { return rmdir(path.c_str()); }
+protected:
+  bool _mounted = false;
+};
+
+}  // namespace fs
+
+using fs::File;
+using fs::FS;
@@ -0,0 +1,115 @@
+/*
+  HTTPClient.h – controfigura di HTTPClient (core ESP32 2.0.x) servita da file del PC
+
+  GET cerca la risposta in host::wwwRoot: prima <www>/<host><path>, poi <www>/<nome del file>
+  (la query non conta). Un path che finisce con "/" prende il primo index.* della cartella,
+  col tipo dall'estensione: "https://images.weserv.nl/?url=..." è images.weserv.nl/index.jpg.
+  404 se non c'è, -1 se la rete dello scenario è spenta. Il corpo arriva a segmenti di 1460
+  byte come da un socket; ETag è un hash del file e un If-None-Match uguale dà 304, così si
+  provano anche i validatori degli sketch.
+  Il corpo si legge con pread dal file: niente malloc, i conti di heap restano dello sketch.
+*/
+#pragma once
+#include "WiFi.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define HTTP_CODE_OK 200
+#define HTTP_CODE_MOVED_PERMANENTLY 301
+#define HTTP_CODE_FOUND 302
+#define HTTP_CODE_NOT_MODIFIED 304
+#define HTTP_CODE_NOT_FOUND 404
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+typedef enum {
+  HTTPC_DISABLE_FOLLOW_REDIRECTS, HTTPC_STRICT_FOLLOW_REDIRECTS, HTTPC_FORCE_FOLLOW_REDIRECTS
+} followRedirects_t;
+
+class HostBodyClient : public WiFiClient {
+public:
+  ~HostBodyClient() { stop(); }
+  bool open(const char *path) {
+    stop();
+    _fd = ::open(path, O_RDONLY);
+    if (_fd < 0) return false;
+    struct stat st;
+    if (fstat(_fd, &st) != 0 || S_ISDIR(st.st_mode)) { stop(); return false; }
+    _size = (size_t)st.st_size;
+    _pos = 0;
+    return true;
+  }
+  size_t size() const { return _size; }
+  int available() override {
+    size_t left = _fd >= 0 ? _size - _pos : 0;
+    return (int)(left < 1460 ? left : 1460);
+  }
+  int read() override {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+  }
+  int read(uint8_t *b, size_t n) override {
+    if (_fd < 0 || _pos >= _size) return -1;
+    ssize_t r = pread(_fd, b, n, (off_t)_pos);
+    if (r > 0) _pos += (size_t)r;
+    return (int)r;
+  }
+  int peek() override {
+    uint8_t c;
+    return _fd >= 0 && pread(_fd, &c, 1, (off_t)_pos) == 1 ? c : -1;
+  }
+  uint8_t connected() override { return _fd >= 0 && _pos < _size; }
+  void stop() override {
+    if (_fd >= 0) ::close(_fd);
+    _fd = -1;
+  }
+private:
+  int _fd = -1;
+  size_t _size = 0, _pos = 0;
+};
+
+class HTTPClient {
+public:
+  bool begin(const String &url) { return begin(url.c_str()); }
+  bool begin(WiFiClient &, const String &url) { return begin(url.c_str()); }
+  bool begin(const char *url) {
+    end();
+    _ifNoneMatch[0] = 0;
+    strlcpy(_url, url, sizeof(_url));
+    return strncmp(url, "http://", 7) == 0 || strncmp(url, "https://", 8) == 0;
+  }
+  void end() { _body.stop(); _size = -1; _etag[0] = _ctype[0] = 0; }
+  void setTimeout(uint16_t) {}
+  void setConnectTimeout(int32_t) {}
+  void setReuse(bool) {}
+  void useHTTP10(bool = true) {}
+  void setUserAgent(const String &) {}
+  void setFollowRedirects(followRedirects_t) {}
+  void addHeader(const String &k, const String &v, bool = false, bool = true) {
+    if (k.equalsIgnoreCase("If-None-Match")) strlcpy(_ifNoneMatch, v.c_str(), sizeof(_ifNoneMatch));
+  }
+  void collectHeaders(const char *[], const size_t) {}
+  String header(const char *k) {
+    if (!strcasecmp(k, "ETag")) return String(_etag);
+    if (!strcasecmp(k, "Content-Type")) return String(_ctype);
+    return String();
+  }
+  bool hasHeader(const char *k) { return header(k).length() > 0; }
+  int GET();
+  int getSize() { return _size; }
+  String getString() {
+    String s;
+    uint8_t b[256];
+    for (int n; (n = _body.read(b, sizeof(b))) > 0;) s.concat((const char *)b, (unsigned)n);
+    return s;
+  }
+  WiFiClient &getStream() { return _body; }
+  WiFiClient *getStreamPtr() { return &_body; }
+  bool connected() { return _body.connected(); }
+  static String errorToString(int code) { return String("errore ") + code; }
+private:
+  HostBodyClient _body;
+  char _url[512] = "", _ifNoneMatch[24] = "", _etag[24] = "", _ctype[32] = "";
+  int _size = -1;
+};
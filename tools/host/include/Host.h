@@ -0,0 +1,89 @@
+/*
+  Host.h – il "pannello" simulato su cui girano gli sketch compilati per Linux
+
+  Lo usano solo le controfigure di include/ (Arduino.h, Arduino_GFX_Library.h, SD.h, ...) e
+  il runner main.cpp; gli sketch non lo includono mai.
+
+  Tempo: un orologio simulato in us. delay/vTaskDelay/attese su mutex e code lo fanno avanzare
+  senza dormire davvero, quindi 90 s di gioco girano in pochi secondi e due esecuzioni dello
+  stesso scenario danno gli stessi numeri. Con cpuClock l'orologio avanza anche del tempo CPU
+  reale speso nel codice: i ms che lo sketch misura da sé (parse, pagine web) diventano tempi
+  del PC, al prezzo del determinismo.
+
+  Task: ogni task FreeRTOS è un thread, ma ne gira uno alla volta. Si passa il turno solo
+  nei punti in cui il firmware si bloccherebbe (delay, yield, prese di mutex e code, notify),
+  a giro tra i task pronti; se nessuno è pronto l'orologio salta al risveglio più vicino.
+*/
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include <string>
+
+namespace host {
+
+// ---- orologio e scheduler ----
+uint64_t nowUs();                        // orologio simulato (millis/micros degli sketch)
+uint64_t wallUs();                       // orologio reale del PC (tempi di disegno)
+void     advanceUs(uint64_t us);         // avanza senza cedere il turno (delayMicroseconds)
+void     sleepUs(uint64_t us);           // blocca il task corrente e cede il turno
+bool     waitFor(const std::function<bool()> &ready, uint64_t timeoutUs);   // true se pronto
+void    *spawn(void (*fn)(void *), void *arg, const char *name);
+void    *currentTask();
+void     exitTask();                     // vTaskDelete(NULL): non ritorna
+void     at(uint64_t us, std::function<void()> fn);   // evento dello scenario all'istante us
+[[noreturn]] void finish(const char *why);   // resoconto e uscita (main.cpp)
+extern bool cpuClock;
+extern uint64_t endUs;                   // oltre questo istante la corsa finisce
+const uint64_t FOREVER = ~0ull;
+
+// ---- display ----
+struct Counters { uint64_t fill = 0, bitmap = 0, pixel = 0, px = 0; };
+extern Counters draw;                    // cumulativi, contati da Arduino_RGB_Display
+extern uint16_t *framebuffer;            // ultimo Arduino_RGB_Display creato (480x480)
+extern int fbWidth, fbHeight;
+
+// ---- touch (coordinate come le riporta il GT911) ----
+struct Touch { bool down = false; int x = 0, y = 0; };
+extern Touch touch;
+
+// ---- Serial: righe iniettate dallo scenario ----
+void serialFeed(const std::string &bytes);
+int  serialAvailable();
+int  serialRead();
+int  serialPeek();
+
+// ---- heap: malloc contate, PSRAM a parte ----
+size_t heapFree();
+size_t heapMinFree();
+size_t heapPeak();                       // massimo allocato dallo sketch, anche oltre i 320 KB del modello
+size_t heapLargestFree();
+size_t psramFree();
+void  *psramAlloc(size_t n, bool zero);
+void  *psramRealloc(void *p, size_t n);
+void   heapBaseline();                   // da qui la heap è dello sketch (prima di setup)
+void   heapMark();                       // azzera il picco: heapPeakSinceMark() da qui
+size_t heapPeakSinceMark();
+
+// ---- cartelle: SD, fixture HTTP, uscite ----
+extern std::string sdRoot;               // copia di lavoro della SD dello scenario
+extern std::string wwwRoot;              // fixture servite da HTTPClient
+extern std::string outDir;
+
+// ---- rete simulata ----
+void wifiSet(bool on);                   // "wifi on/off" dello scenario: c'è la rete?
+bool wifiUp();                           // STA connessa (dopo GOT_IP)
+void wifiBegin(const char *ssid);
+void ntpStart();
+void setEpoch(int64_t epoch);            // ora che l'SNTP consegnerà
+int64_t epochNow();                      // time() degli sketch
+
+// ---- WebServer: richieste dello scenario ----
+struct WebRequest { std::string method, uri, body; };
+bool takeWebRequest(WebRequest &r);
+void queueWebRequest(const WebRequest &r);
+
+// ---- Preferences (NVS in memoria) ----
+void nvsSet(const std::string &ns, const std::string &key, const std::string &value);
+
+}  // namespace host
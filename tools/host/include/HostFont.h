@@ -0,0 +1,262 @@
+// Generato da tools/host/mkfont.py: non modificare a mano.
+#pragma once
+#include <stdint.h>
+
+static const uint8_t HOST_FONT[256 * 5] = {
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x5E, 0x5E, 0x00, 0x00,   // '!'
+  0x00, 0x0E, 0x00, 0x0E, 0x00,   // '"'
+  0x24, 0xFF, 0x24, 0xFF, 0x24,   // '#'
+  0x66, 0x6F, 0xCD, 0x7D, 0x3B,   // '$'
+  0x27, 0x15, 0x7F, 0x54, 0x72,   // '%'
+  0x74, 0x5E, 0x7A, 0x72, 0x50,   // '&'
+  0x00, 0x04, 0x03, 0x01, 0x00,   // '''
+  0x00, 0x3C, 0x7E, 0x81, 0x00,   // '('
+  0x00, 0x81, 0x7E, 0x3C, 0x00,   // ')'
+  0x0A, 0x06, 0x07, 0x0A, 0x00,   // '*'
+  0x08, 0x08, 0x3E, 0x08, 0x08,   // '+'
+  0x00, 0x80, 0xC0, 0x40, 0x00,   // ','
+  0x08, 0x08, 0x08, 0x08, 0x08,   // '-'
+  0x00, 0x40, 0x40, 0x00, 0x00,   // '.'
+  0x00, 0xC0, 0x30, 0x0C, 0x03,   // '/'
+  0x3E, 0x7F, 0x41, 0x7F, 0x3E,   // '0'
+  0x42, 0x42, 0x7F, 0x7F, 0x40,   // '1'
+  0x62, 0x73, 0x59, 0x6F, 0x66,   // '2'
+  0x22, 0x6B, 0x49, 0x7F, 0x36,   // '3'
+  0x18, 0x1C, 0x12, 0x7F, 0x7F,   // '4'
+  0x6F, 0x4F, 0x45, 0x7D, 0x39,   // '5'
+  0x3E, 0x7F, 0x49, 0x7B, 0x32,   // '6'
+  0x03, 0x63, 0x79, 0x1F, 0x07,   // '7'
+  0x36, 0x7F, 0x49, 0x7F, 0x36,   // '8'
+  0x26, 0x6F, 0x49, 0x7F, 0x3E,   // '9'
+  0x00, 0x48, 0x48, 0x00, 0x00,   // ':'
+  0x80, 0xC8, 0x48, 0x00, 0x00,   // ';'
+  0x08, 0x1C, 0x36, 0x22, 0x00,   // '<'
+  0x14, 0x14, 0x14, 0x14, 0x00,   // '='
+  0x00, 0x22, 0x36, 0x1C, 0x08,   // '>'
+  0x04, 0x52, 0x5A, 0x0E, 0x04,   // '?'
+  0x7E, 0xC3, 0x99, 0xA5, 0x3E,   // '@'
+  0x72, 0x7E, 0x16, 0x7E, 0x70,   // 'A'
+  0x7E, 0x7E, 0x4A, 0x7E, 0x34,   // 'B'
+  0x3C, 0x7E, 0x42, 0x66, 0x26,   // 'C'
+  0x7E, 0x7E, 0x42, 0x7E, 0x3C,   // 'D'
+  0x7E, 0x7E, 0x4A, 0x6A, 0x62,   // 'E'
+  0x7E, 0x7E, 0x4A, 0x0A, 0x02,   // 'F'
+  0x3C, 0x7E, 0x52, 0x76, 0x74,   // 'G'
+  0x7E, 0x7E, 0x08, 0x7E, 0x7E,   // 'H'
+  0x42, 0x7E, 0x7E, 0x42, 0x00,   // 'I'
+  0x70, 0x42, 0x7E, 0x3E, 0x02,   // 'J'
+  0x7E, 0x7E, 0x58, 0x36, 0x62,   // 'K'
+  0x7E, 0x7E, 0x42, 0x60, 0x60,   // 'L'
+  0x7E, 0x1C, 0x70, 0x1C, 0x7E,   // 'M'
+  0x7E, 0x7E, 0x0C, 0x32, 0x7E,   // 'N'
+  0x3C, 0x7E, 0x42, 0x7E, 0x3C,   // 'O'
+  0x7E, 0x7E, 0x52, 0x1E, 0x0C,   // 'P'
+  0x3C, 0x7E, 0x42, 0xFE, 0xBC,   // 'Q'
+  0x7E, 0x7E, 0x52, 0x3E, 0x6C,   // 'R'
+  0x6C, 0x4E, 0x5A, 0x7A, 0x36,   // 'S'
+  0x42, 0x7E, 0x7E, 0x42, 0x06,   // 'T'
+  0x3E, 0x7E, 0x40, 0x7E, 0x3E,   // 'U'
+  0x06, 0x3E, 0x70, 0x3E, 0x06,   // 'V'
+  0x1E, 0x70, 0x3E, 0x70, 0x1E,   // 'W'
+  0x42, 0x66, 0x3C, 0x3C, 0x66,   // 'X'
+  0x06, 0x4E, 0x78, 0x78, 0x4E,   // 'Y'
+  0x66, 0x76, 0x5A, 0x6E, 0x66,   // 'Z'
+  0x00, 0xFF, 0xFF, 0x81, 0x00,   // '['
+  0x03, 0x0C, 0x30, 0xC0, 0x00,
+  0x00, 0x81, 0xFF, 0xFF, 0x00,   // ']'
+  0x04, 0x06, 0x03, 0x06, 0x04,   // '^'
+  0x80, 0x80, 0x80, 0x80, 0x80,   // '_'
+  0x00, 0x01, 0x03, 0x04, 0x00,   // '`'
+  0x68, 0x7C, 0x54, 0x7C, 0x78,   // 'a'
+  0x7F, 0x7F, 0x44, 0x7C, 0x38,   // 'b'
+  0x38, 0x7C, 0x44, 0x6C, 0x28,   // 'c'
+  0x38, 0x7C, 0x45, 0x7F, 0x7F,   // 'd'
+  0x38, 0x7C, 0x54, 0x5C, 0x58,   // 'e'
+  0x44, 0x7E, 0x7F, 0x45, 0x45,   // 'f'
+  0xB8, 0xFC, 0xC4, 0xF8, 0xFC,   // 'g'
+  0x7F, 0x7F, 0x04, 0x7C, 0x78,   // 'h'
+  0x44, 0x44, 0x7D, 0x7D, 0x40,   // 'i'
+  0x84, 0x84, 0xFD, 0xFD, 0x00,   // 'j'
+  0x7F, 0x7F, 0x38, 0x6C, 0x44,   // 'k'
+  0x41, 0x41, 0x7F, 0x7F, 0x40,   // 'l'
+  0x7C, 0x0C, 0x7C, 0x0C, 0x78,   // 'm'
+  0x7C, 0x78, 0x04, 0x7C, 0x78,   // 'n'
+  0x38, 0x7C, 0x44, 0x7C, 0x38,   // 'o'
+  0xFC, 0xFC, 0xC4, 0x7C, 0x38,   // 'p'
+  0x38, 0x7C, 0xC4, 0xF8, 0xFC,   // 'q'
+  0x44, 0x7C, 0x78, 0x4C, 0x0C,   // 'r'
+  0x48, 0x5C, 0x5C, 0x74, 0x74,   // 's'
+  0x04, 0x3F, 0x7F, 0x44, 0x64,   // 't'
+  0x3C, 0x7C, 0x40, 0x7C, 0x7C,   // 'u'
+  0x0C, 0x3C, 0x70, 0x3C, 0x0C,   // 'v'
+  0x1C, 0x70, 0x3C, 0x70, 0x3C,   // 'w'
+  0x44, 0x6C, 0x3C, 0x78, 0x6C,   // 'x'
+  0x9C, 0xFC, 0xC0, 0x7C, 0x1C,   // 'y'
+  0x6C, 0x74, 0x5C, 0x6C, 0x64,   // 'z'
+  0x00, 0x08, 0x7E, 0xF7, 0x81,   // '{'
+  0x00, 0x00, 0xFE, 0x00, 0x00,   // '|'
+  0x81, 0xF7, 0x7E, 0x08, 0x00,   // '}'
+  0x08, 0x04, 0x0C, 0x08, 0x04,   // '~'
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00,
+};
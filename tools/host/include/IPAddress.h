@@ -0,0 +1,18 @@
+#pragma once
+#include "Arduino.h"
+
+class IPAddress : public Printable {
+public:
+  IPAddress() {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _b{a, b, c, d} {}
+  uint8_t operator[](int i) const { return _b[i]; }
+  operator uint32_t() const { return _b[0] | _b[1] << 8 | _b[2] << 16 | (uint32_t)_b[3] << 24; }
+  String toString() const {
+    char s[16];
+    snprintf(s, sizeof(s), "%u.%u.%u.%u", _b[0], _b[1], _b[2], _b[3]);
+    return String(s);
+  }
+  size_t printTo(Print &p) const override { return p.print(toString()); }
+private:
+  uint8_t _b[4] = {0, 0, 0, 0};
+};
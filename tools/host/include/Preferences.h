@@ -0,0 +1,29 @@
+// Controfigura di Preferences: NVS in memoria, precaricata dalle righe "nvs" dello scenario
+#pragma once
+#include "Arduino.h"
+
+class Preferences {
+public:
+  bool begin(const char *name, bool readOnly = false);
+  void end() { _ns.clear(); }
+  bool clear();
+  bool remove(const char *key);
+  bool isKey(const char *key);
+  size_t putString(const char *key, const char *value);
+  size_t putString(const char *key, const String &value) { return putString(key, value.c_str()); }
+  String getString(const char *key, const String &def = String());
+  size_t getString(const char *key, char *value, size_t maxLen);
+  size_t putInt(const char *key, int32_t v) { return putString(key, String((long)v)) ? 4 : 0; }
+  int32_t getInt(const char *key, int32_t def = 0) { return isKey(key) ? (int32_t)getString(key).toInt() : def; }
+  size_t putUInt(const char *key, uint32_t v) { return putString(key, String((unsigned long)v)) ? 4 : 0; }
+  uint32_t getUInt(const char *key, uint32_t def = 0) { return isKey(key) ? (uint32_t)strtoul(getString(key).c_str(), nullptr, 10) : def; }
+  size_t putUChar(const char *key, uint8_t v) { return putString(key, String((unsigned)v)) ? 1 : 0; }
+  uint8_t getUChar(const char *key, uint8_t def = 0) { return isKey(key) ? (uint8_t)getString(key).toInt() : def; }
+  size_t putBool(const char *key, bool v) { return putUChar(key, v); }
+  bool getBool(const char *key, bool def = false) { return getUChar(key, def) != 0; }
+  size_t putULong(const char *key, uint32_t v) { return putUInt(key, v); }
+  uint32_t getULong(const char *key, uint32_t def = 0) { return getUInt(key, def); }
+private:
+  std::string _ns;
+  bool _ro = false;
+};
@@ -0,0 +1,21 @@
+// Controfigura di SD (core ESP32 2.0.x): la scheda è la cartella host::sdRoot
+#pragma once
+#include "FS.h"
+#include "SPI.h"
+
+typedef enum { CARD_NONE, CARD_MMC, CARD_SD, CARD_SDHC, CARD_UNKNOWN } sdcard_type_t;
+
+namespace fs {
+class SDFS : public FS {
+public:
+  bool begin(uint8_t ssPin = 5, SPIClass &spi = SPI, uint32_t frequency = 4000000,
+             const char *mountpoint = "/sd", uint8_t max_files = 5, bool format_if_empty = false);
+  void end() { _mounted = false; }
+  sdcard_type_t cardType() { return _mounted ? CARD_SDHC : CARD_NONE; }
+  uint64_t cardSize() { return _mounted ? 16ull << 30 : 0; }
+  uint64_t totalBytes() { return cardSize(); }
+  uint64_t usedBytes() { return 0; }
+};
+}  // namespace fs
+
+extern fs::SDFS SD;
@@ -0,0 +1,13 @@
+#pragma once
+#include "Arduino.h"
+
+#define FSPI 0
+#define HSPI 1
+
+class SPIClass {
+public:
+  SPIClass(uint8_t = HSPI) {}
+  void begin(int8_t = -1, int8_t = -1, int8_t = -1, int8_t = -1) {}
+  void end() {}
+};
+extern SPIClass SPI;
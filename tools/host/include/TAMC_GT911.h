@@ -0,0 +1,35 @@
+// Controfigura di TAMC_GT911 1.0.2: read() riporta il tocco scritto dallo scenario (host::touch)
+#pragma once
+#include "Arduino.h"
+
+#define ROTATION_LEFT 0
+#define ROTATION_INVERTED 1
+#define ROTATION_RIGHT 2
+#define ROTATION_NORMAL 3
+
+class TP_Point {
+public:
+  TP_Point() {}
+  TP_Point(uint8_t i, uint16_t px, uint16_t py, uint16_t s) : id(i), x(px), y(py), size(s) {}
+  uint8_t id = 0;
+  uint16_t x = 0, y = 0, size = 0;
+};
+
+class TAMC_GT911 {
+public:
+  TAMC_GT911(uint8_t, uint8_t, uint8_t, uint8_t, uint16_t, uint16_t) {}
+  void begin(uint8_t = 0x5D) {}
+  void reset() {}
+  void setRotation(uint8_t) {}
+  void setResolution(uint16_t, uint16_t) {}
+  // Coordinate così come arrivano dal controller: lo sketch fa la sua conversione
+  void read() {
+    isTouched = host::touch.down;
+    touches = isTouched ? 1 : 0;
+    points[0] = TP_Point(0, (uint16_t)host::touch.x, (uint16_t)host::touch.y, isTouched ? 30 : 0);
+  }
+  bool isTouched = false;
+  bool isLargeDetect = false;
+  uint8_t touches = 0;
+  TP_Point points[5];
+};
@@ -0,0 +1,6 @@
+// Fotine usa solo jd_prepare/jd_decomp: si prende tjpgd.h dalla libreria TJpg_Decoder vera
+#pragma once
+#include "Arduino.h"
+extern "C" {
+#include "tjpgd.h"
+}
@@ -0,0 +1,70 @@
+/*
+  WebServer.h – controfigura di WebServer (core ESP32 2.0.x) per la build su PC
+
+  Niente socket: le richieste sono le righe "get"/"post" dello scenario (host::queueWebRequest)
+  e handleClient ne serve una per chiamata, come il server vero. La risposta non va da
+  nessuna parte: se ne contano i byte e si stampa una riga
+    [HOST] GET /uri: 200, 5120 byte, picco heap 3412
+  dove il picco è la heap in più rispetto all'inizio della richiesta, handler compreso.
+*/
+#pragma once
+#include "WiFi.h"
+#include <functional>
+#include <utility>
+#include <vector>
+
+typedef enum { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS } HTTPMethod;
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+#define CONTENT_LENGTH_NOT_SET ((size_t)-2)
+
+class WebServer {
+public:
+  typedef std::function<void(void)> THandlerFunction;
+  WebServer(int = 80) {}
+  void begin() { _begun = true; }
+  void stop() { _begun = false; }
+  void close() { _begun = false; }
+  void on(const String &uri, THandlerFunction fn) { on(uri, HTTP_ANY, fn); }
+  void on(const String &uri, HTTPMethod m, THandlerFunction fn) { _routes.push_back({uri.c_str(), m, fn}); }
+  void onNotFound(THandlerFunction fn) { _notFound = fn; }
+  void handleClient();
+
+  String uri() { return String(_uri.c_str()); }
+  HTTPMethod method() { return _method; }
+  String arg(const String &name) {
+    for (auto &a : _args) if (a.first == name.c_str()) return String(a.second.c_str());
+    return String();
+  }
+  String arg(int i) { return i < (int)_args.size() ? String(_args[i].second.c_str()) : String(); }
+  String argName(int i) { return i < (int)_args.size() ? String(_args[i].first.c_str()) : String(); }
+  int args() { return (int)_args.size(); }
+  bool hasArg(const String &name) {
+    for (auto &a : _args) if (a.first == name.c_str()) return true;
+    return false;
+  }
+  String header(const String &) { return String(); }
+  String hostHeader() { return "192.168.4.1"; }
+
+  void setContentLength(size_t n) { _contentLength = n; }
+  void sendHeader(const String &name, const String &value, bool = false) { _bytes += name.length() + value.length() + 4; }
+  void send(int code, const char * = nullptr, const String &content = String()) {
+    _code = code;
+    _bytes += 64 + content.length();
+  }
+  void send(int code, const String &type, const String &content) { send(code, type.c_str(), content); }
+  void send_P(int code, PGM_P type, PGM_P content) { send(code, type, String(content)); }
+  void sendContent(const String &s) { _bytes += s.length(); }
+  void sendContent(const char *, size_t n) { _bytes += n; }
+  void sendContent_P(PGM_P s) { _bytes += strlen(s); }
+
+private:
+  struct Route { std::string uri; HTTPMethod method; THandlerFunction fn; };
+  std::vector<Route> _routes;
+  THandlerFunction _notFound;
+  std::vector<std::pair<std::string, std::string>> _args;
+  std::string _uri;
+  HTTPMethod _method = HTTP_GET;
+  size_t _contentLength = CONTENT_LENGTH_NOT_SET, _bytes = 0;
+  int _code = 0;
+  bool _begun = false;
+};
@@ -0,0 +1,102 @@
+/*
+  WiFi.h – controfigura di WiFi (core ESP32 2.0.x) per la build su PC
+
+  WiFi.begin con un SSID "connette" dopo un attimo se lo scenario ha la rete accesa
+  ("wifi on", il default); gli eventi arrivano ai callback di onEvent da un task a parte,
+  come dal loop eventi del core. "wifi off" nello scenario fa cadere la connessione.
+*/
+#pragma once
+#include "Arduino.h"
+#include "IPAddress.h"
+#include <functional>
+#include <vector>
+
+typedef enum {
+  WL_NO_SHIELD = 255, WL_IDLE_STATUS = 0, WL_NO_SSID_AVAIL, WL_SCAN_COMPLETED, WL_CONNECTED,
+  WL_CONNECT_FAILED, WL_CONNECTION_LOST, WL_DISCONNECTED
+} wl_status_t;
+typedef enum { WIFI_OFF = 0, WIFI_STA, WIFI_AP, WIFI_AP_STA } wifi_mode_t;
+#define WIFI_MODE_NULL WIFI_OFF
+#define WIFI_MODE_STA WIFI_STA
+#define WIFI_MODE_AP WIFI_AP
+#define WIFI_MODE_APSTA WIFI_AP_STA
+
+typedef enum {
+  ARDUINO_EVENT_WIFI_READY = 0, ARDUINO_EVENT_WIFI_SCAN_DONE, ARDUINO_EVENT_WIFI_STA_START,
+  ARDUINO_EVENT_WIFI_STA_STOP, ARDUINO_EVENT_WIFI_STA_CONNECTED, ARDUINO_EVENT_WIFI_STA_DISCONNECTED,
+  ARDUINO_EVENT_WIFI_STA_AUTHMODE_CHANGE, ARDUINO_EVENT_WIFI_STA_GOT_IP, ARDUINO_EVENT_WIFI_STA_GOT_IP6,
+  ARDUINO_EVENT_WIFI_STA_LOST_IP, ARDUINO_EVENT_WIFI_AP_START, ARDUINO_EVENT_WIFI_AP_STOP,
+  ARDUINO_EVENT_MAX
+} arduino_event_id_t;
+typedef arduino_event_id_t WiFiEvent_t;
+typedef struct { int dummy; } WiFiEventInfo_t;
+typedef void (*WiFiEventCb)(arduino_event_id_t event);
+typedef std::function<void(arduino_event_id_t, WiFiEventInfo_t)> WiFiEventFuncCb;
+typedef void (*WiFiEventSysCb)(arduino_event_id_t event, WiFiEventInfo_t info);
+typedef size_t wifi_event_id_t;
+
+class WiFiClient : public Stream {
+public:
+  virtual ~WiFiClient() {}
+  virtual int connect(const char *, uint16_t) { return 0; }
+  size_t write(uint8_t) override { return 1; }
+  size_t write(const uint8_t *, size_t n) override { return n; }
+  using Print::write;
+  int available() override { return 0; }
+  int read() override { return -1; }
+  virtual int read(uint8_t *, size_t) { return -1; }
+  size_t readBytes(uint8_t *b, size_t n) override {
+    int r = read(b, n);
+    return r > 0 ? (size_t)r : 0;
+  }
+  using Stream::readBytes;
+  int peek() override { return -1; }
+  virtual uint8_t connected() { return 0; }
+  virtual void stop() {}
+  void setTimeout(uint32_t) {}
+  operator bool() { return connected(); }
+};
+
+class WiFiClass {
+public:
+  wifi_event_id_t onEvent(WiFiEventCb cb, arduino_event_id_t = ARDUINO_EVENT_MAX);
+  wifi_event_id_t onEvent(WiFiEventFuncCb cb, arduino_event_id_t = ARDUINO_EVENT_MAX);
+  wifi_event_id_t onEvent(WiFiEventSysCb cb, arduino_event_id_t = ARDUINO_EVENT_MAX);
+  wl_status_t begin(const char *ssid, const char *pass = nullptr);
+  wl_status_t begin(const String &ssid, const String &pass = String()) { return begin(ssid.c_str(), pass.c_str()); }
+  wl_status_t status() { return _sta && host::wifiUp() ? WL_CONNECTED : WL_DISCONNECTED; }
+  bool isConnected() { return status() == WL_CONNECTED; }
+  bool reconnect() { if (_sta) host::wifiBegin(_ssid.c_str()); return _sta; }
+  bool disconnect(bool = false, bool = false) { _sta = false; return true; }
+  bool mode(wifi_mode_t m) {                    // solo AP (o spento): l'STA smette di riconnettersi
+    _mode = m;
+    if (m == WIFI_AP || m == WIFI_OFF) { _sta = false; host::wifiBegin(nullptr); }
+    return true;
+  }
+  wifi_mode_t getMode() { return _mode; }
+  void persistent(bool) {}
+  bool setSleep(bool) { return true; }
+  bool setAutoReconnect(bool) { return true; }
+  bool setHostname(const char *) { return true; }
+  bool softAP(const char *, const char * = nullptr, int = 1, int = 0, int = 4) { _ap = true; return true; }
+  bool softAPdisconnect(bool = false) { _ap = false; return true; }
+  IPAddress softAPIP() { return IPAddress(192, 168, 4, 1); }
+  IPAddress localIP() { return status() == WL_CONNECTED ? IPAddress(192, 168, 1, 48) : IPAddress(); }
+  String macAddress() { return "24:0A:C4:00:48:40"; }
+  uint8_t *macAddress(uint8_t *mac) {
+    static const uint8_t m[6] = {0x24, 0x0A, 0xC4, 0x00, 0x48, 0x40};
+    memcpy(mac, m, 6);
+    return mac;
+  }
+  int32_t RSSI() { return status() == WL_CONNECTED ? -58 : 0; }
+  String SSID() { return String(_ssid.c_str()); }
+
+  // Usati da host.cpp
+  void fire(arduino_event_id_t e);
+private:
+  std::vector<WiFiEventFuncCb> _cbs;
+  std::string _ssid;
+  wifi_mode_t _mode = WIFI_OFF;
+  bool _sta = false, _ap = false;
+};
+extern WiFiClass WiFi;
@@ -0,0 +1,11 @@
+#pragma once
+#include "Arduino.h"
+
+class TwoWire {
+public:
+  bool begin(int = -1, int = -1, uint32_t = 0) { return true; }
+  void setClock(uint32_t) {}
+  void beginTransmission(uint8_t) {}
+  uint8_t endTransmission(bool = true) { return 0; }
+};
+extern TwoWire Wire;
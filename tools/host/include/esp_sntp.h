@@ -0,0 +1,8 @@
+// Controfigura di esp_sntp.h: la sincronizzazione arriva poco dopo configTime (host.cpp)
+#pragma once
+#include <sys/time.h>
+
+typedef void (*sntp_sync_time_cb_t)(struct timeval *tv);
+typedef enum { SNTP_SYNC_STATUS_RESET, SNTP_SYNC_STATUS_COMPLETED, SNTP_SYNC_STATUS_IN_PROGRESS } sntp_sync_status_t;
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback);
+sntp_sync_status_t sntp_get_sync_status(void);
@@ -0,0 +1,12 @@
+#pragma once
+#include "FreeRTOS.h"
+
+typedef struct HostQueue *QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t ticks);
+BaseType_t xQueueSendToBack(QueueHandle_t q, const void *item, TickType_t ticks);
+BaseType_t xQueueOverwrite(QueueHandle_t q, const void *item);
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q);
+BaseType_t xQueueReset(QueueHandle_t q);
@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+"""
+ino2cpp.py – da sketch .ino a .cpp compilabile sul PC, come fa arduino-builder
+
+Uso (lo chiama la CMakeLists della radice):
+  python3 tools/host/ino2cpp.py Pongino/Pongino.ino -o build/Pongino.cpp --set DRAW_STATS=1
+
+  - aggiunge #include <Arduino.h> in testa;
+  - raccoglie i prototipi delle funzioni di primo livello e li mette prima della prima
+    definizione, così l'ordine delle funzioni nello sketch non conta (come nell'IDE);
+  - --set NOME=VALORE sostituisce il valore di "#define NOME ..." nello sketch (es. DRAW_STATS);
+  - #line riporta errori e avvisi alle righe del .ino.
+"""
+import argparse
+import os
+import re
+
+FUNC = re.compile(r'^((?:static\s+|inline\s+|IRAM_ATTR\s+)*[A-Za-z_][\w:<>]*[\s\*&]+(?:IRAM_ATTR\s+)?'
+                  r'[A-Za-z_]\w*\s*\([^;{}]*\))\s*\{')
+KEYWORD = re.compile(r'^(else|if|for|while|switch|return)\b')
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("ino")
+    ap.add_argument("-o", "--output", required=True)
+    ap.add_argument("--set", action="append", default=[], metavar="NOME=VALORE")
+    args = ap.parse_args()
+
+    lines = open(args.ino, encoding="utf-8").read().split("\n")
+    for s in args.set:
+        name, value = s.split("=", 1)
+        define = re.compile(r'^(\s*#\s*define\s+%s\s+)\S+(.*)$' % re.escape(name))
+        lines = [define.sub(lambda m: m.group(1) + value + m.group(2), l) for l in lines]
+
+    protos, first, depth = [], None, 0
+    for i, l in enumerate(lines):
+        if depth == 0:
+            m = FUNC.match(l)
+            if m and not KEYWORD.match(l):
+                protos.append(re.sub(r'=\s*[^,)]+', '', m.group(1)) + ';')
+                if first is None:
+                    first = i
+        depth += l.count('{') - l.count('}')
+
+    ino = args.ino.replace("\\", "/")
+    if first is not None:
+        lines.insert(first, "\n".join(protos) + '\n#line %d "%s"' % (first + 1, ino))
+    os.makedirs(os.path.dirname(os.path.abspath(args.output)), exist_ok=True)
+    with open(args.output, "w", encoding="utf-8") as f:
+        f.write('#include <Arduino.h>\n#line 1 "%s"\n' % ino)
+        f.write("\n".join(lines))
+
+
+if __name__ == "__main__":
+    main()
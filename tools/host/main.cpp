@@ -0,0 +1,216 @@
+/*
+  main.cpp – esegue setup()/loop() di uno sketch su uno scenario e riassume il disegno
+
+  Uso:  host_Pongino scenario.txt [-o cartella]
+  Nella cartella (default: host-<scenario> nella cartella corrente) vanno la copia di lavoro
+  della SD e, a fine corsa, screen.ppm con l'ultimo schermo.
+
+  Scenario, una riga per comando ('#' commenta):
+    sketch Pongino            a chi è destinato (lo usa drawbench.py)
+    seconds 90                durata simulata
+    sd dati/                  cartella copiata come SD (relativa allo scenario)
+    www fixtures/             risposte di HTTPClient (vedi HTTPClient.h)
+    nvs wifi ssid casa        valore in Preferences prima del boot
+    epoch 1768471680          ora che consegnerà l'SNTP
+    clock cpu                 l'orologio avanza anche del tempo CPU reale (parse, pagine web)
+    wifi off                  rete assente dall'accensione
+  e comandi a tempo, in ms dall'accensione:
+    1500 touch 240 400        dito giù (coordinate grezze del GT911)
+    1700 release
+    2000 serial rec           una riga su Serial
+    2000 file sessione.txt    un file intero su Serial
+    9000 get /boot            richiesta al WebServer dello sketch
+    9000 post /save a=1&b=2
+    30000 wifi off            cade la rete (e "wifi on" la riporta)
+
+  A fine corsa, su stdout:
+    [HOST] draw frames=.. fill=.. bitmap=.. pixel=.. px=.. maxfill=.. maxbitmap=.. maxpx=.. us=.. maxus=..
+  Un frame è un giro di loop() che ha disegnato; us sono microsecondi reali del PC spesi nei
+  giri che hanno disegnato (compresi gli altri task che hanno girato nel frattempo).
+*/
+#include "Arduino.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+void setup();
+void loop();
+
+namespace {
+
+struct Stats {
+  uint64_t frames = 0, fill = 0, bitmap = 0, pixel = 0, px = 0, us = 0;
+  uint64_t maxFill = 0, maxBitmap = 0, maxPx = 0, maxUs = 0;
+} g_stats;
+
+uint64_t g_passes = 0;
+
+std::string slurp(const std::string &path) {
+  std::ifstream f(path, std::ios::binary);
+  if (!f) { fprintf(stderr, "[HOST] non trovo %s\n", path.c_str()); exit(1); }
+  std::stringstream ss;
+  ss << f.rdbuf();
+  return ss.str();
+}
+
+void dumpScreen() {
+  if (!host::framebuffer || host::outDir.empty()) return;
+  FILE *f = fopen((host::outDir + "/screen.ppm").c_str(), "wb");
+  if (!f) return;
+  fprintf(f, "P6\n%d %d\n255\n", host::fbWidth, host::fbHeight);
+  for (int i = 0; i < host::fbWidth * host::fbHeight; ++i) {
+    const uint16_t c = host::framebuffer[i];
+    const uint8_t rgb[3] = {(uint8_t)((c >> 11) * 255 / 31), (uint8_t)(((c >> 5) & 63) * 255 / 63),
+                            (uint8_t)((c & 31) * 255 / 31)};
+    fwrite(rgb, 1, 3, f);
+  }
+  fclose(f);
+}
+
+// Legge lo scenario: impostazioni subito, comandi a tempo come eventi dello scheduler
+void loadScenario(const std::string &path) {
+  namespace fsys = std::filesystem;
+  const fsys::path dir = fsys::path(path).parent_path();
+  std::istringstream in(slurp(path));
+  std::string line;
+  int lineNo = 0;
+  while (std::getline(in, line)) {
+    ++lineNo;
+    if (size_t h = line.find('#'); h != std::string::npos && (h == 0 || isspace((unsigned char)line[h - 1])))
+      line.erase(h);
+    std::istringstream ls(line);
+    std::string first;
+    if (!(ls >> first)) continue;
+    std::string rest;
+    std::getline(ls, rest);
+    rest.erase(0, rest.find_first_not_of(" \t"));
+    rest.erase(rest.find_last_not_of(" \t\r") + 1);
+
+    if (!isdigit((unsigned char)first[0])) {
+      std::istringstream rs(rest);
+      if (first == "sketch") continue;
+      else if (first == "seconds") host::endUs = (uint64_t)(atof(rest.c_str()) * 1e6);
+      else if (first == "sd") {
+        const fsys::path work = fsys::path(host::outDir) / "sd";
+        fsys::remove_all(work);
+        fsys::copy(dir / rest, work, fsys::copy_options::recursive);
+        host::sdRoot = work.string();
+      }
+      else if (first == "www") host::wwwRoot = (dir / rest).string();
+      else if (first == "nvs") {
+        std::string ns, key, value;
+        rs >> ns >> key;
+        std::getline(rs, value);
+        value.erase(0, value.find_first_not_of(" \t"));
+        host::nvsSet(ns, key, value);
+      }
+      else if (first == "epoch") host::setEpoch(atoll(rest.c_str()));
+      else if (first == "clock") host::cpuClock = rest == "cpu";
+      else if (first == "wifi") host::wifiSet(rest != "off");
+      else { fprintf(stderr, "%s:%d: impostazione sconosciuta '%s'\n", path.c_str(), lineNo, first.c_str()); exit(1); }
+      continue;
+    }
+
+    const uint64_t t = (uint64_t)atoll(first.c_str()) * 1000;
+    std::istringstream rs(rest);
+    std::string cmd, arg;
+    rs >> cmd;
+    std::getline(rs, arg);
+    arg.erase(0, arg.find_first_not_of(" \t"));
+    if (cmd == "touch") {
+      int x = 0, y = 0;
+      sscanf(arg.c_str(), "%d %d", &x, &y);
+      host::at(t, [x, y] { host::touch = {true, x, y}; });
+    } else if (cmd == "release") {
+      host::at(t, [] { host::touch.down = false; });
+    } else if (cmd == "serial") {
+      host::at(t, [arg] { host::serialFeed(arg + "\n"); });
+    } else if (cmd == "file") {
+      std::string data = slurp((dir / arg).string());
+      host::at(t, [data] { host::serialFeed(data); });
+    } else if (cmd == "get" || cmd == "post") {
+      std::string uri = arg, body;
+      if (cmd == "post" && arg.find(' ') != std::string::npos) {
+        uri = arg.substr(0, arg.find(' '));
+        body = arg.substr(arg.find(' ') + 1);
+      }
+      host::WebRequest r{cmd == "get" ? "GET" : "POST", uri, body};
+      host::at(t, [r] { host::queueWebRequest(r); });
+    } else if (cmd == "wifi") {
+      const bool on = arg != "off";
+      host::at(t, [on] { host::wifiSet(on); });
+    } else {
+      fprintf(stderr, "%s:%d: comando sconosciuto '%s'\n", path.c_str(), lineNo, cmd.c_str());
+      exit(1);
+    }
+  }
+}
+
+}  // namespace
+
+namespace host {
+
+void finish(const char *why) {
+  fflush(stdout);
+  const Stats &s = g_stats;
+  const uint64_t f = s.frames ? s.frames : 1;
+  printf("\n[HOST] fine: %s a %llu ms simulati, %llu giri di loop\n", why,
+         (unsigned long long)(nowUs() / 1000), (unsigned long long)g_passes);
+  printf("[HOST] frame %llu: fill %.1f (max %llu), bitmap %.1f (max %llu), px %.0f (max %llu), %.0f us (max %llu)\n",
+         (unsigned long long)s.frames, (double)s.fill / f, (unsigned long long)s.maxFill, (double)s.bitmap / f,
+         (unsigned long long)s.maxBitmap, (double)s.px / f, (unsigned long long)s.maxPx, (double)s.us / f,
+         (unsigned long long)s.maxUs);
+  printf("[HOST] heap libera %zu, minima %zu, picco usato %zu; PSRAM libera %zu\n", heapFree(), heapMinFree(),
+         heapPeak(), psramFree());
+  printf("[HOST] draw frames=%llu fill=%llu bitmap=%llu pixel=%llu px=%llu maxfill=%llu maxbitmap=%llu maxpx=%llu us=%llu maxus=%llu\n",
+         (unsigned long long)s.frames, (unsigned long long)s.fill, (unsigned long long)s.bitmap,
+         (unsigned long long)s.pixel, (unsigned long long)s.px, (unsigned long long)s.maxFill,
+         (unsigned long long)s.maxBitmap, (unsigned long long)s.maxPx, (unsigned long long)s.us,
+         (unsigned long long)s.maxUs);
+  dumpScreen();
+  fflush(stdout);
+  _exit(strcmp(why, "stallo") == 0 ? 2 : 0);
+}
+
+}  // namespace host
+
+int main(int argc, char **argv) {
+  std::string scenario, out;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "-o") && i + 1 < argc) out = argv[++i];
+    else scenario = argv[i];
+  }
+  if (scenario.empty()) { fprintf(stderr, "uso: %s scenario.txt [-o cartella]\n", argv[0]); return 1; }
+  if (out.empty()) out = "host-" + std::filesystem::path(scenario).stem().string();
+  std::filesystem::create_directories(out);
+  host::outDir = out;
+  static char outBuf[1 << 16];           // buffer statico: non pesa sulla heap dello sketch
+  setvbuf(stdout, outBuf, _IOLBF, sizeof(outBuf));
+  loadScenario(scenario);
+
+  host::currentTask();                   // il loopTask esiste già prima di misurare
+  host::heapBaseline();
+  setup();
+  for (;;) {
+    const host::Counters before = host::draw;
+    const uint64_t t0 = host::wallUs();
+    loop();
+    const uint64_t us = host::wallUs() - t0;
+    const host::Counters &d = host::draw;
+    g_passes++;
+    if (d.fill != before.fill || d.bitmap != before.bitmap || d.pixel != before.pixel) {
+      Stats &s = g_stats;
+      const uint64_t fill = d.fill - before.fill, bitmap = d.bitmap - before.bitmap, px = d.px - before.px;
+      s.frames++;
+      s.fill += fill; s.bitmap += bitmap; s.pixel += d.pixel - before.pixel; s.px += px; s.us += us;
+      s.maxFill = std::max(s.maxFill, fill);
+      s.maxBitmap = std::max(s.maxBitmap, bitmap);
+      s.maxPx = std::max(s.maxPx, px);
+      s.maxUs = std::max(s.maxUs, us);
+    }
+    host::sleepUs(1000);                 // un giro di loop = 1 ms simulato, e il turno agli altri task
+  }
+}
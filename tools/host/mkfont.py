@@ -0,0 +1,46 @@
+#!/usr/bin/env python3
+"""
+mkfont.py – genera include/HostFont.h, il font 5x8 del display simulato
+
+Uso (dalla radice del repo, serve Pillow):
+  python3 tools/host/mkfont.py > tools/host/include/HostFont.h
+
+Il font classico di Arduino_GFX non è nel repo: i glifi ASCII 32..126 si ricavano dal font
+bitmap di default di Pillow (6x11), tenendo le righe 2..9 e unendo la sesta colonna alla
+quinta e l'ultima riga alla penultima. Serve a contare pixel realistici e a leggere i dump
+dello schermo; i contatori del testo trasparente restano un'approssimazione di quelli del
+pannello. Stesso layout di glcdfont: 5 byte per carattere, una colonna per byte, bit 0 in alto.
+"""
+from PIL import ImageFont
+
+
+def glyph(font, ch):
+    m = font.getmask(ch)
+    w, h = m.size
+    on = lambda x, y: x < w and y < h and m.getpixel((x, y)) != 0  # noqa: E731
+    cols = []
+    for x in range(5):
+        bits = 0
+        for r in range(8):
+            y = r + 2
+            if on(x, y) or (x == 4 and on(5, y)) or (r == 7 and (on(x, 10) or (x == 4 and on(5, 10)))):
+                bits |= 1 << r
+        cols.append(bits)
+    return cols
+
+
+def main():
+    font = ImageFont.load_default_imagefont()
+    print("// Generato da tools/host/mkfont.py: non modificare a mano.")
+    print("#pragma once")
+    print("#include <stdint.h>")
+    print("")
+    print("static const uint8_t HOST_FONT[256 * 5] = {")
+    for c in range(256):
+        cols = glyph(font, chr(c)) if 32 < c < 127 else [0] * 5
+        print("  " + ", ".join("0x%02X" % b for b in cols) + ",%s" % ("   // '%s'" % chr(c) if 32 < c < 127 and chr(c) != "\\" else ""))
+    print("};")
+
+
+if __name__ == "__main__":
+    main()
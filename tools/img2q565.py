@@ -0,0 +1,233 @@
+#!/usr/bin/env python3
+"""
+img2q565.py – converte un'immagine in un header C compresso Q565 (RGB565 senza perdite)
+
+Uso:
+  python3 tools/img2q565.py splash.png  --name Pongino -o Pongino/Pongino.h
+  python3 tools/img2q565.py Pongino.h   --name Pongino -o Pongino/Pongino.h   (da un vecchio array RGB565)
+  python3 tools/img2q565.py foto.jpg    --name Sfondo --size 480x480 -o Sfondo.h
+
+Ingresso: PNG/JPEG/BMP (serve Pillow) oppure un header C con un array uint16_t RGB565
+(come quelli generati dai convertitori online: vanno passati WIDTH/HEIGHT con --size
+se l'header non li definisce).
+
+Uscita: NAME_WIDTH, NAME_HEIGHT e `static const uint8_t NAME_q565[] PROGMEM`,
+da disegnare con drawQ565() di Q565.h (una riga alla volta, buffer di una riga).
+
+Formato Q565 (little endian):
+  header  'Q' '5' '6' '5', larghezza u16, altezza u16
+  stream  pixel in ordine di riga; stato iniziale prev = 0, index[64] = 0, mru[8] = 0
+    00xxxxxx  INDEX  pixel = index[x]
+    01aaabbb  PAIR   due pixel: mru[a], poi mru[b] (mru aggiornata dopo il primo)
+    10gggggg  LUMA   + 1 byte rrrrbbbb: dg = g-32, dr = dg + r-8, db = dg + b-8 (rispetto a prev)
+    11xxxxxx  RUN    x+1 copie di prev (x = 0..61)
+    11111110  RGB    + 2 byte: pixel RGB565
+    11111111  riservato
+  Ogni pixel che non viene da RUN aggiorna index[hash] e sposta il colore in testa a mru.
+  hash = (r*3 + g*5 + b*7) & 63 con r, g, b i campi 5/6/5 del pixel.
+"""
+import argparse
+import os
+import re
+import sys
+
+MAGIC = b"Q565"
+OP_INDEX, OP_PAIR, OP_LUMA, OP_RUN, OP_RGB = 0x00, 0x40, 0x80, 0xC0, 0xFE
+RUN_MAX = 62
+
+
+def q565_hash(c):
+    return ((c >> 11) * 3 + ((c >> 5) & 63) * 5 + (c & 31) * 7) & 63
+
+
+def wrap(v, bits):
+    m = 1 << bits
+    v &= m - 1
+    return v - m if v >= m // 2 else v
+
+
+def mru_push(mru, c):
+    i = mru.index(c) if c in mru else len(mru) - 1
+    del mru[i]
+    mru.insert(0, c)
+
+
+def encode(px, w, h):
+    out = bytearray(MAGIC + w.to_bytes(2, "little") + h.to_bytes(2, "little"))
+    index = [0] * 64
+    mru = [0] * 8
+    prev = 0
+    stats = dict.fromkeys(("index", "pair", "luma", "run", "rgb"), 0)
+    n, i = len(px), 0
+
+    def emitted(c):
+        index[q565_hash(c)] = c
+        mru_push(mru, c)
+
+    while i < n:
+        c = px[i]
+        if c == prev:
+            j = i
+            while j < n and px[j] == prev and j - i < RUN_MAX:
+                j += 1
+            out.append(OP_RUN | (j - i - 1))
+            stats["run"] += 1
+            i = j
+            continue
+
+        # due pixel consecutivi tra gli 8 colori più recenti: un byte
+        if c in mru and i + 1 < n and px[i + 1] != c:
+            trial = list(mru)
+            a = trial.index(c)
+            mru_push(trial, c)
+            d = px[i + 1]
+            if d in trial:
+                b = trial.index(d)
+                out.append(OP_PAIR | (a << 3) | b)
+                stats["pair"] += 1
+                emitted(c)
+                emitted(d)
+                prev = d
+                i += 2
+                continue
+
+        k = q565_hash(c)
+        if index[k] == c:
+            out.append(OP_INDEX | k)
+            stats["index"] += 1
+        else:
+            dr = wrap((c >> 11) - (prev >> 11), 5)
+            dg = wrap(((c >> 5) & 63) - ((prev >> 5) & 63), 6)
+            db = wrap((c & 31) - (prev & 31), 5)
+            if -32 <= dg <= 31 and -8 <= dr - dg <= 7 and -8 <= db - dg <= 7:
+                out.append(OP_LUMA | (dg + 32))
+                out.append(((dr - dg + 8) << 4) | (db - dg + 8))
+                stats["luma"] += 1
+            else:
+                out.append(OP_RGB)
+                out += c.to_bytes(2, "little")
+                stats["rgb"] += 1
+        emitted(c)
+        prev = c
+        i += 1
+    return out, stats
+
+
+def decode(data):
+    """Decoder di riferimento (stessa logica di Q565.h), per la verifica."""
+    if data[:4] != MAGIC:
+        raise ValueError("non è uno stream Q565")
+    w = int.from_bytes(data[4:6], "little")
+    h = int.from_bytes(data[6:8], "little")
+    index, mru, prev, px = [0] * 64, [0] * 8, 0, []
+    p = 8
+
+    def emitted(c):
+        index[q565_hash(c)] = c
+        mru_push(mru, c)
+        px.append(c)
+
+    while len(px) < w * h:
+        op = data[p]
+        p += 1
+        if op == OP_RGB:
+            c = int.from_bytes(data[p:p + 2], "little")
+            p += 2
+            emitted(c)
+            prev = c
+        elif op >= OP_RUN:
+            px.extend([prev] * ((op & 63) + 1))
+        elif op >= OP_LUMA:
+            dg = (op & 63) - 32
+            dr = dg + (data[p] >> 4) - 8
+            db = dg + (data[p] & 15) - 8
+            p += 1
+            c = ((((prev >> 11) + dr) & 31) << 11) | ((((prev >> 5) + dg) & 63) << 5) | (((prev & 31) + db) & 31)
+            emitted(c)
+            prev = c
+        elif op >= OP_PAIR:
+            c = mru[(op >> 3) & 7]
+            emitted(c)
+            c = mru[op & 7]
+            emitted(c)
+            prev = c
+        else:
+            c = index[op]
+            emitted(c)
+            prev = c
+    return w, h, px[:w * h]
+
+
+def load_image(path, size):
+    from PIL import Image  # solo per immagini: gli header C non ne hanno bisogno
+    im = Image.open(path).convert("RGB")
+    if size and im.size != size:
+        im = im.resize(size, Image.LANCZOS)
+    w, h = im.size
+    px = [((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3) for r, g, b in im.getdata()]
+    return w, h, px
+
+
+def load_header(path, size):
+    src = open(path, encoding="utf-8", errors="replace").read()
+    w = re.search(r"#define\s+\w*WIDTH\s+(\d+)", src)
+    h = re.search(r"#define\s+\w*HEIGHT\s+(\d+)", src)
+    if size:
+        w, h = size
+    elif w and h:
+        w, h = int(w.group(1)), int(h.group(1))
+    else:
+        sys.exit("%s: dimensioni non trovate, usare --size WxH" % path)
+    body = src[src.index("{") + 1:src.rindex("}")]
+    px = [int(v, 16) for v in re.findall(r"0x[0-9A-Fa-f]+", body)]
+    if len(px) != w * h:
+        sys.exit("%s: %d valori, attesi %dx%d" % (path, len(px), w, h))
+    return w, h, px
+
+
+def write_header(path, name, src_name, w, h, data, raw_bytes):
+    lines = [
+        "// Generato da tools/img2q565.py (%s) – non modificare a mano" % src_name,
+        "// %dx%d RGB565: %d byte grezzi -> %d byte Q565 (%.2fx), si disegna con drawQ565() di Q565.h"
+        % (w, h, raw_bytes, len(data), raw_bytes / len(data)),
+        "#pragma once",
+        "#define %s_WIDTH %d" % (name.upper(), w),
+        "#define %s_HEIGHT %d" % (name.upper(), h),
+        "",
+        "static const uint8_t %s_q565[%d] PROGMEM = {" % (name, len(data)),
+    ]
+    for i in range(0, len(data), 24):
+        lines.append("  " + ", ".join("0x%02x" % b for b in data[i:i + 24]) + ",")
+    lines.append("};")
+    with open(path, "w", newline="\n") as f:
+        f.write("\n".join(lines) + "\n")
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Converte un'immagine in un header C Q565 (RGB565 compresso).")
+    ap.add_argument("input", help="PNG/JPEG/BMP oppure header C con array RGB565")
+    ap.add_argument("-o", "--output", help="header da scrivere (default: NAME.h)")
+    ap.add_argument("--name", help="nome dell'asset (default: nome del file)")
+    ap.add_argument("--size", help="WxH: ridimensiona l'immagine / dimensioni dell'array")
+    args = ap.parse_args()
+
+    name = args.name or re.sub(r"\W", "_", os.path.splitext(os.path.basename(args.input))[0])
+    size = tuple(int(v) for v in args.size.lower().split("x")) if args.size else None
+    if args.input.lower().endswith((".h", ".c")):
+        w, h, px = load_header(args.input, size)
+    else:
+        w, h, px = load_image(args.input, size)
+
+    data, stats = encode(px, w, h)
+    if decode(data)[2] != px:
+        sys.exit("verifica fallita: lo stream decodificato non coincide")
+
+    out = args.output or name + ".h"
+    write_header(out, name, os.path.basename(args.input), w, h, data, len(px) * 2)
+    print("%s: %dx%d, %d -> %d byte (%.2fx)  index=%d pair=%d luma=%d run=%d rgb=%d"
+          % (out, w, h, len(px) * 2, len(data), len(px) * 2 / len(data),
+             stats["index"], stats["pair"], stats["luma"], stats["run"], stats["rgb"]))
+
+
+if __name__ == "__main__":
+    main()
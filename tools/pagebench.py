@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+"""
+pagebench.py – misura le pagine web del pannello da un client HTTP locale
+
+Uso:
+  python3 tools/pagebench.py http://192.168.1.50/route http://192.168.1.50/rss
+  python3 tools/pagebench.py -n 20 http://192.168.1.50/route
+  python3 tools/pagebench.py --post "action=save_route&from=Bellinzona&to=Lugano&refresh=300" http://192.168.1.50/route
+
+Per ogni richiesta, con un socket grezzo (niente buffer di librerie in mezzo):
+  header   ms dalla connessione al primo byte della risposta (status line)
+  body     ms al primo byte del body (per chunked: dopo la prima riga di lunghezza)
+  totale   ms all'ultimo byte
+  byte     lunghezza del body; chunk = numero di chunk HTTP (0 = Content-Length)
+Stampa mediana e massimo su -n ripetizioni. Il picco di heap lo stampa il pannello su
+Serial ([WEB] ...), qui non si vede.
+"""
+import argparse
+import socket
+import statistics
+import sys
+import time
+from urllib.parse import urlsplit
+
+
+def fetch(url, body=None, timeout=10.0):
+    u = urlsplit(url)
+    host, port = u.hostname, u.port or 80
+    path = (u.path or "/") + ("?" + u.query if u.query else "")
+    method = "POST" if body is not None else "GET"
+    req = f"{method} {path} HTTP/1.1\r\nHost: {host}\r\nConnection: close\r\n"
+    if body is not None:
+        req += f"Content-Type: application/x-www-form-urlencoded\r\nContent-Length: {len(body)}\r\n"
+    req += "\r\n" + (body or "")
+
+    t0 = time.perf_counter()
+    s = socket.create_connection((host, port), timeout=timeout)
+    s.sendall(req.encode())
+    buf = b""
+    t_head = t_body = None
+    head_end = -1
+    while True:
+        d = s.recv(4096)
+        if not d:
+            break
+        now = time.perf_counter()
+        if t_head is None:
+            t_head = now
+        buf += d
+        if head_end < 0:
+            head_end = buf.find(b"\r\n\r\n")
+            if head_end < 0:
+                continue
+            chunked = b"transfer-encoding: chunked" in buf[:head_end].lower()
+        if t_body is None:
+            rest = buf[head_end + 4:]
+            # per chunked conta il primo byte di dati, non la riga di lunghezza
+            if (chunked and b"\r\n" in rest and len(rest) > rest.find(b"\r\n") + 2) or (not chunked and rest):
+                t_body = now
+    t_end = time.perf_counter()
+    s.close()
+
+    status = buf.split(b"\r\n", 1)[0].decode(errors="replace")
+    raw = buf[head_end + 4:] if head_end >= 0 else b""
+    nbytes, chunks = len(raw), 0
+    if head_end >= 0 and chunked:
+        nbytes, i = 0, 0
+        while True:
+            j = raw.find(b"\r\n", i)
+            if j < 0:
+                break
+            n = int(raw[i:j].split(b";")[0] or b"0", 16)
+            if n == 0:
+                break
+            nbytes += n
+            chunks += 1
+            i = j + 2 + n + 2
+    ms = lambda t: (t - t0) * 1000.0 if t else float("nan")
+    return status, ms(t_head), ms(t_body), ms(t_end), nbytes, chunks
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("url", nargs="+")
+    ap.add_argument("-n", type=int, default=10, help="ripetizioni per pagina (default 10)")
+    ap.add_argument("--post", help="body application/x-www-form-urlencoded: manda POST invece di GET")
+    a = ap.parse_args()
+
+    print(f"{'pagina':32} {'header':>14} {'body':>14} {'totale':>14} {'byte':>7} {'chunk':>5}")
+    for url in a.url:
+        rows = []
+        for _ in range(a.n):
+            try:
+                rows.append(fetch(url, a.post))
+            except OSError as e:
+                print(f"{url}: {e}", file=sys.stderr)
+                break
+        if not rows:
+            continue
+        col = lambda k: f"{statistics.median(r[k] for r in rows):6.1f}/{max(r[k] for r in rows):6.1f}"
+        last = rows[-1]
+        print(f"{urlsplit(url).path or '/':32} {col(1):>14} {col(2):>14} {col(3):>14} {last[4]:7d} {last[5]:5d}   {last[0]}")
+    print("(ms, mediana/max)")
+
+
+if __name__ == "__main__":
+    main()